@@ -4447,7 +4447,7 @@ ac_lower_indirect_derefs(struct nir_shader *nir, enum chip_class chip_class)
 	 */
 	indirect_mask |= nir_var_function_temp;
 
-	nir_lower_indirect_derefs(nir, indirect_mask);
+	nir_lower_indirect_derefs(nir, indirect_mask, UINT32_MAX);
 }
 
 static unsigned
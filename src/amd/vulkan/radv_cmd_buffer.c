@@ -287,6 +287,8 @@ static VkResult radv_create_cmd_buffer(
 		return vk_error(device->instance, VK_ERROR_OUT_OF_HOST_MEMORY);
 	}
 
+	vk_arena_init(&cmd_buffer->transient, &cmd_buffer->pool->alloc, 4096);
+
 	*pCommandBuffer = radv_cmd_buffer_to_handle(cmd_buffer);
 
 	list_inithead(&cmd_buffer->upload.list);
@@ -313,6 +315,8 @@ radv_cmd_buffer_destroy(struct radv_cmd_buffer *cmd_buffer)
 	for (unsigned i = 0; i < VK_PIPELINE_BIND_POINT_RANGE_SIZE; i++)
 		free(cmd_buffer->descriptors[i].push_set.set.mapped_ptr);
 
+	vk_arena_finish(&cmd_buffer->transient);
+
 	vk_free(&cmd_buffer->pool->alloc, cmd_buffer);
 }
 
@@ -341,6 +345,10 @@ radv_reset_cmd_buffer(struct radv_cmd_buffer *cmd_buffer)
 				   cmd_buffer->upload.upload_bo);
 	cmd_buffer->upload.offset = 0;
 
+	vk_arena_reset(&cmd_buffer->transient);
+	cmd_buffer->state.attachments = NULL;
+	cmd_buffer->state.subpass_sample_locs = NULL;
+
 	cmd_buffer->record_result = VK_SUCCESS;
 
 	memset(cmd_buffer->vertex_bindings, 0, sizeof(cmd_buffer->vertex_bindings));
@@ -2863,10 +2871,9 @@ radv_cmd_state_setup_sample_locations(struct radv_cmd_buffer *cmd_buffer,
 			     sample_locs_info->sampleLocationsCount);
 	}
 
-	state->subpass_sample_locs = vk_alloc(&cmd_buffer->pool->alloc,
-					      sample_locs->postSubpassSampleLocationsCount *
-					      sizeof(state->subpass_sample_locs[0]),
-					      8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+	state->subpass_sample_locs = vk_arena_alloc(&cmd_buffer->transient,
+						    sample_locs->postSubpassSampleLocationsCount *
+						    sizeof(state->subpass_sample_locs[0]), 8);
 	if (state->subpass_sample_locs == NULL) {
 		cmd_buffer->record_result = VK_ERROR_OUT_OF_HOST_MEMORY;
 		return cmd_buffer->record_result;
@@ -2908,10 +2915,9 @@ radv_cmd_state_setup_attachments(struct radv_cmd_buffer *cmd_buffer,
 		return VK_SUCCESS;
 	}
 
-	state->attachments = vk_alloc(&cmd_buffer->pool->alloc,
-					pass->attachment_count *
-					sizeof(state->attachments[0]),
-					8, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+	state->attachments = vk_arena_alloc(&cmd_buffer->transient,
+					    pass->attachment_count *
+					    sizeof(state->attachments[0]), 8);
 	if (state->attachments == NULL) {
 		cmd_buffer->record_result = VK_ERROR_OUT_OF_HOST_MEMORY;
 		return cmd_buffer->record_result;
@@ -3388,9 +3394,6 @@ VkResult radv_EndCommandBuffer(
 	 */
 	si_cp_dma_wait_for_idle(cmd_buffer);
 
-	vk_free(&cmd_buffer->pool->alloc, cmd_buffer->state.attachments);
-	vk_free(&cmd_buffer->pool->alloc, cmd_buffer->state.subpass_sample_locs);
-
 	if (!cmd_buffer->device->ws->cs_finalize(cmd_buffer->cs))
 		return vk_error(cmd_buffer->device->instance, VK_ERROR_OUT_OF_DEVICE_MEMORY);
 
@@ -4812,9 +4815,8 @@ void radv_CmdEndRenderPass(
 
 	radv_cmd_buffer_end_subpass(cmd_buffer);
 
-	vk_free(&cmd_buffer->pool->alloc, cmd_buffer->state.attachments);
-	vk_free(&cmd_buffer->pool->alloc, cmd_buffer->state.subpass_sample_locs);
-
+	/* The attachment state lives in the transient arena and is reclaimed
+	 * with everything else at the next command buffer reset. */
 	cmd_buffer->state.pass = NULL;
 	cmd_buffer->state.subpass = NULL;
 	cmd_buffer->state.attachments = NULL;
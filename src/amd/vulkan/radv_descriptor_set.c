@@ -469,6 +469,78 @@ void radv_DestroyPipelineLayout(
 
 #define EMPTY 1
 
+/* Chunk allocator for the set structs of freeable pools. Freed chunks are
+ * linked through a first-fit free list embedded in the chunks themselves,
+ * so allocating and freeing sets never touches the heap allocator, which
+ * is shared between all recording threads. Offsets are relative to
+ * chunk_memory_base.
+ */
+#define RADV_DESCRIPTOR_POOL_CHUNK_END (~0u)
+
+struct radv_descriptor_pool_chunk {
+	uint32_t size;
+	uint32_t next;
+};
+
+static void *
+radv_descriptor_pool_chunk_alloc(struct radv_descriptor_pool *pool,
+				 unsigned size)
+{
+	uint32_t *prev = &pool->free_chunk_offset;
+
+	if (!pool->chunk_memory_base)
+		return NULL;
+
+	size = align_u32(size, 8);
+
+	while (*prev != RADV_DESCRIPTOR_POOL_CHUNK_END) {
+		struct radv_descriptor_pool_chunk *chunk =
+			(struct radv_descriptor_pool_chunk *)(pool->chunk_memory_base + *prev);
+
+		if (chunk->size >= size) {
+			/* Split the chunk if the remainder can still hold a
+			 * set, otherwise hand out all of it. */
+			if (chunk->size - size >= sizeof(struct radv_descriptor_set) + 8) {
+				struct radv_descriptor_pool_chunk *rest =
+					(struct radv_descriptor_pool_chunk *)((uint8_t*)chunk + size);
+				rest->size = chunk->size - size;
+				rest->next = chunk->next;
+				*prev += size;
+			} else {
+				*prev = chunk->next;
+			}
+			return chunk;
+		}
+		prev = &chunk->next;
+	}
+
+	if (pool->chunk_memory_end - pool->chunk_memory_ptr < size)
+		return NULL;
+
+	void *ret = pool->chunk_memory_ptr;
+	pool->chunk_memory_ptr += size;
+	return ret;
+}
+
+static void
+radv_descriptor_pool_free_set_memory(struct radv_device *device,
+				     struct radv_descriptor_pool *pool,
+				     struct radv_descriptor_set *set,
+				     unsigned mem_size)
+{
+	if ((uint8_t*)set >= pool->chunk_memory_base &&
+	    (uint8_t*)set < pool->chunk_memory_end) {
+		struct radv_descriptor_pool_chunk *chunk =
+			(struct radv_descriptor_pool_chunk *)set;
+
+		chunk->size = align_u32(mem_size, 8);
+		chunk->next = pool->free_chunk_offset;
+		pool->free_chunk_offset = (uint8_t*)set - pool->chunk_memory_base;
+	} else {
+		vk_free2(&device->alloc, NULL, set);
+	}
+}
+
 static VkResult
 radv_descriptor_set_create(struct radv_device *device,
 			   struct radv_descriptor_pool *pool,
@@ -489,8 +561,13 @@ radv_descriptor_set_create(struct radv_device *device,
 		set = (struct radv_descriptor_set*)pool->host_memory_ptr;
 		pool->host_memory_ptr += mem_size;
 	} else {
-		set = vk_alloc2(&device->alloc, NULL, mem_size, 8,
-		                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+		set = radv_descriptor_pool_chunk_alloc(pool, mem_size);
+
+		/* Fall back to the heap when the pool-local storage is
+		 * exhausted or too fragmented. */
+		if (!set)
+			set = vk_alloc2(&device->alloc, NULL, mem_size, 8,
+			                VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 
 		if (!set)
 			return vk_error(device->instance, VK_ERROR_OUT_OF_HOST_MEMORY);
@@ -514,7 +591,7 @@ radv_descriptor_set_create(struct radv_device *device,
 		set->size = layout_size;
 
 		if (!pool->host_memory_base && pool->entry_count == pool->max_entry_count) {
-			vk_free2(&device->alloc, NULL, set);
+			radv_descriptor_pool_free_set_memory(device, pool, set, mem_size);
 			return vk_error(device->instance, VK_ERROR_OUT_OF_POOL_MEMORY);
 		}
 
@@ -543,7 +620,7 @@ radv_descriptor_set_create(struct radv_device *device,
 			}
 
 			if (pool->size - offset < layout_size) {
-				vk_free2(&device->alloc, NULL, set);
+				radv_descriptor_pool_free_set_memory(device, pool, set, mem_size);
 				return vk_error(device->instance, VK_ERROR_OUT_OF_POOL_MEMORY);
 			}
 			set->bo = pool->bo;
@@ -600,7 +677,11 @@ radv_descriptor_set_destroy(struct radv_device *device,
 			}
 		}
 	}
-	vk_free2(&device->alloc, NULL, set);
+
+	unsigned mem_size = sizeof(struct radv_descriptor_set) +
+		sizeof(struct radeon_winsys_bo *) * set->layout->buffer_count +
+		sizeof(struct radv_descriptor_range) * set->layout->dynamic_offset_count;
+	radv_descriptor_pool_free_set_memory(device, pool, set, mem_size);
 }
 
 VkResult radv_CreateDescriptorPool(
@@ -664,13 +745,18 @@ VkResult radv_CreateDescriptorPool(
 		}
 	}
 
+	uint64_t host_size = pCreateInfo->maxSets * sizeof(struct radv_descriptor_set);
+	host_size += sizeof(struct radeon_winsys_bo*) * bo_count;
+	host_size += sizeof(struct radv_descriptor_range) * range_count;
+
 	if (!(pCreateInfo->flags & VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT)) {
-		uint64_t host_size = pCreateInfo->maxSets * sizeof(struct radv_descriptor_set);
-		host_size += sizeof(struct radeon_winsys_bo*) * bo_count;
-		host_size += sizeof(struct radv_descriptor_range) * range_count;
 		size += host_size;
 	} else {
+		/* Freeable pools get the same worst-case storage for their set
+		 * structs; sets that don't fit because of free-list
+		 * fragmentation fall back to the heap. */
 		size += sizeof(struct radv_descriptor_pool_entry) * pCreateInfo->maxSets;
+		size += host_size;
 	}
 
 	pool = vk_alloc2(&device->alloc, pAllocator, size, 8,
@@ -684,6 +770,12 @@ VkResult radv_CreateDescriptorPool(
 		pool->host_memory_base = (uint8_t*)pool + sizeof(struct radv_descriptor_pool);
 		pool->host_memory_ptr = pool->host_memory_base;
 		pool->host_memory_end = (uint8_t*)pool + size;
+	} else {
+		pool->chunk_memory_base = (uint8_t*)pool + sizeof(struct radv_descriptor_pool) +
+			sizeof(struct radv_descriptor_pool_entry) * pCreateInfo->maxSets;
+		pool->chunk_memory_ptr = pool->chunk_memory_base;
+		pool->chunk_memory_end = (uint8_t*)pool + size;
+		pool->free_chunk_offset = RADV_DESCRIPTOR_POOL_CHUNK_END;
 	}
 
 	if (bo_size) {
@@ -741,6 +833,8 @@ VkResult radv_ResetDescriptorPool(
 
 	pool->current_offset = 0;
 	pool->host_memory_ptr = pool->host_memory_base;
+	pool->chunk_memory_ptr = pool->chunk_memory_base;
+	pool->free_chunk_offset = RADV_DESCRIPTOR_POOL_CHUNK_END;
 
 	return VK_SUCCESS;
 }
@@ -1205,66 +1299,89 @@ void radv_update_descriptor_set_with_template(struct radv_device *device,
 	uint32_t i;
 
 	for (i = 0; i < templ->entry_count; ++i) {
-		struct radeon_winsys_bo **buffer_list = set->descriptors + templ->entry[i].buffer_offset;
-		uint32_t *pDst = set->mapped_ptr + templ->entry[i].dst_offset;
-		const uint8_t *pSrc = ((const uint8_t *) pData) + templ->entry[i].src_offset;
+		const struct radv_descriptor_update_template_entry *entry = &templ->entry[i];
+		struct radeon_winsys_bo **buffer_list = set->descriptors + entry->buffer_offset;
+		uint32_t *pDst = set->mapped_ptr + entry->dst_offset;
+		const uint8_t *pSrc = ((const uint8_t *) pData) + entry->src_offset;
 		uint32_t j;
 
-		if (templ->entry[i].descriptor_type == VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT) {
-			memcpy((uint8_t*)pDst, pSrc, templ->entry[i].descriptor_count);
-			continue;
-		}
-
-		for (j = 0; j < templ->entry[i].descriptor_count; ++j) {
-			switch (templ->entry[i].descriptor_type) {
-			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
-			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC: {
-				const unsigned idx = templ->entry[i].dst_offset + j;
-				assert(!(set->layout->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
-				write_dynamic_buffer_descriptor(device, set->dynamic_descriptors + idx,
-								buffer_list, (struct VkDescriptorBufferInfo *) pSrc);
-				break;
+		/* The descriptor type is uniform over an entry, so dispatch once
+		 * per entry and run a tight loop over the elements instead of
+		 * re-selecting the writer for every element. */
+		switch (entry->descriptor_type) {
+		case VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK_EXT:
+			memcpy((uint8_t*)pDst, pSrc, entry->descriptor_count);
+			break;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+			assert(!(set->layout->flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR));
+			for (j = 0; j < entry->descriptor_count; ++j) {
+				write_dynamic_buffer_descriptor(device,
+								set->dynamic_descriptors + entry->dst_offset + j,
+								buffer_list + j,
+								(struct VkDescriptorBufferInfo *) (pSrc + j * entry->src_stride));
 			}
-			case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
-			case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			break;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+			for (j = 0; j < entry->descriptor_count; ++j) {
 				write_buffer_descriptor(device, cmd_buffer, pDst, buffer_list,
 				                        (struct VkDescriptorBufferInfo *) pSrc);
-				break;
-			case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
-			case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+				pSrc += entry->src_stride;
+				pDst += entry->dst_stride;
+				++buffer_list;
+			}
+			break;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+		case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+			for (j = 0; j < entry->descriptor_count; ++j) {
 				write_texel_buffer_descriptor(device, cmd_buffer, pDst, buffer_list,
 						              *(VkBufferView *) pSrc);
-				break;
-			case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
-			case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
-			case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+				pSrc += entry->src_stride;
+				pDst += entry->dst_stride;
+				++buffer_list;
+			}
+			break;
+		case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+		case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+		case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+			for (j = 0; j < entry->descriptor_count; ++j) {
 				write_image_descriptor(device, cmd_buffer, 64, pDst, buffer_list,
-						       templ->entry[i].descriptor_type,
+						       entry->descriptor_type,
 					               (struct VkDescriptorImageInfo *) pSrc);
-				break;
-			case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
-				write_combined_image_sampler_descriptor(device, cmd_buffer, templ->entry[i].sampler_offset,
-									pDst, buffer_list, templ->entry[i].descriptor_type,
+				pSrc += entry->src_stride;
+				pDst += entry->dst_stride;
+				++buffer_list;
+			}
+			break;
+		case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+			for (j = 0; j < entry->descriptor_count; ++j) {
+				write_combined_image_sampler_descriptor(device, cmd_buffer, entry->sampler_offset,
+									pDst, buffer_list, entry->descriptor_type,
 									(struct VkDescriptorImageInfo *) pSrc,
-									templ->entry[i].has_sampler);
-				if (templ->entry[i].immutable_samplers) {
-					memcpy((char*)pDst + templ->entry[i].sampler_offset, templ->entry[i].immutable_samplers + 4 * j, 16);
+									entry->has_sampler);
+				if (entry->immutable_samplers) {
+					memcpy((char*)pDst + entry->sampler_offset, entry->immutable_samplers + 4 * j, 16);
 				}
-				break;
-			case VK_DESCRIPTOR_TYPE_SAMPLER:
-				if (templ->entry[i].has_sampler)
+				pSrc += entry->src_stride;
+				pDst += entry->dst_stride;
+				++buffer_list;
+			}
+			break;
+		case VK_DESCRIPTOR_TYPE_SAMPLER:
+			for (j = 0; j < entry->descriptor_count; ++j) {
+				if (entry->has_sampler)
 					write_sampler_descriptor(device, pDst,
 					                         (struct VkDescriptorImageInfo *) pSrc);
-				else if (templ->entry[i].immutable_samplers)
-					memcpy(pDst, templ->entry[i].immutable_samplers + 4 * j, 16);
-				break;
-			default:
-				unreachable("unimplemented descriptor type");
-				break;
+				else if (entry->immutable_samplers)
+					memcpy(pDst, entry->immutable_samplers + 4 * j, 16);
+				pSrc += entry->src_stride;
+				pDst += entry->dst_stride;
 			}
-		        pSrc += templ->entry[i].src_stride;
-			pDst += templ->entry[i].dst_stride;
-			++buffer_list;
+			break;
+		default:
+			unreachable("unimplemented descriptor type");
+			break;
 		}
 	}
 }
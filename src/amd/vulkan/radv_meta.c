@@ -30,6 +30,8 @@
 #include <pwd.h>
 #include <sys/stat.h>
 
+#include "util/disk_cache.h"
+
 void
 radv_meta_save(struct radv_meta_saved_state *state,
 	       struct radv_cmd_buffer *cmd_buffer, uint32_t flags)
@@ -241,18 +243,25 @@ meta_free(void* _device, void *data)
 }
 
 static bool
-radv_builtin_cache_path(char *path)
+radv_builtin_cache_path(struct radv_device *device, char *path)
 {
 	char *xdg_cache_home = getenv("XDG_CACHE_HOME");
 	const char *suffix = "/radv_builtin_shaders";
 	const char *suffix2 = "/.cache/radv_builtin_shaders";
 	struct passwd pwd, *result;
 	char path2[PATH_MAX + 1]; /* PATH_MAX is not a real max,but suffices here. */
+	char uuid[VK_UUID_SIZE * 2 + 1];
 	int ret;
 
+	/* Key the file name on the cache UUID (driver build-id + chip), so
+	 * devices of different families or driver builds on the same machine
+	 * each keep their own cache instead of overwriting a shared one. */
+	disk_cache_format_hex_id(uuid, device->physical_device->cache_uuid,
+				 VK_UUID_SIZE * 2);
+
 	if (xdg_cache_home) {
-		ret = snprintf(path, PATH_MAX + 1, "%s%s%zd",
-			       xdg_cache_home, suffix, sizeof(void *) * 8);
+		ret = snprintf(path, PATH_MAX + 1, "%s%s%zd_%s",
+			       xdg_cache_home, suffix, sizeof(void *) * 8, uuid);
 		return ret > 0 && ret < PATH_MAX + 1;
 	}
 
@@ -264,8 +273,8 @@ radv_builtin_cache_path(char *path)
 	strcat(path, "/.cache");
 	mkdir(path, 0755);
 
-	ret = snprintf(path, PATH_MAX + 1, "%s%s%zd",
-		       pwd.pw_dir, suffix2, sizeof(void *) * 8);
+	ret = snprintf(path, PATH_MAX + 1, "%s%s%zd_%s",
+		       pwd.pw_dir, suffix2, sizeof(void *) * 8, uuid);
 	return ret > 0 && ret < PATH_MAX + 1;
 }
 
@@ -277,7 +286,7 @@ radv_load_meta_pipeline(struct radv_device *device)
 	void *data = NULL;
 	bool ret = false;
 
-	if (!radv_builtin_cache_path(path))
+	if (!radv_builtin_cache_path(device, path))
 		return false;
 
 	int fd = open(path, O_RDONLY);
@@ -313,7 +322,7 @@ radv_store_meta_pipeline(struct radv_device *device)
 				      &size, NULL))
 		return;
 
-	if (!radv_builtin_cache_path(path))
+	if (!radv_builtin_cache_path(device, path))
 		return;
 
 	strcpy(path2, path);
@@ -2120,6 +2120,40 @@ void radv_stop_feedback(VkPipelineCreationFeedbackEXT *feedback, bool cache_hit)
 	                   (cache_hit ? VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT : 0);
 }
 
+/* A serialized cache entry may record fewer stages than this pipeline needs
+ * (e.g. one produced by a buggy or older driver); accepting such a hit would
+ * hand back a pipeline with missing shaders. Check that every module is
+ * covered by a variant, accounting for the stage merging done at compile
+ * time: on GFX9+ the vertex shader is folded into tess ctrl or geometry, and
+ * tess eval into geometry.
+ */
+static bool
+radv_cache_hit_is_complete(const struct radv_device *device,
+                           struct radv_shader_module *const *modules,
+                           struct radv_shader_variant *const *variants)
+{
+	for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
+		gl_shader_stage stage = i;
+
+		if (!modules[i])
+			continue;
+
+		if (device->physical_device->rad_info.chip_class >= GFX9) {
+			if (i == MESA_SHADER_VERTEX &&
+			    (modules[MESA_SHADER_TESS_CTRL] || modules[MESA_SHADER_GEOMETRY]))
+				stage = modules[MESA_SHADER_TESS_CTRL] ?
+					MESA_SHADER_TESS_CTRL : MESA_SHADER_GEOMETRY;
+			else if (i == MESA_SHADER_TESS_EVAL && modules[MESA_SHADER_GEOMETRY])
+				stage = MESA_SHADER_GEOMETRY;
+		}
+
+		if (!variants[stage])
+			return false;
+	}
+
+	return true;
+}
+
 static
 void radv_create_shaders(struct radv_pipeline *pipeline,
                          struct radv_device *device,
@@ -2136,7 +2170,7 @@ void radv_create_shaders(struct radv_pipeline *pipeline,
 	void *codes[MESA_SHADER_STAGES] = {0};
 	unsigned code_sizes[MESA_SHADER_STAGES] = {0};
 	struct radv_shader_variant_key keys[MESA_SHADER_STAGES] = {{{{0}}}};
-	unsigned char hash[20], gs_copy_hash[20];
+	unsigned char hash[20], gs_copy_hash[20], preraster_hash[20];
 
 	radv_start_feedback(pipeline_feedback);
 
@@ -2164,13 +2198,38 @@ void radv_create_shaders(struct radv_pipeline *pipeline,
 		pipeline->gs_copy_shader = variants[MESA_SHADER_GEOMETRY];
 	}
 
-	if (radv_create_shader_variants_from_pipeline_cache(device, cache, hash, pipeline->shaders,
-	                                                    &found_in_application_cache) &&
-	    (!modules[MESA_SHADER_GEOMETRY] || pipeline->gs_copy_shader)) {
+	bool found_entry =
+		radv_create_shader_variants_from_pipeline_cache(device, cache, hash, pipeline->shaders,
+		                                                &found_in_application_cache);
+	bool cache_hit = found_entry &&
+		radv_cache_hit_is_complete(device, modules, pipeline->shaders);
+	if (cache_hit && (!modules[MESA_SHADER_GEOMETRY] || pipeline->gs_copy_shader)) {
 		radv_stop_feedback(pipeline_feedback, found_in_application_cache);
 		return;
 	}
 
+	/* The hash above covers all shader stages, so pipelines that only
+	 * differ in blend/format state miss it even though every stage before
+	 * the fragment shader would compile to the same code. Look up a second
+	 * entry keyed without the fragment-only state and reuse the
+	 * pre-rasterization stages from it, leaving only the fragment shader
+	 * to be compiled.
+	 */
+	/* Only prefill when the pipeline-wide lookup produced nothing at all:
+	 * the lookup replaces all of pipeline->shaders, which would leak any
+	 * variants an incomplete entry already installed.
+	 */
+	bool use_preraster_cache = !found_entry && modules[MESA_SHADER_FRAGMENT];
+	if (use_preraster_cache) {
+		radv_hash_preraster_shaders(preraster_hash, pStages, pipeline->layout, key,
+		                            get_hash_flags(device));
+		radv_create_shader_variants_from_pipeline_cache(device, cache, preraster_hash,
+		                                                pipeline->shaders,
+		                                                &found_in_application_cache);
+		/* Fragment shaders are never inserted under the pre-raster hash. */
+		assert(!pipeline->shaders[MESA_SHADER_FRAGMENT]);
+	}
+
 	if (!modules[MESA_SHADER_FRAGMENT] && !modules[MESA_SHADER_COMPUTE]) {
 		nir_builder fs_b;
 		nir_builder_init_simple_shader(&fs_b, NULL, MESA_SHADER_FRAGMENT, NULL);
@@ -2341,6 +2400,28 @@ void radv_create_shaders(struct radv_pipeline *pipeline,
 	radv_pipeline_cache_insert_shaders(device, cache, hash, pipeline->shaders,
 					   (const void**)codes, code_sizes);
 
+	if (use_preraster_cache) {
+		/* Also publish the pre-rasterization stages under the hash that
+		 * masks the fragment-only state, so that future pipelines
+		 * differing only in blend/format state can reuse them.
+		 */
+		struct radv_shader_variant *fs_variant = pipeline->shaders[MESA_SHADER_FRAGMENT];
+		void *fs_code = codes[MESA_SHADER_FRAGMENT];
+		unsigned fs_code_size = code_sizes[MESA_SHADER_FRAGMENT];
+
+		pipeline->shaders[MESA_SHADER_FRAGMENT] = NULL;
+		codes[MESA_SHADER_FRAGMENT] = NULL;
+		code_sizes[MESA_SHADER_FRAGMENT] = 0;
+
+		radv_pipeline_cache_insert_shaders(device, cache, preraster_hash,
+						   pipeline->shaders,
+						   (const void**)codes, code_sizes);
+
+		pipeline->shaders[MESA_SHADER_FRAGMENT] = fs_variant;
+		codes[MESA_SHADER_FRAGMENT] = fs_code;
+		code_sizes[MESA_SHADER_FRAGMENT] = fs_code_size;
+	}
+
 	for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
 		free(codes[i]);
 		if (nir[i]) {
@@ -24,6 +24,7 @@
 #include "util/mesa-sha1.h"
 #include "util/debug.h"
 #include "util/disk_cache.h"
+#include "util/hash_table.h"
 #include "util/u_atomic.h"
 #include "radv_debug.h"
 #include "radv_private.h"
@@ -47,12 +48,85 @@ struct cache_entry {
 	char code[0];
 };
 
+/* Many pipelines share identical per-stage binaries (the same fragment
+ * shader compiled into many pipeline keys is the common case), so variants
+ * are additionally indexed by a hash of their machine code and config.
+ * Materializing an entry first checks this table and references the
+ * existing variant instead of uploading the code again.
+ */
+struct cache_variant {
+	unsigned char sha1[20];
+	struct radv_shader_variant *variant;
+};
+
+static uint32_t
+variant_sha1_hash_func(const void *sha1)
+{
+	return *(const uint32_t *)sha1;
+}
+
+static bool
+variant_sha1_compare_func(const void *sha1_a, const void *sha1_b)
+{
+	return memcmp(sha1_a, sha1_b, 20) == 0;
+}
+
+static void
+radv_hash_variant_code(const struct cache_entry_variant_info *info,
+		       const void *code, size_t code_size,
+		       unsigned char *sha1)
+{
+	struct mesa_sha1 ctx;
+
+	_mesa_sha1_init(&ctx);
+	_mesa_sha1_update(&ctx, info, sizeof(*info));
+	_mesa_sha1_update(&ctx, code, code_size);
+	_mesa_sha1_final(&ctx, sha1);
+}
+
+/* Called with cache->lock held for writing. */
+static struct radv_shader_variant *
+radv_pipeline_cache_lookup_variant(struct radv_pipeline_cache *cache,
+				   const unsigned char *sha1)
+{
+	struct hash_entry *he;
+
+	if (!cache->variant_table)
+		return NULL;
+
+	he = _mesa_hash_table_search(cache->variant_table, sha1);
+	return he ? ((struct cache_variant *)he->data)->variant : NULL;
+}
+
+/* Called with cache->lock held for writing.  Takes its own reference on the variant. */
+static void
+radv_pipeline_cache_add_variant(struct radv_pipeline_cache *cache,
+				const unsigned char *sha1,
+				struct radv_shader_variant *variant)
+{
+	struct cache_variant *cv;
+
+	if (!cache->variant_table ||
+	    _mesa_hash_table_search(cache->variant_table, sha1))
+		return;
+
+	cv = malloc(sizeof(*cv));
+	if (!cv)
+		return;
+
+	memcpy(cv->sha1, sha1, 20);
+	cv->variant = variant;
+	p_atomic_inc(&variant->ref_count);
+
+	_mesa_hash_table_insert(cache->variant_table, cv->sha1, cv);
+}
+
 void
 radv_pipeline_cache_init(struct radv_pipeline_cache *cache,
 			 struct radv_device *device)
 {
 	cache->device = device;
-	pthread_mutex_init(&cache->mutex, NULL);
+	pthread_rwlock_init(&cache->lock, NULL);
 
 	cache->modified = false;
 	cache->kernel_count = 0;
@@ -70,6 +144,14 @@ radv_pipeline_cache_init(struct radv_pipeline_cache *cache,
 		cache->table_size = 0;
 	else
 		memset(cache->hash_table, 0, byte_size);
+
+	if (cache->table_size) {
+		cache->variant_table =
+			_mesa_hash_table_create(NULL, variant_sha1_hash_func,
+						variant_sha1_compare_func);
+	} else {
+		cache->variant_table = NULL;
+	}
 }
 
 void
@@ -84,7 +166,16 @@ radv_pipeline_cache_finish(struct radv_pipeline_cache *cache)
 			}
 			vk_free(&cache->alloc, cache->hash_table[i]);
 		}
-	pthread_mutex_destroy(&cache->mutex);
+	if (cache->variant_table) {
+		hash_table_foreach(cache->variant_table, he) {
+			struct cache_variant *cv = he->data;
+
+			radv_shader_variant_destroy(cache->device, cv->variant);
+			free(cv);
+		}
+		_mesa_hash_table_destroy(cache->variant_table, NULL);
+	}
+	pthread_rwlock_destroy(&cache->lock);
 	free(cache->hash_table);
 }
 
@@ -98,6 +189,20 @@ entry_size(struct cache_entry *entry)
 	return ret;
 }
 
+/* Entries created from pre-raster prefilled variants carry variants whose
+ * machine code was never handed to us (code_sizes[i] == 0).  They are valid
+ * for in-memory reuse, but serializing them would record those stages as
+ * absent and a later load would return an incomplete pipeline as a full hit.
+ */
+static bool
+entry_is_serializable(const struct cache_entry *entry)
+{
+	for (int i = 0; i < MESA_SHADER_STAGES; ++i)
+		if (entry->variants[i] && !entry->code_sizes[i])
+			return false;
+	return true;
+}
+
 void
 radv_hash_shaders(unsigned char *hash,
 		  const VkPipelineShaderStageCreateInfo **stages,
@@ -131,6 +236,34 @@ radv_hash_shaders(unsigned char *hash,
 	_mesa_sha1_final(&ctx, hash);
 }
 
+void
+radv_hash_preraster_shaders(unsigned char *hash,
+			    const VkPipelineShaderStageCreateInfo **stages,
+			    const struct radv_pipeline_layout *layout,
+			    const struct radv_pipeline_key *key,
+			    uint32_t flags)
+{
+	/* Hash for the stages before rasterization only: mask out the state
+	 * that radv_fill_shader_keys() feeds exclusively into the fragment
+	 * shader key, so that pipelines differing only in blend/format state
+	 * map to the same entry and can share their pre-rasterization stages.
+	 */
+	struct radv_pipeline_key masked_key = *key;
+
+	masked_key.col_format = 0;
+	masked_key.is_int8 = 0;
+	masked_key.is_int10 = 0;
+	masked_key.log2_ps_iter_samples = 0;
+	masked_key.num_samples = 0;
+
+	radv_hash_shaders(hash, stages, layout, &masked_key, flags);
+
+	/* Keep these entries separate from the pipeline-wide ones (which also
+	 * contain the fragment shader), like the GS copy shader hash does.
+	 */
+	hash[0] ^= 2;
+}
+
 
 static struct cache_entry *
 radv_pipeline_cache_search_unlocked(struct radv_pipeline_cache *cache,
@@ -163,11 +296,11 @@ radv_pipeline_cache_search(struct radv_pipeline_cache *cache,
 {
 	struct cache_entry *entry;
 
-	pthread_mutex_lock(&cache->mutex);
+	pthread_rwlock_rdlock(&cache->lock);
 
 	entry = radv_pipeline_cache_search_unlocked(cache, sha1);
 
-	pthread_mutex_unlock(&cache->mutex);
+	pthread_rwlock_unlock(&cache->lock);
 
 	return entry;
 }
@@ -265,7 +398,39 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 		*found_in_application_cache = false;
 	}
 
-	pthread_mutex_lock(&cache->mutex);
+	/* Fast path: when the entry exists and every variant has already been
+	 * materialized, a read lock suffices since all we do is bump atomic
+	 * reference counts, so concurrent pipeline creations don't serialize
+	 * on cache hits. */
+	pthread_rwlock_rdlock(&cache->lock);
+
+	entry = radv_pipeline_cache_search_unlocked(cache, sha1);
+
+	if (entry) {
+		bool materialized = true;
+
+		for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
+			if (entry->code_sizes[i] && !entry->variants[i]) {
+				materialized = false;
+				break;
+			}
+		}
+
+		if (materialized) {
+			for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
+				if (entry->variants[i])
+					p_atomic_inc(&entry->variants[i]->ref_count);
+			}
+
+			memcpy(variants, entry->variants, sizeof(entry->variants));
+			pthread_rwlock_unlock(&cache->lock);
+			return true;
+		}
+	}
+
+	pthread_rwlock_unlock(&cache->lock);
+
+	pthread_rwlock_wrlock(&cache->lock);
 
 	entry = radv_pipeline_cache_search_unlocked(cache, sha1);
 
@@ -276,7 +441,7 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 		 * present in the cache.
 		 */
 		if (radv_is_cache_disabled(device) || !device->physical_device->disk_cache) {
-			pthread_mutex_unlock(&cache->mutex);
+			pthread_rwlock_unlock(&cache->lock);
 			return false;
 		}
 
@@ -287,7 +452,7 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 			disk_cache_get(device->physical_device->disk_cache,
 				       disk_sha1, NULL);
 		if (!entry) {
-			pthread_mutex_unlock(&cache->mutex);
+			pthread_rwlock_unlock(&cache->lock);
 			return false;
 		} else {
 			size_t size = entry_size(entry);
@@ -295,7 +460,7 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 								 VK_SYSTEM_ALLOCATION_SCOPE_CACHE);
 			if (!new_entry) {
 				free(entry);
-				pthread_mutex_unlock(&cache->mutex);
+				pthread_rwlock_unlock(&cache->lock);
 				return false;
 			}
 
@@ -312,16 +477,31 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 		if (!entry->variants[i] && entry->code_sizes[i]) {
 			struct radv_shader_variant *variant;
 			struct cache_entry_variant_info info;
+			unsigned char code_sha1[20];
+
+			memcpy(&info, p, sizeof(struct cache_entry_variant_info));
+			p += sizeof(struct cache_entry_variant_info);
+
+			radv_hash_variant_code(&info, p, entry->code_sizes[i],
+					       code_sha1);
+
+			variant = radv_pipeline_cache_lookup_variant(cache,
+								     code_sha1);
+			if (variant) {
+				/* Another entry carries identical code; share
+				 * the existing upload. */
+				p_atomic_inc(&variant->ref_count);
+				p += entry->code_sizes[i];
+				entry->variants[i] = variant;
+				continue;
+			}
 
 			variant = calloc(1, sizeof(struct radv_shader_variant));
 			if (!variant) {
-				pthread_mutex_unlock(&cache->mutex);
+				pthread_rwlock_unlock(&cache->lock);
 				return false;
 			}
 
-			memcpy(&info, p, sizeof(struct cache_entry_variant_info));
-			p += sizeof(struct cache_entry_variant_info);
-
 			variant->config = info.config;
 			variant->info = info.variant_info;
 			variant->rsrc1 = info.rsrc1;
@@ -334,6 +514,9 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 			p += entry->code_sizes[i];
 
 			entry->variants[i] = variant;
+
+			radv_pipeline_cache_add_variant(cache, code_sha1,
+							variant);
 		} else if (entry->code_sizes[i]) {
 			p += sizeof(struct cache_entry_variant_info) + entry->code_sizes[i];
 		}
@@ -345,7 +528,7 @@ radv_create_shader_variants_from_pipeline_cache(struct radv_device *device,
 			p_atomic_inc(&entry->variants[i]->ref_count);
 
 	memcpy(variants, entry->variants, sizeof(entry->variants));
-	pthread_mutex_unlock(&cache->mutex);
+	pthread_rwlock_unlock(&cache->lock);
 	return true;
 }
 
@@ -360,7 +543,7 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 	if (!cache)
 		cache = device->mem_cache;
 
-	pthread_mutex_lock(&cache->mutex);
+	pthread_rwlock_wrlock(&cache->lock);
 	struct cache_entry *entry = radv_pipeline_cache_search_unlocked(cache, sha1);
 	if (entry) {
 		for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
@@ -373,7 +556,7 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 			if (variants[i])
 				p_atomic_inc(&variants[i]->ref_count);
 		}
-		pthread_mutex_unlock(&cache->mutex);
+		pthread_rwlock_unlock(&cache->lock);
 		return;
 	}
 
@@ -381,20 +564,29 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 	 * present in the cache.
 	 */
 	if (radv_is_cache_disabled(device)) {
-		pthread_mutex_unlock(&cache->mutex);
+		pthread_rwlock_unlock(&cache->lock);
 		return;
 	}
 
+	/* The pre-raster prefill path hands us variants that came out of the
+	 * cache without their machine code (codes[i] == NULL); only stages
+	 * with code can be written to the entry's blob.
+	 */
+	bool complete = true;
+	for (int i = 0; i < MESA_SHADER_STAGES; ++i)
+		if (variants[i] && !code_sizes[i])
+			complete = false;
+
 	size_t size = sizeof(*entry);
 	for (int i = 0; i < MESA_SHADER_STAGES; ++i)
-		if (variants[i])
+		if (variants[i] && code_sizes[i])
 			size += sizeof(struct cache_entry_variant_info) + code_sizes[i];
 
 
 	entry = vk_alloc(&cache->alloc, size, 8,
 			   VK_SYSTEM_ALLOCATION_SCOPE_CACHE);
 	if (!entry) {
-		pthread_mutex_unlock(&cache->mutex);
+		pthread_rwlock_unlock(&cache->lock);
 		return;
 	}
 
@@ -406,7 +598,7 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 	memset(&info, 0, sizeof(info));
 
 	for (int i = 0; i < MESA_SHADER_STAGES; ++i) {
-		if (!variants[i])
+		if (!variants[i] || !code_sizes[i])
 			continue;
 
 		entry->code_sizes[i] = code_sizes[i];
@@ -420,13 +612,27 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 
 		memcpy(p, codes[i], code_sizes[i]);
 		p += code_sizes[i];
+
+		/* Index the fresh variant by its code, so entries loaded
+		 * later with identical code share it. */
+		{
+			unsigned char code_sha1[20];
+
+			radv_hash_variant_code(&info, codes[i], code_sizes[i],
+					       code_sha1);
+			radv_pipeline_cache_add_variant(cache, code_sha1,
+							variants[i]);
+		}
 	}
 
 	/* Always add cache items to disk. This will allow collection of
 	 * compiled shaders by third parties such as steam, even if the app
 	 * implements its own pipeline cache.
+	 *
+	 * Entries missing the code for some of their variants only work
+	 * within this in-memory cache and must not hit the disk.
 	 */
-	if (device->physical_device->disk_cache) {
+	if (complete && device->physical_device->disk_cache) {
 		uint8_t disk_sha1[20];
 		disk_cache_compute_key(device->physical_device->disk_cache, sha1, 20,
 			       disk_sha1);
@@ -448,7 +654,7 @@ radv_pipeline_cache_insert_shaders(struct radv_device *device,
 	radv_pipeline_cache_add_entry(cache, entry);
 
 	cache->modified = true;
-	pthread_mutex_unlock(&cache->mutex);
+	pthread_rwlock_unlock(&cache->lock);
 	return;
 }
 
@@ -567,16 +773,16 @@ VkResult radv_GetPipelineCacheData(
 	struct cache_header *header;
 	VkResult result = VK_SUCCESS;
 
-	pthread_mutex_lock(&cache->mutex);
+	pthread_rwlock_rdlock(&cache->lock);
 
 	const size_t size = sizeof(*header) + cache->total_size;
 	if (pData == NULL) {
-		pthread_mutex_unlock(&cache->mutex);
+		pthread_rwlock_unlock(&cache->lock);
 		*pDataSize = size;
 		return VK_SUCCESS;
 	}
 	if (*pDataSize < sizeof(*header)) {
-		pthread_mutex_unlock(&cache->mutex);
+		pthread_rwlock_unlock(&cache->lock);
 		*pDataSize = 0;
 		return VK_INCOMPLETE;
 	}
@@ -594,6 +800,8 @@ VkResult radv_GetPipelineCacheData(
 		if (!cache->hash_table[i])
 			continue;
 		entry = cache->hash_table[i];
+		if (!entry_is_serializable(entry))
+			continue;
 		const uint32_t size = entry_size(entry);
 		if (end < p + size) {
 			result = VK_INCOMPLETE;
@@ -607,7 +815,7 @@ VkResult radv_GetPipelineCacheData(
 	}
 	*pDataSize = p - pData;
 
-	pthread_mutex_unlock(&cache->mutex);
+	pthread_rwlock_unlock(&cache->lock);
 	return result;
 }
 
@@ -370,12 +370,16 @@ struct cache_entry;
 
 struct radv_pipeline_cache {
 	struct radv_device *                          device;
-	pthread_mutex_t                              mutex;
+	pthread_rwlock_t                             lock;
 
 	uint32_t                                     total_size;
 	uint32_t                                     table_size;
 	uint32_t                                     kernel_count;
 	struct cache_entry **                        hash_table;
+	/* Content-addressed table mapping a hash of the compiled machine code
+	 * to an already materialized variant, so entries with identical code
+	 * share one upload. */
+	struct hash_table *                          variant_table;
 	bool                                         modified;
 
 	VkAllocationCallbacks                        alloc;
@@ -829,6 +833,16 @@ struct radv_descriptor_pool {
 	uint8_t *host_memory_ptr;
 	uint8_t *host_memory_end;
 
+	/* Pool-local storage for the set structs of freeable pools, so that
+	 * vkAllocate/FreeDescriptorSets don't go through the heap allocator,
+	 * which is shared between all recording threads. Freed chunks are
+	 * kept on an embedded first-fit free list.
+	 */
+	uint8_t *chunk_memory_base;
+	uint8_t *chunk_memory_ptr;
+	uint8_t *chunk_memory_end;
+	uint32_t free_chunk_offset;
+
 	uint32_t entry_count;
 	uint32_t max_entry_count;
 	struct radv_descriptor_pool_entry entries[0];
@@ -1187,6 +1201,9 @@ struct radv_cmd_buffer {
 
 	struct radv_cmd_buffer_upload upload;
 
+	/* Transient CPU allocations that live until the next reset. */
+	struct vk_arena transient;
+
 	uint32_t scratch_size_needed;
 	uint32_t compute_scratch_size_needed;
 	uint32_t esgs_ring_size_needed;
@@ -1390,6 +1407,13 @@ radv_hash_shaders(unsigned char *hash,
 		  const struct radv_pipeline_key *key,
 		  uint32_t flags);
 
+void
+radv_hash_preraster_shaders(unsigned char *hash,
+			    const VkPipelineShaderStageCreateInfo **stages,
+			    const struct radv_pipeline_layout *layout,
+			    const struct radv_pipeline_key *key,
+			    uint32_t flags);
+
 static inline gl_shader_stage
 vk_to_mesa_shader_stage(VkShaderStageFlagBits vk_stage)
 {
@@ -34,12 +34,39 @@
 #include "radv_private.h"
 #include "radv_cs.h"
 #include "sid.h"
+#include "util/os_time.h"
 
 #define TIMESTAMP_NOT_READY UINT64_MAX
 
 static const int pipelinestat_block_size = 11 * 8;
 static const unsigned pipeline_statistics_indices[] = {7, 6, 3, 4, 5, 2, 1, 0, 8, 9, 10};
 
+/* Queries can take milliseconds to become available, so don't burn a full
+ * core spinning on them: after a short initial spin, back off to sleeping
+ * between polls.
+ */
+static void
+radv_query_wait_relax(unsigned *iter)
+{
+	if (++*iter > 1024)
+		os_time_sleep(10);
+}
+
+static bool
+radv_occlusion_query_available(volatile const uint64_t *src64,
+			       uint32_t db_count, uint32_t enabled_rb_mask)
+{
+	for (uint32_t i = 0; i < db_count; ++i) {
+		if (!(enabled_rb_mask & (1 << i)))
+			continue;
+
+		if (!(src64[2 * i] & (1ull << 63)) ||
+		    !(src64[2 * i + 1] & (1ull << 63)))
+			return false;
+	}
+	return true;
+}
+
 static nir_ssa_def *nir_test_flag(nir_builder *b, nir_ssa_def *flags, uint32_t flag)
 {
 	return nir_i2b(b, nir_iand(b, flags, nir_imm_int(b, flag)));
@@ -1116,6 +1143,36 @@ VkResult radv_GetQueryPoolResults(
 	char *data = pData;
 	VkResult result = VK_SUCCESS;
 
+	/* Queries finish in execution order, so when the caller wants to wait
+	 * for a whole batch, waiting for the last requested query up front
+	 * lets the per-query loops below find their results already written
+	 * instead of busy-waiting once per query.
+	 */
+	if ((flags & VK_QUERY_RESULT_WAIT_BIT) && queryCount > 1) {
+		unsigned query = firstQuery + queryCount - 1;
+		char *src = pool->ptr + query * pool->stride;
+		unsigned spin = 0;
+
+		switch (pool->type) {
+		case VK_QUERY_TYPE_TIMESTAMP:
+			while (*(volatile uint64_t *)src == TIMESTAMP_NOT_READY)
+				radv_query_wait_relax(&spin);
+			break;
+		case VK_QUERY_TYPE_OCCLUSION:
+			while (!radv_occlusion_query_available((volatile uint64_t *)src,
+							       device->physical_device->rad_info.num_render_backends,
+							       device->physical_device->rad_info.enabled_rb_mask))
+				radv_query_wait_relax(&spin);
+			break;
+		case VK_QUERY_TYPE_PIPELINE_STATISTICS:
+			while (!*(volatile uint32_t*)(pool->ptr + pool->availability_offset + 4 * query))
+				radv_query_wait_relax(&spin);
+			break;
+		default:
+			break;
+		}
+	}
+
 	for(unsigned i = 0; i < queryCount; ++i, data += stride) {
 		char *dest = data;
 		unsigned query = firstQuery + i;
@@ -1127,8 +1184,10 @@ VkResult radv_GetQueryPoolResults(
 			available = *(uint64_t *)src != TIMESTAMP_NOT_READY;
 
 			if (flags & VK_QUERY_RESULT_WAIT_BIT) {
+				unsigned spin = 0;
+
 				while (*(volatile uint64_t *)src == TIMESTAMP_NOT_READY)
-					;
+					radv_query_wait_relax(&spin);
 				available = *(uint64_t *)src != TIMESTAMP_NOT_READY;
 			}
 
@@ -1151,6 +1210,7 @@ VkResult radv_GetQueryPoolResults(
 			uint32_t db_count = device->physical_device->rad_info.num_render_backends;
 			uint32_t enabled_rb_mask = device->physical_device->rad_info.enabled_rb_mask;
 			uint64_t sample_count = 0;
+			unsigned spin = 0;
 			available = 1;
 
 			for (int i = 0; i < db_count; ++i) {
@@ -1162,7 +1222,12 @@ VkResult radv_GetQueryPoolResults(
 				do {
 					start = src64[2 * i];
 					end = src64[2 * i + 1];
-				} while ((!(start & (1ull << 63)) || !(end & (1ull << 63))) && (flags & VK_QUERY_RESULT_WAIT_BIT));
+
+					if ((start & (1ull << 63)) && (end & (1ull << 63)))
+						break;
+
+					radv_query_wait_relax(&spin);
+				} while (flags & VK_QUERY_RESULT_WAIT_BIT);
 
 				if (!(start & (1ull << 63)) || !(end & (1ull << 63)))
 					available = 0;
@@ -1186,9 +1251,12 @@ VkResult radv_GetQueryPoolResults(
 			break;
 		}
 		case VK_QUERY_TYPE_PIPELINE_STATISTICS: {
-			if (flags & VK_QUERY_RESULT_WAIT_BIT)
+			if (flags & VK_QUERY_RESULT_WAIT_BIT) {
+				unsigned spin = 0;
+
 				while(!*(volatile uint32_t*)(pool->ptr + pool->availability_offset + 4 * query))
-					;
+					radv_query_wait_relax(&spin);
+			}
 			available = *(uint32_t*)(pool->ptr + pool->availability_offset + 4 * query);
 
 			if (!available && !(flags & VK_QUERY_RESULT_PARTIAL_BIT))
@@ -40,6 +40,12 @@ enum {
 	VIRTUAL_BUFFER_HASH_TABLE_SIZE = 1024
 };
 
+/* Secondary command buffers below this size are copied into the primary
+ * instead of being executed through an indirect-buffer packet: for very
+ * small buffers copying is cheaper than having the CP switch IBs twice.
+ */
+#define RADV_INLINE_SECONDARY_MAX_DW 128
+
 struct radv_amdgpu_cs {
 	struct radeon_cmdbuf base;
 	struct radv_amdgpu_winsys *ws;
@@ -647,6 +653,22 @@ static void radv_amdgpu_cs_execute_secondary(struct radeon_cmdbuf *_parent,
 	}
 
 	if (parent->ws->use_ib_bos) {
+		/* Executing the child IB costs an indirect-buffer switch in
+		 * the CP, which is noticeable when an app executes hundreds of
+		 * tiny secondary buffers per frame. Children that fit in a
+		 * single IB and are smaller than the switch overhead is worth
+		 * get copied into the parent instead of chained.
+		 */
+		if (child->num_old_ib_buffers == 0 &&
+		    child->base.cdw <= RADV_INLINE_SECONDARY_MAX_DW) {
+			if (parent->base.cdw + child->base.cdw > parent->base.max_dw)
+				radv_amdgpu_cs_grow(&parent->base, child->base.cdw);
+
+			memcpy(parent->base.buf + parent->base.cdw, child->base.buf, 4 * child->base.cdw);
+			parent->base.cdw += child->base.cdw;
+			return;
+		}
+
 		if (parent->base.cdw + 4 > parent->base.max_dw)
 			radv_amdgpu_cs_grow(&parent->base, 4);
 
@@ -0,0 +1,15 @@
+#version 330
+
+/* Baseline: close to the smallest interesting fragment shader, so the
+ * harness tracks fixed per-compile overhead.
+ */
+
+uniform vec4 color;
+
+in vec2 uv;
+out vec4 frag_color;
+
+void main()
+{
+   frag_color = color * vec4(uv, 1.0 - uv.x, 1.0);
+}
@@ -0,0 +1,32 @@
+#version 330
+
+/* Matrix-palette skinning: uniform array indexing plus a small
+ * unrollable loop, typical of game vertex shaders.
+ */
+
+const int MAX_BONES = 64;
+
+uniform mat4 bones[MAX_BONES];
+uniform mat4 mvp;
+uniform mat3 normal_matrix;
+
+in vec3 position;
+in vec3 normal;
+in vec2 texcoord;
+in vec4 weights;
+in ivec4 bone_ids;
+
+out vec3 v_normal;
+out vec2 v_texcoord;
+
+void main()
+{
+   mat4 skin = mat4(0.0);
+   for (int i = 0; i < 4; i++)
+      skin += bones[bone_ids[i]] * weights[i];
+
+   vec4 pos = skin * vec4(position, 1.0);
+   v_normal = normal_matrix * mat3(skin) * normal;
+   v_texcoord = texcoord;
+   gl_Position = mvp * pos;
+}
@@ -0,0 +1,105 @@
+#version 330
+
+/* Uber-shader style fragment shader: a lit/fogged/textured path with
+ * per-light loop and plenty of control flow for the optimizer to chew
+ * on.  This is the heavyweight entry in the corpus.
+ */
+
+const int MAX_LIGHTS = 8;
+
+struct light {
+   vec4 position;
+   vec4 diffuse;
+   vec4 specular;
+   vec3 attenuation;
+   float spot_cutoff;
+   vec3 spot_direction;
+   float spot_exponent;
+};
+
+uniform light lights[MAX_LIGHTS];
+uniform int num_lights;
+uniform sampler2D diffuse_map;
+uniform sampler2D specular_map;
+uniform sampler2D normal_map;
+uniform samplerCube env_map;
+uniform vec4 ambient;
+uniform float shininess;
+uniform float fog_density;
+uniform vec4 fog_color;
+uniform bool use_normal_map;
+uniform bool use_env_map;
+
+in vec3 v_position;
+in vec3 v_normal;
+in vec3 v_tangent;
+in vec2 v_texcoord;
+
+out vec4 frag_color;
+
+vec3 fetch_normal()
+{
+   if (!use_normal_map)
+      return normalize(v_normal);
+
+   vec3 n = normalize(v_normal);
+   vec3 t = normalize(v_tangent - n * dot(v_tangent, n));
+   vec3 b = cross(n, t);
+   vec3 tn = texture(normal_map, v_texcoord).xyz * 2.0 - 1.0;
+   return normalize(mat3(t, b, n) * tn);
+}
+
+void main()
+{
+   vec3 n = fetch_normal();
+   vec3 view = normalize(-v_position);
+   vec4 base = texture(diffuse_map, v_texcoord);
+   vec4 spec_mask = texture(specular_map, v_texcoord);
+
+   vec4 acc = ambient * base;
+
+   for (int i = 0; i < MAX_LIGHTS; i++) {
+      if (i >= num_lights)
+         break;
+
+      vec3 l;
+      float att = 1.0;
+
+      if (lights[i].position.w == 0.0) {
+         l = normalize(lights[i].position.xyz);
+      } else {
+         vec3 d = lights[i].position.xyz - v_position;
+         float dist = length(d);
+         l = d / dist;
+         att = 1.0 / (lights[i].attenuation.x +
+                      lights[i].attenuation.y * dist +
+                      lights[i].attenuation.z * dist * dist);
+
+         if (lights[i].spot_cutoff < 180.0) {
+            float spot = dot(-l, normalize(lights[i].spot_direction));
+            if (spot < cos(radians(lights[i].spot_cutoff)))
+               att = 0.0;
+            else
+               att *= pow(spot, lights[i].spot_exponent);
+         }
+      }
+
+      float ndotl = max(dot(n, l), 0.0);
+      if (ndotl > 0.0 && att > 0.0) {
+         acc += att * ndotl * lights[i].diffuse * base;
+
+         vec3 h = normalize(l + view);
+         float ndoth = max(dot(n, h), 0.0);
+         acc += att * pow(ndoth, shininess) * lights[i].specular * spec_mask;
+      }
+   }
+
+   if (use_env_map) {
+      vec3 r = reflect(-view, n);
+      acc = mix(acc, texture(env_map, r), spec_mask.a);
+   }
+
+   float fog = exp(-fog_density * fog_density *
+                   dot(v_position, v_position));
+   frag_color = mix(fog_color, vec4(acc.rgb, base.a), clamp(fog, 0.0, 1.0));
+}
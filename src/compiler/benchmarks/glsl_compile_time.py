@@ -0,0 +1,131 @@
+# encoding=utf-8
+# Copyright © 2019 Intel Corporation
+
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""Compile-time benchmark for the standalone GLSL compiler.
+
+Runs glsl_compiler over a checked-in corpus and reports, per shader:
+
+- wall_time_ms: best-of-N wall time of a plain compile (no IR dumping),
+  so the number tracks the compiler and not stdout formatting.
+- peak_rss_kb: peak resident set size of the compiler process (a proxy
+  for peak ralloc usage; not available on platforms without os.wait4).
+- lir_lines: non-empty lines of --dump-lir output, a stable proxy for
+  the size of the generated IR.
+
+The results are printed as JSON so CI can diff runs across commits.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+VERSION_RE = re.compile(r'^\s*#\s*version\s+(\d+)', re.MULTILINE)
+
+
+def shader_version(path):
+    with open(path, 'r') as f:
+        m = VERSION_RE.search(f.read())
+    return m.group(1) if m else '110'
+
+
+def run_compiler(compiler, shader, extra_args):
+    """Run the compiler once, returning (wall_time_sec, peak_rss_kb, stdout)."""
+    cmd = [compiler, '--version', shader_version(shader)] + extra_args + [shader]
+
+    start = time.time()
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE)
+    out, err = proc.communicate()
+
+    if hasattr(os, 'wait4'):
+        # The child is already reaped by communicate(); re-run under wait4 to
+        # get rusage would double the cost, so take getrusage of children
+        # instead.  RUSAGE_CHILDREN accumulates, so sample the high-water
+        # mark, which is what we want for a peak value anyway.
+        import resource
+        rss = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    else:
+        rss = None
+
+    elapsed = time.time() - start
+
+    if proc.returncode != 0:
+        sys.stderr.write('{}: compile failed\n{}\n'.format(
+            shader, err.decode(errors='replace')))
+        sys.exit(1)
+
+    return elapsed, rss, out.decode(errors='replace')
+
+
+def bench_shader(compiler, shader, runs):
+    # Warm the page cache and get the IR size in one go.
+    _, _, lir = run_compiler(compiler, shader, ['--dump-lir'])
+    lir_lines = sum(1 for l in lir.splitlines() if l.strip())
+
+    best = None
+    peak_rss = None
+    for _ in range(runs):
+        elapsed, rss, _ = run_compiler(compiler, shader, [])
+        if best is None or elapsed < best:
+            best = elapsed
+        if rss is not None and (peak_rss is None or rss > peak_rss):
+            peak_rss = rss
+
+    return {
+        'name': os.path.basename(shader),
+        'wall_time_ms': round(best * 1000.0, 3),
+        'peak_rss_kb': peak_rss,
+        'lir_lines': lir_lines,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--compiler', required=True,
+                        help='path to the glsl_compiler standalone binary')
+    parser.add_argument('--runs', type=int, default=5,
+                        help='timed compiles per shader (best is reported)')
+    parser.add_argument('--output', help='write JSON here instead of stdout')
+    parser.add_argument('shaders', nargs='+')
+    args = parser.parse_args()
+
+    results = {
+        'runs': args.runs,
+        'shaders': [bench_shader(args.compiler, s, args.runs)
+                    for s in sorted(args.shaders)],
+    }
+
+    text = json.dumps(results, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -222,6 +222,21 @@ blob_write_intptr(struct blob *blob, intptr_t value)
    return blob_write_bytes(blob, &value, sizeof(value));
 }
 
+bool
+blob_write_varint(struct blob *blob, uint64_t value)
+{
+   uint8_t buf[(sizeof(value) * 8 + 6) / 7];
+   unsigned len = 0;
+
+   do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      buf[len++] = byte | (value ? 0x80 : 0);
+   } while (value);
+
+   return blob_write_bytes(blob, buf, len);
+}
+
 bool
 blob_overwrite_intptr (struct blob *blob,
                        size_t offset,
@@ -356,6 +371,27 @@ blob_read_intptr(struct blob_reader *blob)
    return ret;
 }
 
+uint64_t
+blob_read_varint(struct blob_reader *blob)
+{
+   uint64_t value = 0;
+   unsigned shift = 0;
+   uint8_t byte;
+
+   do {
+      if (!ensure_can_read(blob, 1))
+         return 0;
+
+      byte = *blob->current;
+      blob->current++;
+
+      value |= (uint64_t)(byte & 0x7f) << shift;
+      shift += 7;
+   } while ((byte & 0x80) && shift < 64);
+
+   return value;
+}
+
 char *
 blob_read_string(struct blob_reader *blob)
 {
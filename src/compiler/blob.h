@@ -235,6 +235,20 @@ blob_write_uint64(struct blob *blob, uint64_t value);
 bool
 blob_write_intptr(struct blob *blob, intptr_t value);
 
+/**
+ * Add a varint-encoded value to a blob.
+ *
+ * The value is stored LEB128-style: seven bits per byte, least significant
+ * group first, with the high bit of each byte indicating that more bytes
+ * follow.  Small values take a single byte and no alignment padding is
+ * inserted, which makes this the encoding of choice for indices that are
+ * frequent but usually small.
+ *
+ * \return True unless allocation failed.
+ */
+bool
+blob_write_varint(struct blob *blob, uint64_t value);
+
 /**
  * Overwrite an intptr_t previously written to the blob.
  *
@@ -336,6 +350,15 @@ blob_read_uint64(struct blob_reader *blob);
 intptr_t
 blob_read_intptr(struct blob_reader *blob);
 
+/**
+ * Read a varint-encoded value from the current location, (and update the
+ * current location to just past it).
+ *
+ * \return The value read
+ */
+uint64_t
+blob_read_varint(struct blob_reader *blob);
+
 /**
  * Read a NULL-terminated string from the current location, (and update the
  * current location to just past this string).
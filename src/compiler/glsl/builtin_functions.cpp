@@ -83,6 +83,7 @@
 #include <math.h>
 #include "builtin_functions.h"
 #include "util/hash_table.h"
+#include "util/u_atomic.h"
 
 #define M_PIf   ((float) M_PI)
 #define M_PI_2f ((float) M_PI_2)
@@ -7213,6 +7214,15 @@ builtin_builder::_vote(const char *intrinsic_name,
 static builtin_builder builtins;
 static mtx_t builtins_lock = _MTX_INITIALIZER_NP;
 
+/* The built-in table is immutable once initialize() has run, so lookups
+ * don't need builtins_lock; they only have to guard against a concurrent
+ * glReleaseShaderCompiler() tearing the table down.  Readers announce
+ * themselves with an atomic counter and fall back to the mutex while a
+ * release is draining them.
+ */
+static int builtins_uses = 0;
+static int builtins_releasing = 0;
+
 /**
  * External API (exposing the built-in module to the rest of the compiler):
  *  @{
@@ -7229,7 +7239,20 @@ void
 _mesa_glsl_release_builtin_functions()
 {
    mtx_lock(&builtins_lock);
+   /* Push new lock-free readers onto the mutex path, then wait for the
+    * ones already inside to drain before freeing anything.
+    *
+    * The flag must be set with a full-barrier RMW, not a plain store: a
+    * release store may still sit in the store buffer while the uses read
+    * below executes, letting us see an old zero while a reader that
+    * incremented uses still saw releasing == 0.  The reader side relies
+    * on p_atomic_inc being a full-barrier RMW the same way.
+    */
+   (void) p_atomic_xchg(&builtins_releasing, 1);
+   while (p_atomic_read(&builtins_uses) != 0)
+      thrd_yield();
    builtins.release();
+   p_atomic_set(&builtins_releasing, 0);
    mtx_unlock(&builtins_lock);
 }
 
@@ -7237,29 +7260,53 @@ ir_function_signature *
 _mesa_glsl_find_builtin_function(_mesa_glsl_parse_state *state,
                                  const char *name, exec_list *actual_parameters)
 {
-   ir_function_signature *s;
+   ir_function_signature *s = NULL;
+
+   p_atomic_inc(&builtins_uses);
+   if (!p_atomic_read(&builtins_releasing) && builtins.shader) {
+      s = builtins.find(state, name, actual_parameters);
+      p_atomic_dec(&builtins_uses);
+      return s;
+   }
+   p_atomic_dec(&builtins_uses);
+
    mtx_lock(&builtins_lock);
-   s = builtins.find(state, name, actual_parameters);
+   if (builtins.shader)
+      s = builtins.find(state, name, actual_parameters);
    mtx_unlock(&builtins_lock);
 
    return s;
 }
 
-bool
-_mesa_glsl_has_builtin_function(_mesa_glsl_parse_state *state, const char *name)
+static bool
+has_builtin_function(_mesa_glsl_parse_state *state, const char *name)
 {
-   ir_function *f;
-   bool ret = false;
-   mtx_lock(&builtins_lock);
-   f = builtins.shader->symbols->get_function(name);
+   ir_function *f = builtins.shader->symbols->get_function(name);
    if (f != NULL) {
       foreach_in_list(ir_function_signature, sig, &f->signatures) {
-         if (sig->is_builtin_available(state)) {
-            ret = true;
-            break;
-         }
+         if (sig->is_builtin_available(state))
+            return true;
       }
    }
+   return false;
+}
+
+bool
+_mesa_glsl_has_builtin_function(_mesa_glsl_parse_state *state, const char *name)
+{
+   bool ret = false;
+
+   p_atomic_inc(&builtins_uses);
+   if (!p_atomic_read(&builtins_releasing) && builtins.shader) {
+      ret = has_builtin_function(state, name);
+      p_atomic_dec(&builtins_uses);
+      return ret;
+   }
+   p_atomic_dec(&builtins_uses);
+
+   mtx_lock(&builtins_lock);
+   if (builtins.shader)
+      ret = has_builtin_function(state, name);
    mtx_unlock(&builtins_lock);
 
    return ret;
@@ -2041,9 +2041,15 @@ opt_shader_and_create_symbol_table(struct gl_context *ctx,
       &ctx->Const.ShaderCompilerOptions[shader->Stage];
 
    /* Do some optimization at compile time to reduce shader IR size
-    * and reduce later work if the same shader is linked multiple times
+    * and reduce later work if the same shader is linked multiple times.
+    *
+    * For drivers that consume NIR the GLSL IR fixpoint buys very little:
+    * glsl_to_nir runs the full NIR optimization loop afterwards anyway, so
+    * iterating here only helps repeated links of the same shader.  A single
+    * round is enough to shrink the IR for the linker, which matters for
+    * apps that compile thousands of small shaders at startup.
     */
-   if (ctx->Const.GLSLOptimizeConservatively) {
+   if (ctx->Const.GLSLOptimizeConservatively || options->NirOptions) {
       /* Run it just once. */
       do_common_optimization(shader->ir, false, false, options,
                              ctx->Const.NativeIntegers);
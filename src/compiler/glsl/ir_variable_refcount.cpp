@@ -134,18 +134,17 @@ ir_variable_refcount_visitor::visit_leave(ir_assignment *ir)
       entry->assigned_count++;
 
       /* Build a list for dead code optimisation. Don't add assignment if it
-       * was declared out of scope (outside the instruction stream). Also don't
-       * bother adding any more to the list if there are more references than
-       * assignments as this means the variable is used and won't be optimised
-       * out.
+       * was declared out of scope (outside the instruction stream).  The
+       * list must be complete even for variables that currently look used:
+       * the dead code pass decrements reference counts while it removes
+       * assignments, so a variable can become dead after this list was
+       * built.
        */
       assert(entry->referenced_count >= entry->assigned_count);
-      if (entry->referenced_count == entry->assigned_count) {
-         struct assignment_entry *assignment_entry =
-            (struct assignment_entry *)calloc(1, sizeof(*assignment_entry));
-         assignment_entry->assign = ir;
-         entry->assign_list.push_head(&assignment_entry->link);
-      }
+      struct assignment_entry *assignment_entry =
+         (struct assignment_entry *)calloc(1, sizeof(*assignment_entry));
+      assignment_entry->assign = ir;
+      entry->assign_list.push_head(&assignment_entry->link);
    }
 
    return visit_continue;
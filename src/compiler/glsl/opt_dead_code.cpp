@@ -35,22 +35,52 @@
 
 static bool debug = false;
 
+namespace {
+
 /**
- * Do a dead code pass over instructions and everything that instructions
- * references.
- *
- * Note that this will remove assignments to globals, so it is not suitable
- * for usage on an unlinked instruction stream.
+ * Walks a removed assignment and decrements the refcounts of every variable
+ * it referenced, so that variables that become dead as a result can be
+ * collected in the same pass run.
  */
-bool
-do_dead_code(exec_list *instructions, bool uniform_locations_assigned)
+class ir_dead_code_refcount_update_visitor : public ir_hierarchical_visitor {
+public:
+   ir_dead_code_refcount_update_visitor(ir_variable_refcount_visitor *refs)
+      : refs(refs)
+   {
+   }
+
+   virtual ir_visitor_status visit(ir_dereference_variable *ir)
+   {
+      struct hash_entry *e =
+         _mesa_hash_table_search(refs->ht, ir->variable_referenced());
+
+      if (e) {
+         ir_variable_refcount_entry *entry =
+            (ir_variable_refcount_entry *) e->data;
+         assert(entry->referenced_count > 0);
+         entry->referenced_count--;
+      }
+
+      return visit_continue;
+   }
+
+private:
+   ir_variable_refcount_visitor *refs;
+};
+
+} /* unnamed namespace */
+
+/**
+ * Sweep the refcount table once, removing whatever is dead.
+ */
+static bool
+dead_code_sweep(ir_variable_refcount_visitor *v,
+                ir_dead_code_refcount_update_visitor *update,
+                bool uniform_locations_assigned)
 {
-   ir_variable_refcount_visitor v;
    bool progress = false;
 
-   v.run(instructions);
-
-   hash_table_foreach(v.ht, e) {
+   hash_table_foreach(v->ht, e) {
       ir_variable_refcount_entry *entry = (ir_variable_refcount_entry *)e->data;
 
       /* Since each assignment is a reference, the refereneced count must be
@@ -104,6 +134,13 @@ do_dead_code(exec_list *instructions, bool uniform_locations_assigned)
 
 	       assignment_entry->assign->remove();
 
+	       /* Update the refcounts so that anything the assignment's
+		* right-hand side kept alive can be collected by a later
+		* sweep of this same run.
+		*/
+	       assignment_entry->assign->accept(update);
+	       entry->assigned_count--;
+
 	       if (debug) {
 	          printf("Removed assignment to %s@%p\n",
 		         entry->var->name, (void *) entry->var);
@@ -153,6 +190,10 @@ do_dead_code(exec_list *instructions, bool uniform_locations_assigned)
          }
 
 	 entry->var->remove();
+	 /* Clear the flag so later sweeps don't try to remove the
+	  * declaration again.
+	  */
+	 entry->declaration = false;
 	 progress = true;
 
 	 if (debug) {
@@ -165,6 +206,33 @@ do_dead_code(exec_list *instructions, bool uniform_locations_assigned)
    return progress;
 }
 
+/**
+ * Do a dead code pass over instructions and everything that instructions
+ * references.
+ *
+ * Note that this will remove assignments to globals, so it is not suitable
+ * for usage on an unlinked instruction stream.
+ */
+bool
+do_dead_code(exec_list *instructions, bool uniform_locations_assigned)
+{
+   ir_variable_refcount_visitor v;
+   ir_dead_code_refcount_update_visitor update(&v);
+   bool progress = false;
+
+   v.run(instructions);
+
+   /* Removing a dead assignment drops the references its right-hand side
+    * held, which can make more variables dead.  Keep sweeping the refcount
+    * table until nothing changes rather than leaving the rest to another
+    * whole-tree iteration of the surrounding optimization loop.
+    */
+   while (dead_code_sweep(&v, &update, uniform_locations_assigned))
+      progress = true;
+
+   return progress;
+}
+
 /**
  * Does a dead code pass on the functions present in the instruction stream.
  *
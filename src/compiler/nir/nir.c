@@ -28,9 +28,12 @@
 #include "nir.h"
 #include "nir_control_flow_private.h"
 #include "util/half_float.h"
+#include <inttypes.h>
 #include <limits.h>
 #include <assert.h>
 #include <math.h>
+#include "util/debug.h"
+#include "util/os_time.h"
 #include "util/u_math.h"
 
 #include "main/menums.h" /* BITFIELD64_MASK */
@@ -913,6 +916,59 @@ void nir_instr_remove_v(nir_instr *instr)
    }
 }
 
+static bool
+remove_batch_use_cb(nir_src *src, void *state)
+{
+   if (!src_is_valid(src))
+      return true;
+
+   /* A source reading a value that dies in the same batch doesn't need to
+    * be unlinked: the def's whole use list goes away with its instruction.
+    */
+   if (src->is_ssa && src->ssa->parent_instr->pass_flags == 0)
+      return true;
+
+   list_del(&src->use_link);
+
+   return true;
+}
+
+/**
+ * Bulk-removes every instruction in \p impl whose pass_flags is zero.
+ *
+ * The marking must be closed: no surviving instruction (or if-condition) may
+ * read an SSA value defined by an instruction being removed.  Under that
+ * invariant a dead SSA def's entire use list dies with the batch, so only
+ * sources reading surviving values (live SSA defs or registers) need their
+ * use links removed - for the chain-shaped dead code DCE typically finds,
+ * that skips most of the per-instruction list surgery nir_instr_remove()
+ * would do.
+ *
+ * Jump instructions may not be removed this way since their removal has
+ * control-flow side effects; use nir_instr_remove() for those.
+ */
+bool
+nir_instr_remove_batch(nir_function_impl *impl)
+{
+   bool progress = false;
+
+   nir_foreach_block(block, impl) {
+      nir_foreach_instr_safe(instr, block) {
+         if (instr->pass_flags)
+            continue;
+
+         assert(instr->type != nir_instr_type_jump);
+
+         nir_foreach_src(instr, remove_batch_use_cb, NULL);
+         nir_foreach_dest(instr, remove_def_cb, NULL);
+         exec_node_remove(&instr->node);
+         progress = true;
+      }
+   }
+
+   return progress;
+}
+
 /*@}*/
 
 void
@@ -1784,6 +1840,58 @@ nir_index_ssa_defs(nir_function_impl *impl)
    impl->ssa_alloc = index;
 }
 
+static bool
+count_ssa_def_uses_cb(nir_ssa_def *def, void *state)
+{
+   nir_ssa_use_table *table = state;
+
+   table->offsets[def->index + 1] = list_length(&def->uses);
+   return true;
+}
+
+static bool
+fill_ssa_def_uses_cb(nir_ssa_def *def, void *state)
+{
+   nir_ssa_use_table *table = state;
+   nir_src **dst = table->srcs + table->offsets[def->index];
+
+   nir_foreach_use(use, def)
+      *dst++ = use;
+   return true;
+}
+
+nir_ssa_use_table *
+nir_build_ssa_use_table(nir_function_impl *impl, void *mem_ctx)
+{
+   nir_ssa_use_table *table = ralloc(mem_ctx, nir_ssa_use_table);
+   unsigned i;
+
+   nir_index_ssa_defs(impl);
+
+   table->num_defs = impl->ssa_alloc;
+   table->offsets = ralloc_array(table, unsigned, table->num_defs + 1);
+   table->offsets[0] = 0;
+
+   nir_foreach_block(block, impl) {
+      nir_foreach_instr(instr, block)
+         nir_foreach_ssa_def(instr, count_ssa_def_uses_cb, table);
+   }
+
+   /* turn the per-def use counts into offsets */
+   for (i = 0; i < table->num_defs; i++)
+      table->offsets[i + 1] += table->offsets[i];
+
+   table->srcs = ralloc_array(table, nir_src *,
+                              table->offsets[table->num_defs]);
+
+   nir_foreach_block(block, impl) {
+      nir_foreach_instr(instr, block)
+         nir_foreach_ssa_def(instr, fill_ssa_def_uses_cb, table);
+   }
+
+   return table;
+}
+
 /**
  * The indices are applied top-to-bottom which has the very nice property
  * that, if A dominates B, then A->index <= B->index.
@@ -2051,3 +2159,52 @@ nir_rewrite_image_intrinsic(nir_intrinsic_instr *intrin, nir_ssa_def *src,
    nir_instr_rewrite_src(&intrin->instr, &intrin->src[0],
                          nir_src_for_ssa(src));
 }
+
+static unsigned
+nir_shader_instr_count(nir_shader *shader)
+{
+   unsigned count = 0;
+
+   nir_foreach_function(function, shader) {
+      if (!function->impl)
+         continue;
+      nir_foreach_block(block, function->impl) {
+         nir_foreach_instr(instr, block)
+            count++;
+      }
+   }
+
+   return count;
+}
+
+static bool
+nir_time_passes(void)
+{
+   static int enabled = -1;
+   if (enabled < 0)
+      enabled = env_var_as_boolean("NIR_TIME", false);
+
+   return enabled;
+}
+
+bool
+_nir_pass_time_begin(nir_shader *shader, int64_t *time, unsigned *num_instrs)
+{
+   if (!nir_time_passes())
+      return false;
+
+   *num_instrs = nir_shader_instr_count(shader);
+   *time = os_time_get_nano();
+   return true;
+}
+
+void
+_nir_pass_time_end(const char *pass_name, nir_shader *shader,
+                   int64_t time, unsigned num_instrs)
+{
+   int64_t us = (os_time_get_nano() - time) / 1000;
+
+   fprintf(stderr, "NIR_TIME: %s: %s: %"PRIi64" us, %u -> %u instructions\n",
+           gl_shader_stage_name(shader->info.stage), pass_name, us,
+           num_instrs, nir_shader_instr_count(shader));
+}
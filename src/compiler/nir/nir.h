@@ -2812,6 +2812,8 @@ nir_instr_insert_after_cf_list(struct exec_list *list, nir_instr *after)
 
 void nir_instr_remove_v(nir_instr *instr);
 
+bool nir_instr_remove_batch(nir_function_impl *impl);
+
 static inline nir_cursor
 nir_instr_remove(nir_instr *instr)
 {
@@ -2941,6 +2943,38 @@ void nir_index_local_regs(nir_function_impl *impl);
 void nir_index_ssa_defs(nir_function_impl *impl);
 unsigned nir_index_instrs(nir_function_impl *impl);
 
+/**
+ * Packed table of the instruction uses of every SSA def in an impl.
+ *
+ * This is a read-only snapshot for analysis passes that iterate uses
+ * heavily: the uses of a def sit in one contiguous slice instead of a
+ * linked list threaded through the using instructions.  Any change to
+ * the shader (rewriting sources, adding or removing instructions)
+ * invalidates the table, so rebuild it like the indices it is based on.
+ * If-condition uses are not included; check nir_ssa_def::if_uses.
+ */
+typedef struct {
+   unsigned num_defs;
+   /** num_defs + 1 entries; the uses of a def are the slice
+    * [offsets[index], offsets[index + 1]) of srcs.
+    */
+   unsigned *offsets;
+   nir_src **srcs;
+} nir_ssa_use_table;
+
+nir_ssa_use_table *nir_build_ssa_use_table(nir_function_impl *impl,
+                                           void *mem_ctx);
+
+/** Return the packed uses of \p def and their number in \p num_uses. */
+static inline nir_src **
+nir_ssa_use_table_uses(const nir_ssa_use_table *table,
+                       const nir_ssa_def *def, unsigned *num_uses)
+{
+   assert(def->index < table->num_defs);
+   *num_uses = table->offsets[def->index + 1] - table->offsets[def->index];
+   return table->srcs + table->offsets[def->index];
+}
+
 void nir_index_blocks(nir_function_impl *impl);
 
 void nir_print_shader(nir_shader *shader, FILE *fp);
@@ -2963,6 +2997,8 @@ void nir_shader_serialize_deserialize(nir_shader *s);
 
 #ifndef NDEBUG
 void nir_validate_shader(nir_shader *shader, const char *when);
+void nir_validate_shaders(nir_shader * const *shaders, unsigned num_shaders,
+                          const char *when);
 void nir_metadata_set_validation_flag(nir_shader *shader);
 void nir_metadata_check_validation_flag(nir_shader *shader);
 
@@ -3014,6 +3050,7 @@ should_print_nir(void)
 }
 #else
 static inline void nir_validate_shader(nir_shader *shader, const char *when) { (void) shader; (void)when; }
+static inline void nir_validate_shaders(nir_shader * const *shaders, unsigned num_shaders, const char *when) { (void) shaders; (void) num_shaders; (void)when; }
 static inline void nir_metadata_set_validation_flag(nir_shader *shader) { (void) shader; }
 static inline void nir_metadata_check_validation_flag(nir_shader *shader) { (void) shader; }
 static inline bool should_skip_nir(UNUSED const char *pass_name) { return false; }
@@ -3022,12 +3059,27 @@ static inline bool should_serialize_deserialize_nir(void) { return false; }
 static inline bool should_print_nir(void) { return false; }
 #endif /* NDEBUG */
 
+/* Per-pass telemetry, enabled with NIR_TIME=1: prints each pass's wall time
+ * and instruction-count delta to stderr.  Unlike the NDEBUG-only helpers
+ * above this works in release builds, where the numbers are meaningful.
+ */
+bool _nir_pass_time_begin(nir_shader *shader, int64_t *time,
+                          unsigned *num_instrs);
+void _nir_pass_time_end(const char *pass_name, nir_shader *shader,
+                        int64_t time, unsigned num_instrs);
+
 #define _PASS(pass, nir, do_pass) do {                               \
    if (should_skip_nir(#pass)) {                                     \
       printf("skipping %s\n", #pass);                                \
       break;                                                         \
    }                                                                 \
+   int64_t _pass_time = 0;                                           \
+   unsigned _pass_instrs = 0;                                        \
+   bool _pass_timed = _nir_pass_time_begin(nir, &_pass_time,         \
+                                           &_pass_instrs);           \
    do_pass                                                           \
+   if (_pass_timed)                                                  \
+      _nir_pass_time_end(#pass, nir, _pass_time, _pass_instrs);      \
    nir_validate_shader(nir, "after " #pass);                         \
    if (should_clone_nir()) {                                         \
       nir_shader *clone = nir_shader_clone(ralloc_parent(nir), nir); \
@@ -3064,6 +3116,9 @@ void nir_calc_dominance_impl(nir_function_impl *impl);
 void nir_calc_dominance(nir_shader *shader);
 
 nir_block *nir_dominance_lca(nir_block *b1, nir_block *b2);
+void nir_dominance_update_after_cf_insert(nir_function_impl *impl,
+                                          nir_block *pred,
+                                          nir_block *new_block);
 bool nir_block_dominates(nir_block *parent, nir_block *child);
 
 void nir_dump_dom_tree_impl(nir_function_impl *impl, FILE *fp);
@@ -3091,6 +3146,13 @@ void nir_inline_function_impl(struct nir_builder *b,
                               nir_ssa_def **params);
 bool nir_inline_functions(nir_shader *shader);
 
+/** Instruments loops and texture ops with SSBO atomic counters.
+ *
+ * Returns the number of counter slots used; see nir_inject_profiling.c for
+ * the slot assignment and buffer layout.
+ */
+unsigned nir_inject_profiling(nir_shader *shader, unsigned ssbo_binding);
+
 bool nir_propagate_invariant(nir_shader *shader);
 
 void nir_lower_var_copy_instr(nir_intrinsic_instr *copy, nir_shader *shader);
@@ -3112,7 +3174,8 @@ typedef enum {
 bool nir_lower_array_deref_of_vec(nir_shader *shader, nir_variable_mode modes,
                                   nir_lower_array_deref_of_vec_options options);
 
-bool nir_lower_indirect_derefs(nir_shader *shader, nir_variable_mode modes);
+bool nir_lower_indirect_derefs(nir_shader *shader, nir_variable_mode modes,
+                               uint64_t max_lower_array_len);
 
 bool nir_lower_locals_to_regs(nir_shader *shader);
 
@@ -3647,6 +3710,8 @@ bool nir_opt_loop_unroll(nir_shader *shader, nir_variable_mode indirect_mask);
 
 bool nir_opt_move_comparisons(nir_shader *shader);
 
+bool nir_opt_move_discards_to_top(nir_shader *shader);
+
 bool nir_opt_move_load_ubo(nir_shader *shader);
 
 bool nir_opt_peephole_select(nir_shader *shader, unsigned limit,
@@ -3656,6 +3721,22 @@ bool nir_opt_rematerialize_compares(nir_shader *shader);
 
 bool nir_opt_remove_phis(nir_shader *shader);
 
+typedef struct nir_opt_schedule_options {
+   /** Return true if the backend considers \p instr long-latency and
+    * worth hoisting; NULL means texture fetches and reorderable loads.
+    */
+   bool (*is_long_latency)(nir_instr *instr, const void *data);
+   const void *cb_data;
+
+   /** Bound on how many instructions a hoisted instruction may move up,
+    * to limit the register pressure cost; 0 means unlimited.
+    */
+   unsigned max_distance;
+} nir_opt_schedule_options;
+
+bool nir_opt_schedule(nir_shader *shader,
+                      const nir_opt_schedule_options *options);
+
 bool nir_opt_shrink_load(nir_shader *shader);
 
 bool nir_opt_sink(nir_shader *shader, bool sink_intrinsics);
@@ -3676,6 +3757,14 @@ void nir_strip(nir_shader *shader);
 
 void nir_sweep(nir_shader *shader);
 
+void nir_compact(nir_shader *shader);
+
+/** callback invoked on a worker thread; must only touch \p shader */
+typedef void (*nir_parallel_opt_cb)(nir_shader *shader, void *data);
+
+void nir_optimize_parallel(nir_shader * const *shaders, unsigned num_shaders,
+                           nir_parallel_opt_cb callback, void *data);
+
 void nir_remap_dual_slot_attributes(nir_shader *shader,
                                     uint64_t *dual_slot_inputs);
 uint64_t nir_get_single_slot_attribs_mask(uint64_t attribs, uint64_t dual_slot);
@@ -1049,6 +1049,15 @@ struct per_op_table {
    const uint16_t *table;
 };
 
+/* The pattern set is compiled at build time into a bottom-up tree automaton
+ * (see TreeAutomaton in nir_algebraic.py).  The tables below are emitted as
+ * static const data, so there is no per-process or per-context automaton
+ * construction cost: _pre_block() assigns each SSA def a state with a few
+ * dense table lookups and _block() only calls into the recursive
+ * nir_replace_instr() matcher for instructions whose state has candidate
+ * patterns.
+ */
+
 /* Note: these must match the start states created in
  * TreeAutomaton._build_table()
  */
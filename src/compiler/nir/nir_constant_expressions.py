@@ -300,6 +300,19 @@ struct ${type}${width}_vec {
       ## For per-component instructions, we need to iterate over the
       ## components and apply the constant expression one component
       ## at a time.
+      ##
+      ## Hoist the source pointers into restrict-qualified locals so the
+      ## compiler can see that the loop iterations are independent and
+      ## vectorize the simple integer/float kernels.  Callers never pass
+      ## aliasing dest/src arrays (see nir_eval_const_opcode).
+      % for j in range(op.num_inputs):
+         % if op.input_sizes[j] != 0:
+            <% continue %>
+         % elif "src" + str(j) not in op.const_expr:
+            <% continue %>
+         % endif
+         const nir_const_value * restrict _src${j} = _src[${j}];
+      % endfor
       for (unsigned _i = 0; _i < num_components; _i++) {
          ## For each per-component input, create a variable srcN that
          ## contains the value of the current (_i'th) component.
@@ -311,13 +324,13 @@ struct ${type}${width}_vec {
                <% continue %>
             % elif input_types[j] == "int1":
                /* 1-bit integers use a 0/-1 convention */
-               const int1_t src${j} = -(int1_t)_src[${j}][_i].b;
+               const int1_t src${j} = -(int1_t)_src${j}[_i].b;
             % elif input_types[j] == "float16":
                const float src${j} =
-                  _mesa_half_to_float(_src[${j}][_i].u16);
+                  _mesa_half_to_float(_src${j}[_i].u16);
             % else:
                const ${input_types[j]}_t src${j} =
-                  _src[${j}][_i].${get_const_field(input_types[j])};
+                  _src${j}[_i].${get_const_field(input_types[j])};
             % endif
          % endfor
 
@@ -383,7 +396,7 @@ struct ${type}${width}_vec {
 
 % for name, op in sorted(opcodes.items()):
 static void
-evaluate_${name}(nir_const_value *_dst_val,
+evaluate_${name}(nir_const_value * restrict _dst_val,
                  MAYBE_UNUSED unsigned num_components,
                  ${"UNUSED" if op_bit_sizes(op) is None else ""} unsigned bit_size,
                  MAYBE_UNUSED nir_const_value **_src)
@@ -491,11 +491,26 @@ visit_if(bool *divergent, nir_if *if_stmt)
 static bool
 visit_loop(bool *divergent, nir_loop *loop)
 {
+   nir_block *header = nir_loop_first_block(loop);
    bool has_changed = false;
    bool repeat = true;
 
-   while (repeat){
-      repeat = nir_divergence_analysis_impl(divergent, &loop->body);
+   /* Values can only flow backwards into a loop through the header phis:
+    * either as loop-carried phi sources or as divergent continue conditions.
+    * Anything else a body pass changes has already been propagated forward
+    * within that pass, so instead of re-running passes until a full pass
+    * changes nothing, re-evaluate just the header phis after each pass and
+    * stop as soon as they are stable. */
+   while (repeat) {
+      has_changed |= nir_divergence_analysis_impl(divergent, &loop->body);
+
+      repeat = false;
+      nir_foreach_instr(instr, header) {
+         if (instr->type != nir_instr_type_phi)
+            break;
+         if (visit_phi(divergent, nir_instr_as_phi(instr)))
+            repeat = true;
+      }
       has_changed |= repeat;
    }
 
@@ -192,6 +192,78 @@ nir_calc_dominance_impl(nir_function_impl *impl)
    calc_dfs_indicies(start_block, &dfs_index);
 }
 
+/**
+ * Patches valid dominance metadata after a single edge has been split.
+ *
+ * \p new_block must have been inserted on the sole edge from \p pred to what
+ * is now new_block's one successor, i.e. new_block has exactly one
+ * predecessor (pred) and one successor.  Splitting an edge never changes the
+ * dominance relation between pre-existing blocks: the new block dominates
+ * only itself, its frontier is its successor (when the successor is a merge
+ * block), and the successor's immediate dominator only moves when the split
+ * edge was its sole incoming edge.
+ *
+ * This lets control-flow passes that insert blocks (rather than re-routing
+ * existing edges) keep nir_metadata_dominance and nir_metadata_block_index
+ * valid instead of forcing a full recompute on the next
+ * nir_metadata_require().  The indices and DFS numbers are refreshed with
+ * allocation-free list walks, so the cost is one O(blocks) sweep rather than
+ * the fixpoint iteration plus frontier rebuild of nir_calc_dominance_impl().
+ */
+void
+nir_dominance_update_after_cf_insert(nir_function_impl *impl,
+                                     nir_block *pred, nir_block *new_block)
+{
+   assert(impl->valid_metadata & nir_metadata_dominance);
+   assert(new_block->successors[0] != NULL &&
+          new_block->successors[1] == NULL);
+   assert(new_block->predecessors->entries == 1);
+   assert(_mesa_set_search(new_block->predecessors, pred));
+
+   nir_block *succ = new_block->successors[0];
+
+   /* Re-number the blocks; the source order of structured NIR is a reverse
+    * post-order, which is what intersect() relies on.
+    */
+   nir_index_blocks(impl);
+
+   new_block->imm_dom = pred;
+   new_block->num_dom_children = 0;
+   if (succ->predecessors->entries > 1)
+      _mesa_set_add(new_block->dom_frontier, succ);
+
+   if (succ->imm_dom == pred && succ->predecessors->entries == 1) {
+      /* The split edge was the successor's only incoming edge, so the new
+       * block now sits between pred and succ in the dominance tree.  Move
+       * succ from pred's child list to the new block's.
+       */
+      succ->imm_dom = new_block;
+
+      for (unsigned i = 0; i < pred->num_dom_children; i++) {
+         if (pred->dom_children[i] == succ) {
+            pred->dom_children[i] =
+               pred->dom_children[--pred->num_dom_children];
+            break;
+         }
+      }
+
+      new_block->dom_children = ralloc_array(ralloc_parent(impl),
+                                             nir_block *, 1);
+      new_block->dom_children[0] = succ;
+      new_block->num_dom_children = 1;
+   }
+
+   /* Add the new block to its parent's child list. */
+   pred->dom_children = reralloc(ralloc_parent(impl), pred->dom_children,
+                                 nir_block *, pred->num_dom_children + 1);
+   pred->dom_children[pred->num_dom_children++] = new_block;
+
+   unsigned dfs_index = 0;
+   calc_dfs_indicies(nir_start_block(impl), &dfs_index);
+
+   impl->valid_metadata |= nir_metadata_block_index | nir_metadata_dominance;
+}
+
 void
 nir_calc_dominance(nir_shader *shader)
 {
@@ -0,0 +1,113 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nir.h"
+#include "nir_builder.h"
+
+/*
+ * Shader hot-spot instrumentation.
+ *
+ * Inserts an SSBO atomic increment at every loop header and in front of
+ * every texture instruction, so that after a run the counter buffer tells
+ * you how many times each loop iterated and each texture op executed,
+ * summed over all invocations.  Counter i is the dwords at offset 4*i of
+ * the SSBO bound at the given binding; slots are assigned in the order the
+ * sites appear in the shader, which matches nir_print_shader output, so the
+ * numbers can be correlated back to the source.
+ *
+ * The caller is responsible for allocating and zeroing the counter buffer,
+ * binding it, and reading it back.  Since every invocation hits the
+ * atomics, the instrumented shader is much slower; this is a profiling
+ * tool, not something to leave enabled.
+ */
+
+struct inject_state {
+   nir_builder b;
+   unsigned ssbo_binding;
+   unsigned num_counters;
+};
+
+static void
+emit_count(struct inject_state *state)
+{
+   nir_builder *b = &state->b;
+   nir_intrinsic_instr *atomic =
+      nir_intrinsic_instr_create(b->shader, nir_intrinsic_ssbo_atomic_add);
+
+   atomic->src[0] = nir_src_for_ssa(nir_imm_int(b, state->ssbo_binding));
+   atomic->src[1] = nir_src_for_ssa(nir_imm_int(b, state->num_counters * 4));
+   atomic->src[2] = nir_src_for_ssa(nir_imm_int(b, 1));
+   atomic->num_components = 1;
+   nir_intrinsic_set_access(atomic, 0);
+   nir_ssa_dest_init(&atomic->instr, &atomic->dest, 1, 32, NULL);
+   nir_builder_instr_insert(b, &atomic->instr);
+
+   state->num_counters++;
+}
+
+static void
+inject_impl(struct inject_state *state, nir_function_impl *impl)
+{
+   nir_builder_init(&state->b, impl);
+
+   nir_foreach_block(block, impl) {
+      /* Count loop iterations: the first block of a loop body runs once
+       * per iteration.
+       */
+      if (block->cf_node.parent->type == nir_cf_node_loop &&
+          block == nir_loop_first_block(nir_cf_node_as_loop(block->cf_node.parent))) {
+         state->b.cursor = nir_after_phis(block);
+         emit_count(state);
+      }
+
+      nir_foreach_instr_safe(instr, block) {
+         if (instr->type != nir_instr_type_tex)
+            continue;
+
+         state->b.cursor = nir_before_instr(instr);
+         emit_count(state);
+      }
+   }
+
+   nir_metadata_preserve(impl, nir_metadata_block_index |
+                               nir_metadata_dominance);
+}
+
+unsigned
+nir_inject_profiling(nir_shader *shader, unsigned ssbo_binding)
+{
+   struct inject_state state;
+
+   state.ssbo_binding = ssbo_binding;
+   state.num_counters = 0;
+
+   nir_foreach_function(function, shader) {
+      if (function->impl)
+         inject_impl(&state, function->impl);
+   }
+
+   if (state.num_counters)
+      shader->info.num_ssbos = MAX2(shader->info.num_ssbos, ssbo_binding + 1);
+
+   return state.num_counters;
+}
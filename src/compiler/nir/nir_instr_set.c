@@ -831,7 +831,15 @@ nir_instr_set_add_or_rewrite(struct set *instr_set, nir_instr *instr)
    if (!instr_can_rewrite(instr))
       return false;
 
-   struct set_entry *e = _mesa_set_search_or_add(instr_set, instr);
+   /* Hashing an instruction walks all of its sources, so do it once and
+    * cache the result in instr->index for nir_instr_set_remove().  The set
+    * owns the index field while the instruction is in the set; this is fine
+    * because none of the set's users are index-based passes.
+    */
+   instr->index = hash_instr(instr);
+
+   struct set_entry *e =
+      _mesa_set_search_or_add_pre_hashed(instr_set, instr->index, instr);
    nir_instr *match = (nir_instr *) e->key;
    if (match != instr) {
       nir_ssa_def *def = nir_instr_get_dest_ssa_def(instr);
@@ -858,7 +866,9 @@ nir_instr_set_remove(struct set *instr_set, nir_instr *instr)
    if (!instr_can_rewrite(instr))
       return;
 
-   struct set_entry *entry = _mesa_set_search(instr_set, instr);
+   /* instr->index holds the hash cached by nir_instr_set_add_or_rewrite. */
+   struct set_entry *entry =
+      _mesa_set_search_pre_hashed(instr_set, instr->index, instr);
    if (entry)
       _mesa_set_remove(instr_set, entry);
 }
@@ -662,6 +662,26 @@ compact_components(nir_shader *producer, nir_shader *consumer,
    for (unsigned i = 0; i < varying_comp_info_size; i++ ) {
       struct varying_component *info = &varying_comp_info[i];
 
+      /* The sort groups components by matching interpolation type and
+       * location, and the cursor never moves backwards within a group.
+       * Slots that were skipped while packing one group, (because they
+       * already held components of another group), would therefore stay
+       * half-empty, costing a whole extra slot (an export and an
+       * interpolated input) for each.  Rewind the cursor at every group
+       * boundary so later groups can fill those gaps;
+       * assign_remap_locations() skips over mismatching slots anyway.
+       */
+      if (i > 0) {
+         struct varying_component *prev = &varying_comp_info[i - 1];
+
+         if (prev->interp_type != info->interp_type ||
+             prev->interp_loc != info->interp_loc ||
+             prev->is_patch != info->is_patch) {
+            cursor = 0;
+            comp = 0;
+         }
+      }
+
       assert(info->is_patch || cursor < MAX_VARYING);
       if (info->is_patch) {
          /* The list should be sorted with all non-patch inputs first followed
@@ -776,7 +796,9 @@ static bool
 does_varying_match(nir_variable *out_var, nir_variable *in_var)
 {
    return in_var->data.location == out_var->data.location &&
-          in_var->data.location_frac == out_var->data.location_frac;
+          in_var->data.location_frac == out_var->data.location_frac &&
+          glsl_get_vector_elements(in_var->type) ==
+          glsl_get_vector_elements(out_var->type);
 }
 
 static nir_variable *
@@ -802,10 +824,11 @@ can_replace_varying(nir_variable *out_var)
        glsl_type_is_struct_or_ifc(out_var->type))
       return false;
 
-   /* Limit this pass to scalars for now to keep things simple. Most varyings
-    * should have been lowered to scalars at this point anyway.
+   /* Vectors are fine too as long as the whole vector is written in one
+    * store and the matching input has the same number of components, which
+    * does_varying_match() checks.
     */
-   if (!glsl_type_is_scalar(out_var->type))
+   if (!glsl_type_is_vector_or_scalar(out_var->type))
       return false;
 
    if (out_var->data.location < VARYING_SLOT_VAR0 ||
@@ -947,6 +970,13 @@ nir_link_opt_varyings(nir_shader *producer, nir_shader *consumer)
       if (!can_replace_varying(out_var))
          continue;
 
+      /* A partial write means the rest of the output comes from some
+       * earlier store; don't try to trace that.
+       */
+      if (nir_intrinsic_write_mask(intr) !=
+          (1u << intr->num_components) - 1)
+         continue;
+
       if (intr->src[1].ssa->parent_instr->type == nir_instr_type_load_const) {
          progress |= replace_constant_input(consumer, intr);
       } else {
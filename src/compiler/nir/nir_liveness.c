@@ -40,6 +40,12 @@
  * SSA value may not dominate a use is if the use is in a phi node and the
  * uses in phi no are in the live-out of the corresponding predecessor
  * block but not in the live-in of the block containing the phi node.
+ *
+ * Note that deleting an instruction whose destinations are unused cannot
+ * change any block's live-in or live-out set (the defs were never live and
+ * removal does not renumber the remaining live_index values), so passes that
+ * only remove dead instructions may keep nir_metadata_live_ssa_defs valid by
+ * including it in their nir_metadata_preserve() mask.
  */
 
 struct live_ssa_defs_state {
@@ -113,7 +113,8 @@ emit_load_store_deref(nir_builder *b, nir_intrinsic_instr *orig_instr,
 
 static bool
 lower_indirect_derefs_block(nir_block *block, nir_builder *b,
-                            nir_variable_mode modes)
+                            nir_variable_mode modes,
+                            uint64_t max_lower_array_len)
 {
    bool progress = false;
 
@@ -133,13 +134,18 @@ lower_indirect_derefs_block(nir_block *block, nir_builder *b,
 
       /* Walk the deref chain back to the base and look for indirects */
       bool has_indirect = false;
+      uint64_t indirect_len = 1;
       nir_deref_instr *base = deref;
       while (base && base->deref_type != nir_deref_type_var) {
+         nir_deref_instr *parent = nir_deref_instr_parent(base);
+
          if (base->deref_type == nir_deref_type_array &&
-             !nir_src_is_const(base->arr.index))
+             !nir_src_is_const(base->arr.index)) {
             has_indirect = true;
+            indirect_len *= glsl_get_length(parent->type);
+         }
 
-         base = nir_deref_instr_parent(base);
+         base = parent;
       }
 
       if (!has_indirect || !base)
@@ -152,6 +158,14 @@ lower_indirect_derefs_block(nir_block *block, nir_builder *b,
       if (!(modes & base->var->data.mode) && !base->var->data.compact)
          continue;
 
+      /* The if-ladder grows with the product of the indirectly indexed
+       * array lengths, so leave arrays above the caller's limit alone.
+       * Compact arrays are always lowered since we can't handle indirects
+       * on them at all.
+       */
+      if (indirect_len > max_lower_array_len && !base->var->data.compact)
+         continue;
+
       b->cursor = nir_instr_remove(&intrin->instr);
 
       nir_deref_path path;
@@ -178,14 +192,16 @@ lower_indirect_derefs_block(nir_block *block, nir_builder *b,
 }
 
 static bool
-lower_indirects_impl(nir_function_impl *impl, nir_variable_mode modes)
+lower_indirects_impl(nir_function_impl *impl, nir_variable_mode modes,
+                     uint64_t max_lower_array_len)
 {
    nir_builder builder;
    nir_builder_init(&builder, impl);
    bool progress = false;
 
    nir_foreach_block_safe(block, impl) {
-      progress |= lower_indirect_derefs_block(block, &builder, modes);
+      progress |= lower_indirect_derefs_block(block, &builder, modes,
+                                              max_lower_array_len);
    }
 
    if (progress)
@@ -197,16 +213,22 @@ lower_indirects_impl(nir_function_impl *impl, nir_variable_mode modes)
 /** Lowers indirect variable loads/stores to direct loads/stores.
  *
  * The pass works by replacing any indirect load or store with an if-ladder
- * that does a binary search on the array index.
+ * that does a binary search on the array index.  Only accesses whose
+ * indirectly indexed array lengths multiply to at most max_lower_array_len
+ * are lowered; this lets drivers turn small indirectly indexed arrays into
+ * SSA values while keeping large ones in scratch.
  */
 bool
-nir_lower_indirect_derefs(nir_shader *shader, nir_variable_mode modes)
+nir_lower_indirect_derefs(nir_shader *shader, nir_variable_mode modes,
+                          uint64_t max_lower_array_len)
 {
    bool progress = false;
 
    nir_foreach_function(function, shader) {
-      if (function->impl)
-         progress = lower_indirects_impl(function->impl, modes) || progress;
+      if (function->impl) {
+         progress = lower_indirects_impl(function->impl, modes,
+                                         max_lower_array_len) || progress;
+      }
    }
 
    return progress;
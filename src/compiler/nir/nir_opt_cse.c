@@ -39,10 +39,9 @@
  */
 
 static bool
-cse_block(nir_block *block, struct set *dominance_set)
+cse_block(nir_block *block, struct set *instr_set)
 {
    bool progress = false;
-   struct set *instr_set = _mesa_set_clone(dominance_set, NULL);
 
    nir_foreach_instr_safe(instr, block) {
       if (nir_instr_set_add_or_rewrite(instr_set, instr)) {
@@ -56,7 +55,13 @@ cse_block(nir_block *block, struct set *dominance_set)
       progress |= cse_block(child, instr_set);
    }
 
-   _mesa_set_destroy(instr_set, NULL);
+   /* Pop this block's instructions back out of the set so siblings in the
+    * dominance tree don't see them.  This keeps one flat open-addressed
+    * table live for the whole pass instead of cloning the set per block,
+    * and the removals are cheap because the hash is cached at add time.
+    */
+   nir_foreach_instr(instr, block)
+      nir_instr_set_remove(instr_set, instr);
 
    return progress;
 }
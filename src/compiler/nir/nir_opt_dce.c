@@ -134,16 +134,12 @@ nir_opt_dce_impl(nir_function_impl *impl)
 
    nir_instr_worklist_destroy(worklist);
 
-   bool progress = false;
-
-   nir_foreach_block(block, impl) {
-      nir_foreach_instr_safe(instr, block) {
-         if (!instr->pass_flags) {
-            nir_instr_remove(instr);
-            progress = true;
-         }
-      }
-   }
+   /* The mark phase is closed over SSA uses (anything a live instruction
+    * reads was pushed on the worklist), which is exactly the invariant
+    * nir_instr_remove_batch() needs, so all of the dead instructions can be
+    * unlinked in one traversal.
+    */
+   bool progress = nir_instr_remove_batch(impl);
 
    if (progress) {
       nir_metadata_preserve(impl, nir_metadata_block_index |
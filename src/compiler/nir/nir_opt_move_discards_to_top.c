@@ -0,0 +1,155 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "nir.h"
+
+/** @file nir_opt_move_discards_to_top.c
+ *
+ * Moves discard and discard_if intrinsics as close to the top of their
+ * function's first block as possible, so back-ends that know whether a
+ * fragment has been killed before a given point can keep early depth and
+ * stencil testing enabled for the code that follows.
+ *
+ * Only straight-line code in the first block is considered.  A discard is
+ * never moved above the instruction producing its condition, and never
+ * across an instruction whose execution could be observed: anything with
+ * side effects, and anything that participates in derivative computations
+ * (killing a fragment earlier may change its helper-invocation behaviour).
+ */
+
+static bool
+instr_is_hoist_barrier(nir_instr *instr)
+{
+   switch (instr->type) {
+   case nir_instr_type_alu:
+      switch (nir_instr_as_alu(instr)->op) {
+      case nir_op_fddx:
+      case nir_op_fddy:
+      case nir_op_fddx_fine:
+      case nir_op_fddy_fine:
+      case nir_op_fddx_coarse:
+      case nir_op_fddy_coarse:
+         return true;
+      default:
+         return false;
+      }
+
+   case nir_instr_type_tex:
+      /* These compute an implicit derivative from neighbouring fragments. */
+      switch (nir_instr_as_tex(instr)->op) {
+      case nir_texop_tex:
+      case nir_texop_txb:
+      case nir_texop_lod:
+         return true;
+      default:
+         return false;
+      }
+
+   case nir_instr_type_intrinsic: {
+      nir_intrinsic_instr *intrin = nir_instr_as_intrinsic(instr);
+      return !(nir_intrinsic_infos[intrin->intrinsic].flags &
+               NIR_INTRINSIC_CAN_ELIMINATE);
+   }
+
+   case nir_instr_type_call:
+      return true;
+
+   default:
+      return false;
+   }
+}
+
+static bool
+opt_move_discards_block(nir_block *block)
+{
+   nir_instr *insert_after = NULL; /* NULL means the top of the block */
+   unsigned index = 0;
+   bool progress = false;
+
+   nir_foreach_instr_safe(instr, block) {
+      /* Number the instructions as we go so the position of a discard
+       * condition can be compared against the insertion point.  Moved
+       * discards inherit the index of their new predecessor; they define
+       * no values, so their own index is never looked at.
+       */
+      instr->index = index++;
+
+      nir_intrinsic_instr *intrin = instr->type == nir_instr_type_intrinsic ?
+         nir_instr_as_intrinsic(instr) : NULL;
+
+      if (!intrin ||
+          (intrin->intrinsic != nir_intrinsic_discard &&
+           intrin->intrinsic != nir_intrinsic_discard_if)) {
+         if (instr_is_hoist_barrier(instr))
+            insert_after = instr;
+         continue;
+      }
+
+      if (intrin->intrinsic == nir_intrinsic_discard_if) {
+         assert(intrin->src[0].is_ssa);
+         nir_instr *cond = intrin->src[0].ssa->parent_instr;
+
+         if (cond->block == block &&
+             (!insert_after || cond->index > insert_after->index))
+            insert_after = cond;
+      }
+
+      if (insert_after != nir_instr_prev(instr)) {
+         nir_instr_remove(instr);
+         if (insert_after)
+            nir_instr_insert(nir_after_instr(insert_after), instr);
+         else
+            nir_instr_insert(nir_before_block(block), instr);
+
+         instr->index = insert_after ? insert_after->index : 0;
+         progress = true;
+      }
+
+      /* Later discards must not move above this one. */
+      insert_after = instr;
+   }
+
+   return progress;
+}
+
+bool
+nir_opt_move_discards_to_top(nir_shader *shader)
+{
+   bool progress = false;
+
+   assert(shader->info.stage == MESA_SHADER_FRAGMENT);
+
+   nir_foreach_function(function, shader) {
+      if (!function->impl)
+         continue;
+
+      if (opt_move_discards_block(nir_start_block(function->impl))) {
+         nir_metadata_preserve(function->impl,
+                               nir_metadata_block_index |
+                               nir_metadata_dominance);
+         progress = true;
+      }
+   }
+
+   return progress;
+}
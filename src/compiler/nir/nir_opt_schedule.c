@@ -0,0 +1,207 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "nir.h"
+
+/*
+ * A simple machine-independent latency scheduler: long-latency
+ * instructions (texture fetches and reorderable loads by default, or
+ * whatever the backend's callback says) are hoisted as early in their
+ * block as their dependencies allow, so more independent work sits
+ * between issuing the fetch and consuming its result.
+ *
+ * This is the counterpart of nir_opt_sink: sinking shortens live ranges
+ * of cheap values, hoisting hides the latency of expensive ones.  Since
+ * hoisting extends the result's live range, backends worried about
+ * register pressure can bound the motion with max_distance.
+ */
+
+struct sched_dep_state {
+   nir_block *block;
+   /* latest in-block instruction defining one of our sources */
+   nir_instr *latest;
+   bool movable;
+};
+
+static bool
+sched_src_dep_cb(nir_src *src, void *data)
+{
+   struct sched_dep_state *state = data;
+   nir_instr *parent;
+
+   if (!src->is_ssa) {
+      state->movable = false;
+      return false;
+   }
+
+   parent = src->ssa->parent_instr;
+   if (parent->block != state->block)
+      return true;
+
+   /* An instruction hoisted earlier this pass has a stale index, so we
+    * can't order against it; be conservative and leave this one alone.
+    */
+   if (parent->pass_flags) {
+      state->movable = false;
+      return false;
+   }
+
+   /* phis stay at the top of the block, which every hoist destination
+    * is already below
+    */
+   if (parent->type == nir_instr_type_phi)
+      return true;
+
+   if (!state->latest || parent->index > state->latest->index)
+      state->latest = parent;
+
+   return true;
+}
+
+static bool
+can_hoist_instr(nir_instr *instr)
+{
+   switch (instr->type) {
+   case nir_instr_type_tex:
+      return nir_instr_as_tex(instr)->dest.is_ssa;
+   case nir_instr_type_intrinsic: {
+      nir_intrinsic_instr *intrin = nir_instr_as_intrinsic(instr);
+      return nir_intrinsic_infos[intrin->intrinsic].has_dest &&
+             intrin->dest.is_ssa &&
+             nir_intrinsic_can_reorder(intrin);
+   }
+   default:
+      return false;
+   }
+}
+
+static bool
+is_long_latency_instr(nir_instr *instr,
+                      const nir_opt_schedule_options *options)
+{
+   if (options && options->is_long_latency)
+      return options->is_long_latency(instr, options->cb_data);
+
+   /* by default only texture fetches and memory loads are worth the
+    * extra live range
+    */
+   return instr->type == nir_instr_type_tex ||
+          instr->type == nir_instr_type_intrinsic;
+}
+
+static bool
+opt_schedule_block(nir_block *block,
+                   const nir_opt_schedule_options *options)
+{
+   bool progress = false;
+
+   nir_foreach_instr_safe(instr, block) {
+      struct sched_dep_state state = {
+         .block = block,
+         .latest = NULL,
+         .movable = true,
+      };
+      nir_instr *after, *prev;
+
+      if (!can_hoist_instr(instr) || !is_long_latency_instr(instr, options))
+         continue;
+
+      nir_foreach_src(instr, sched_src_dep_cb, &state);
+      if (!state.movable)
+         continue;
+
+      after = state.latest;
+
+      if (options && options->max_distance) {
+         /* don't extend the live range by more than max_distance
+          * instructions, to keep register pressure in check
+          */
+         nir_instr *p = nir_instr_prev(instr);
+         unsigned d = 0;
+
+         while (p != after && p != NULL &&
+                p->type != nir_instr_type_phi) {
+            if (++d > options->max_distance) {
+               after = p;
+               break;
+            }
+            p = nir_instr_prev(p);
+         }
+      }
+
+      /* already as early as it can get? */
+      prev = nir_instr_prev(instr);
+      if (after ? prev == after
+                : (prev == NULL || prev->type == nir_instr_type_phi))
+         continue;
+
+      exec_node_remove(&instr->node);
+      if (after) {
+         exec_node_insert_after(&after->node, &instr->node);
+      } else {
+         /* no in-block dependencies: right after the phis */
+         nir_instr *first = nir_block_first_instr(block);
+         while (first->type == nir_instr_type_phi)
+            first = nir_instr_next(first);
+         exec_node_insert_node_before(&first->node, &instr->node);
+      }
+      instr->pass_flags = 1;
+      progress = true;
+   }
+
+   return progress;
+}
+
+bool
+nir_opt_schedule(nir_shader *shader,
+                 const nir_opt_schedule_options *options)
+{
+   bool progress = false;
+
+   nir_foreach_function(function, shader) {
+      bool impl_progress = false;
+
+      if (!function->impl)
+         continue;
+
+      nir_index_instrs(function->impl);
+      nir_foreach_block(block, function->impl) {
+         nir_foreach_instr(instr, block)
+            instr->pass_flags = 0;
+      }
+
+      nir_foreach_block(block, function->impl)
+         impl_progress |= opt_schedule_block(block, options);
+
+      if (impl_progress) {
+         nir_metadata_preserve(function->impl,
+                               nir_metadata_block_index |
+                               nir_metadata_dominance);
+         progress = true;
+      } else {
+         nir_metadata_preserve(function->impl, nir_metadata_all);
+      }
+   }
+
+   return progress;
+}
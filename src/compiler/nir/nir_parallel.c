@@ -0,0 +1,111 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "nir.h"
+
+#include "util/u_cpu_detect.h"
+#include "util/u_queue.h"
+
+/**
+ * \file nir_parallel.c
+ *
+ * A small job-based driver that lets state trackers run per-shader NIR
+ * optimization loops concurrently.  A nir_shader never shares mutable state
+ * with another nir_shader, so the per-stage shaders of a program (or the
+ * shaders of many programs being linked at once) can be optimized on
+ * separate threads as long as the callback only touches the shader it was
+ * handed.
+ *
+ * The callback must not touch the ralloc context above the shader, any
+ * GL/gallium object, or the shader of another job.  In particular it must
+ * not call nir_shader_get_entrypoint() on a different shader or mutate
+ * shared shader_info.  These are the same rules u_threaded_context imposes
+ * on driver compile threads.
+ */
+
+struct nir_parallel_job {
+   nir_shader *shader;
+   nir_parallel_opt_cb callback;
+   void *data;
+   struct util_queue_fence fence;
+};
+
+static void
+nir_parallel_execute_job(void *job, int thread_index)
+{
+   struct nir_parallel_job *pjob = job;
+
+   pjob->callback(pjob->shader, pjob->data);
+}
+
+void
+nir_optimize_parallel(nir_shader * const *shaders, unsigned num_shaders,
+                      nir_parallel_opt_cb callback, void *data)
+{
+   if (num_shaders == 0)
+      return;
+
+   util_cpu_detect();
+
+   unsigned num_threads = MIN2(num_shaders, (unsigned)util_cpu_caps.nr_cpus);
+
+   /* With a single shader (or a single CPU) the queue is pure overhead. */
+   if (num_threads <= 1) {
+      for (unsigned i = 0; i < num_shaders; i++)
+         callback(shaders[i], data);
+      return;
+   }
+
+   struct util_queue queue;
+   if (!util_queue_init(&queue, "nir_opt", num_shaders, num_threads, 0)) {
+      for (unsigned i = 0; i < num_shaders; i++)
+         callback(shaders[i], data);
+      return;
+   }
+
+   struct nir_parallel_job *jobs =
+      calloc(num_shaders, sizeof(struct nir_parallel_job));
+   if (!jobs) {
+      util_queue_destroy(&queue);
+      for (unsigned i = 0; i < num_shaders; i++)
+         callback(shaders[i], data);
+      return;
+   }
+
+   for (unsigned i = 0; i < num_shaders; i++) {
+      jobs[i].shader = shaders[i];
+      jobs[i].callback = callback;
+      jobs[i].data = data;
+      util_queue_fence_init(&jobs[i].fence);
+      util_queue_add_job(&queue, &jobs[i], &jobs[i].fence,
+                         nir_parallel_execute_job, NULL);
+   }
+
+   for (unsigned i = 0; i < num_shaders; i++) {
+      util_queue_fence_wait(&jobs[i].fence);
+      util_queue_fence_destroy(&jobs[i].fence);
+   }
+
+   util_queue_destroy(&queue);
+   free(jobs);
+}
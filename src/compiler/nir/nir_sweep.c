@@ -22,6 +22,7 @@
  */
 
 #include "nir.h"
+#include "util/debug.h"
 
 /**
  * \file nir_sweep.c
@@ -180,3 +181,90 @@ nir_sweep(nir_shader *nir)
    /* Free everything we didn't steal back. */
    ralloc_free(rubbish);
 }
+
+static bool
+nir_list_stats_enabled(void)
+{
+   static int enabled = -1;
+   if (enabled < 0)
+      enabled = env_var_as_boolean("NIR_LIST_STATS", false);
+
+   return enabled;
+}
+
+/**
+ * Report how well the instruction lists sit in memory.
+ *
+ * The lists are intrusive, so a list walk touches one cache line per
+ * instruction unless consecutive instructions happen to be adjacent on the
+ * heap.  We count, for each traversal step, whether the next instruction
+ * lies within a cache line (64 bytes) or at least within the same 4K page
+ * of the previous one; the remainder are likely cache or TLB misses on a
+ * cold walk.  Enabled with NIR_LIST_STATS=1.
+ */
+static void
+nir_list_stats(nir_shader *nir, const char *when)
+{
+   unsigned instrs = 0, steps = 0, near = 0, same_page = 0;
+
+   nir_foreach_function(function, nir) {
+      if (!function->impl)
+         continue;
+
+      nir_foreach_block(block, function->impl) {
+         const nir_instr *prev = NULL;
+
+         nir_foreach_instr(instr, block) {
+            instrs++;
+            if (prev) {
+               ptrdiff_t dist = (const char *)instr - (const char *)prev;
+               if (dist < 0)
+                  dist = -dist;
+
+               steps++;
+               if (dist <= 64)
+                  near++;
+               if (((uintptr_t)instr >> 12) == ((uintptr_t)prev >> 12))
+                  same_page++;
+            }
+            prev = instr;
+         }
+      }
+   }
+
+   fprintf(stderr, "nir_list_stats: %s (%s): %u instructions, "
+           "%u of %u steps within 64B, %u within the same 4K page\n",
+           nir->info.name ? nir->info.name : "(unnamed)", when,
+           instrs, near, steps, same_page);
+}
+
+/**
+ * Re-lay the shader's memory in (roughly) program order.
+ *
+ * nir_sweep() frees dead memory but leaves the live allocations wherever
+ * malloc happened to put them, so after many optimization passes the
+ * instruction list is scattered across the heap and list walks take cache
+ * misses on nearly every node.  This pass rebuilds the shader by cloning it
+ * into a fresh ralloc context - the clone allocates instructions in block
+ * order, so consecutive instructions usually end up adjacent in memory - and
+ * then replaces the original in place, preserving the nir_shader pointer
+ * callers hold.
+ *
+ * Like nir_sweep(), this invalidates all metadata and any pointers into the
+ * shader's guts, so only call it between passes.  It is most profitable once
+ * after the heaviest churn (e.g. after inlining and the first optimization
+ * loop) rather than after every pass.
+ */
+void
+nir_compact(nir_shader *nir)
+{
+   if (nir_list_stats_enabled())
+      nir_list_stats(nir, "before compaction");
+
+   nir_shader *clone = nir_shader_clone(NULL, nir);
+
+   nir_shader_replace(nir, clone);
+
+   if (nir_list_stats_enabled())
+      nir_list_stats(nir, "after compaction");
+}
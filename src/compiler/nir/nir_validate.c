@@ -27,6 +27,7 @@
 
 #include "nir.h"
 #include "c11/threads.h"
+#include "util/u_atomic.h"
 #include <assert.h>
 
 /*
@@ -1228,6 +1229,20 @@ nir_validate_shader(nir_shader *shader, const char *when)
    if (!should_validate)
       return;
 
+   /* NIR_VALIDATE_SAMPLE=N only validates every Nth invocation, so perf
+    * runs can keep validation enabled at a fraction of the cost.  Most IR
+    * corruption survives several passes, so sampled validation still
+    * catches it, just with a less precise "when".
+    */
+   static unsigned sample_rate = 0;
+   if (sample_rate == 0)
+      sample_rate = MAX2(env_var_as_unsigned("NIR_VALIDATE_SAMPLE", 1), 1);
+   if (sample_rate > 1) {
+      static uint32_t invocation = 0;
+      if (p_atomic_inc_return(&invocation) % sample_rate != 0)
+         return;
+   }
+
    validate_state state;
    init_validate_state(&state);
 
@@ -1274,4 +1289,25 @@ nir_validate_shader(nir_shader *shader, const char *when)
    destroy_validate_state(&state);
 }
 
+static void
+validate_shader_cb(nir_shader *shader, void *data)
+{
+   nir_validate_shader(shader, data);
+}
+
+/**
+ * Validates a set of independent shaders (e.g. the stages of a pipeline)
+ * concurrently.  All validation state is per-shader, so the jobs don't
+ * share anything; on failure the offending job dumps its errors and aborts
+ * like nir_validate_shader() would, though output from multiple failing
+ * shaders may interleave.
+ */
+void
+nir_validate_shaders(nir_shader * const *shaders, unsigned num_shaders,
+                     const char *when)
+{
+   nir_optimize_parallel(shaders, num_shaders, validate_shader_cb,
+                         (void *)when);
+}
+
 #endif /* NDEBUG */
@@ -760,10 +760,20 @@ vtn_build_cfg(struct vtn_builder *b, const uint32_t *words, const uint32_t *end)
    vtn_foreach_instruction(b, words, end,
                            vtn_cfg_handle_prepass_instruction);
 
-   foreach_list_typed(struct vtn_function, func, node, &b->functions) {
-      vtn_cfg_walk_blocks(b, &func->body, func->start_block,
-                          NULL, NULL, NULL, NULL, NULL);
-   }
+   /* Structurizing a function's blocks is deferred to
+    * vtn_build_function_cfg(), called as functions become referenced from
+    * the selected entry point.  Multi-entry-point modules (and repeat
+    * translations of one module with different specialization constants)
+    * usually contain a lot of code the chosen entry point never calls, and
+    * we don't want to pay for walking it.
+    */
+}
+
+void
+vtn_build_function_cfg(struct vtn_builder *b, struct vtn_function *func)
+{
+   vtn_cfg_walk_blocks(b, &func->body, func->start_block,
+                       NULL, NULL, NULL, NULL, NULL);
 }
 
 static bool
@@ -247,6 +247,7 @@ typedef bool (*vtn_instruction_handler)(struct vtn_builder *, SpvOp,
 
 void vtn_build_cfg(struct vtn_builder *b, const uint32_t *words,
                    const uint32_t *end);
+void vtn_build_function_cfg(struct vtn_builder *b, struct vtn_function *func);
 void vtn_function_emit(struct vtn_builder *b, struct vtn_function *func,
                        vtn_instruction_handler instruction_handler);
 void vtn_handle_function_call(struct vtn_builder *b, SpvOp opcode,
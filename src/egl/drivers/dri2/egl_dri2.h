@@ -190,6 +190,7 @@ struct dri2_egl_display
    const __DRI2interopExtension *interop;
    const __DRIconfigOptionsExtension *configOptions;
    const __DRImutableRenderBufferDriverExtension *mutable_render_buffer;
+   const __DRIcopySubBufferExtension *copySubBuffer;
    int                       fd;
 
    /* dri2_initialize/dri2_terminate increment/decrement this count, so does
@@ -299,6 +300,13 @@ struct dri2_egl_surface
    __DRIbuffer           *local_buffers[__DRI_BUFFER_COUNT];
 
 #if defined(HAVE_WAYLAND_PLATFORM) || defined(HAVE_DRM_PLATFORM)
+   /* With swap interval 0 the compositor can be holding up to three buffers
+    * at once (displayed, queued and just-released-but-unprocessed), plus one
+    * in flight to the server; a fifth slot lets the client keep rendering
+    * instead of blocking in get_back_bo until a release event arrives.
+    * Slots only ever allocate a real buffer on first use, so the deeper
+    * pool costs nothing under light load.
+    */
    struct {
 #ifdef HAVE_WAYLAND_PLATFORM
       struct wl_buffer   *wl_buffer;
@@ -315,7 +323,7 @@ struct dri2_egl_surface
 #endif
       bool                locked;
       int                 age;
-   } color_buffers[4], *back, *current;
+   } color_buffers[5], *back, *current;
 #endif
 
 #ifdef HAVE_ANDROID_PLATFORM
@@ -985,6 +985,34 @@ dri2_x11_swap_buffers(_EGLDriver *drv, _EGLDisplay *disp, _EGLSurface *draw)
    return EGL_TRUE;
 }
 
+static EGLBoolean
+dri2_x11_swrast_swap_buffers_with_damage(_EGLDriver *drv, _EGLDisplay *disp,
+                                         _EGLSurface *draw,
+                                         const EGLint *rects, EGLint n_rects)
+{
+   struct dri2_egl_display *dri2_dpy = dri2_egl_display(disp);
+   struct dri2_egl_surface *dri2_surf = dri2_egl_surface(draw);
+
+   if (!dri2_dpy->copySubBuffer || n_rects == 0 ||
+       draw->Type != EGL_WINDOW_BIT)
+      return dri2_x11_swap_buffers(drv, disp, draw);
+
+   /* The driver copies only the damaged rectangles to the window instead of
+    * the whole back buffer.  Both the EGL damage rectangles and the driver's
+    * copySubBuffer use a bottom-left origin, so the coordinates pass through
+    * unmodified.
+    */
+   for (int i = 0; i < n_rects; i++) {
+      const EGLint *rect = &rects[i * 4];
+
+      dri2_dpy->copySubBuffer->copySubBuffer(dri2_surf->dri_drawable,
+                                             rect[0], rect[1],
+                                             rect[2], rect[3]);
+   }
+
+   return EGL_TRUE;
+}
+
 static EGLBoolean
 dri2_x11_swap_buffers_region(_EGLDriver *drv, _EGLDisplay *disp,
                              _EGLSurface *draw,
@@ -1217,6 +1245,7 @@ static const struct dri2_egl_display_vtbl dri2_x11_swrast_display_vtbl = {
    .destroy_surface = dri2_x11_destroy_surface,
    .create_image = dri2_create_image_khr,
    .swap_buffers = dri2_x11_swap_buffers,
+   .swap_buffers_with_damage = dri2_x11_swrast_swap_buffers_with_damage,
    .set_damage_region = dri2_fallback_set_damage_region,
    .swap_buffers_region = dri2_fallback_swap_buffers_region,
    .post_sub_buffer = dri2_fallback_post_sub_buffer,
@@ -1356,6 +1385,9 @@ dri2_initialize_x11_swrast(_EGLDriver *drv, _EGLDisplay *disp)
 
    dri2_setup_screen(disp);
 
+   if (dri2_dpy->copySubBuffer)
+      disp->Extensions.EXT_swap_buffers_with_damage = EGL_TRUE;
+
    if (!dri2_x11_add_configs_for_visuals(dri2_dpy, disp, true))
       goto cleanup;
 
@@ -737,21 +737,24 @@ _eglFilterConfigArray(_EGLArray *array, EGLConfig *configs,
    _EGLConfig **configList;
    EGLint i, count;
 
-   /* get the number of matched configs */
-   count = _eglFilterArray(array, NULL, 0,
-         (_EGLArrayForEach) match, priv_data);
-   if (!count) {
-      *num_configs = count;
+   if (!_eglGetArraySize(array)) {
+      *num_configs = 0;
       return EGL_TRUE;
    }
 
-   configList = malloc(sizeof(*configList) * count);
+   configList = malloc(sizeof(*configList) * _eglGetArraySize(array));
    if (!configList)
       return _eglError(EGL_BAD_ALLOC, "eglChooseConfig(out of memory)");
 
-   /* get the matched configs */
-   _eglFilterArray(array, (void **) configList, count,
+   /* get the matched configs, testing each config only once */
+   count = _eglFilterArray(array, (void **) configList,
+         _eglGetArraySize(array),
          (_EGLArrayForEach) match, priv_data);
+   if (!count) {
+      free(configList);
+      *num_configs = count;
+      return EGL_TRUE;
+   }
 
    /* perform sorting of configs */
    if (configs && count) {
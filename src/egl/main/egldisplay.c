@@ -286,9 +286,12 @@ _eglFindDisplay(_EGLPlatformType plat, void *plat_dpy,
             memcpy(disp->Options.Attribs, attrib_list,
                    num_attribs * sizeof(EGLAttrib));
          }
-         /* add to the display list */
+         /* Add to the display list.  Publish with a release store so that
+          * the lock-free walk in _eglCheckDisplayHandle never observes a
+          * partially initialized display.
+          */
          disp->Next = _eglGlobal.DisplayList;
-         _eglGlobal.DisplayList = disp;
+         p_atomic_set(&_eglGlobal.DisplayList, disp);
       }
    }
 
@@ -373,14 +376,18 @@ _eglCheckDisplayHandle(EGLDisplay dpy)
 {
    _EGLDisplay *cur;
 
-   mtx_lock(_eglGlobal.Mutex);
-   cur = _eglGlobal.DisplayList;
+   /* Displays are never removed from the list until process cleanup, and
+    * new ones are fully initialized before being published (with a release
+    * store, in _eglFindDisplay), so the list can be walked without taking
+    * the global lock.  This runs for every EGL call that takes an
+    * EGLDisplay, so staying off the lock matters.
+    */
+   cur = p_atomic_read(&_eglGlobal.DisplayList);
    while (cur) {
       if (cur == (_EGLDisplay *) dpy)
          break;
       cur = cur->Next;
    }
-   mtx_unlock(_eglGlobal.Mutex);
    return (cur != NULL);
 }
 
@@ -239,6 +239,7 @@ struct ir3_shader_variant *
 ir3_shader_get_variant(struct ir3_shader *shader, struct ir3_shader_key *key,
 		bool binning_pass, bool *created)
 {
+	mtx_lock(&shader->variants_lock);
 	struct ir3_shader_variant *v =
 			shader_variant(shader, key, created);
 
@@ -247,8 +248,9 @@ ir3_shader_get_variant(struct ir3_shader *shader, struct ir3_shader_key *key,
 			v->binning = create_variant(shader, key, true);
 			*created = true;
 		}
-		return v->binning;
+		v = v->binning;
 	}
+	mtx_unlock(&shader->variants_lock);
 
 	return v;
 }
@@ -257,6 +259,13 @@ void
 ir3_shader_destroy(struct ir3_shader *shader)
 {
 	struct ir3_shader_variant *v, *t;
+
+	/* Wait for any queued initial-variant compile to finish before we
+	 * start tearing things down:
+	 */
+	util_queue_fence_wait(&shader->ready);
+	util_queue_fence_destroy(&shader->ready);
+
 	for (v = shader->variants; v; ) {
 		t = v;
 		v = v->next;
@@ -264,6 +273,7 @@ ir3_shader_destroy(struct ir3_shader *shader)
 	}
 	free(shader->const_state.immediates);
 	ralloc_free(shader->nir);
+	mtx_destroy(&shader->variants_lock);
 	free(shader);
 }
 
@@ -272,6 +282,9 @@ ir3_shader_from_nir(struct ir3_compiler *compiler, nir_shader *nir)
 {
 	struct ir3_shader *shader = CALLOC_STRUCT(ir3_shader);
 
+	mtx_init(&shader->variants_lock, mtx_plain);
+	util_queue_fence_init(&shader->ready);
+
 	shader->compiler = compiler;
 	shader->id = ++shader->compiler->shader_count;
 	shader->type = nir->info.stage;
@@ -32,6 +32,7 @@
 #include "compiler/shader_enums.h"
 #include "compiler/nir/nir.h"
 #include "util/bitscan.h"
+#include "util/u_queue.h"
 
 #include "ir3.h"
 
@@ -544,6 +545,14 @@ struct ir3_shader {
 	struct ir3_stream_output_info stream_output;
 
 	struct ir3_shader_variant *variants;
+
+	/* Protects the variants list, so initial variants can be compiled
+	 * asynchronously with CSO creation:
+	 */
+	mtx_t variants_lock;
+
+	/* Signalled when any queued initial-variant compile has finished: */
+	struct util_queue_fence ready;
 };
 
 void * ir3_shader_assemble(struct ir3_shader_variant *v, uint32_t gpu_id);
@@ -36,8 +36,27 @@
 #include "cso_hash.h"
 
 
+/* Number of entries in the front-side MRU array per CSO type. */
+#define CSO_CACHE_MRU_SIZE 4
+
+/**
+ * Most-recently-used state objects of one type. Probed before the hash:
+ * applications tend to cycle through a handful of CSOs per type, so the
+ * common lookup can skip the hash walk and its collision-list memcmps.
+ *
+ * The iterators stay valid as long as no node of this type is removed
+ * from the hash; every path that can remove nodes clears the array.
+ */
+struct cso_cache_mru {
+   unsigned hash_key[CSO_CACHE_MRU_SIZE];
+   struct cso_hash_iter iter[CSO_CACHE_MRU_SIZE];
+   unsigned num;
+};
+
 struct cso_cache {
    struct cso_hash *hashes[CSO_CACHE_MAX];
+   struct cso_cache_mru mru[CSO_CACHE_MAX];
+   struct cso_cache_stats stats[CSO_CACHE_MAX];
    int    max_size;
 
    cso_sanitize_callback sanitize_cb;
@@ -87,6 +106,34 @@ static inline struct cso_hash *_cso_hash_for_type(struct cso_cache *sc, enum cso
    return hash;
 }
 
+static inline void cso_cache_mru_clear(struct cso_cache *sc,
+                                       enum cso_cache_type type)
+{
+   sc->mru[type].num = 0;
+}
+
+/**
+ * Push an entry to the front of the MRU array, dropping the oldest one
+ * if the array is full. The caller guarantees the node isn't in the
+ * array already.
+ */
+static void cso_cache_mru_add(struct cso_cache *sc, enum cso_cache_type type,
+                              unsigned hash_key, struct cso_hash_iter iter)
+{
+   struct cso_cache_mru *mru = &sc->mru[type];
+   unsigned i;
+
+   if (mru->num < CSO_CACHE_MRU_SIZE)
+      mru->num++;
+
+   for (i = mru->num - 1; i > 0; i--) {
+      mru->hash_key[i] = mru->hash_key[i - 1];
+      mru->iter[i] = mru->iter[i - 1];
+   }
+   mru->hash_key[0] = hash_key;
+   mru->iter[0] = iter;
+}
+
 static void delete_blend_state(void *state, UNUSED void *data)
 {
    struct cso_blend *cso = (struct cso_blend *)state;
@@ -157,8 +204,16 @@ static inline void sanitize_hash(struct cso_cache *sc,
                                  enum cso_cache_type type,
                                  int max_size)
 {
-   if (sc->sanitize_cb)
+   if (sc->sanitize_cb) {
+      int size_before = cso_hash_size(hash);
+      int size_after;
+
       sc->sanitize_cb(hash, type, max_size, sc->sanitize_data);
+
+      size_after = cso_hash_size(hash);
+      if (size_after < size_before)
+         sc->stats[type].evictions += size_before - size_after;
+   }
 }
 
 
@@ -188,9 +243,17 @@ cso_insert_state(struct cso_cache *sc,
                  void *state)
 {
    struct cso_hash *hash = _cso_hash_for_type(sc, type);
+   struct cso_hash_iter iter;
+
+   /* The sanitize callback may remove (or, for bound sampler states,
+    * re-create) nodes, which would leave the MRU array dangling. */
+   cso_cache_mru_clear(sc, type);
    sanitize_hash(sc, hash, type, sc->max_size);
 
-   return cso_hash_insert(hash, hash_key, state);
+   iter = cso_hash_insert(hash, hash_key, state);
+   if (!cso_hash_iter_is_null(iter))
+      cso_cache_mru_add(sc, type, hash_key, iter);
+   return iter;
 }
 
 struct cso_hash_iter
@@ -226,13 +289,42 @@ struct cso_hash_iter cso_find_state_template(struct cso_cache *sc,
                                              unsigned hash_key, enum cso_cache_type type,
                                              void *templ, unsigned size)
 {
-   struct cso_hash_iter iter = cso_find_state(sc, hash_key, type);
+   struct cso_cache_mru *mru = &sc->mru[type];
+   struct cso_hash_iter iter;
+   unsigned i;
+
+   /* Probe the front-side MRU array first. All cached state structs
+    * start with the template, so the same memcmp applies. */
+   for (i = 0; i < mru->num; i++) {
+      if (mru->hash_key[i] == hash_key &&
+          !memcmp(cso_hash_iter_data(mru->iter[i]), templ, size)) {
+         struct cso_hash_iter hit = mru->iter[i];
+
+         /* Move the entry to the front. */
+         for (; i > 0; i--) {
+            mru->hash_key[i] = mru->hash_key[i - 1];
+            mru->iter[i] = mru->iter[i - 1];
+         }
+         mru->hash_key[0] = hash_key;
+         mru->iter[0] = hit;
+
+         sc->stats[type].mru_hits++;
+         return hit;
+      }
+   }
+
+   iter = cso_find_state(sc, hash_key, type);
    while (!cso_hash_iter_is_null(iter)) {
       void *iter_data = cso_hash_iter_data(iter);
-      if (!memcmp(iter_data, templ, size))
+      if (!memcmp(iter_data, templ, size)) {
+         sc->stats[type].hash_hits++;
+         cso_cache_mru_add(sc, type, hash_key, iter);
          return iter;
+      }
       iter = cso_hash_iter_next(iter);
    }
+
+   sc->stats[type].misses++;
    return iter;
 }
 
@@ -240,12 +332,13 @@ void * cso_take_state(struct cso_cache *sc,
                       unsigned hash_key, enum cso_cache_type type)
 {
    struct cso_hash *hash = _cso_hash_for_type(sc, type);
+   cso_cache_mru_clear(sc, type);
    return cso_hash_take(hash, hash_key);
 }
 
 struct cso_cache *cso_cache_create(void)
 {
-   struct cso_cache *sc = MALLOC_STRUCT(cso_cache);
+   struct cso_cache *sc = CALLOC_STRUCT(cso_cache);
    int i;
    if (!sc)
       return NULL;
@@ -278,12 +371,28 @@ void cso_for_each_state(struct cso_cache *sc, enum cso_cache_type type,
 
 void cso_cache_delete(struct cso_cache *sc)
 {
+   static const char *type_names[CSO_CACHE_MAX] = {
+      "rasterizer", "blend", "depth_stencil_alpha", "sampler", "velements"
+   };
    int i;
    assert(sc);
 
    if (!sc)
       return;
 
+   if (debug_get_bool_option("CSO_CACHE_STATS", FALSE)) {
+      for (i = 0; i < CSO_CACHE_MAX; i++) {
+         const struct cso_cache_stats *stats = &sc->stats[i];
+
+         debug_printf("cso_cache %s: mru hits %llu, hash hits %llu, "
+                      "misses %llu, evictions %llu\n", type_names[i],
+                      (unsigned long long)stats->mru_hits,
+                      (unsigned long long)stats->hash_hits,
+                      (unsigned long long)stats->misses,
+                      (unsigned long long)stats->evictions);
+      }
+   }
+
    /* delete driver data */
    cso_for_each_state(sc, CSO_BLEND, delete_blend_state, 0);
    cso_for_each_state(sc, CSO_DEPTH_STENCIL_ALPHA, delete_depth_stencil_state, 0);
@@ -303,8 +412,10 @@ void cso_set_maximum_cache_size(struct cso_cache *sc, int number)
 
    sc->max_size = number;
 
-   for (i = 0; i < CSO_CACHE_MAX; i++)
+   for (i = 0; i < CSO_CACHE_MAX; i++) {
+      cso_cache_mru_clear(sc, i);
       sanitize_hash(sc, sc->hashes[i], i, sc->max_size);
+   }
 }
 
 int cso_maximum_cache_size(const struct cso_cache *sc)
@@ -312,6 +423,12 @@ int cso_maximum_cache_size(const struct cso_cache *sc)
    return sc->max_size;
 }
 
+const struct cso_cache_stats *
+cso_cache_get_stats(const struct cso_cache *sc, enum cso_cache_type type)
+{
+   return &sc->stats[type];
+}
+
 void cso_cache_set_sanitize_callback(struct cso_cache *sc,
                                      cso_sanitize_callback cb,
                                      void *user_data)
@@ -103,6 +103,20 @@ typedef void (*cso_sanitize_callback)(struct cso_hash *hash,
 
 struct cso_cache;
 
+/**
+ * Per-type cache statistics.
+ *
+ * mru_hits are lookups satisfied by the small front-side MRU array,
+ * hash_hits required walking the hash, misses created a new state object,
+ * and evictions count entries removed by the size sanitizer.
+ */
+struct cso_cache_stats {
+   uint64_t mru_hits;
+   uint64_t hash_hits;
+   uint64_t misses;
+   uint64_t evictions;
+};
+
 struct cso_blend {
    struct pipe_blend_state state;
    void *data;
@@ -169,6 +183,9 @@ void * cso_take_state(struct cso_cache *sc, unsigned hash_key,
 void cso_set_maximum_cache_size(struct cso_cache *sc, int number);
 int cso_maximum_cache_size(const struct cso_cache *sc);
 
+const struct cso_cache_stats *
+cso_cache_get_stats(const struct cso_cache *sc, enum cso_cache_type type);
+
 #ifdef	__cplusplus
 }
 #endif
@@ -73,8 +73,8 @@ struct cso_context {
 
    unsigned saved_state;  /**< bitmask of CSO_BIT_x flags */
 
-   struct pipe_sampler_view *fragment_views[PIPE_MAX_SHADER_SAMPLER_VIEWS];
-   unsigned nr_fragment_views;
+   struct pipe_sampler_view *sampler_views[PIPE_SHADER_TYPES][PIPE_MAX_SHADER_SAMPLER_VIEWS];
+   unsigned nr_sampler_views[PIPE_SHADER_TYPES];
 
    struct pipe_sampler_view *fragment_views_saved[PIPE_MAX_SHADER_SAMPLER_VIEWS];
    unsigned nr_fragment_views_saved;
@@ -352,7 +352,7 @@ out:
  */
 void cso_destroy_context( struct cso_context *ctx )
 {
-   unsigned i;
+   unsigned i, sh;
 
    if (ctx->pipe) {
       ctx->pipe->bind_blend_state( ctx->pipe, NULL );
@@ -404,8 +404,10 @@ void cso_destroy_context( struct cso_context *ctx )
          ctx->pipe->set_stream_output_targets(ctx->pipe, 0, NULL, NULL);
    }
 
-   for (i = 0; i < ctx->nr_fragment_views; i++) {
-      pipe_sampler_view_reference(&ctx->fragment_views[i], NULL);
+   for (sh = 0; sh < PIPE_SHADER_TYPES; sh++) {
+      for (i = 0; i < ctx->nr_sampler_views[sh]; i++) {
+         pipe_sampler_view_reference(&ctx->sampler_views[sh][i], NULL);
+      }
    }
    for (i = 0; i < ctx->nr_fragment_views_saved; i++) {
       pipe_sampler_view_reference(&ctx->fragment_views_saved[i], NULL);
@@ -1316,32 +1318,30 @@ cso_set_sampler_views(struct cso_context *ctx,
                       unsigned count,
                       struct pipe_sampler_view **views)
 {
-   if (shader_stage == PIPE_SHADER_FRAGMENT) {
-      unsigned i;
-      boolean any_change = FALSE;
-
-      /* reference new views */
-      for (i = 0; i < count; i++) {
-         any_change |= ctx->fragment_views[i] != views[i];
-         pipe_sampler_view_reference(&ctx->fragment_views[i], views[i]);
-      }
-      /* unref extra old views, if any */
-      for (; i < ctx->nr_fragment_views; i++) {
-         any_change |= ctx->fragment_views[i] != NULL;
-         pipe_sampler_view_reference(&ctx->fragment_views[i], NULL);
-      }
+   unsigned i;
+   boolean any_change = FALSE;
 
-      /* bind the new sampler views */
-      if (any_change) {
-         ctx->pipe->set_sampler_views(ctx->pipe, shader_stage, 0,
-                                      MAX2(ctx->nr_fragment_views, count),
-                                      ctx->fragment_views);
-      }
+   /* reference new views */
+   for (i = 0; i < count; i++) {
+      any_change |= ctx->sampler_views[shader_stage][i] != views[i];
+      pipe_sampler_view_reference(&ctx->sampler_views[shader_stage][i],
+                                  views[i]);
+   }
+   /* unref extra old views, if any */
+   for (; i < ctx->nr_sampler_views[shader_stage]; i++) {
+      any_change |= ctx->sampler_views[shader_stage][i] != NULL;
+      pipe_sampler_view_reference(&ctx->sampler_views[shader_stage][i], NULL);
+   }
 
-      ctx->nr_fragment_views = count;
+   /* bind the new sampler views */
+   if (any_change) {
+      ctx->pipe->set_sampler_views(ctx->pipe, shader_stage, 0,
+                                   MAX2(ctx->nr_sampler_views[shader_stage],
+                                        count),
+                                   ctx->sampler_views[shader_stage]);
    }
-   else
-      ctx->pipe->set_sampler_views(ctx->pipe, shader_stage, 0, count, views);
+
+   ctx->nr_sampler_views[shader_stage] = count;
 }
 
 
@@ -1350,12 +1350,12 @@ cso_save_fragment_sampler_views(struct cso_context *ctx)
 {
    unsigned i;
 
-   ctx->nr_fragment_views_saved = ctx->nr_fragment_views;
+   ctx->nr_fragment_views_saved = ctx->nr_sampler_views[PIPE_SHADER_FRAGMENT];
 
-   for (i = 0; i < ctx->nr_fragment_views; i++) {
+   for (i = 0; i < ctx->nr_fragment_views_saved; i++) {
       assert(!ctx->fragment_views_saved[i]);
       pipe_sampler_view_reference(&ctx->fragment_views_saved[i],
-                                  ctx->fragment_views[i]);
+                                  ctx->sampler_views[PIPE_SHADER_FRAGMENT][i]);
    }
 }
 
@@ -1363,26 +1363,28 @@ cso_save_fragment_sampler_views(struct cso_context *ctx)
 static void
 cso_restore_fragment_sampler_views(struct cso_context *ctx)
 {
+   struct pipe_sampler_view **views =
+      ctx->sampler_views[PIPE_SHADER_FRAGMENT];
    unsigned i, nr_saved = ctx->nr_fragment_views_saved;
    unsigned num;
 
    for (i = 0; i < nr_saved; i++) {
-      pipe_sampler_view_reference(&ctx->fragment_views[i], NULL);
+      pipe_sampler_view_reference(&views[i], NULL);
       /* move the reference from one pointer to another */
-      ctx->fragment_views[i] = ctx->fragment_views_saved[i];
+      views[i] = ctx->fragment_views_saved[i];
       ctx->fragment_views_saved[i] = NULL;
    }
-   for (; i < ctx->nr_fragment_views; i++) {
-      pipe_sampler_view_reference(&ctx->fragment_views[i], NULL);
+   for (; i < ctx->nr_sampler_views[PIPE_SHADER_FRAGMENT]; i++) {
+      pipe_sampler_view_reference(&views[i], NULL);
    }
 
-   num = MAX2(ctx->nr_fragment_views, nr_saved);
+   num = MAX2(ctx->nr_sampler_views[PIPE_SHADER_FRAGMENT], nr_saved);
 
    /* bind the old/saved sampler views */
    ctx->pipe->set_sampler_views(ctx->pipe, PIPE_SHADER_FRAGMENT, 0, num,
-                                ctx->fragment_views);
+                                views);
 
-   ctx->nr_fragment_views = nr_saved;
+   ctx->nr_sampler_views[PIPE_SHADER_FRAGMENT] = nr_saved;
    ctx->nr_fragment_views_saved = 0;
 }
 
@@ -40,6 +40,7 @@ static boolean TAG(do_cliptest)( struct pt_post_vs *pvs,
    unsigned ucp_enable = pvs->draw->rasterizer->clip_plane_enable;
    unsigned flags = (FLAGS);
    unsigned need_pipeline = 0;
+   unsigned all_mask = ~0U;
    unsigned j;
    unsigned i;
    bool have_cd = false;
@@ -156,6 +157,7 @@ static boolean TAG(do_cliptest)( struct pt_post_vs *pvs,
          out->clipmask = mask;
          need_pipeline |= out->clipmask;
       }
+      all_mask &= mask;
 
       /*
        * Transform the vertex position from clip coords to window coords,
@@ -193,6 +195,12 @@ static boolean TAG(do_cliptest)( struct pt_post_vs *pvs,
 
       out = (struct vertex_header *)( (char *)out + info->stride );
    }
+
+   /* A common set bit means every vertex is outside the same plane, so all
+    * primitives in the batch are trivially rejected.
+    */
+   pvs->all_clipmask = info->count ? all_mask : 0;
+
    return need_pipeline != 0;
 }
 
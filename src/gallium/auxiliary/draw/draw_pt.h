@@ -229,6 +229,8 @@ boolean draw_pt_post_vs_run( struct pt_post_vs *pvs,
 			     struct draw_vertex_info *info,
                              const struct draw_prim_info *prim_info );
 
+boolean draw_pt_post_vs_all_clipped( const struct pt_post_vs *pvs );
+
 void draw_pt_post_vs_prepare( struct pt_post_vs *pvs,
 			      boolean clip_xy,
 			      boolean clip_z,
@@ -357,6 +357,18 @@ fetch_pipeline_generic(struct draw_pt_middle_end *middle,
 
       if (draw_pt_post_vs_run( fpme->post_vs, vert_info, prim_info ))
       {
+         /* If every vertex ended up outside the same clip plane, the whole
+          * batch is trivially rejected; there is no point walking the
+          * primitive pipeline just to discard each primitive in turn.
+          */
+         if (draw_pt_post_vs_all_clipped( fpme->post_vs )) {
+            FREE(vert_info->verts);
+            if (free_prim_info) {
+               FREE(prim_info->primitive_lengths);
+            }
+            return;
+         }
+
          opt |= PT_PIPELINE;
       }
 
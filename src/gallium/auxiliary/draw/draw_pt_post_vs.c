@@ -34,6 +34,11 @@
 #include "draw/draw_pt.h"
 #include "draw/draw_vs.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define USE_X86_64_SIMD
+#include <emmintrin.h>
+#endif
+
 #define DO_CLIP_XY           0x1
 #define DO_CLIP_FULL_Z       0x2
 #define DO_CLIP_HALF_Z       0x4
@@ -48,6 +53,11 @@ struct pt_post_vs {
 
    unsigned flags;
 
+   /* AND of all vertex clipmasks from the last run.  Non-zero means every
+    * vertex was outside the same clip plane.
+    */
+   unsigned all_clipmask;
+
    boolean (*run)( struct pt_post_vs *pvs,
                    struct draw_vertex_info *info,
                    const struct draw_prim_info *prim_info );
@@ -75,6 +85,11 @@ dot4(const float *a, const float *b)
 #define TAG(x) x##_none
 #include "draw_cliptest_tmp.h"
 
+/* These three are replaced by do_cliptest_xyz_viewport_simd below when
+ * SSE is available.
+ */
+#ifndef USE_X86_64_SIMD
+
 #define FLAGS (DO_CLIP_XY | DO_CLIP_FULL_Z | DO_VIEWPORT)
 #define TAG(x) x##_xy_fullz_viewport
 #include "draw_cliptest_tmp.h"
@@ -87,6 +102,8 @@ dot4(const float *a, const float *b)
 #define TAG(x) x##_xy_gb_halfz_viewport
 #include "draw_cliptest_tmp.h"
 
+#endif /* !USE_X86_64_SIMD */
+
 #define FLAGS (DO_CLIP_FULL_Z | DO_VIEWPORT)
 #define TAG(x) x##_fullz_viewport
 #include "draw_cliptest_tmp.h"
@@ -115,6 +132,107 @@ dot4(const float *a, const float *b)
 #include "draw_cliptest_tmp.h"
 
 
+#ifdef USE_X86_64_SIMD
+
+/* SSE kernel for the common specializations (xy or xy-guardband clip,
+ * full or half z, viewport transform, no user planes, no edgeflags).
+ * The four x/y plane tests become a single packed compare and the
+ * viewport transform a packed multiply-add, instead of the scalar
+ * per-component arithmetic in draw_cliptest_tmp.h.
+ *
+ * Shaders which write clip distances re-enable user clipping at run
+ * time, and per-vertex viewport indices need the viewport reloaded per
+ * primitive; both are rare, so hand those off to the generic loop.
+ */
+static boolean do_cliptest_xyz_viewport_simd( struct pt_post_vs *pvs,
+                                              struct draw_vertex_info *info,
+                                              const struct draw_prim_info *prim_info )
+{
+   struct vertex_header *out = info->verts;
+   const unsigned pos = draw_current_shader_position_output(pvs->draw);
+   const unsigned flags = pvs->flags;
+   const float *scale = pvs->draw->viewports[0].scale;
+   const float *trans = pvs->draw->viewports[0].translate;
+   const float c = (flags & DO_CLIP_XY_GUARD_BAND) ? 0.5f : 1.0f;
+   const __m128 coef = _mm_setr_ps(-c, c, -c, c);
+   const __m128 vp_scale = _mm_setr_ps(scale[0], scale[1], scale[2], 0.0f);
+   const __m128 vp_trans = _mm_setr_ps(trans[0], trans[1], trans[2], 0.0f);
+   unsigned need_pipeline = 0;
+   unsigned all_mask = ~0U;
+   unsigned j;
+
+   if (draw_current_shader_num_written_clipdistances(pvs->draw) ||
+       draw_current_shader_uses_viewport_index(pvs->draw))
+      return do_cliptest_generic(pvs, info, prim_info);
+
+   assert(pos != -1);
+   assert((flags & (DO_CLIP_USER | DO_EDGEFLAG)) == 0);
+   assert(flags & DO_VIEWPORT);
+
+   for (j = 0; j < info->count; j++) {
+      float *position = out->data[pos];
+      __m128 p = _mm_loadu_ps(position);
+      __m128 xxyy = _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 0, 0));
+      __m128 wwww = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3));
+      unsigned mask;
+
+      initialize_vertex_header(out);
+
+      _mm_storeu_ps(out->clip_pos, p);
+
+      /* (-c*x + w, c*x + w, -c*y + w, c*y + w) against the sign bits;
+       * cmpnge rather than cmplt so that NaNs stay clipped, matching
+       * the scalar !(v >= 0) tests.
+       */
+      mask = _mm_movemask_ps(
+         _mm_cmpnge_ps(_mm_add_ps(_mm_mul_ps(xxyy, coef), wwww),
+                       _mm_setzero_ps()));
+
+      if (flags & DO_CLIP_FULL_Z) {
+         if (!( position[2] + position[3] >= 0)) mask |= (1<<4);
+         if (!(-position[2] + position[3] >= 0)) mask |= (1<<5);
+      }
+      else {
+         if (!( position[2]               >= 0)) mask |= (1<<4);
+         if (!(-position[2] + position[3] >= 0)) mask |= (1<<5);
+      }
+
+      out->clipmask = mask;
+      need_pipeline |= mask;
+      all_mask &= mask;
+
+      if (mask == 0) {
+         /* divide by w, then viewport mapping */
+         float w = 1.0f / position[3];
+         __m128 res = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, _mm_set1_ps(w)),
+                                            vp_scale),
+                                 vp_trans);
+         _mm_storeu_ps(position, res);
+         position[3] = w;
+      }
+#ifdef DEBUG
+      /* For debug builds, set the clipped vertex's window coordinate
+       * to NaN to help catch potential errors later.
+       */
+      else {
+         float zero = 0.0f;
+         position[0] =
+         position[1] =
+         position[2] =
+         position[3] = zero / zero; /* MSVC doesn't accept 0.0 / 0.0 */
+      }
+#endif
+
+      out = (struct vertex_header *)( (char *)out + info->stride );
+   }
+
+   pvs->all_clipmask = info->count ? all_mask : 0;
+
+   return need_pipeline != 0;
+}
+
+#endif /* USE_X86_64_SIMD */
+
 
 boolean draw_pt_post_vs_run( struct pt_post_vs *pvs,
                              struct draw_vertex_info *info,
@@ -124,6 +242,17 @@ boolean draw_pt_post_vs_run( struct pt_post_vs *pvs,
 }
 
 
+/**
+ * Whether the last run left every vertex outside the same clip plane.  In
+ * that case all primitives of the batch are trivially rejected and the
+ * caller can drop them without walking the primitive pipeline.
+ */
+boolean draw_pt_post_vs_all_clipped( const struct pt_post_vs *pvs )
+{
+   return pvs->all_clipmask != 0;
+}
+
+
 void draw_pt_post_vs_prepare( struct pt_post_vs *pvs,
 			      boolean clip_xy,
 			      boolean clip_z,
@@ -182,15 +311,27 @@ void draw_pt_post_vs_prepare( struct pt_post_vs *pvs,
       break;
 
    case DO_CLIP_XY | DO_CLIP_FULL_Z | DO_VIEWPORT:
+#ifdef USE_X86_64_SIMD
+      pvs->run = do_cliptest_xyz_viewport_simd;
+#else
       pvs->run = do_cliptest_xy_fullz_viewport;
+#endif
       break;
 
    case DO_CLIP_XY | DO_CLIP_HALF_Z | DO_VIEWPORT:
+#ifdef USE_X86_64_SIMD
+      pvs->run = do_cliptest_xyz_viewport_simd;
+#else
       pvs->run = do_cliptest_xy_halfz_viewport;
+#endif
       break;
 
    case DO_CLIP_XY_GUARD_BAND | DO_CLIP_HALF_Z | DO_VIEWPORT:
+#ifdef USE_X86_64_SIMD
+      pvs->run = do_cliptest_xyz_viewport_simd;
+#else
       pvs->run = do_cliptest_xy_gb_halfz_viewport;
+#endif
       break;
 
    case DO_CLIP_FULL_Z | DO_VIEWPORT:
@@ -986,6 +986,32 @@ dd_maybe_dump_record(struct dd_screen *dscreen, struct dd_draw_record *record)
    fclose(f);
 }
 
+static const char *
+dd_call_type_name(enum call_type type)
+{
+   switch (type) {
+   case CALL_FLUSH: return "flush";
+   case CALL_DRAW_VBO: return "draw_vbo";
+   case CALL_LAUNCH_GRID: return "launch_grid";
+   case CALL_RESOURCE_COPY_REGION: return "resource_copy_region";
+   case CALL_BLIT: return "blit";
+   case CALL_FLUSH_RESOURCE: return "flush_resource";
+   case CALL_CLEAR: return "clear";
+   case CALL_CLEAR_BUFFER: return "clear_buffer";
+   case CALL_CLEAR_TEXTURE: return "clear_texture";
+   case CALL_CLEAR_RENDER_TARGET: return "clear_render_target";
+   case CALL_CLEAR_DEPTH_STENCIL: return "clear_depth_stencil";
+   case CALL_GENERATE_MIPMAP: return "generate_mipmap";
+   case CALL_GET_QUERY_RESULT_RESOURCE: return "get_query_result_resource";
+   case CALL_TRANSFER_MAP: return "transfer_map";
+   case CALL_TRANSFER_FLUSH_REGION: return "transfer_flush_region";
+   case CALL_TRANSFER_UNMAP: return "transfer_unmap";
+   case CALL_BUFFER_SUBDATA: return "buffer_subdata";
+   case CALL_TEXTURE_SUBDATA: return "texture_subdata";
+   }
+   return "?";
+}
+
 static const char *
 dd_fence_state(struct pipe_screen *screen, struct pipe_fence_handle *fence,
                bool *not_reached)
@@ -1009,11 +1035,13 @@ dd_report_hang(struct dd_context *dctx)
    bool encountered_hang = false;
    bool stop_output = false;
    unsigned num_later = 0;
+   struct dd_draw_record *suspect = NULL;
+   char suspect_file[512] = {0};
 
    fprintf(stderr, "GPU hang detected, collecting information...\n\n");
 
-   fprintf(stderr, "Draw #   driver  prev BOP  TOP  BOP  dump file\n"
-                   "-------------------------------------------------------------\n");
+   fprintf(stderr, "Draw #   driver  prev BOP  TOP  BOP  call                  dump file\n"
+                   "--------------------------------------------------------------------------\n");
 
    list_for_each_entry(struct dd_draw_record, record, &dctx->records, list) {
       if (!encountered_hang &&
@@ -1034,8 +1062,9 @@ dd_report_hang(struct dd_context *dctx)
       const char *top = dd_fence_state(screen, record->top_of_pipe, &top_not_reached);
       const char *bop = dd_fence_state(screen, record->bottom_of_pipe, NULL);
 
-      fprintf(stderr, "%-9u %s      %s     %s  %s  ",
-              record->draw_call, driver ? "YES" : "NO ", prev_bop, top, bop);
+      fprintf(stderr, "%-9u %s      %s     %s  %s  %-20s  ",
+              record->draw_call, driver ? "YES" : "NO ", prev_bop, top, bop,
+              dd_call_type_name(record->call.type));
 
       char name[512];
       dd_get_debug_filename_and_mkdir(name, sizeof(name), false);
@@ -1052,6 +1081,15 @@ dd_report_hang(struct dd_context *dctx)
          fclose(f);
       }
 
+      /* The first unfinished call whose top-of-pipe fence has signalled is
+       * the one the GPU was executing when the timeout expired.
+       */
+      if (!suspect && !top_not_reached) {
+         suspect = record;
+         if (f)
+            strncpy(suspect_file, name, sizeof(suspect_file) - 1);
+      }
+
       if (top_not_reached)
          stop_output = true;
       encountered_hang = true;
@@ -1060,6 +1098,16 @@ dd_report_hang(struct dd_context *dctx)
    if (num_later)
       fprintf(stderr, "... and %u additional draws.\n", num_later);
 
+   if (suspect) {
+      fprintf(stderr, "\nThe GPU had started but not finished %s call #%u "
+                      "when the timeout expired, which makes it the most "
+                      "likely culprit.\n",
+              dd_call_type_name(suspect->call.type), suspect->draw_call);
+      if (suspect_file[0])
+         fprintf(stderr, "Its dump, including the IR of all bound shaders, "
+                         "is in %s.\n", suspect_file);
+   }
+
    char name[512];
    dd_get_debug_filename_and_mkdir(name, sizeof(name), false);
    FILE *f = fopen(name, "w");
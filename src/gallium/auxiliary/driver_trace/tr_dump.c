@@ -59,6 +59,7 @@
 
 static boolean close_stream = FALSE;
 static FILE *stream = NULL;
+static boolean flush_per_call = TRUE;
 static mtx_t call_mutex = _MTX_INITIALIZER_NP;
 static long unsigned call_no = 0;
 static boolean dumping = FALSE;
@@ -97,23 +98,42 @@ static inline void
 trace_dump_escape(const char *str)
 {
    const unsigned char *p = (const unsigned char *)str;
+   const unsigned char *run = p;
    unsigned char c;
-   while((c = *p++) != 0) {
+
+   /* Accumulate runs of characters that need no escaping and write them
+    * in one go rather than per character.
+    */
+   while((c = *p) != 0) {
+      const char *escape;
+
       if(c == '<')
-         trace_dump_writes("&lt;");
+         escape = "&lt;";
       else if(c == '>')
-         trace_dump_writes("&gt;");
+         escape = "&gt;";
       else if(c == '&')
-         trace_dump_writes("&amp;");
+         escape = "&amp;";
       else if(c == '\'')
-         trace_dump_writes("&apos;");
+         escape = "&apos;";
       else if(c == '\"')
-         trace_dump_writes("&quot;");
-      else if(c >= 0x20 && c <= 0x7e)
-         trace_dump_writef("%c", c);
+         escape = "&quot;";
+      else if(c >= 0x20 && c <= 0x7e) {
+         ++p;
+         continue;
+      }
+      else
+         escape = NULL;
+
+      if(p != run)
+         trace_dump_write((const char *)run, p - run);
+      if(escape)
+         trace_dump_writes(escape);
       else
          trace_dump_writef("&#%u;", c);
+      run = ++p;
    }
+   if(p != run)
+      trace_dump_write((const char *)run, p - run);
 }
 
 
@@ -223,8 +243,18 @@ trace_dump_trace_begin(void)
          stream = fopen(filename, "wt");
          if (!stream)
             return FALSE;
+         /* Give the file stream a decent buffer; the dump code emits lots
+          * of small writes.
+          */
+         setvbuf(stream, NULL, _IOFBF, 1024 * 1024);
       }
 
+      /* Flushing after every call keeps the trace usable after a crash but
+       * dominates capture time on call-heavy workloads; it can be turned
+       * off when capturing for performance analysis.
+       */
+      flush_per_call = debug_get_bool_option("GALLIUM_TRACE_FLUSH", TRUE);
+
       trace_dump_writes("<?xml version='1.0' encoding='UTF-8'?>\n");
       trace_dump_writes("<?xml-stylesheet type='text/xsl' href='trace.xsl'?>\n");
       trace_dump_writes("<trace version='0.1'>\n");
@@ -338,7 +368,8 @@ void trace_dump_call_end_locked(void)
    trace_dump_indent(1);
    trace_dump_tag_end("call");
    trace_dump_newline();
-   fflush(stream);
+   if (flush_per_call)
+      fflush(stream);
 }
 
 void trace_dump_call_begin(const char *klass, const char *method)
@@ -432,12 +463,17 @@ void trace_dump_bytes(const void *data,
       return;
 
    trace_dump_writes("<bytes>");
-   for(i = 0; i < size; ++i) {
-      uint8_t byte = *p++;
-      char hex[2];
-      hex[0] = hex_table[byte >> 4];
-      hex[1] = hex_table[byte & 0xf];
-      trace_dump_write(hex, 2);
+   while (size) {
+      char hex[512];
+      size_t chunk = MIN2(size, sizeof(hex) / 2);
+
+      for(i = 0; i < chunk; ++i) {
+         uint8_t byte = *p++;
+         hex[2 * i + 0] = hex_table[byte >> 4];
+         hex[2 * i + 1] = hex_table[byte & 0xf];
+      }
+      trace_dump_write(hex, 2 * chunk);
+      size -= chunk;
    }
    trace_dump_writes("</bytes>");
 }
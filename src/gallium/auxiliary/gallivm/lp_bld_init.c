@@ -455,9 +455,12 @@ lp_build_init(void)
     *
     * See also:
     * - http://www.anandtech.com/show/4955/the-bulldozer-review-amd-fx8150-tested/2
+    *
+    * This only applies to AVX1-era AMD parts; anything with AVX2 (Zen and
+    * later) has full-rate 256-bit units and wants the wide vectors too.
     */
    if (util_cpu_caps.has_avx &&
-       util_cpu_caps.has_intel) {
+       (util_cpu_caps.has_intel || util_cpu_caps.has_avx2)) {
       lp_native_vector_width = 256;
    } else {
       /* Leave it at 128, even when no SIMD extensions are available.
@@ -46,6 +46,7 @@
 #include "util/u_inlines.h"
 #include "util/u_memory.h"
 #include "util/u_math.h"
+#include "util/os_time.h"
 #include "util/u_sampler.h"
 #include "util/u_simple_shaders.h"
 #include "util/u_string.h"
@@ -53,6 +54,12 @@
 #include "tgsi/tgsi_text.h"
 #include "tgsi/tgsi_dump.h"
 
+#ifndef PIPE_OS_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 /* Control the visibility of all HUD contexts */
 static boolean huds_visible = TRUE;
 
@@ -708,10 +715,52 @@ hud_stop_queries(struct hud_context *hud, struct pipe_context *pipe)
          hud_pane_accumulate_vertices(hud, pane);
    }
 
+   if (hud->csv_fd) {
+      boolean first = TRUE;
+
+      LIST_FOR_EACH_ENTRY(pane, &hud->pane_list, head) {
+         LIST_FOR_EACH_ENTRY(gr, &pane->graph_list, head) {
+            fprintf(hud->csv_fd, first ? "%f" : ",%f", gr->current_value);
+            first = FALSE;
+         }
+      }
+      fprintf(hud->csv_fd, "\n");
+   }
+
    /* unmap the uploader's vertex buffer before drawing */
    u_upload_unmap(pipe->stream_uploader);
 }
 
+/**
+ * Per-frame part of the shared-memory export: a smoothed frame time of
+ * the monitored context, meant as the one backpressure signal that
+ * compositors and resolution-scaling controllers read instead of each
+ * rolling their own timing loops.
+ */
+static void
+hud_shm_update_frame(struct hud_context *hud)
+{
+   struct hud_shm_header *header = hud->shm;
+   int64_t now;
+
+   if (!header)
+      return;
+
+   now = os_time_get();
+   if (hud->shm_last_time) {
+      double ms = (now - hud->shm_last_time) / 1000.0;
+
+      if (header->frame == 0)
+         header->frametime_avg_ms = ms;
+      else
+         header->frametime_avg_ms += (ms - header->frametime_avg_ms) * 0.125;
+   }
+   hud->shm_last_time = now;
+
+   /* Publish; readers acquire-load 'frame' before frametime_avg_ms. */
+   p_atomic_set(&header->frame, header->frame + 1);
+}
+
 /**
  * Record queries and draw the HUD. The "cso" parameter acts as a filter.
  * If "cso" is not the recording context, recording is skipped.
@@ -727,8 +776,10 @@ hud_run(struct hud_context *hud, struct cso_context *cso,
    /* If "cso" is the recording or drawing context or NULL, execute
     * the operation. Otherwise, don't do anything.
     */
-   if (hud->record_pipe && (!pipe || pipe == hud->record_pipe))
+   if (hud->record_pipe && (!pipe || pipe == hud->record_pipe)) {
       hud_stop_queries(hud, hud->record_pipe);
+      hud_shm_update_frame(hud);
+   }
 
    if (hud->cso && (!cso || cso == hud->cso))
       hud_draw_results(hud, tex);
@@ -955,6 +1006,22 @@ void
 hud_graph_add_value(struct hud_graph *gr, double value)
 {
    gr->current_value = value;
+
+   if (gr->shm) {
+      struct hud_shm_graph *shm = gr->shm;
+      uint32_t next = shm->head + 1;
+
+      if (next == 1)
+         gr->ema = value;
+      else
+         gr->ema += (value - gr->ema) * 0.125;
+
+      shm->ring[next % HUD_SHM_RING_SIZE] = value;
+      shm->avg = gr->ema;
+      /* Publish the slot; readers acquire-load 'head' before reading it. */
+      p_atomic_set(&shm->head, next);
+   }
+
    value = value > gr->pane->ceiling ? gr->pane->ceiling : value;
 
    if (gr->fd) {
@@ -1057,6 +1124,111 @@ hud_graph_set_dump_file(struct hud_graph *gr)
    }
 }
 
+/**
+ * If the GALLIUM_HUD_SHMEM env var is set, map the named file and export
+ * the raw HUD values into it, so an external process can read them
+ * without perturbing the monitored context. See hud_private.h for the
+ * layout and the reader protocol.
+ */
+static void
+hud_shm_create(struct hud_context *hud)
+{
+#ifndef PIPE_OS_WINDOWS
+   const char *path = getenv("GALLIUM_HUD_SHMEM");
+   struct hud_shm_header *header;
+   struct hud_pane *pane;
+   struct hud_graph *gr;
+   unsigned num_graphs = 0, i;
+   size_t size;
+   int fd;
+
+   if (!path)
+      return;
+
+   LIST_FOR_EACH_ENTRY(pane, &hud->pane_list, head)
+      num_graphs += pane->num_graphs;
+
+   if (!num_graphs)
+      return;
+
+   size = sizeof(*header) + num_graphs * sizeof(header->graphs[0]);
+
+   fd = open(path, O_CREAT | O_RDWR, 0644);
+   if (fd < 0 || ftruncate(fd, size) < 0) {
+      fprintf(stderr, "gallium_hud: can't create %s\n", path);
+      fflush(stderr);
+      if (fd >= 0)
+         close(fd);
+      return;
+   }
+
+   header = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (header == MAP_FAILED) {
+      fprintf(stderr, "gallium_hud: can't map %s\n", path);
+      fflush(stderr);
+      return;
+   }
+
+   memset(header, 0, size);
+   header->num_graphs = num_graphs;
+   header->pid = getpid();
+
+   i = 0;
+   LIST_FOR_EACH_ENTRY(pane, &hud->pane_list, head) {
+      LIST_FOR_EACH_ENTRY(gr, &pane->graph_list, head) {
+         struct hud_shm_graph *shm = &header->graphs[i++];
+
+         memcpy(shm->name, gr->name, sizeof(shm->name));
+         gr->shm = shm;
+      }
+   }
+
+   /* Write the magic last, so a reader that sees it also sees the graph
+    * names. */
+   p_atomic_set(&header->magic, HUD_SHM_MAGIC);
+
+   hud->shm = header;
+   hud->shm_size = size;
+#endif
+}
+
+/**
+ * If the GALLIUM_HUD_CSV env var is set, write all graph values into the
+ * named file as one CSV row per frame, with a header row of graph names.
+ * Don't combine this with pane sorting - sorting reorders the graph list
+ * and with it the columns.
+ */
+static void
+hud_csv_create(struct hud_context *hud)
+{
+   const char *path = getenv("GALLIUM_HUD_CSV");
+   struct hud_pane *pane;
+   struct hud_graph *gr;
+   boolean first = TRUE;
+
+   if (!path)
+      return;
+
+   hud->csv_fd = fopen(path, "w");
+   if (!hud->csv_fd) {
+      fprintf(stderr, "gallium_hud: can't open %s\n", path);
+      fflush(stderr);
+      return;
+   }
+
+   /* flush output after each line is written */
+   setvbuf(hud->csv_fd, NULL, _IOLBF, 0);
+
+   LIST_FOR_EACH_ENTRY(pane, &hud->pane_list, head) {
+      LIST_FOR_EACH_ENTRY(gr, &pane->graph_list, head) {
+         fprintf(hud->csv_fd, first ? "%s" : ",%s", gr->name);
+         first = FALSE;
+      }
+   }
+   fprintf(hud->csv_fd, "\n");
+}
+
 /**
  * Read a string from the environment variable.
  * The separators "+", ",", ":", and ";" terminate the string.
@@ -1508,6 +1680,9 @@ hud_parse_env_var(struct hud_context *hud, struct pipe_screen *screen,
          hud_graph_set_dump_file(gr);
       }
    }
+
+   hud_shm_create(hud);
+   hud_csv_create(hud);
 }
 
 static void
@@ -1926,6 +2101,12 @@ hud_destroy(struct hud_context *hud, struct cso_context *cso)
       hud_unset_draw_context(hud);
 
    if (p_atomic_dec_zero(&hud->refcount)) {
+#ifndef PIPE_OS_WINDOWS
+      if (hud->shm)
+         munmap(hud->shm, hud->shm_size);
+#endif
+      if (hud->csv_fd)
+         fclose(hud->csv_fd);
       pipe_resource_reference(&hud->font.texture, NULL);
       FREE(hud);
    }
@@ -39,6 +39,43 @@ enum hud_counter {
    HUD_COUNTER_SYNCS,
 };
 
+/* Layout of the shared-memory export (GALLIUM_HUD_SHMEM=<file>).
+ *
+ * The file starts with hud_shm_header followed by num_graphs
+ * hud_shm_graph records. Each graph is a single-writer ring: the HUD
+ * writes the newest value into ring[(head + 1) % HUD_SHM_RING_SIZE],
+ * updates avg (an exponential moving average of the raw values) and
+ * then publishes both with a release store to head. A reader mapping
+ * the file loads head with an acquire load, reads the slots it wants,
+ * and loads head again to detect being overtaken. head increases
+ * monotonically; magic is written last during setup, so a reader that
+ * sees it can also see the graph names.
+ *
+ * The header additionally carries a smoothed frame time, published the
+ * same way through the frame counter. It is the one backpressure signal
+ * resolution-scaling controllers should use: unlike the per-graph data
+ * it is always present, whatever GALLIUM_HUD selects.
+ */
+#define HUD_SHM_MAGIC     0x32445548 /* "HUD2" */
+#define HUD_SHM_RING_SIZE 64
+
+struct hud_shm_graph {
+   char name[128];
+   uint32_t head;
+   uint32_t pad;
+   double avg;
+   double ring[HUD_SHM_RING_SIZE];
+};
+
+struct hud_shm_header {
+   uint32_t magic;
+   uint32_t num_graphs;
+   uint32_t pid;
+   uint32_t frame;              /* publishes frametime_avg_ms */
+   double frametime_avg_ms;
+   struct hud_shm_graph graphs[];
+};
+
 struct hud_context {
    int refcount;
    bool simple;
@@ -92,6 +129,14 @@ struct hud_context {
    } text, bg, whitelines, color_prims;
 
    bool has_srgb;
+
+   /* shared-memory export (GALLIUM_HUD_SHMEM) */
+   struct hud_shm_header *shm;
+   size_t shm_size;
+   int64_t shm_last_time;
+
+   /* combined CSV dump (GALLIUM_HUD_CSV) */
+   FILE *csv_fd;
 };
 
 struct hud_graph {
@@ -113,7 +158,9 @@ struct hud_graph {
    unsigned num_vertices;
    unsigned index; /* vertex index being updated */
    double current_value;
+   double ema; /* smoothed value for the shared-memory export */
    FILE *fd;
+   struct hud_shm_graph *shm;
 };
 
 struct hud_pane {
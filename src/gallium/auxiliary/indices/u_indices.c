@@ -25,6 +25,12 @@
 #include "u_indices.h"
 #include "u_indices_priv.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define USE_X86_64_SIMD
+#include <tmmintrin.h>
+#include "util/u_cpu_detect.h"
+#endif
+
 static void translate_memcpy_ushort( const void *in,
                                      unsigned start,
                                      unsigned in_nr,
@@ -44,7 +50,213 @@ static void translate_memcpy_uint( const void *in,
 {
    memcpy(out, &((int *)in)[start], out_nr*sizeof(int));
 }
-                              
+
+
+#ifdef USE_X86_64_SIMD
+
+/* SIMD replacements for the hottest generated translators.  They are
+ * installed over the matching entries of the generated dispatch table by
+ * u_index_init_simd() and produce bit-identical output to the scalar loops
+ * they replace.  Only the no-restart, provoking-vertex-preserving variants
+ * are covered; the restart-enabled loops have data-dependent control flow
+ * and stay scalar.
+ */
+
+/**
+ * Elementwise ubyte->ushort widening, used for points/lines/tris (and the
+ * adjacency flavors) when the driver doesn't do byte indices.  SSE2 is
+ * baseline on x86-64, so this needs no CPU check.
+ */
+static void translate_elts_ubyte2ushort_simd( const void *_in,
+                                              unsigned start,
+                                              unsigned in_nr,
+                                              unsigned out_nr,
+                                              unsigned restart_index,
+                                              void *_out )
+{
+   const ubyte *in = (const ubyte*)_in;
+   ushort *out = (ushort*)_out;
+   const __m128i zero = _mm_setzero_si128();
+   unsigned i = start;
+   unsigned end = out_nr + start;
+
+   for (; i + 16 <= end; i += 16) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + i), _mm_unpacklo_epi8(v, zero));
+      _mm_storeu_si128((__m128i *)(out + i + 8), _mm_unpackhi_epi8(v, zero));
+   }
+   for (; i < end; i++)
+      out[i] = (ushort)in[i];
+}
+
+/**
+ * ushort tristrip->tris, first provoking vertex preserved.  Emits two
+ * triangles (six indices) per PSHUFB from the four input indices they
+ * share; the leftovers use the same scalar pattern as the generated loop.
+ */
+static void
+__attribute__((target("ssse3")))
+translate_tristrip_ushort_first_simd( const void *_in,
+                                      unsigned start,
+                                      unsigned in_nr,
+                                      unsigned out_nr,
+                                      unsigned restart_index,
+                                      void *_out )
+{
+   const ushort *in = (const ushort*)_in;
+   ushort *out = (ushort*)_out;
+   /* words i..i+3 -> (i, i+1, i+2), (i+1, i+3, i+2), two bytes of padding */
+   const __m128i shuf = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 2, 3, 6, 7, 4, 5,
+                                      -128, -128, -128, -128);
+   unsigned i = start;
+   unsigned j = 0;
+
+   /* The shuffle pairs an even with an odd triangle, so align first. */
+   if ((i & 1) && j < out_nr) {
+      out[j + 0] = in[i];
+      out[j + 1] = in[i + 2];
+      out[j + 2] = in[i + 1];
+      j += 3;
+      i++;
+   }
+
+   /* The store covers eight indices, so stop while all of them fit. */
+   for (; j + 8 <= out_nr; j += 6, i += 2) {
+      __m128i v = _mm_loadl_epi64((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + j), _mm_shuffle_epi8(v, shuf));
+   }
+
+   for (; j < out_nr; j += 3, i++) {
+      out[j + 0] = in[i];
+      out[j + 1] = in[i + 1 + (i & 1)];
+      out[j + 2] = in[i + 2 - (i & 1)];
+   }
+}
+
+/**
+ * ushort tristrip->tris, last provoking vertex preserved.
+ */
+static void
+__attribute__((target("ssse3")))
+translate_tristrip_ushort_last_simd( const void *_in,
+                                     unsigned start,
+                                     unsigned in_nr,
+                                     unsigned out_nr,
+                                     unsigned restart_index,
+                                     void *_out )
+{
+   const ushort *in = (const ushort*)_in;
+   ushort *out = (ushort*)_out;
+   /* words i..i+3 -> (i, i+1, i+2), (i+2, i+1, i+3), two bytes of padding */
+   const __m128i shuf = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 4, 5, 2, 3, 6, 7,
+                                      -128, -128, -128, -128);
+   unsigned i = start;
+   unsigned j = 0;
+
+   if ((i & 1) && j < out_nr) {
+      out[j + 0] = in[i + 1];
+      out[j + 1] = in[i];
+      out[j + 2] = in[i + 2];
+      j += 3;
+      i++;
+   }
+
+   for (; j + 8 <= out_nr; j += 6, i += 2) {
+      __m128i v = _mm_loadl_epi64((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + j), _mm_shuffle_epi8(v, shuf));
+   }
+
+   for (; j < out_nr; j += 3, i++) {
+      out[j + 0] = in[i + (i & 1)];
+      out[j + 1] = in[i + 1 - (i & 1)];
+      out[j + 2] = in[i + 2];
+   }
+}
+
+/**
+ * ushort trifan->tris.  When the provoking vertex convention is preserved
+ * the generated loop emits (center, i+1, i+2) for either convention, so
+ * one kernel serves both table slots.  The constant fan center is OR'ed
+ * into the shuffled zero lanes.
+ */
+static void
+__attribute__((target("ssse3")))
+translate_trifan_ushort_simd( const void *_in,
+                                    unsigned start,
+                                    unsigned in_nr,
+                                    unsigned out_nr,
+                                    unsigned restart_index,
+                                    void *_out )
+{
+   const ushort *in = (const ushort*)_in;
+   ushort *out = (ushort*)_out;
+   /* words i..i+3 -> (center, i+1, i+2), (center, i+2, i+3) */
+   const __m128i shuf = _mm_setr_epi8(-128, -128, 2, 3, 4, 5,
+                                      -128, -128, 4, 5, 6, 7,
+                                      -128, -128, -128, -128);
+   const __m128i center = _mm_setr_epi16(in[start], 0, 0, in[start],
+                                         0, 0, 0, 0);
+   unsigned i = start;
+   unsigned j = 0;
+
+   for (; j + 8 <= out_nr; j += 6, i += 2) {
+      __m128i v = _mm_loadl_epi64((const __m128i *)(in + i));
+      _mm_storeu_si128((__m128i *)(out + j),
+                       _mm_or_si128(_mm_shuffle_epi8(v, shuf), center));
+   }
+
+   for (; j < out_nr; j += 3, i++) {
+      out[j + 0] = in[start];
+      out[j + 1] = in[i + 1];
+      out[j + 2] = in[i + 2];
+   }
+}
+
+/**
+ * Overwrite the generated table entries whose SIMD replacements above are
+ * usable on this CPU.  Runs once, right after u_index_init().
+ */
+static void u_index_init_simd( void )
+{
+   static const enum pipe_prim_type elt_prims[] = {
+      PIPE_PRIM_POINTS,
+      PIPE_PRIM_LINES,
+      PIPE_PRIM_TRIANGLES,
+      PIPE_PRIM_LINES_ADJACENCY,
+      PIPE_PRIM_TRIANGLES_ADJACENCY
+   };
+   static int firsttime = 1;
+   unsigned i, pv;
+
+   if (!firsttime)
+      return;
+   firsttime = 0;
+
+   /* These translators copy indices through unchanged, so they are the
+    * same function for either preserved provoking vertex convention.
+    */
+   for (i = 0; i < ARRAY_SIZE(elt_prims); i++) {
+      for (pv = 0; pv < PV_COUNT; pv++) {
+         translate[IN_UBYTE][OUT_USHORT][pv][pv][PR_DISABLE][elt_prims[i]] =
+            translate_elts_ubyte2ushort_simd;
+      }
+   }
+
+   util_cpu_detect();
+   if (util_cpu_caps.has_ssse3) {
+      translate[IN_USHORT][OUT_USHORT][PV_FIRST][PV_FIRST][PR_DISABLE]
+               [PIPE_PRIM_TRIANGLE_STRIP] = translate_tristrip_ushort_first_simd;
+      translate[IN_USHORT][OUT_USHORT][PV_LAST][PV_LAST][PR_DISABLE]
+               [PIPE_PRIM_TRIANGLE_STRIP] = translate_tristrip_ushort_last_simd;
+      translate[IN_USHORT][OUT_USHORT][PV_FIRST][PV_FIRST][PR_DISABLE]
+               [PIPE_PRIM_TRIANGLE_FAN] = translate_trifan_ushort_simd;
+      translate[IN_USHORT][OUT_USHORT][PV_LAST][PV_LAST][PR_DISABLE]
+               [PIPE_PRIM_TRIANGLE_FAN] = translate_trifan_ushort_simd;
+   }
+}
+
+#endif /* USE_X86_64_SIMD */
+
 
 /**
  * Translate indexes when a driver can't support certain types
@@ -92,6 +304,9 @@ u_index_translator(unsigned hw_mask,
           in_index_size == 4);
 
    u_index_init();
+#ifdef USE_X86_64_SIMD
+   u_index_init_simd();
+#endif
 
    in_idx = in_size_idx(in_index_size);
    *out_index_size = (in_index_size == 4) ? 4 : 2;
@@ -22,7 +22,9 @@
  * IN THE SOFTWARE.
  */
 
+#include "util/hash_table.h"
 #include "util/ralloc.h"
+#include "c11/threads.h"
 #include "pipe/p_screen.h"
 
 #include "compiler/nir/nir.h"
@@ -2115,18 +2117,109 @@ ttn_finalize_nir(struct ttn_compile *c)
    nir_validate_shader(nir, "TTN: after all optimizations");
 }
 
+/* Cache of finished translations, shared by all contexts in the process.
+ * Multi-context apps (and state trackers recreating CSOs) hand us the same
+ * token streams over and over; cloning a cached shader is much cheaper than
+ * re-running the translation and the optimization loop in ttn_finalize_nir.
+ *
+ * The output only depends on the token stream, the compiler options and the
+ * caps read in ttn_read_pipe_caps, so those make up the key.  We deliberately
+ * don't key on the screen pointer itself: it could be reused by a new screen
+ * after destruction, and the options pointer (a static per-driver struct) plus
+ * the cap bits capture everything the screen contributes.  Entries are never
+ * evicted; the cache is bounded by the number of distinct shaders translated
+ * by the process and lives until exit.
+ */
+struct ttn_cache_entry {
+   const nir_shader_compiler_options *options;
+   uint32_t caps;
+   uint32_t size;
+   void *tokens;
+   struct nir_shader *nir;
+};
+
+static struct hash_table *ttn_cache;
+static mtx_t ttn_cache_mutex = _MTX_INITIALIZER_NP;
+
+static uint32_t
+ttn_cache_hash(const void *data)
+{
+   const struct ttn_cache_entry *e = data;
+
+   return _mesa_hash_data(e->tokens, e->size) ^
+          _mesa_hash_pointer(e->options) ^ e->caps;
+}
+
+static bool
+ttn_cache_equals(const void *a_, const void *b_)
+{
+   const struct ttn_cache_entry *a = a_;
+   const struct ttn_cache_entry *b = b_;
+
+   return a->options == b->options &&
+          a->caps == b->caps &&
+          a->size == b->size &&
+          memcmp(a->tokens, b->tokens, a->size) == 0;
+}
+
+static uint32_t
+ttn_screen_caps(struct pipe_screen *screen, enum pipe_shader_type processor)
+{
+   /* Matches the caps read in ttn_read_pipe_caps. */
+   return (screen->get_shader_param(screen, processor,
+                                    PIPE_SHADER_CAP_SCALAR_ISA) ? 1 << 0 : 0) |
+          (screen->get_param(screen, PIPE_CAP_PACKED_UNIFORMS) ? 1 << 1 : 0) |
+          (screen->get_param(screen, PIPE_CAP_NIR_SAMPLERS_AS_DEREF) ? 1 << 2 : 0) |
+          (screen->get_param(screen, PIPE_CAP_TGSI_FS_FACE_IS_INTEGER_SYSVAL) ? 1 << 3 : 0) |
+          (screen->get_param(screen, PIPE_CAP_TGSI_FS_POSITION_IS_SYSVAL) ? 1 << 4 : 0);
+}
+
 struct nir_shader *
 tgsi_to_nir(const void *tgsi_tokens,
             struct pipe_screen *screen)
 {
    struct ttn_compile *c;
    struct nir_shader *s;
+   enum pipe_shader_type processor = tgsi_get_processor_type(tgsi_tokens);
+   struct ttn_cache_entry key = {
+      .options = screen->get_compiler_options(screen, PIPE_SHADER_IR_NIR,
+                                              processor),
+      .caps = ttn_screen_caps(screen, processor),
+      .size = tgsi_num_tokens(tgsi_tokens) * sizeof(struct tgsi_token),
+      .tokens = (void *)tgsi_tokens,
+   };
+
+   mtx_lock(&ttn_cache_mutex);
+   if (!ttn_cache)
+      ttn_cache = _mesa_hash_table_create(NULL, ttn_cache_hash,
+                                          ttn_cache_equals);
+   struct hash_entry *he = _mesa_hash_table_search(ttn_cache, &key);
+   if (he) {
+      /* Callers own and mutate the shader they get, so hand out a clone and
+       * keep the cached master untouched.
+       */
+      s = nir_shader_clone(NULL, ((struct ttn_cache_entry *)he->key)->nir);
+      mtx_unlock(&ttn_cache_mutex);
+      return s;
+   }
+   mtx_unlock(&ttn_cache_mutex);
 
    c = ttn_compile_init(tgsi_tokens, NULL, screen);
    s = c->build.shader;
    ttn_finalize_nir(c);
    ralloc_free(c);
 
+   mtx_lock(&ttn_cache_mutex);
+   if (!_mesa_hash_table_search(ttn_cache, &key)) {
+      struct ttn_cache_entry *entry = ralloc(ttn_cache, struct ttn_cache_entry);
+      *entry = key;
+      entry->tokens = ralloc_size(entry, key.size);
+      memcpy(entry->tokens, tgsi_tokens, key.size);
+      entry->nir = nir_shader_clone(entry, s);
+      _mesa_hash_table_insert(ttn_cache, entry, entry);
+   }
+   mtx_unlock(&ttn_cache_mutex);
+
    return s;
 }
 
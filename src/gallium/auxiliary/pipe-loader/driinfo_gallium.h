@@ -5,6 +5,9 @@ DRI_CONF_SECTION_PERFORMANCE
    DRI_CONF_DISABLE_EXT_BUFFER_AGE("false")
    DRI_CONF_DISABLE_OML_SYNC_CONTROL("false")
    DRI_CONF_DISABLE_SGI_VIDEO_SYNC("false")
+   DRI_CONF_BLOCK_ON_DEPLETED_BUFFERS("false")
+   DRI_CONF_MAX_FRAMES_IN_FLIGHT(0)
+   DRI_CONF_THROTTLE_AT_FIRST_DRAW("false")
 DRI_CONF_SECTION_END
 
 DRI_CONF_SECTION_QUALITY
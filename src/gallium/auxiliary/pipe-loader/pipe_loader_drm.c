@@ -243,8 +243,37 @@ open_drm_render_node_minor(int minor)
 int
 pipe_loader_drm_probe(struct pipe_loader_device **devs, int ndev)
 {
+   const char *path;
    int i, j, fd;
 
+   /* GALLIUM_DRM_DEVICE selects a single render node explicitly, which is
+    * the only way to pick a specific GPU on multi-GPU systems where the
+    * render node minors enumerate in an arbitrary order.
+    */
+   path = debug_get_option("GALLIUM_DRM_DEVICE", NULL);
+   if (path) {
+      struct pipe_loader_device *dev;
+
+      fd = loader_open_device(path);
+      if (fd < 0) {
+         fprintf(stderr, "pipe_loader: failed to open %s\n", path);
+         return 0;
+      }
+
+      if (!pipe_loader_drm_probe_fd_nodup(&dev, fd)) {
+         close(fd);
+         return 0;
+      }
+
+      if (ndev > 0) {
+         devs[0] = dev;
+      } else {
+         close(fd);
+         dev->ops->release(&dev);
+      }
+      return 1;
+   }
+
    for (i = DRM_RENDER_NODE_MIN_MINOR, j = 0;
         i <= DRM_RENDER_NODE_MAX_MINOR; i++) {
       struct pipe_loader_device *dev;
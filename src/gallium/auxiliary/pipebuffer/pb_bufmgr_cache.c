@@ -65,6 +65,28 @@ struct pb_cache_manager
 };
 
 
+/**
+ * Unused buffers are kept in power-of-two size classes so that a reclaim
+ * only scans buffers which could actually satisfy the request, instead of
+ * every buffer in the cache.  The first class holds buffers up to 4 KB,
+ * the last one everything from 4 MB up.
+ */
+#define PB_CACHE_MIN_BUCKET_SIZE_LOG2 12
+#define PB_CACHE_NUM_BUCKETS 12
+
+
+static unsigned
+pb_cache_manager_bucket_index(pb_size size)
+{
+   unsigned i = 0;
+
+   while (i < PB_CACHE_NUM_BUCKETS - 1 &&
+          size > ((pb_size)1 << (PB_CACHE_MIN_BUCKET_SIZE_LOG2 + i)))
+      i++;
+   return i;
+}
+
+
 static inline struct pb_cache_buffer *
 pb_cache_buffer(struct pb_buffer *buf)
 {
@@ -205,11 +227,19 @@ pb_cache_manager_create_buffer(struct pb_manager *_mgr,
 {
    struct pb_cache_manager *mgr = pb_cache_manager(_mgr);
    struct pb_cache_buffer *buf;
+   unsigned bucket = pb_cache_manager_bucket_index(size);
 
-   /* get a buffer from the cache */
+   /* Get a buffer from the cache.  A buffer within size_factor of the
+    * request may also sit in the next size class, so probe that one too.
+    */
    buf = (struct pb_cache_buffer *)
          pb_cache_reclaim_buffer(&mgr->cache, size, desc->alignment,
-                                 desc->usage, 0);
+                                 desc->usage, bucket);
+   if (!buf && bucket + 1 < PB_CACHE_NUM_BUCKETS) {
+      buf = (struct pb_cache_buffer *)
+            pb_cache_reclaim_buffer(&mgr->cache, size, desc->alignment,
+                                    desc->usage, bucket + 1);
+   }
    if (buf)
       return &buf->base;
 
@@ -242,7 +272,11 @@ pb_cache_manager_create_buffer(struct pb_manager *_mgr,
    
    buf->base.vtbl = &pb_cache_buffer_vtbl;
    buf->mgr = mgr;
-   pb_cache_init_entry(&mgr->cache, &buf->cache_entry, &buf->base, 0);
+   /* Bucket by the actual size: the provider may have rounded up, and
+    * reclaim compares against the real buffer size.
+    */
+   pb_cache_init_entry(&mgr->cache, &buf->cache_entry, &buf->base,
+                       pb_cache_manager_bucket_index(buf->base.size));
    
    return &buf->base;
 }
@@ -304,7 +338,8 @@ pb_cache_manager_create(struct pb_manager *provider,
    mgr->base.create_buffer = pb_cache_manager_create_buffer;
    mgr->base.flush = pb_cache_manager_flush;
    mgr->provider = provider;
-   pb_cache_init(&mgr->cache, 1, usecs, size_factor, bypass_usage,
+   pb_cache_init(&mgr->cache, PB_CACHE_NUM_BUCKETS, usecs, size_factor,
+                 bypass_usage,
                  maximum_cache_size,
                  _pb_cache_buffer_destroy,
                  pb_cache_can_reclaim_buffer);
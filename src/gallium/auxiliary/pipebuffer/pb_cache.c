@@ -27,10 +27,29 @@
  **************************************************************************/
 
 #include "pb_cache.h"
+#include "util/u_math.h"
 #include "util/u_memory.h"
 #include "util/os_time.h"
 
 
+/**
+ * Size class of a buffer: power-of-two classes starting at 4 KB.  Keeping
+ * sizes apart means a reclaim only scans entries that can actually satisfy
+ * the request instead of walking one long mixed-size list.
+ */
+static unsigned
+pb_cache_size_class(pb_size size)
+{
+   return MIN2(util_logbase2(size / 4096), PB_CACHE_SIZE_CLASSES - 1);
+}
+
+static struct list_head *
+pb_cache_get_bucket(struct pb_cache *mgr, unsigned bucket_index,
+                    unsigned size_class)
+{
+   return &mgr->buckets[bucket_index * PB_CACHE_SIZE_CLASSES + size_class];
+}
+
 /**
  * Actually destroy the buffer.
  */
@@ -83,8 +102,10 @@ void
 pb_cache_add_buffer(struct pb_cache_entry *entry)
 {
    struct pb_cache *mgr = entry->mgr;
-   struct list_head *cache = &mgr->buckets[entry->bucket_index];
    struct pb_buffer *buf = entry->buffer;
+   struct list_head *cache =
+      pb_cache_get_bucket(mgr, entry->bucket_index,
+                          pb_cache_size_class(buf->size));
    unsigned i;
 
    mtx_lock(&mgr->mutex);
@@ -92,7 +113,7 @@ pb_cache_add_buffer(struct pb_cache_entry *entry)
 
    int64_t current_time = os_time_get();
 
-   for (i = 0; i < mgr->num_heaps; i++)
+   for (i = 0; i < mgr->num_heaps * PB_CACHE_SIZE_CLASSES; i++)
       release_expired_buffers_locked(&mgr->buckets[i], current_time);
 
    /* Directly release any buffer that exceeds the limit. */
@@ -140,31 +161,24 @@ pb_cache_is_buffer_compat(struct pb_cache_entry *entry,
 }
 
 /**
- * Find a compatible buffer in the cache, return it, and remove it
- * from the cache.
+ * Find a compatible buffer in the given list and remove expired buffers
+ * along the way.
  */
-struct pb_buffer *
-pb_cache_reclaim_buffer(struct pb_cache *mgr, pb_size size,
-                        unsigned alignment, unsigned usage,
-                        unsigned bucket_index)
+static struct pb_cache_entry *
+reclaim_from_list_locked(struct pb_cache *mgr, struct list_head *cache,
+                         pb_size size, unsigned alignment, unsigned usage,
+                         int64_t now)
 {
    struct pb_cache_entry *entry;
    struct pb_cache_entry *cur_entry;
    struct list_head *cur, *next;
-   int64_t now;
    int ret = 0;
 
-   assert(bucket_index < mgr->num_heaps);
-   struct list_head *cache = &mgr->buckets[bucket_index];
-
-   mtx_lock(&mgr->mutex);
-
    entry = NULL;
    cur = cache->next;
    next = cur->next;
 
    /* search in the expired buffers, freeing them in the process */
-   now = os_time_get();
    while (cur != cache) {
       cur_entry = LIST_ENTRY(struct pb_cache_entry, cur, head);
 
@@ -203,6 +217,41 @@ pb_cache_reclaim_buffer(struct pb_cache *mgr, pb_size size,
       }
    }
 
+   return entry;
+}
+
+/**
+ * Find a compatible buffer in the cache, return it, and remove it
+ * from the cache.
+ */
+struct pb_buffer *
+pb_cache_reclaim_buffer(struct pb_cache *mgr, pb_size size,
+                        unsigned alignment, unsigned usage,
+                        unsigned bucket_index)
+{
+   struct pb_cache_entry *entry = NULL;
+   int64_t now;
+   unsigned cls;
+
+   assert(bucket_index < mgr->num_heaps);
+
+   /* Only the size classes that can hold a buffer within
+    * [size, size_factor * size] can satisfy the request.
+    */
+   unsigned first_class = pb_cache_size_class(size);
+   unsigned last_class =
+      pb_cache_size_class((pb_size)(mgr->size_factor * size));
+
+   mtx_lock(&mgr->mutex);
+
+   now = os_time_get();
+   for (cls = first_class; cls <= last_class && !entry; cls++) {
+      entry = reclaim_from_list_locked(mgr,
+                                       pb_cache_get_bucket(mgr, bucket_index,
+                                                           cls),
+                                       size, alignment, usage, now);
+   }
+
    /* found a compatible buffer, return it */
    if (entry) {
       struct pb_buffer *buf = entry->buffer;
@@ -231,7 +280,7 @@ pb_cache_release_all_buffers(struct pb_cache *mgr)
    unsigned i;
 
    mtx_lock(&mgr->mutex);
-   for (i = 0; i < mgr->num_heaps; i++) {
+   for (i = 0; i < mgr->num_heaps * PB_CACHE_SIZE_CLASSES; i++) {
       struct list_head *cache = &mgr->buckets[i];
 
       curr = cache->next;
@@ -285,11 +334,12 @@ pb_cache_init(struct pb_cache *mgr, uint num_heaps,
 {
    unsigned i;
 
-   mgr->buckets = CALLOC(num_heaps, sizeof(struct list_head));
+   mgr->buckets = CALLOC(num_heaps * PB_CACHE_SIZE_CLASSES,
+                         sizeof(struct list_head));
    if (!mgr->buckets)
       return;
 
-   for (i = 0; i < num_heaps; i++)
+   for (i = 0; i < num_heaps * PB_CACHE_SIZE_CLASSES; i++)
       LIST_INITHEAD(&mgr->buckets[i]);
 
    (void) mtx_init(&mgr->mutex, mtx_plain);
@@ -45,10 +45,16 @@ struct pb_cache_entry
    unsigned bucket_index;
 };
 
+/* The number of power-of-two size classes each bucket is subdivided into,
+ * so that a reclaim only scans entries of roughly the requested size.
+ */
+#define PB_CACHE_SIZE_CLASSES 10
+
 struct pb_cache
 {
    /* The cache is divided into buckets for minimizing cache misses.
     * The driver controls which buffer goes into which bucket.
+    * Internally, each bucket is further subdivided into size classes.
     */
    struct list_head *buckets;
 
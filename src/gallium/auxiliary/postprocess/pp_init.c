@@ -78,9 +78,41 @@ pp_init(struct pipe_context *pipe, const unsigned int *enabled,
       goto error;
    }
 
+   ppq->app_pipe = pipe;
+   ppq->async = debug_get_bool_option("PP_ASYNC", FALSE);
+   if (ppq->async) {
+      /* The filters run on a private context so that the worker thread
+       * never touches the application's context.
+       */
+      struct pipe_context *ppipe =
+         pipe->screen->context_create(pipe->screen, NULL, 0);
+      struct cso_context *pcso = ppipe ? cso_create_context(ppipe, 0) : NULL;
+
+      if (!pcso || !util_queue_init(&ppq->queue, "pp", 1, 1, 0)) {
+         if (pcso)
+            cso_destroy_context(pcso);
+         if (ppipe)
+            ppipe->destroy(ppipe);
+         pp_debug("Async context creation failed, staying synchronous.\n");
+         ppq->async = false;
+      } else {
+         util_queue_fence_init(&ppq->job_fence);
+         pipe = ppipe;
+         cso = pcso;
+      }
+   }
+
    ppq->p = pp_init_prog(ppq, pipe, cso);
    if (ppq->p == NULL) {
       pp_debug("pp_init_prog returned NULL.\n");
+      if (ppq->async) {
+         /* pp_free won't see the private context without ppq->p. */
+         cso_destroy_context(cso);
+         pipe->destroy(pipe);
+         util_queue_destroy(&ppq->queue);
+         util_queue_fence_destroy(&ppq->job_fence);
+         ppq->async = false;
+      }
       goto error;
    }
 
@@ -157,6 +189,9 @@ pp_free_fbos(struct pp_queue_t *ppq)
    }
    pipe_surface_reference(&ppq->stencils, NULL);
    pipe_resource_reference(&ppq->stencil, NULL);
+   pipe_resource_reference(&ppq->async_in, NULL);
+   pipe_resource_reference(&ppq->async_out, NULL);
+   ppq->async_valid = false;
 
    ppq->fbos_init = false;
 }
@@ -173,6 +208,19 @@ pp_free(struct pp_queue_t *ppq)
    if (!ppq)
       return;
 
+   /* Drain the worker before tearing anything down. */
+   if (ppq->async) {
+      util_queue_destroy(&ppq->queue);
+      util_queue_fence_destroy(&ppq->job_fence);
+
+      if (ppq->p) {
+         struct pipe_screen *screen = ppq->p->screen;
+
+         screen->fence_reference(screen, &ppq->in_fence, NULL);
+         screen->fence_reference(screen, &ppq->out_fence, NULL);
+      }
+   }
+
    pp_free_fbos(ppq);
 
    if (ppq->p) {
@@ -220,6 +268,12 @@ pp_free(struct pp_queue_t *ppq)
          }
       }
 
+      /* In async mode the filter context is ours, not the caller's. */
+      if (ppq->async && ppq->p->cso) {
+         cso_destroy_context(ppq->p->cso);
+         ppq->p->pipe->destroy(ppq->p->pipe);
+      }
+
       FREE(ppq->p);
    }
 
@@ -300,6 +354,14 @@ pp_init_fbos(struct pp_queue_t *ppq, unsigned int w,
          goto error;
    }
 
+   if (ppq->async) {
+      ppq->async_in = p->screen->resource_create(p->screen, &tmp_res);
+      ppq->async_out = p->screen->resource_create(p->screen, &tmp_res);
+
+      if (!ppq->async_in || !ppq->async_out)
+         goto error;
+   }
+
    tmp_res.bind = PIPE_BIND_DEPTH_STENCIL;
 
    tmp_res.format = p->surf.format = PIPE_FORMAT_S8_UINT_Z24_UNORM;
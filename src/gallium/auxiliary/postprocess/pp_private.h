@@ -31,6 +31,8 @@
 
 #include "postprocess.h"
 
+#include "util/u_queue.h"
+
 
 /**
  * Internal control details.
@@ -85,6 +87,22 @@ struct pp_queue_t
    struct pp_program *p;
 
    bool fbos_init;
+
+   /*
+    * Async mode (PP_ASYNC=true): the filter chain runs on a private
+    * context owned by a worker thread, one frame behind the application.
+    * p->pipe and p->cso then belong to the worker; app_pipe is the
+    * caller's context and is only used to copy frames in and out.
+    */
+   bool async;
+   struct pipe_context *app_pipe;
+   struct util_queue queue;             /* single worker thread */
+   struct util_queue_fence job_fence;
+   struct pipe_resource *async_in;      /* copy of the app frame */
+   struct pipe_resource *async_out;     /* filtered result, one frame old */
+   struct pipe_fence_handle *in_fence;  /* copy to async_in done */
+   struct pipe_fence_handle *out_fence; /* filter chain done */
+   bool async_valid;                    /* async_out holds a frame */
 };
 
 
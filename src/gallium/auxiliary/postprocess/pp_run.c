@@ -74,6 +74,143 @@ pp_blit(struct pipe_context *pipe,
    pipe->blit(pipe, &blit);
 }
 
+/**
+*	Run the requested filters in order, shuffling the temp buffers
+*	in between.
+*/
+static void
+pp_run_filters(struct pp_queue_t *ppq, struct pipe_resource *in,
+               struct pipe_resource *out)
+{
+   unsigned int i;
+
+   switch (ppq->n_filters) {
+   case 0:
+      /* Failsafe, but never reached. */
+      break;
+   case 1:                     /* No temp buf */
+      ppq->pp_queue[0] (ppq, in, out, 0);
+      break;
+   case 2:                     /* One temp buf */
+
+      ppq->pp_queue[0] (ppq, in, ppq->tmp[0], 0);
+      ppq->pp_queue[1] (ppq, ppq->tmp[0], out, 1);
+
+      break;
+   default:                    /* Two temp bufs */
+      assert(ppq->tmp[1]);
+      ppq->pp_queue[0] (ppq, in, ppq->tmp[0], 0);
+
+      for (i = 1; i < (ppq->n_filters - 1); i++) {
+         if (i % 2 == 0)
+            ppq->pp_queue[i] (ppq, ppq->tmp[1], ppq->tmp[0], i);
+
+         else
+            ppq->pp_queue[i] (ppq, ppq->tmp[0], ppq->tmp[1], i);
+      }
+
+      if (i % 2 == 0)
+         ppq->pp_queue[i] (ppq, ppq->tmp[1], out, i);
+
+      else
+         ppq->pp_queue[i] (ppq, ppq->tmp[0], out, i);
+
+      break;
+   }
+}
+
+/** Copy a full frame between two equally sized resources. */
+static void
+pp_copy_frame(struct pipe_context *pipe, struct pipe_resource *src,
+              struct pipe_resource *dst)
+{
+   struct pipe_blit_info blit;
+
+   memset(&blit, 0, sizeof(blit));
+
+   blit.src.resource = src;
+   blit.src.format = src->format;
+   blit.src.box.width = src->width0;
+   blit.src.box.height = src->height0;
+   blit.src.box.depth = 1;
+
+   blit.dst.resource = dst;
+   blit.dst.format = dst->format;
+   blit.dst.box.width = src->width0;
+   blit.dst.box.height = src->height0;
+   blit.dst.box.depth = 1;
+
+   blit.mask = PIPE_MASK_RGBA;
+
+   pipe->blit(pipe, &blit);
+}
+
+/** Worker thread: run the whole chain on the private context. */
+static void
+pp_run_job(void *job, int thread_index)
+{
+   struct pp_queue_t *ppq = job;
+   struct pipe_screen *screen = ppq->p->screen;
+   struct cso_context *cso = ppq->p->cso;
+
+   /* Wait for the copy of the app frame to reach the GPU. */
+   screen->fence_finish(screen, NULL, ppq->in_fence, PIPE_TIMEOUT_INFINITE);
+   screen->fence_reference(screen, &ppq->in_fence, NULL);
+
+   /* The context is ours alone; just set the default state. */
+   cso_set_sample_mask(cso, ~0);
+   cso_set_min_samples(cso, 1);
+   cso_set_stream_outputs(cso, 0, NULL, NULL);
+   cso_set_tessctrl_shader_handle(cso, NULL);
+   cso_set_tesseval_shader_handle(cso, NULL);
+   cso_set_geometry_shader_handle(cso, NULL);
+   cso_set_render_condition(cso, NULL, FALSE, 0);
+
+   pp_run_filters(ppq, ppq->async_in, ppq->async_out);
+
+   ppq->p->pipe->flush(ppq->p->pipe, &ppq->out_fence, 0);
+}
+
+/**
+*	Async mode: show the previous frame's filtered output, then hand a
+*	copy of this frame to the worker.  Filtering overlaps with the
+*	application's next frame at the cost of one frame of latency.
+*/
+static void
+pp_run_async(struct pp_queue_t *ppq, struct pipe_resource *in,
+             struct pipe_resource *out)
+{
+   struct pipe_context *pipe = ppq->app_pipe;
+   struct pipe_screen *screen = ppq->p->screen;
+
+   /* Wait out the previous job before touching the shared buffers. */
+   util_queue_fence_wait(&ppq->job_fence);
+
+   if (in->width0 != ppq->p->framebuffer.width ||
+       in->height0 != ppq->p->framebuffer.height) {
+      pp_debug("Resizing the temp pp buffers\n");
+      pp_free_fbos(ppq);
+      pp_init_fbos(ppq, in->width0, in->height0);
+   }
+
+   if (!ppq->async_in || !ppq->async_out)
+      return;
+
+   if (ppq->async_valid) {
+      screen->fence_finish(screen, NULL, ppq->out_fence,
+                           PIPE_TIMEOUT_INFINITE);
+      screen->fence_reference(screen, &ppq->out_fence, NULL);
+
+      pp_copy_frame(pipe, ppq->async_out, out);
+   }
+
+   pp_copy_frame(pipe, in, ppq->async_in);
+   pipe->flush(pipe, &ppq->in_fence, 0);
+
+   util_queue_add_job(&ppq->queue, ppq, &ppq->job_fence, pp_run_job, NULL);
+   ppq->async_valid = true;
+}
+
 /**
 *	Main run function of the PP queue. Called on swapbuffers/flush.
 *
@@ -85,13 +222,22 @@ pp_run(struct pp_queue_t *ppq, struct pipe_resource *in,
        struct pipe_resource *out, struct pipe_resource *indepth)
 {
    struct pipe_resource *refin = NULL, *refout = NULL;
-   unsigned int i;
    struct cso_context *cso = ppq->p->cso;
 
    if (ppq->n_filters == 0)
       return;
 
    assert(ppq->pp_queue);
+
+   if (ppq->async) {
+      /* The worker reading the app's live depth buffer would race with
+       * the next frame, so indepth stays unused here and depth-based
+       * MLAA falls back to color edge detection.
+       */
+      pp_run_async(ppq, in, out);
+      return;
+   }
+
    assert(ppq->tmp[0]);
 
    if (in->width0 != ppq->p->framebuffer.width ||
@@ -152,39 +298,7 @@ pp_run(struct pp_queue_t *ppq, struct pipe_resource *in,
    pipe_resource_reference(&refin, in);
    pipe_resource_reference(&refout, out);
 
-   switch (ppq->n_filters) {
-   case 0:
-      /* Failsafe, but never reached. */
-      break;
-   case 1:                     /* No temp buf */
-      ppq->pp_queue[0] (ppq, in, out, 0);
-      break;
-   case 2:                     /* One temp buf */
-
-      ppq->pp_queue[0] (ppq, in, ppq->tmp[0], 0);
-      ppq->pp_queue[1] (ppq, ppq->tmp[0], out, 1);
-
-      break;
-   default:                    /* Two temp bufs */
-      assert(ppq->tmp[1]);
-      ppq->pp_queue[0] (ppq, in, ppq->tmp[0], 0);
-
-      for (i = 1; i < (ppq->n_filters - 1); i++) {
-         if (i % 2 == 0)
-            ppq->pp_queue[i] (ppq, ppq->tmp[1], ppq->tmp[0], i);
-
-         else
-            ppq->pp_queue[i] (ppq, ppq->tmp[0], ppq->tmp[1], i);
-      }
-
-      if (i % 2 == 0)
-         ppq->pp_queue[i] (ppq, ppq->tmp[1], out, i);
-
-      else
-         ppq->pp_queue[i] (ppq, ppq->tmp[0], out, i);
-
-      break;
-   }
+   pp_run_filters(ppq, in, out);
 
    /* restore state we changed */
    cso_restore_state(cso);
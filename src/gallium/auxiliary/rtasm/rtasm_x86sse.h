@@ -253,6 +253,11 @@ void sse2_punpcklwd( struct x86_function *p, struct x86_reg dst, struct x86_reg
 void sse2_punpckldq( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
 void sse2_punpcklqdq( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
 
+void sse4_1_pmovzxbd( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
+void sse4_1_pmovzxwd( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
+void sse4_1_pmovsxbd( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
+void sse4_1_pmovsxwd( struct x86_function *p, struct x86_reg dst, struct x86_reg src );
+
 void sse2_psllw_imm( struct x86_function *p, struct x86_reg dst, unsigned imm );
 void sse2_pslld_imm( struct x86_function *p, struct x86_reg dst, unsigned imm );
 void sse2_psllq_imm( struct x86_function *p, struct x86_reg dst, unsigned imm );
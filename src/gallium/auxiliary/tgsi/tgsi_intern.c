@@ -0,0 +1,192 @@
+/**************************************************************************
+ *
+ * Copyright 2019 VMware, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL VMWARE AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+#include <string.h>
+
+#include "os/os_thread.h"
+#include "util/hash_table.h"
+#include "util/u_memory.h"
+
+#include "tgsi_intern.h"
+#include "tgsi_parse.h"
+
+struct tgsi_token_entry {
+   struct tgsi_token *tokens;
+   uint32_t hash;
+   unsigned refcount;
+};
+
+struct tgsi_token_pool {
+   mtx_t mutex;
+   /* maps the canonical token stream to its tgsi_token_entry */
+   struct hash_table *table;
+};
+
+
+static uint32_t
+token_stream_hash(const struct tgsi_token *tokens)
+{
+   return _mesa_hash_data(tokens, tgsi_num_tokens(tokens) * sizeof(*tokens));
+}
+
+
+static bool
+token_stream_equal(const void *a, const void *b)
+{
+   const struct tgsi_token *ta = a;
+   const struct tgsi_token *tb = b;
+   const unsigned na = tgsi_num_tokens(ta);
+
+   return na == tgsi_num_tokens(tb) &&
+          memcmp(ta, tb, na * sizeof(*ta)) == 0;
+}
+
+
+struct tgsi_token_pool *
+tgsi_token_pool_create(void)
+{
+   struct tgsi_token_pool *pool = CALLOC_STRUCT(tgsi_token_pool);
+
+   if (!pool)
+      return NULL;
+
+   pool->table = _mesa_hash_table_create(NULL, NULL, token_stream_equal);
+   if (!pool->table) {
+      FREE(pool);
+      return NULL;
+   }
+
+   (void) mtx_init(&pool->mutex, mtx_plain);
+   return pool;
+}
+
+
+void
+tgsi_token_pool_destroy(struct tgsi_token_pool *pool)
+{
+   /* Entries may be left if shader CSOs leaked; free them along with
+    * the pool.
+    */
+   hash_table_foreach(pool->table, he) {
+      struct tgsi_token_entry *entry = he->data;
+
+      tgsi_free_tokens(entry->tokens);
+      FREE(entry);
+   }
+   _mesa_hash_table_destroy(pool->table, NULL);
+   mtx_destroy(&pool->mutex);
+   FREE(pool);
+}
+
+
+/**
+ * Return a refcounted canonical copy of the given token stream.
+ *
+ * The returned stream is read-only, shared with every other caller which
+ * interned an identical stream, and stays valid until released with
+ * tgsi_token_pool_release().  The caller's stream is not retained.
+ *
+ * \return the interned stream, or NULL on allocation failure.
+ */
+const struct tgsi_token *
+tgsi_token_pool_intern(struct tgsi_token_pool *pool,
+                       const struct tgsi_token *tokens)
+{
+   const uint32_t hash = token_stream_hash(tokens);
+   struct tgsi_token_entry *entry;
+   struct hash_entry *he;
+
+   mtx_lock(&pool->mutex);
+
+   he = _mesa_hash_table_search_pre_hashed(pool->table, hash, tokens);
+   if (he) {
+      entry = he->data;
+      entry->refcount++;
+      mtx_unlock(&pool->mutex);
+      return entry->tokens;
+   }
+
+   entry = MALLOC_STRUCT(tgsi_token_entry);
+   if (!entry)
+      goto fail;
+
+   entry->tokens = tgsi_dup_tokens(tokens);
+   if (!entry->tokens) {
+      FREE(entry);
+      goto fail;
+   }
+
+   entry->hash = hash;
+   entry->refcount = 1;
+
+   if (!_mesa_hash_table_insert_pre_hashed(pool->table, hash, entry->tokens,
+                                           entry)) {
+      tgsi_free_tokens(entry->tokens);
+      FREE(entry);
+      goto fail;
+   }
+
+   mtx_unlock(&pool->mutex);
+   return entry->tokens;
+
+fail:
+   mtx_unlock(&pool->mutex);
+   return NULL;
+}
+
+
+/**
+ * Drop a reference to an interned token stream, freeing the canonical
+ * copy when the last reference goes away.  NULL is accepted for the
+ * convenience of error paths.
+ */
+void
+tgsi_token_pool_release(struct tgsi_token_pool *pool,
+                        const struct tgsi_token *tokens)
+{
+   struct hash_entry *he;
+
+   if (!tokens)
+      return;
+
+   mtx_lock(&pool->mutex);
+
+   he = _mesa_hash_table_search_pre_hashed(pool->table,
+                                           token_stream_hash(tokens), tokens);
+   assert(he && he->key == tokens);
+   if (he) {
+      struct tgsi_token_entry *entry = he->data;
+
+      if (--entry->refcount == 0) {
+         _mesa_hash_table_remove(pool->table, he);
+         tgsi_free_tokens(entry->tokens);
+         FREE(entry);
+      }
+   }
+
+   mtx_unlock(&pool->mutex);
+}
@@ -0,0 +1,70 @@
+/**************************************************************************
+ *
+ * Copyright 2019 VMware, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL VMWARE AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+#ifndef TGSI_INTERN_H
+#define TGSI_INTERN_H
+
+/**
+ * Refcounted interning of TGSI token streams.
+ *
+ * Drivers which retain the tokens of every shader CSO keep one private
+ * copy per CSO, so identical shaders created across contexts (or simply
+ * created repeatedly by the application) duplicate their token streams.
+ * A tgsi_token_pool, typically one per screen, stores a single canonical
+ * read-only copy of each distinct stream and hands out refcounted
+ * pointers to it.
+ *
+ * The pool is internally locked, so it can be shared by all contexts of
+ * a screen.  Interned streams must be treated as immutable by callers.
+ */
+
+#if defined __cplusplus
+extern "C" {
+#endif
+
+struct tgsi_token;
+struct tgsi_token_pool;
+
+struct tgsi_token_pool *
+tgsi_token_pool_create(void);
+
+void
+tgsi_token_pool_destroy(struct tgsi_token_pool *pool);
+
+const struct tgsi_token *
+tgsi_token_pool_intern(struct tgsi_token_pool *pool,
+                       const struct tgsi_token *tokens);
+
+void
+tgsi_token_pool_release(struct tgsi_token_pool *pool,
+                        const struct tgsi_token *tokens);
+
+#if defined __cplusplus
+}
+#endif
+
+#endif /* TGSI_INTERN_H */
@@ -531,17 +531,27 @@ translate_attr_convert(struct translate_sse *p,
                            input_desc->channel[0].size *
                            input_desc->nr_channels >> 3);
 
-            /* TODO: add support for SSE4.1 pmovzx */
             switch (input_desc->channel[0].size) {
             case 8:
-               /* TODO: this may be inefficient due to get_identity() being
-                *  used both as a float and integer register.
-                */
-               sse2_punpcklbw(p->func, dataXMM, get_const(p, CONST_IDENTITY));
-               sse2_punpcklbw(p->func, dataXMM, get_const(p, CONST_IDENTITY));
+               if (x86_target_caps(p->func) & X86_SSE4_1) {
+                  sse4_1_pmovzxbd(p->func, dataXMM, dataXMM);
+               } else {
+                  /* TODO: this may be inefficient due to get_identity() being
+                   *  used both as a float and integer register.
+                   */
+                  sse2_punpcklbw(p->func, dataXMM,
+                                 get_const(p, CONST_IDENTITY));
+                  sse2_punpcklbw(p->func, dataXMM,
+                                 get_const(p, CONST_IDENTITY));
+               }
                break;
             case 16:
-               sse2_punpcklwd(p->func, dataXMM, get_const(p, CONST_IDENTITY));
+               if (x86_target_caps(p->func) & X86_SSE4_1) {
+                  sse4_1_pmovzxwd(p->func, dataXMM, dataXMM);
+               } else {
+                  sse2_punpcklwd(p->func, dataXMM,
+                                 get_const(p, CONST_IDENTITY));
+               }
                break;
             case 32:           /* we lose precision here */
                sse2_psrld_imm(p->func, dataXMM, 1);
@@ -583,16 +593,23 @@ translate_attr_convert(struct translate_sse *p,
                            input_desc->channel[0].size *
                            input_desc->nr_channels >> 3);
 
-            /* TODO: add support for SSE4.1 pmovsx */
             switch (input_desc->channel[0].size) {
             case 8:
-               sse2_punpcklbw(p->func, dataXMM, dataXMM);
-               sse2_punpcklbw(p->func, dataXMM, dataXMM);
-               sse2_psrad_imm(p->func, dataXMM, 24);
+               if (x86_target_caps(p->func) & X86_SSE4_1) {
+                  sse4_1_pmovsxbd(p->func, dataXMM, dataXMM);
+               } else {
+                  sse2_punpcklbw(p->func, dataXMM, dataXMM);
+                  sse2_punpcklbw(p->func, dataXMM, dataXMM);
+                  sse2_psrad_imm(p->func, dataXMM, 24);
+               }
                break;
             case 16:
-               sse2_punpcklwd(p->func, dataXMM, dataXMM);
-               sse2_psrad_imm(p->func, dataXMM, 16);
+               if (x86_target_caps(p->func) & X86_SSE4_1) {
+                  sse4_1_pmovsxwd(p->func, dataXMM, dataXMM);
+               } else {
+                  sse2_punpcklwd(p->func, dataXMM, dataXMM);
+                  sse2_psrad_imm(p->func, dataXMM, 16);
+               }
                break;
             case 32:           /* we lose precision here */
                break;
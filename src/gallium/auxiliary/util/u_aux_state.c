@@ -0,0 +1,144 @@
+/*
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "util/u_aux_state.h"
+#include "util/u_math.h"
+#include "util/u_memory.h"
+
+static uint8_t *
+aux_slice(const struct util_aux_state_tracker *aux, unsigned level, unsigned layer)
+{
+   assert(level < aux->levels);
+   assert(layer < aux->layers);
+   return &aux->state[level * aux->layers + layer];
+}
+
+boolean
+util_aux_state_init(struct util_aux_state_tracker *aux,
+                    unsigned levels, unsigned layers,
+                    enum util_aux_state initial)
+{
+   aux->levels = levels;
+   aux->layers = layers;
+   aux->state = MALLOC(levels * layers);
+   if (!aux->state)
+      return FALSE;
+
+   memset(aux->state, initial, levels * layers);
+   memset(&aux->clear_color, 0, sizeof(aux->clear_color));
+   return TRUE;
+}
+
+void
+util_aux_state_fini(struct util_aux_state_tracker *aux)
+{
+   FREE(aux->state);
+   aux->state = NULL;
+}
+
+void
+util_aux_state_set(struct util_aux_state_tracker *aux,
+                   unsigned level,
+                   unsigned first_layer, unsigned num_layers,
+                   enum util_aux_state state)
+{
+   assert(first_layer + num_layers <= aux->layers);
+   memset(aux_slice(aux, level, first_layer), state, num_layers);
+}
+
+enum util_aux_state
+util_aux_state_get(const struct util_aux_state_tracker *aux,
+                   unsigned level, unsigned layer)
+{
+   return (enum util_aux_state)*aux_slice(aux, level, layer);
+}
+
+/**
+ * Record a new fast-clear color.  Returns TRUE if it differs from the
+ * previous one, in which case slices in UTIL_AUX_STATE_CLEAR or
+ * UTIL_AUX_STATE_COMPRESSED_CLEAR still reference the old color and the
+ * driver has to resolve them (or rewrite the clear blocks) first.
+ */
+boolean
+util_aux_state_set_clear_color(struct util_aux_state_tracker *aux,
+                               const union pipe_color_union *color)
+{
+   if (memcmp(&aux->clear_color, color, sizeof(*color)) == 0)
+      return FALSE;
+
+   aux->clear_color = *color;
+   return TRUE;
+}
+
+/**
+ * Plan the resolves needed before an access that can handle states up to
+ * \p max_allowed (the enum is ordered from most to least compressed, so
+ * e.g. UTIL_AUX_STATE_COMPRESSED allows compressed data but no clear
+ * blocks, and UTIL_AUX_STATE_RESOLVED demands plain data).
+ *
+ * Consecutive layers of a level that all need the transition are merged
+ * into a single range so the driver can batch them into one resolve pass.
+ * Returns the number of ranges written; if more than \p max_ranges are
+ * needed the caller should retry with a bigger array (the full worst case
+ * is one range per level).
+ */
+unsigned
+util_aux_state_plan_resolves(const struct util_aux_state_tracker *aux,
+                             unsigned first_level, unsigned last_level,
+                             unsigned first_layer, unsigned last_layer,
+                             enum util_aux_state max_allowed,
+                             struct util_aux_resolve_range *ranges,
+                             unsigned max_ranges)
+{
+   unsigned num_ranges = 0;
+   unsigned level, layer;
+
+   last_level = MIN2(last_level, aux->levels - 1);
+   last_layer = MIN2(last_layer, aux->layers - 1);
+
+   for (level = first_level; level <= last_level; level++) {
+      struct util_aux_resolve_range *range = NULL;
+
+      for (layer = first_layer; layer <= last_layer; layer++) {
+         if (util_aux_state_get(aux, level, layer) >= max_allowed) {
+            range = NULL;
+            continue;
+         }
+
+         if (range && range->first_layer + range->num_layers == layer) {
+            range->num_layers++;
+            continue;
+         }
+
+         if (num_ranges == max_ranges)
+            return num_ranges;
+
+         range = &ranges[num_ranges++];
+         range->level = level;
+         range->first_layer = layer;
+         range->num_layers = 1;
+      }
+   }
+
+   return num_ranges;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef U_AUX_STATE_H
+#define U_AUX_STATE_H
+
+#include "pipe/p_state.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Shared bookkeeping for compressed/fast-cleared surfaces.
+ *
+ * Drivers with auxiliary surface data (fast-clear metadata, delta color
+ * compression, depth compression, ...) all need the same state machine:
+ * what state each (level, layer) is in, what the current fast-clear color
+ * is, and which slices have to be resolved before a given access.  This
+ * module keeps that per-slice state and plans the resolves; actually
+ * emitting the resolve passes stays in the driver.
+ *
+ * The intended use is:
+ *
+ *  1) util_aux_state_init() when the aux data is allocated
+ *  2) util_aux_state_set() after clears, rendering and resolve passes
+ *  3) before an access that can't handle some states (e.g. sampling
+ *     without fast-clear support), util_aux_state_plan_resolves() to get
+ *     the minimal set of merged slice ranges to resolve, emit one pass
+ *     per range, and mark the result with util_aux_state_set()
+ */
+
+enum util_aux_state {
+   /** entirely the fast-clear color, aux data may be all-clear blocks */
+   UTIL_AUX_STATE_CLEAR,
+   /** compressed and may still contain fast-clear blocks */
+   UTIL_AUX_STATE_COMPRESSED_CLEAR,
+   /** compressed, guaranteed free of fast-clear blocks */
+   UTIL_AUX_STATE_COMPRESSED,
+   /** plain data, aux contents are ignored */
+   UTIL_AUX_STATE_RESOLVED,
+};
+
+/** A run of layers of one level that needs a resolve pass. */
+struct util_aux_resolve_range {
+   unsigned level;
+   unsigned first_layer;
+   unsigned num_layers;
+};
+
+struct util_aux_state_tracker {
+   unsigned levels;
+   unsigned layers;
+   /** levels * layers entries of enum util_aux_state, layer-major */
+   uint8_t *state;
+   union pipe_color_union clear_color;
+};
+
+boolean util_aux_state_init(struct util_aux_state_tracker *aux,
+                            unsigned levels, unsigned layers,
+                            enum util_aux_state initial);
+
+void util_aux_state_fini(struct util_aux_state_tracker *aux);
+
+void util_aux_state_set(struct util_aux_state_tracker *aux,
+                        unsigned level,
+                        unsigned first_layer, unsigned num_layers,
+                        enum util_aux_state state);
+
+enum util_aux_state util_aux_state_get(const struct util_aux_state_tracker *aux,
+                                       unsigned level, unsigned layer);
+
+boolean util_aux_state_set_clear_color(struct util_aux_state_tracker *aux,
+                                       const union pipe_color_union *color);
+
+unsigned util_aux_state_plan_resolves(const struct util_aux_state_tracker *aux,
+                                      unsigned first_level,
+                                      unsigned last_level,
+                                      unsigned first_layer,
+                                      unsigned last_layer,
+                                      enum util_aux_state max_allowed,
+                                      struct util_aux_resolve_range *ranges,
+                                      unsigned max_ranges);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_AUX_STATE_H */
@@ -1805,17 +1805,22 @@ static void do_blits(struct blitter_context_priv *ctx,
    }
 }
 
-void util_blitter_blit_generic(struct blitter_context *blitter,
-                               struct pipe_surface *dst,
-                               const struct pipe_box *dstbox,
-                               struct pipe_sampler_view *src,
-                               const struct pipe_box *srcbox,
-                               unsigned src_width0, unsigned src_height0,
-                               unsigned mask, unsigned filter,
-                               const struct pipe_scissor_state *scissor,
-                               bool alpha_blend)
+/**
+ * The per-blit part of util_blitter_blit_generic: binds the states and
+ * draws the quad(s) for one blit. The caller is responsible for the
+ * save-state checks, the running flag, and the state restoration, which
+ * allows util_blitter_blit_batch to amortize those over many blits.
+ */
+static void blitter_blit_generic_one(struct blitter_context_priv *ctx,
+                                     struct pipe_surface *dst,
+                                     const struct pipe_box *dstbox,
+                                     struct pipe_sampler_view *src,
+                                     const struct pipe_box *srcbox,
+                                     unsigned src_width0, unsigned src_height0,
+                                     unsigned mask, unsigned filter,
+                                     const struct pipe_scissor_state *scissor,
+                                     bool alpha_blend)
 {
-   struct blitter_context_priv *ctx = (struct blitter_context_priv*)blitter;
    struct pipe_context *pipe = ctx->base.pipe;
    enum pipe_texture_target src_target = src->target;
    unsigned src_samples = src->texture->nr_samples;
@@ -1887,14 +1892,6 @@ void util_blitter_blit_generic(struct blitter_context *blitter,
          box.z + box.depth > 0 && box.z + box.depth <= src_depth;
    }
 
-   /* Check whether the states are properly saved. */
-   util_blitter_set_running_flag(blitter);
-   blitter_check_saved_vertex_states(ctx);
-   blitter_check_saved_fragment_states(ctx);
-   blitter_check_saved_textures(ctx);
-   blitter_check_saved_fb_state(ctx);
-   blitter_disable_render_cond(ctx);
-
    if (blit_depth || blit_stencil) {
       pipe->bind_blend_state(pipe, ctx->blend[0][0]);
 
@@ -1992,6 +1989,32 @@ void util_blitter_blit_generic(struct blitter_context *blitter,
 
    do_blits(ctx, dst, dstbox, src, src_width0, src_height0,
             srcbox, blit_depth || blit_stencil, use_txf);
+}
+
+void util_blitter_blit_generic(struct blitter_context *blitter,
+                               struct pipe_surface *dst,
+                               const struct pipe_box *dstbox,
+                               struct pipe_sampler_view *src,
+                               const struct pipe_box *srcbox,
+                               unsigned src_width0, unsigned src_height0,
+                               unsigned mask, unsigned filter,
+                               const struct pipe_scissor_state *scissor,
+                               bool alpha_blend)
+{
+   struct blitter_context_priv *ctx = (struct blitter_context_priv*)blitter;
+   struct pipe_context *pipe = ctx->base.pipe;
+
+   /* Check whether the states are properly saved. */
+   util_blitter_set_running_flag(blitter);
+   blitter_check_saved_vertex_states(ctx);
+   blitter_check_saved_fragment_states(ctx);
+   blitter_check_saved_textures(ctx);
+   blitter_check_saved_fb_state(ctx);
+   blitter_disable_render_cond(ctx);
+
+   blitter_blit_generic_one(ctx, dst, dstbox, src, srcbox,
+                            src_width0, src_height0, mask, filter,
+                            scissor, alpha_blend);
 
    util_blitter_restore_vertex_states(blitter);
    util_blitter_restore_fragment_states(blitter);
@@ -2004,6 +2027,77 @@ void util_blitter_blit_generic(struct blitter_context *blitter,
    util_blitter_unset_running_flag(blitter);
 }
 
+/**
+ * Perform one blit from a pipe_blit_info: set up the views and run the
+ * per-blit part of the generic path. Shared by util_blitter_blit and
+ * util_blitter_blit_batch.
+ */
+static void blitter_blit_info_one(struct blitter_context_priv *ctx,
+                                  const struct pipe_blit_info *info)
+{
+   struct pipe_resource *dst = info->dst.resource;
+   struct pipe_resource *src = info->src.resource;
+   struct pipe_context *pipe = ctx->base.pipe;
+   struct pipe_surface *dst_view, dst_templ;
+   struct pipe_sampler_view src_templ, *src_view;
+
+   /* Initialize the surface. */
+   util_blitter_default_dst_texture(&dst_templ, dst, info->dst.level,
+                                    info->dst.box.z);
+   dst_templ.format = info->dst.format;
+   dst_view = pipe->create_surface(pipe, dst, &dst_templ);
+
+   /* Initialize the sampler view. */
+   util_blitter_default_src_texture(&ctx->base, &src_templ, src,
+                                    info->src.level);
+   src_templ.format = info->src.format;
+   src_view = pipe->create_sampler_view(pipe, src, &src_templ);
+
+   /* Copy. */
+   blitter_blit_generic_one(ctx, dst_view, &info->dst.box,
+                            src_view, &info->src.box,
+                            src->width0, src->height0,
+                            info->mask, info->filter,
+                            info->scissor_enable ? &info->scissor : NULL,
+                            info->alpha_blend);
+
+   pipe_surface_reference(&dst_view, NULL);
+   pipe_sampler_view_reference(&src_view, NULL);
+}
+
+void util_blitter_blit_batch(struct blitter_context *blitter,
+                             const struct pipe_blit_info *info,
+                             unsigned num_blits)
+{
+   struct blitter_context_priv *ctx = (struct blitter_context_priv*)blitter;
+   struct pipe_context *pipe = ctx->base.pipe;
+   bool scissor_used = false;
+   unsigned i;
+
+   /* Check whether the states are properly saved. */
+   util_blitter_set_running_flag(blitter);
+   blitter_check_saved_vertex_states(ctx);
+   blitter_check_saved_fragment_states(ctx);
+   blitter_check_saved_textures(ctx);
+   blitter_check_saved_fb_state(ctx);
+   blitter_disable_render_cond(ctx);
+
+   for (i = 0; i < num_blits; i++) {
+      scissor_used |= info[i].scissor_enable;
+      blitter_blit_info_one(ctx, &info[i]);
+   }
+
+   util_blitter_restore_vertex_states(blitter);
+   util_blitter_restore_fragment_states(blitter);
+   util_blitter_restore_textures(blitter);
+   util_blitter_restore_fb_state(blitter);
+   if (scissor_used) {
+      pipe->set_scissor_states(pipe, 0, 1, &ctx->base.saved_scissor);
+   }
+   util_blitter_restore_render_cond(blitter);
+   util_blitter_unset_running_flag(blitter);
+}
+
 void
 util_blitter_blit(struct blitter_context *blitter,
                   const struct pipe_blit_info *info)
@@ -270,6 +270,18 @@ void util_blitter_blit_generic(struct blitter_context *blitter,
 void util_blitter_blit(struct blitter_context *blitter,
 		       const struct pipe_blit_info *info);
 
+/**
+ * Perform a sequence of blits with a single state save/restore cycle.
+ *
+ * This is equivalent to calling util_blitter_blit for each element of
+ * the info array, except that the saved states are only checked and
+ * restored once. Useful when many small regions are blitted back-to-back,
+ * e.g. the faces of a cube map or tiles of an atlas.
+ */
+void util_blitter_blit_batch(struct blitter_context *blitter,
+                             const struct pipe_blit_info *info,
+                             unsigned num_blits);
+
 void util_blitter_generate_mipmap(struct blitter_context *blitter,
                                   struct pipe_resource *tex,
                                   enum pipe_format format,
@@ -38,6 +38,7 @@
 #include "u_surface.h"
 #include "util/u_math.h"
 
+#include "pipe/p_config.h"
 #include "pipe/p_defines.h"
 
 
@@ -588,6 +589,68 @@ util_format_fits_8unorm(const struct util_format_description *format_desc)
 }
 
 
+#define UTIL_FORMAT_SHUFFLE_00 4
+#define UTIL_FORMAT_SHUFFLE_FF 5
+
+/**
+ * Compute the source byte feeding each destination byte when the two formats
+ * are mere byte shuffles of each other, i.e. both are 8888 variants of the
+ * same colorspace.  Each shuffle entry is a source byte index, or one of the
+ * UTIL_FORMAT_SHUFFLE_* constants for constant bytes.
+ *
+ * Returns FALSE if the conversion is not a pure shuffle.
+ */
+static boolean
+util_format_compute_shuffle_8888(const struct util_format_description *dst_desc,
+                                 const struct util_format_description *src_desc,
+                                 uint8_t shuffle[4])
+{
+   unsigned chan, comp;
+
+   if (dst_desc->colorspace != src_desc->colorspace)
+      return FALSE;
+
+   if (!util_format_is_rgba8_variant(dst_desc) ||
+       !util_format_is_rgba8_variant(src_desc))
+      return FALSE;
+
+   for (chan = 0; chan < 4; chan++) {
+      /*
+       * Find which rgba component the destination stores in this byte.
+       */
+      for (comp = 0; comp < 4; comp++) {
+         if (dst_desc->swizzle[comp] == PIPE_SWIZZLE_X + chan)
+            break;
+      }
+
+      if (comp == 4) {
+         /* void channel, matches the "reads back as one" convention */
+         shuffle[chan] = UTIL_FORMAT_SHUFFLE_FF;
+         continue;
+      }
+
+      switch (src_desc->swizzle[comp]) {
+      case PIPE_SWIZZLE_X:
+      case PIPE_SWIZZLE_Y:
+      case PIPE_SWIZZLE_Z:
+      case PIPE_SWIZZLE_W:
+         shuffle[chan] = src_desc->swizzle[comp] - PIPE_SWIZZLE_X;
+         break;
+      case PIPE_SWIZZLE_0:
+         shuffle[chan] = UTIL_FORMAT_SHUFFLE_00;
+         break;
+      case PIPE_SWIZZLE_1:
+         shuffle[chan] = UTIL_FORMAT_SHUFFLE_FF;
+         break;
+      default:
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+
 boolean
 util_format_translate(enum pipe_format dst_format,
                       void *dst, unsigned dst_stride,
@@ -642,9 +705,52 @@ util_format_translate(enum pipe_format dst_format,
 
    /*
     * TODO: double formats will loose precision
-    * TODO: Add a special case for formats that are mere swizzles of each other
     */
 
+#ifdef PIPE_ARCH_LITTLE_ENDIAN
+   /*
+    * Formats that are mere byte shuffles of each other, in particular the
+    * 8888 variants that dominate transfers and blits, don't need to go
+    * through the generic unpack/pack paths: shuffle the bytes in a single
+    * pass instead.  The shuffle is loop-invariant, so the compiler can keep
+    * it in registers and vectorize the inner loop.
+    */
+   {
+      uint8_t shuffle[4];
+
+      if (util_format_compute_shuffle_8888(dst_format_desc, src_format_desc,
+                                           shuffle)) {
+         unsigned x;
+
+         while (height--) {
+            const uint8_t *s = src_row;
+            uint8_t *d = dst_row;
+
+            for (x = 0; x < width; x++) {
+               unsigned chan;
+
+               for (chan = 0; chan < 4; chan++) {
+                  if (shuffle[chan] < 4)
+                     d[chan] = s[shuffle[chan]];
+                  else if (shuffle[chan] == UTIL_FORMAT_SHUFFLE_00)
+                     d[chan] = 0x00;
+                  else
+                     d[chan] = 0xff;
+               }
+
+               s += 4;
+               d += 4;
+            }
+
+            dst_row += dst_step;
+            src_row += src_step;
+         }
+
+         return TRUE;
+      }
+   }
+#endif
+
    if (src_format_desc->colorspace == UTIL_FORMAT_COLORSPACE_ZS ||
        dst_format_desc->colorspace == UTIL_FORMAT_COLORSPACE_ZS) {
       float *tmp_z = NULL;
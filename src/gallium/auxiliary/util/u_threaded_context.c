@@ -179,8 +179,25 @@ tc_is_sync(struct threaded_context *tc)
           !next->num_total_call_slots;
 }
 
+/**
+ * Remember which call site forced a sync.  Syncs only happen on the
+ * application thread, so the table needs no locking, and __func__ literals
+ * are unique within this file, so pointer comparison suffices.
+ */
+static void
+tc_record_sync_reason(struct threaded_context *tc, const char *func)
+{
+   for (unsigned i = 0; i < TC_MAX_SYNC_REASONS; i++) {
+      if (tc->sync_reasons[i].func == func || !tc->sync_reasons[i].func) {
+         tc->sync_reasons[i].func = func;
+         tc->sync_reasons[i].count++;
+         return;
+      }
+   }
+}
+
 static void
-_tc_sync(struct threaded_context *tc, MAYBE_UNUSED const char *info, MAYBE_UNUSED const char *func)
+_tc_sync(struct threaded_context *tc, MAYBE_UNUSED const char *info, const char *func)
 {
    struct tc_batch *last = &tc->batch_slots[tc->last];
    struct tc_batch *next = &tc->batch_slots[tc->next];
@@ -210,6 +227,7 @@ _tc_sync(struct threaded_context *tc, MAYBE_UNUSED const char *info, MAYBE_UNUSE
 
    if (synced) {
       p_atomic_inc(&tc->num_syncs);
+      tc_record_sync_reason(tc, func);
 
       if (tc_strcmp(func, "tc_destroy") != 0) {
          tc_printf("sync %s %s\n", func, info);
@@ -2527,6 +2545,16 @@ tc_destroy(struct pipe_context *_pipe)
       }
    }
 
+   if (debug_get_bool_option("TC_SYNC_STATS", false)) {
+      fprintf(stderr, "tc: %u syncs, %u offloaded slots, %u direct slots\n",
+              tc->num_syncs, tc->num_offloaded_slots, tc->num_direct_slots);
+      for (unsigned i = 0;
+           i < TC_MAX_SYNC_REASONS && tc->sync_reasons[i].func; i++) {
+         fprintf(stderr, "tc: %10u from %s\n",
+                 tc->sync_reasons[i].count, tc->sync_reasons[i].func);
+      }
+   }
+
    slab_destroy_child(&tc->pool_transfers);
    assert(tc->batch_slots[tc->next].num_total_call_slots == 0);
    pipe->destroy(pipe);
@@ -232,6 +232,10 @@ struct tc_unflushed_batch_token;
  */
 #define TC_MAX_SUBDATA_BYTES        320
 
+/* Max number of distinct call sites tracked by the per-reason sync counters;
+ * u_threaded_context.c has fewer tc_sync call sites than this. */
+#define TC_MAX_SYNC_REASONS         32
+
 typedef void (*tc_replace_buffer_storage_func)(struct pipe_context *ctx,
                                                struct pipe_resource *dst,
                                                struct pipe_resource *src);
@@ -361,6 +365,14 @@ struct threaded_context {
    unsigned num_direct_slots;
    unsigned num_syncs;
 
+   /* Per-call-site breakdown of num_syncs, printed on destroy when the
+    * TC_SYNC_STATS debug option is set.
+    */
+   struct {
+      const char *func;
+      unsigned count;
+   } sync_reasons[TC_MAX_SYNC_REASONS];
+
    struct util_queue queue;
    struct util_queue_fence *fence;
 
@@ -0,0 +1,201 @@
+/**************************************************************************
+ *
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+#include "pipe/p_defines.h"
+#include "pipe/p_screen.h"
+#include "pipe/p_state.h"
+#include "util/u_inlines.h"
+#include "util/u_memory.h"
+#include "util/u_transient.h"
+
+/* A pooled resource is freed when it has not been reused for this many
+ * frames, so a pool sized for a heavy frame shrinks back afterwards.
+ */
+#define UTIL_TRANSIENT_MAX_UNUSED_FRAMES 4
+
+struct util_transient_entry {
+   struct pipe_resource *res;
+   boolean in_use;
+   /* frame counter value when the entry was last acquired */
+   int64_t last_used;
+};
+
+struct util_transient_pool {
+   struct pipe_screen *screen;
+   struct util_transient_entry *entries;
+   unsigned num_entries;
+   unsigned max_entries;
+   int64_t frame;
+};
+
+
+struct util_transient_pool *
+util_transient_pool_create(struct pipe_screen *screen)
+{
+   struct util_transient_pool *pool = CALLOC_STRUCT(util_transient_pool);
+
+   if (!pool)
+      return NULL;
+
+   pool->screen = screen;
+   return pool;
+}
+
+
+void
+util_transient_pool_destroy(struct util_transient_pool *pool)
+{
+   unsigned i;
+
+   for (i = 0; i < pool->num_entries; i++) {
+      assert(!pool->entries[i].in_use);
+      pipe_resource_reference(&pool->entries[i].res, NULL);
+   }
+   FREE(pool->entries);
+   FREE(pool);
+}
+
+
+/**
+ * Whether a pooled resource can serve as backing for the given template.
+ * Only exact matches are reused; a mismatch in any field that affects
+ * layout or placement allocates a fresh resource.
+ */
+static boolean
+transient_entry_matches(const struct pipe_resource *res,
+                        const struct pipe_resource *templ)
+{
+   return res->target == templ->target &&
+          res->format == templ->format &&
+          res->width0 == templ->width0 &&
+          res->height0 == templ->height0 &&
+          res->depth0 == templ->depth0 &&
+          res->array_size == templ->array_size &&
+          res->last_level == templ->last_level &&
+          res->nr_samples == templ->nr_samples &&
+          res->nr_storage_samples == templ->nr_storage_samples &&
+          res->usage == templ->usage &&
+          res->bind == (templ->bind | PIPE_BIND_FRAME_TRANSIENT) &&
+          res->flags == templ->flags;
+}
+
+
+struct pipe_resource *
+util_transient_get(struct util_transient_pool *pool,
+                   const struct pipe_resource *templ)
+{
+   struct pipe_resource transient_templ;
+   struct util_transient_entry *entry;
+   struct pipe_resource *res = NULL;
+   unsigned i;
+
+   /* Look for a put entry with matching backing first; this is where the
+    * aliasing across disjoint lifetimes happens.
+    */
+   for (i = 0; i < pool->num_entries; i++) {
+      entry = &pool->entries[i];
+
+      if (!entry->in_use && transient_entry_matches(entry->res, templ)) {
+         entry->in_use = TRUE;
+         entry->last_used = pool->frame;
+         pipe_resource_reference(&res, entry->res);
+         return res;
+      }
+   }
+
+   if (pool->num_entries == pool->max_entries) {
+      unsigned new_max = MAX2(pool->max_entries * 2, 8);
+      struct util_transient_entry *entries =
+         REALLOC(pool->entries,
+                 pool->max_entries * sizeof(*entries),
+                 new_max * sizeof(*entries));
+
+      if (!entries)
+         return NULL;
+
+      pool->entries = entries;
+      pool->max_entries = new_max;
+   }
+
+   transient_templ = *templ;
+   transient_templ.bind |= PIPE_BIND_FRAME_TRANSIENT;
+
+   res = pool->screen->resource_create(pool->screen, &transient_templ);
+   if (!res)
+      return NULL;
+
+   entry = &pool->entries[pool->num_entries++];
+   entry->res = NULL;
+   pipe_resource_reference(&entry->res, res);
+   entry->in_use = TRUE;
+   entry->last_used = pool->frame;
+   return res;
+}
+
+
+void
+util_transient_put(struct util_transient_pool *pool,
+                   struct pipe_resource *res)
+{
+   unsigned i;
+
+   for (i = 0; i < pool->num_entries; i++) {
+      struct util_transient_entry *entry = &pool->entries[i];
+
+      if (entry->res == res) {
+         assert(entry->in_use);
+         entry->in_use = FALSE;
+         pipe_resource_reference(&res, NULL);
+         return;
+      }
+   }
+
+   /* Not from this pool; just drop the reference. */
+   assert(!"util_transient_put: resource not from this pool");
+   pipe_resource_reference(&res, NULL);
+}
+
+
+void
+util_transient_end_frame(struct util_transient_pool *pool)
+{
+   unsigned i = 0;
+
+   pool->frame++;
+
+   while (i < pool->num_entries) {
+      struct util_transient_entry *entry = &pool->entries[i];
+
+      if (!entry->in_use &&
+          pool->frame - entry->last_used > UTIL_TRANSIENT_MAX_UNUSED_FRAMES) {
+         pipe_resource_reference(&entry->res, NULL);
+         *entry = pool->entries[--pool->num_entries];
+         continue;
+      }
+      i++;
+   }
+}
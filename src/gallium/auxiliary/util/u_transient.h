@@ -0,0 +1,93 @@
+/**************************************************************************
+ *
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+/* Pool for frame-transient resources, (render targets whose contents only
+ * live within one frame, such as G-buffer or post-processing targets).
+ *
+ * Callers acquire a resource with util_transient_get() and hand it back
+ * with util_transient_put() as soon as its contents are dead.  Within a
+ * frame, a put resource's backing is reused for any later get with a
+ * matching template, so targets with disjoint lifetimes share one
+ * allocation instead of each holding dedicated memory.  The lifetime
+ * intervals are defined by the get/put order the caller issues; the pool
+ * never inspects rendering.
+ *
+ * util_transient_end_frame() marks the frame boundary and frees pooled
+ * resources that have not been reused for several frames.
+ */
+
+#ifndef U_TRANSIENT_H
+#define U_TRANSIENT_H
+
+#include "pipe/p_compiler.h"
+
+struct pipe_screen;
+struct pipe_resource;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct util_transient_pool *
+util_transient_pool_create(struct pipe_screen *screen);
+
+void
+util_transient_pool_destroy(struct util_transient_pool *pool);
+
+/**
+ * Acquire a resource matching \p templ.
+ *
+ * PIPE_BIND_FRAME_TRANSIENT is added to the template's bind flags, so a
+ * driver can recognize such resources and choose a placement accordingly.
+ * Returns a new reference owned by the caller, or NULL on failure.
+ */
+struct pipe_resource *
+util_transient_get(struct util_transient_pool *pool,
+                   const struct pipe_resource *templ);
+
+/**
+ * Return a resource acquired from util_transient_get() whose contents are
+ * no longer needed.  This drops the caller's reference; the backing
+ * becomes available for reuse by later gets in the same or a following
+ * frame.
+ */
+void
+util_transient_put(struct util_transient_pool *pool,
+                   struct pipe_resource *res);
+
+/**
+ * Mark a frame boundary and trim pooled resources that have gone unused
+ * for several frames.
+ */
+void
+util_transient_end_frame(struct util_transient_pool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_TRANSIENT_H */
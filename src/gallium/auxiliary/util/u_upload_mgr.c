@@ -42,6 +42,9 @@ struct u_upload_mgr {
    struct pipe_context *pipe;
 
    unsigned default_size;  /* Minimum size of the upload buffer, in bytes. */
+   unsigned grown_size;    /* Current allocation size; grows geometrically up
+                            * to a multiple of default_size when buffers keep
+                            * filling up. */
    unsigned bind;          /* Bitmask of PIPE_BIND_* flags. */
    enum pipe_resource_usage usage;
    unsigned flags;
@@ -67,6 +70,7 @@ u_upload_create(struct pipe_context *pipe, unsigned default_size,
 
    upload->pipe = pipe;
    upload->default_size = default_size;
+   upload->grown_size = default_size;
    upload->bind = bind;
    upload->usage = usage;
    upload->flags = flags;
@@ -189,13 +193,21 @@ u_upload_alloc_buffer(struct u_upload_mgr *upload, unsigned min_size)
    struct pipe_resource buffer;
    unsigned size;
 
+   /* If we're replacing a buffer we filled up, grow the allocation size
+    * geometrically (up to 8x the default) so that workloads streaming many
+    * megabytes per frame converge on a few large buffers instead of
+    * continuously creating and mapping default-sized ones.
+    */
+   if (upload->buffer && upload->grown_size < upload->default_size * 8)
+      upload->grown_size *= 2;
+
    /* Release the old buffer, if present:
     */
    u_upload_release_buffer(upload);
 
    /* Allocate a new one:
     */
-   size = align(MAX2(upload->default_size, min_size), 4096);
+   size = align(MAX2(upload->grown_size, min_size), 4096);
 
    memset(&buffer, 0, sizeof buffer);
    buffer.target = PIPE_BUFFER;
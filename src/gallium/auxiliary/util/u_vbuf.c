@@ -97,6 +97,12 @@
 #include "cso_cache/cso_cache.h"
 #include "cso_cache/cso_hash.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define USE_X86_64_SIMD
+#include <smmintrin.h>
+#include "util/u_cpu_detect.h"
+#endif
+
 struct u_vbuf_elements {
    unsigned count;
    struct pipe_vertex_element ve[PIPE_MAX_ATTRIBS];
@@ -1025,6 +1031,77 @@ static boolean u_vbuf_mapping_vertex_buffer_blocks(const struct u_vbuf *mgr)
             mgr->nonzero_stride_vb_mask)) != 0;
 }
 
+#ifdef USE_X86_64_SIMD
+
+/* SSE4.1 min/max scans for the no-primitive-restart paths below.  Every
+ * indexed draw whose range the driver needs (user vertex arrays, index
+ * translation) walks the whole index buffer here, so in draw-heavy apps
+ * these loops are hot enough to show up in profiles.
+ */
+
+static void
+__attribute__((target("sse4.1")))
+u_vbuf_minmax_index_ui_sse41(const unsigned *indices, unsigned count,
+                             unsigned *out_min, unsigned *out_max)
+{
+   __m128i vmin = _mm_set1_epi32(-1);
+   __m128i vmax = _mm_setzero_si128();
+   unsigned min, max;
+   unsigned i;
+
+   for (i = 0; i + 4 <= count; i += 4) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(indices + i));
+      vmin = _mm_min_epu32(vmin, v);
+      vmax = _mm_max_epu32(vmax, v);
+   }
+
+   vmin = _mm_min_epu32(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(1, 0, 3, 2)));
+   vmin = _mm_min_epu32(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(2, 3, 0, 1)));
+   vmax = _mm_max_epu32(vmax, _mm_shuffle_epi32(vmax, _MM_SHUFFLE(1, 0, 3, 2)));
+   vmax = _mm_max_epu32(vmax, _mm_shuffle_epi32(vmax, _MM_SHUFFLE(2, 3, 0, 1)));
+   min = _mm_cvtsi128_si32(vmin);
+   max = _mm_cvtsi128_si32(vmax);
+
+   for (; i < count; i++) {
+      if (indices[i] > max) max = indices[i];
+      if (indices[i] < min) min = indices[i];
+   }
+   *out_min = min;
+   *out_max = max;
+}
+
+static void
+__attribute__((target("sse4.1")))
+u_vbuf_minmax_index_us_sse41(const unsigned short *indices, unsigned count,
+                             unsigned *out_min, unsigned *out_max)
+{
+   __m128i vmin = _mm_set1_epi16(-1);
+   __m128i vmax = _mm_setzero_si128();
+   unsigned min, max;
+   unsigned i;
+
+   for (i = 0; i + 8 <= count; i += 8) {
+      __m128i v = _mm_loadu_si128((const __m128i *)(indices + i));
+      vmin = _mm_min_epu16(vmin, v);
+      vmax = _mm_max_epu16(vmax, v);
+   }
+
+   /* PHMINPOSUW computes the horizontal unsigned minimum; derive the
+    * maximum from the minimum of the complement. */
+   min = _mm_extract_epi16(_mm_minpos_epu16(vmin), 0);
+   vmax = _mm_xor_si128(vmax, _mm_set1_epi16(-1));
+   max = 0xffff - _mm_extract_epi16(_mm_minpos_epu16(vmax), 0);
+
+   for (; i < count; i++) {
+      if (indices[i] > max) max = indices[i];
+      if (indices[i] < min) min = indices[i];
+   }
+   *out_min = min;
+   *out_max = max;
+}
+
+#endif /* USE_X86_64_SIMD */
+
 static void
 u_vbuf_get_minmax_index_mapped(const struct pipe_draw_info *info,
                                const void *indices, unsigned *out_min_index,
@@ -1045,6 +1122,13 @@ u_vbuf_get_minmax_index_mapped(const struct pipe_draw_info *info,
          }
       }
       else {
+#ifdef USE_X86_64_SIMD
+         util_cpu_detect();
+         if (util_cpu_caps.has_sse4_1) {
+            u_vbuf_minmax_index_ui_sse41(ui_indices, info->count, &min, &max);
+            break;
+         }
+#endif
          for (unsigned i = 0; i < info->count; i++) {
             if (ui_indices[i] > max) max = ui_indices[i];
             if (ui_indices[i] < min) min = ui_indices[i];
@@ -1063,6 +1147,13 @@ u_vbuf_get_minmax_index_mapped(const struct pipe_draw_info *info,
          }
       }
       else {
+#ifdef USE_X86_64_SIMD
+         util_cpu_detect();
+         if (util_cpu_caps.has_sse4_1) {
+            u_vbuf_minmax_index_us_sse41(us_indices, info->count, &min, &max);
+            break;
+         }
+#endif
          for (unsigned i = 0; i < info->count; i++) {
             if (us_indices[i] > max) max = us_indices[i];
             if (us_indices[i] < min) min = us_indices[i];
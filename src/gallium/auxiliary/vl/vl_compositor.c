@@ -561,38 +561,34 @@ vl_compositor_set_buffer_layer(struct vl_compositor_state *s,
       float half_a_line = 0.5f / s->layers[layer].zw.y;
       switch(deinterlace) {
       case VL_COMPOSITOR_WEAVE:
+         s->layers[layer].fs = c->fs_weave_rgb;
          if (c->pipe_cs_composit_supported)
             s->layers[layer].cs = c->cs_weave_rgb;
-         else
-            s->layers[layer].fs = c->fs_weave_rgb;
          break;
 
       case VL_COMPOSITOR_BOB_TOP:
          s->layers[layer].zw.x = 0.0f;
          s->layers[layer].src.tl.y += half_a_line;
          s->layers[layer].src.br.y += half_a_line;
+         s->layers[layer].fs = c->fs_video_buffer;
          if (c->pipe_cs_composit_supported)
             s->layers[layer].cs = c->cs_video_buffer;
-         else
-            s->layers[layer].fs = c->fs_video_buffer;
          break;
 
       case VL_COMPOSITOR_BOB_BOTTOM:
          s->layers[layer].zw.x = 1.0f;
          s->layers[layer].src.tl.y -= half_a_line;
          s->layers[layer].src.br.y -= half_a_line;
+         s->layers[layer].fs = c->fs_video_buffer;
          if (c->pipe_cs_composit_supported)
             s->layers[layer].cs = c->cs_video_buffer;
-         else
-            s->layers[layer].fs = c->fs_video_buffer;
          break;
       }
 
    } else {
+      s->layers[layer].fs = c->fs_video_buffer;
       if (c->pipe_cs_composit_supported)
          s->layers[layer].cs = c->cs_video_buffer;
-      else
-         s->layers[layer].fs = c->fs_video_buffer;
    }
 }
 
@@ -643,6 +639,8 @@ vl_compositor_set_rgba_layer(struct vl_compositor_state *s,
 
    s->used_layers |= 1 << layer;
    s->layers[layer].fs = c->fs_rgba;
+   if (c->pipe_cs_composit_supported)
+      s->layers[layer].cs = c->cs_rgba;
    s->layers[layer].samplers[0] = c->sampler_linear;
    s->layers[layer].samplers[1] = NULL;
    s->layers[layer].samplers[2] = NULL;
@@ -742,9 +740,37 @@ vl_compositor_render(struct vl_compositor_state *s,
                      struct u_rect              *dirty_area,
                      bool                        clear_dirty)
 {
+   static const struct vertex4f white[4] = {
+      { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f },
+      { 1.0f, 1.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f }
+   };
+   unsigned used, i;
+   bool use_cs;
+
    assert(s);
 
-   if (s->layers->cs)
+   /* Use the compute path only if it can composite every used layer.
+    * A layer must have a compute shader, and since compute_shader_rgba
+    * overwrites the destination, an RGBA layer that relies on blending,
+    * rotation or vertex colors pushes the whole frame onto the gfx path.
+    */
+   use_cs = s->used_layers != 0;
+   used = s->used_layers;
+   for (i = 0; used && use_cs; ++i, used >>= 1) {
+      const struct vl_compositor_layer *layer = &s->layers[i];
+
+      if (!(used & 1))
+         continue;
+
+      if (!layer->cs ||
+          (layer->cs == c->cs_rgba &&
+           (!layer->clearing ||
+            layer->rotate != VL_COMPOSITOR_ROTATE_0 ||
+            memcmp(layer->colors, white, sizeof(white)) != 0)))
+         use_cs = false;
+   }
+
+   if (use_cs)
       vl_compositor_cs_render(s, c, dst_surface, dirty_area, clear_dirty);
    else
       vl_compositor_gfx_render(s, c, dst_surface, dirty_area, clear_dirty);
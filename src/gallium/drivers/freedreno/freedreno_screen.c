@@ -152,6 +152,9 @@ fd_screen_destroy(struct pipe_screen *pscreen)
 
 	fd_bc_fini(&screen->batch_cache);
 
+	if (util_queue_is_initialized(&screen->compile_queue))
+		util_queue_destroy(&screen->compile_queue);
+
 	slab_destroy_parent(&screen->transfer_pool);
 
 	mtx_destroy(&screen->lock);
@@ -914,6 +917,10 @@ fd_screen_create(struct fd_device *dev, struct renderonly *ro)
 
 	fd_bc_init(&screen->batch_cache);
 
+	if (!util_queue_init(&screen->compile_queue, "fd_cmp", 64, 1,
+			UTIL_QUEUE_INIT_RESIZE_IF_FULL))
+		goto fail;
+
 	(void) mtx_init(&screen->lock, mtx_plain);
 
 	pscreen->destroy = fd_screen_destroy;
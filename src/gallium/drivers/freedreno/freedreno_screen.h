@@ -32,6 +32,7 @@
 
 #include "pipe/p_screen.h"
 #include "util/u_memory.h"
+#include "util/u_queue.h"
 #include "util/slab.h"
 #include "os/os_thread.h"
 #include "renderonly/renderonly.h"
@@ -98,6 +99,11 @@ struct fd_screen {
 
 	struct fd_batch_cache batch_cache;
 
+	/* Queue for offloading initial shader variant compiles from the
+	 * API thread (shared by all contexts of the screen):
+	 */
+	struct util_queue compile_queue;
+
 	bool reorder;
 
 	uint16_t rsc_seqno;
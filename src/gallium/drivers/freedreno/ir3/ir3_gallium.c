@@ -87,6 +87,24 @@ ir3_shader_variant(struct ir3_shader *shader, struct ir3_shader_key key,
 	return v;
 }
 
+/* Compile the standard variant (and, for vertex shaders, its binning pass
+ * counterpart) on the screen's compile queue, so the first draw using the
+ * shader doesn't have to eat the compile time on the API thread.
+ */
+static void
+ir3_shader_initial_variants(void *job, int thread_index)
+{
+	struct ir3_shader *shader = job;
+	struct ir3_shader_key key;
+
+	memset(&key, 0, sizeof(key));
+
+	ir3_shader_variant(shader, key, false, NULL);
+
+	if (shader->type == MESA_SHADER_VERTEX)
+		ir3_shader_variant(shader, key, true, NULL);
+}
+
 static void
 copy_stream_out(struct ir3_stream_output_info *i,
 		const struct pipe_stream_output_info *p)
@@ -141,6 +159,13 @@ ir3_shader_create(struct ir3_compiler *compiler,
 
 		if (nir->info.stage != MESA_SHADER_FRAGMENT)
 			ir3_shader_variant(shader, key, true, debug);
+	} else {
+		/* Compile the initial variants asynchronously.  The first draw
+		 * waits on shader->variants_lock if the compile is still in
+		 * flight, and shader deletion waits on shader->ready.
+		 */
+		util_queue_add_job(&fd_screen(screen)->compile_queue, shader,
+				&shader->ready, ir3_shader_initial_variants, NULL);
 	}
 	return shader;
 }
@@ -90,6 +90,7 @@ binder_realloc(struct iris_context *ice)
    binder->bo->gtt_offset = next_address;
    binder->map = iris_bo_map(NULL, binder->bo, MAP_WRITE);
    binder->insert_point = INIT_INSERT_POINT;
+   binder->generation++;
 
    /* Allocating a new binder requires changing Surface State Base Address,
     * which also invalidates all our previous binding tables - each entry
@@ -128,10 +129,11 @@ iris_binder_reserve(struct iris_context *ice,
 }
 
 /**
- * Reserve and record binder space for 3D pipeline shader stages.
+ * Ensure the binder has space for the 3D pipeline's binding tables.
  *
- * Note that you must actually populate the new binding tables after
- * calling this command - the new area is uninitialized.
+ * Note that this only guarantees capacity - the space is claimed (or an
+ * existing identical table reused) later, when the binding tables are
+ * actually populated.
  */
 void
 iris_binder_reserve_3d(struct iris_context *ice)
@@ -176,18 +178,6 @@ iris_binder_reserve_3d(struct iris_context *ice)
        */
       binder_realloc(ice);
    }
-
-   /* Assign space and record the new binding table offsets. */
-   uint32_t offset = binder_insert(binder, total_size);
-
-   for (int stage = 0; stage <= MESA_SHADER_FRAGMENT; stage++) {
-      if (ice->state.dirty & (IRIS_DIRTY_BINDINGS_VS << stage)) {
-         binder->bt_offset[stage] = sizes[stage] > 0 ? offset : 0;
-         iris_record_state_size(ice->state.sizes,
-                                binder->bo->gtt_offset + offset, sizes[stage]);
-         offset += sizes[stage];
-      }
-   }
 }
 
 void
@@ -205,7 +195,8 @@ iris_binder_reserve_compute(struct iris_context *ice)
    if (size == 0)
       return;
 
-   binder->bt_offset[MESA_SHADER_COMPUTE] = iris_binder_reserve(ice, size);
+   if (!binder_has_space(binder, align(size, BTP_ALIGNMENT)))
+      binder_realloc(ice);
 }
 
 void
@@ -34,6 +34,12 @@ struct iris_bufmgr;
 struct iris_compiled_shader;
 struct iris_context;
 
+/**
+ * Most binding tables fit in this many entries; larger ones skip the
+ * reuse cache and always stream a fresh table.
+ */
+#define IRIS_BINDER_CACHED_BT_ENTRIES 128
+
 struct iris_binder
 {
    struct iris_bo *bo;
@@ -42,11 +48,30 @@ struct iris_binder
    /** Insert new entries at this offset (in bytes) */
    uint32_t insert_point;
 
+   /**
+    * Bumped every time we allocate a new binder BO, so stale cached
+    * binding tables (whose offsets are relative to an old BO) miss.
+    */
+   uint32_t generation;
+
    /**
     * Last assigned offset for each shader stage's binding table.
     * Zero is considered invalid and means there's no binding table.
     */
    uint32_t bt_offset[MESA_SHADER_STAGES];
+
+   /**
+    * The last binding table written for each stage, used to detect when
+    * re-dirtied bindings produce a table identical to the one already in
+    * the binder.  Reusing the old table saves binder space, delaying the
+    * STATE_BASE_ADDRESS stall that a full binder forces.
+    */
+   struct {
+      uint32_t generation;
+      uint32_t offset;
+      uint32_t size_bytes;
+      uint32_t entries[IRIS_BINDER_CACHED_BT_ENTRIES];
+   } cached_bt[MESA_SHADER_STAGES];
 };
 
 void iris_init_binder(struct iris_context *ice);
@@ -497,6 +497,117 @@ iris_blit(struct pipe_context *ctx, const struct pipe_blit_info *info)
                                     "cache history: post-blit");
 }
 
+/**
+ * The pipe->generate_mipmap() driver hook.
+ *
+ * The state tracker's fallback issues one full pipe->blit() per level,
+ * each of which pays for its own blorp batch, cache flushing, and
+ * resolve tracking.  Generating the whole chain here lets us record all
+ * of the per-level blits into a single blorp batch and emit one merged
+ * pipe control between levels instead of the blit hook's full
+ * post-blit flush-and-dirty dance.
+ */
+static boolean
+iris_generate_mipmap(struct pipe_context *ctx,
+                     struct pipe_resource *p_res,
+                     enum pipe_format format,
+                     unsigned base_level,
+                     unsigned last_level,
+                     unsigned first_layer,
+                     unsigned last_layer)
+{
+   struct iris_context *ice = (void *) ctx;
+   struct iris_screen *screen = (struct iris_screen *)ctx->screen;
+   const struct gen_device_info *devinfo = &screen->devinfo;
+   struct iris_batch *batch = &ice->batches[IRIS_BATCH_RENDER];
+   struct iris_resource *res = (void *) p_res;
+
+   /* Fall back to the blit path for anything blorp_blit can't consume as
+    * simple per-level 2D rectangles.  3D textures also shrink in depth
+    * from level to level, which the loop below doesn't handle.
+    */
+   if (p_res->target == PIPE_BUFFER ||
+       p_res->target == PIPE_TEXTURE_3D ||
+       p_res->nr_samples > 1 ||
+       util_format_is_depth_or_stencil(format))
+      return FALSE;
+
+   const unsigned num_layers = last_layer - first_layer + 1;
+
+   struct iris_format_info src_fmt =
+      iris_format_for_usage(devinfo, format, ISL_SURF_USAGE_TEXTURE_BIT);
+   enum isl_aux_usage src_aux_usage =
+      iris_resource_texture_aux_usage(ice, res, src_fmt.fmt, 0);
+   bool src_clear_supported = src_aux_usage != ISL_AUX_USAGE_NONE &&
+                              res->surf.format == src_fmt.fmt;
+
+   struct iris_format_info dst_fmt =
+      iris_format_for_usage(devinfo, format,
+                            ISL_SURF_USAGE_RENDER_TARGET_BIT);
+   enum isl_aux_usage dst_aux_usage =
+      iris_resource_render_aux_usage(ice, res, dst_fmt.fmt, false, false);
+   bool dst_clear_supported = dst_aux_usage != ISL_AUX_USAGE_NONE;
+
+   struct blorp_surf src_surf, dst_surf;
+   iris_blorp_surf_for_resource(&ice->vtbl, &src_surf, p_res,
+                                src_aux_usage, base_level, false);
+   iris_blorp_surf_for_resource(&ice->vtbl, &dst_surf, p_res,
+                                dst_aux_usage, base_level + 1, true);
+
+   struct blorp_batch blorp_batch;
+   blorp_batch_init(&ice->blorp, &blorp_batch, batch, 0);
+
+   for (unsigned level = base_level; level < last_level; level++) {
+      const unsigned src_width = u_minify(p_res->width0, level);
+      const unsigned src_height = u_minify(p_res->height0, level);
+      const unsigned dst_width = u_minify(p_res->width0, level + 1);
+      const unsigned dst_height = u_minify(p_res->height0, level + 1);
+
+      iris_resource_prepare_access(ice, batch, res, level, 1,
+                                   first_layer, num_layers,
+                                   src_aux_usage, src_clear_supported);
+      iris_resource_prepare_access(ice, batch, res, level + 1, 1,
+                                   first_layer, num_layers,
+                                   dst_aux_usage, dst_clear_supported);
+
+      for (unsigned layer = 0; layer < num_layers; layer++) {
+         iris_batch_maybe_flush(batch, 1500);
+
+         blorp_blit(&blorp_batch,
+                    &src_surf, level, first_layer + layer,
+                    src_fmt.fmt, src_fmt.swizzle,
+                    &dst_surf, level + 1, first_layer + layer,
+                    dst_fmt.fmt, dst_fmt.swizzle,
+                    0, 0, src_width, src_height,
+                    0, 0, dst_width, dst_height,
+                    BLORP_FILTER_BILINEAR, false, false);
+      }
+
+      iris_resource_finish_write(ice, res, level + 1, first_layer,
+                                 num_layers, dst_aux_usage);
+
+      /* The level we just wrote is the source of the next one, so get the
+       * render target writes into memory and out of the sampler's cache
+       * before the next blit reads them.  iris_emit_pipe_control_flush
+       * takes care of splitting the flush from the invalidation.
+       */
+      if (level + 1 < last_level) {
+         iris_emit_pipe_control_flush(batch, "mipmap generation",
+                                      PIPE_CONTROL_RENDER_TARGET_FLUSH |
+                                      PIPE_CONTROL_TEXTURE_CACHE_INVALIDATE |
+                                      PIPE_CONTROL_CS_STALL);
+      }
+   }
+
+   blorp_batch_finish(&blorp_batch);
+
+   iris_flush_and_dirty_for_history(ice, batch, res,
+                                    PIPE_CONTROL_RENDER_TARGET_FLUSH,
+                                    "cache history: post generate_mipmap");
+
+   return TRUE;
+}
+
 static void
 get_copy_region_aux_settings(const struct gen_device_info *devinfo,
                              struct iris_resource *res,
@@ -676,5 +787,6 @@ void
 iris_init_blit_functions(struct pipe_context *ctx)
 {
    ctx->blit = iris_blit;
+   ctx->generate_mipmap = iris_generate_mipmap;
    ctx->resource_copy_region = iris_resource_copy_region;
 }
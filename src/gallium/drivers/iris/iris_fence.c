@@ -107,10 +107,33 @@ iris_batch_add_syncpt(struct iris_batch *batch,
    iris_syncpt_reference(batch->screen, store, syncpt);
 }
 
+/**
+ * Return the syncobj that will be signalled when the batch is flushed.
+ *
+ * The signalling sync-point is always the first one added to the batch
+ * (see iris_batch_reset).
+ */
+static struct iris_syncpt *
+batch_signal_syncpt(struct iris_batch *batch)
+{
+   struct iris_syncpt **syncpts = util_dynarray_begin(&batch->syncpts);
+   return syncpts[0];
+}
+
 /* ------------------------------------------------------------------- */
 
 struct pipe_fence_handle {
    struct pipe_reference ref;
+
+   /**
+    * The context which created this fence with PIPE_FLUSH_DEFERRED, or
+    * NULL if the relevant batches were flushed at creation time.  The
+    * syncobjs of a deferred fence have no DMA fence attached until that
+    * context flushes, so waiters may need to trigger the flush (or wait
+    * for submission) themselves.
+    */
+   struct pipe_context *unflushed_ctx;
+
    struct iris_syncpt *syncpt[IRIS_BATCH_COUNT];
    unsigned count;
 };
@@ -163,9 +186,18 @@ iris_fence_flush(struct pipe_context *ctx,
    struct iris_screen *screen = (void *) ctx->screen;
    struct iris_context *ice = (struct iris_context *)ctx;
 
-   /* XXX PIPE_FLUSH_DEFERRED */
-   for (unsigned i = 0; i < IRIS_BATCH_COUNT; i++)
-      iris_batch_flush(&ice->batches[i]);
+   /* We can defer the actual submission as long as we hand back syncobjs
+    * which will be signalled once the pending batches eventually flush.
+    * Native fence fds need a DMA fence right away, however, so don't
+    * defer in that case.
+    */
+   const bool deferred = (flags & PIPE_FLUSH_DEFERRED) &&
+                         !(flags & PIPE_FLUSH_FENCE_FD);
+
+   if (!deferred) {
+      for (unsigned i = 0; i < IRIS_BATCH_COUNT; i++)
+         iris_batch_flush(&ice->batches[i]);
+   }
 
    if (!out_fence)
       return;
@@ -176,12 +208,26 @@ iris_fence_flush(struct pipe_context *ctx,
 
    pipe_reference_init(&fence->ref, 1);
 
+   if (deferred)
+      fence->unflushed_ctx = ctx;
+
    for (unsigned b = 0; b < IRIS_BATCH_COUNT; b++) {
-      if (!iris_wait_syncpt(ctx->screen, ice->batches[b].last_syncpt, 0))
+      struct iris_batch *batch = &ice->batches[b];
+
+      if (deferred && iris_batch_bytes_used(batch) > 0) {
+         /* This batch has unflushed commands; take the syncobj which will
+          * be signalled when it's eventually submitted.
+          */
+         struct iris_syncpt *syncpt = batch_signal_syncpt(batch);
+         iris_syncpt_reference(screen, &fence->syncpt[fence->count++], syncpt);
+         continue;
+      }
+
+      if (!iris_wait_syncpt(ctx->screen, batch->last_syncpt, 0))
          continue;
 
       iris_syncpt_reference(screen, &fence->syncpt[fence->count++],
-                            ice->batches[b].last_syncpt);
+                            batch->last_syncpt);
    }
    *out_fence = fence;
 }
@@ -192,6 +238,16 @@ iris_fence_await(struct pipe_context *ctx,
 {
    struct iris_context *ice = (struct iris_context *)ctx;
 
+   /* Deferred fences are awkward here: the kernel rejects execbuf waits on
+    * syncobjs which have no DMA fence attached.  If the fence came from
+    * this context, the pending batches already precede anything we record
+    * from here on, so there's nothing to do.  If it came from another
+    * context which hasn't flushed, the wait is undefined anyway (the GL
+    * spec requires the source context to be flushed first), so skip it.
+    */
+   if (fence->unflushed_ctx)
+      return;
+
    for (unsigned b = 0; b < IRIS_BATCH_COUNT; b++) {
       for (unsigned i = 0; i < fence->count; i++) {
          iris_batch_add_syncpt(&ice->batches[b], fence->syncpt[i],
@@ -233,6 +289,19 @@ iris_fence_finish(struct pipe_screen *p_screen,
 {
    struct iris_screen *screen = (struct iris_screen *)p_screen;
 
+   /* If the fence was created with PIPE_FLUSH_DEFERRED by this context,
+    * we're responsible for flushing before waiting (see the fence_finish
+    * documentation in p_screen.h).
+    */
+   if (ctx && ctx == fence->unflushed_ctx) {
+      struct iris_context *ice = (struct iris_context *)ctx;
+
+      for (unsigned i = 0; i < IRIS_BATCH_COUNT; i++)
+         iris_batch_flush(&ice->batches[i]);
+
+      fence->unflushed_ctx = NULL;
+   }
+
    if (!fence->count)
       return true;
 
@@ -240,11 +309,17 @@ iris_fence_finish(struct pipe_screen *p_screen,
    for (unsigned i = 0; i < fence->count; i++)
       handles[i] = fence->syncpt[i]->handle;
 
+   /* A deferred fence from another context may not have been submitted
+    * yet, leaving the syncobjs empty; WAIT_FOR_SUBMIT makes the kernel
+    * wait for the creating context's eventual flush instead of erroring.
+    */
    struct drm_syncobj_wait args = {
       .handles = (uintptr_t)handles,
       .count_handles = fence->count,
       .timeout_nsec = rel2abs(timeout), /* XXX */
-      .flags = DRM_SYNCOBJ_WAIT_FLAGS_WAIT_ALL
+      .flags = DRM_SYNCOBJ_WAIT_FLAGS_WAIT_ALL |
+               (fence->unflushed_ctx ?
+                DRM_SYNCOBJ_WAIT_FLAGS_WAIT_FOR_SUBMIT : 0)
    };
    return drm_ioctl(screen->fd, DRM_IOCTL_SYNCOBJ_WAIT, &args) == 0;
 }
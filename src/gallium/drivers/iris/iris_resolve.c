@@ -126,15 +126,25 @@ resolve_image_views(struct iris_context *ice,
 
    while (views) {
       const int i = u_bit_scan(&views);
-      struct iris_resource *res = (void *) shs->image[i].base.resource;
+      const struct pipe_image_view *pview = &shs->image[i].base;
+      struct iris_resource *res = (void *) pview->resource;
 
       if (res->base.target != PIPE_BUFFER) {
+         unsigned num_layers =
+            pview->u.tex.last_layer - pview->u.tex.first_layer + 1;
+
          if (consider_framebuffer) {
             disable_rb_aux_buffer(ice, draw_aux_buffer_disabled,
-                                  res, 0, ~0, "as a shader image");
+                                  res, pview->u.tex.level, 1,
+                                  "as a shader image");
          }
 
-         iris_resource_prepare_image(ice, batch, res);
+         /* The data port doesn't understand compression, so only the
+          * bound level/layer range needs resolving, not the whole array.
+          */
+         iris_resource_prepare_image(ice, batch, res,
+                                     pview->u.tex.level, 1,
+                                     pview->u.tex.first_layer, num_layers);
       }
 
       iris_cache_flush_for_read(batch, res->bo);
@@ -1384,11 +1394,13 @@ iris_resource_prepare_texture(struct iris_context *ice,
 void
 iris_resource_prepare_image(struct iris_context *ice,
                             struct iris_batch *batch,
-                            struct iris_resource *res)
+                            struct iris_resource *res,
+                            uint32_t level, uint32_t num_levels,
+                            uint32_t start_layer, uint32_t num_layers)
 {
    /* The data port doesn't understand any compression */
-   iris_resource_prepare_access(ice, batch, res, 0, INTEL_REMAINING_LEVELS,
-                                0, INTEL_REMAINING_LAYERS,
+   iris_resource_prepare_access(ice, batch, res, level, num_levels,
+                                start_layer, num_layers,
                                 ISL_AUX_USAGE_NONE, false);
 }
 
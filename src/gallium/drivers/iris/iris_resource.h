@@ -405,7 +405,9 @@ void iris_resource_prepare_texture(struct iris_context *ice,
                                    enum gen9_astc5x5_wa_tex_type);
 void iris_resource_prepare_image(struct iris_context *ice,
                                  struct iris_batch *batch,
-                                 struct iris_resource *res);
+                                 struct iris_resource *res,
+                                 uint32_t level, uint32_t num_levels,
+                                 uint32_t start_layer, uint32_t num_layers);
 
 void iris_resource_check_level_layer(const struct iris_resource *res,
                                      uint32_t level, uint32_t layer);
@@ -4033,6 +4033,12 @@ use_image(struct iris_batch *batch, struct iris_context *ice,
  * This fills out the table of pointers to surfaces required by the shader,
  * and also adds those buffers to the validation list so the kernel can make
  * resident before running our batch.
+ *
+ * The table is built in a local buffer first, then compared against the
+ * last table written for this stage.  Bindings are often re-dirtied by
+ * things that don't change their contents (blorp operations, resolves),
+ * in which case we point at the existing copy in the binder rather than
+ * claiming fresh binder space for an identical table.
  */
 static void
 iris_populate_binding_table(struct iris_context *ice,
@@ -4040,25 +4046,38 @@ iris_populate_binding_table(struct iris_context *ice,
                             gl_shader_stage stage,
                             bool pin_only)
 {
-   const struct iris_binder *binder = &ice->state.binder;
+   struct iris_binder *binder = &ice->state.binder;
    struct iris_uncompiled_shader *ish = ice->shaders.uncompiled[stage];
    struct iris_compiled_shader *shader = ice->shaders.prog[stage];
-   if (!shader)
+   uint32_t table[IRIS_BINDER_CACHED_BT_ENTRIES];
+
+   if (!shader) {
+      if (!pin_only)
+         binder->bt_offset[stage] = 0;
       return;
+   }
 
    struct iris_binding_table *bt = &shader->bt;
    UNUSED struct brw_stage_prog_data *prog_data = shader->prog_data;
    struct iris_shader_state *shs = &ice->state.shaders[stage];
    uint32_t binder_addr = binder->bo->gtt_offset;
 
-   //struct brw_stage_prog_data *prog_data = (void *) shader->prog_data;
-   uint32_t *bt_map = binder->map + binder->bt_offset[stage];
+   /* Tables too large for the reuse cache stream directly to the binder. */
+   const bool use_cache = !pin_only && bt->size_bytes <= sizeof(table);
+   uint32_t *bt_map = table;
+   if (!use_cache && !pin_only) {
+      binder->bt_offset[stage] = bt->size_bytes > 0 ?
+         iris_binder_reserve(ice, bt->size_bytes) : 0;
+      bt_map = binder->map + binder->bt_offset[stage];
+   }
    int s = 0;
 
    const struct shader_info *info = iris_get_shader_info(ice, stage);
    if (!info) {
       /* TCS passthrough doesn't need a binding table. */
       assert(stage == MESA_SHADER_TESS_CTRL);
+      if (!pin_only)
+         binder->bt_offset[stage] = 0;
       return;
    }
 
@@ -4143,6 +4162,35 @@ iris_populate_binding_table(struct iris_context *ice,
       bt_assert(plane_start[1], ...);
       bt_assert(plane_start[2], ...);
 #endif
+
+   if (use_cache) {
+      const unsigned table_bytes = s * sizeof(uint32_t);
+      struct iris_binder *b = binder;
+
+      if (b->cached_bt[stage].generation == b->generation &&
+          b->cached_bt[stage].size_bytes == table_bytes &&
+          memcmp(b->cached_bt[stage].entries, table, table_bytes) == 0) {
+         /* Same contents as the table already in the binder - reuse it. */
+         b->bt_offset[stage] = b->cached_bt[stage].offset;
+         return;
+      }
+
+      if (table_bytes == 0) {
+         b->bt_offset[stage] = 0;
+         return;
+      }
+
+      uint32_t offset = iris_binder_reserve(ice, table_bytes);
+      b->bt_offset[stage] = offset;
+      memcpy(b->map + offset, table, table_bytes);
+      iris_record_state_size(ice->state.sizes,
+                             b->bo->gtt_offset + offset, table_bytes);
+
+      b->cached_bt[stage].generation = b->generation;
+      b->cached_bt[stage].offset = offset;
+      b->cached_bt[stage].size_bytes = table_bytes;
+      memcpy(b->cached_bt[stage].entries, table, table_bytes);
+   }
 }
 
 static void
@@ -4630,18 +4678,22 @@ iris_upload_dirty_render_state(struct iris_context *ice,
       }
    }
 
+   /* Populate before emitting the pointers - the tables may end up reusing
+    * an existing identical copy in the binder, in which case the populate
+    * step is what decides the offset to point at.
+    */
    for (int stage = 0; stage <= MESA_SHADER_FRAGMENT; stage++) {
       if (dirty & (IRIS_DIRTY_BINDINGS_VS << stage)) {
-         iris_emit_cmd(batch, GENX(3DSTATE_BINDING_TABLE_POINTERS_VS), ptr) {
-            ptr._3DCommandSubOpcode = 38 + stage;
-            ptr.PointertoVSBindingTable = binder->bt_offset[stage];
-         }
+         iris_populate_binding_table(ice, batch, stage, false);
       }
    }
 
    for (int stage = 0; stage <= MESA_SHADER_FRAGMENT; stage++) {
       if (dirty & (IRIS_DIRTY_BINDINGS_VS << stage)) {
-         iris_populate_binding_table(ice, batch, stage, false);
+         iris_emit_cmd(batch, GENX(3DSTATE_BINDING_TABLE_POINTERS_VS), ptr) {
+            ptr._3DCommandSubOpcode = 38 + stage;
+            ptr.PointertoVSBindingTable = binder->bt_offset[stage];
+         }
       }
    }
 
@@ -55,6 +55,14 @@ llvmpipe_flush( struct pipe_context *pipe,
    /* ask the setup module to flush */
    lp_setup_flush(llvmpipe->setup, fence, reason);
 
+   /* Callers that don't take a fence expect rendering to be complete when
+    * we return (the sw winsys present paths copy the framebuffer out right
+    * after flushing), so drain the rasterizer for them.  Callers that do
+    * take a fence are responsible for waiting on it themselves.
+    */
+   if (!fence)
+      lp_setup_finish(llvmpipe->setup);
+
    /* Enable to dump BMPs of the color/depth buffers each frame */
    if (0) {
       static unsigned frame_no = 1;
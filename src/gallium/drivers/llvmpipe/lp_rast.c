@@ -33,6 +33,7 @@
 #include "util/u_pack_color.h"
 #include "util/u_string.h"
 #include "util/u_thread.h"
+#include "util/u_cpu_detect.h"
 
 #include "util/os_time.h"
 
@@ -316,53 +317,80 @@ lp_rast_shade_tile(struct lp_rasterizer_task *task,
    }
    variant = state->variant;
 
-   /* render the whole 64x64 tile in 4x4 chunks */
-   for (y = 0; y < task->height; y += 4){
-      for (x = 0; x < task->width; x += 4) {
+   {
+      uint8_t *color_row[PIPE_MAX_COLOR_BUFS];
+      unsigned stride[PIPE_MAX_COLOR_BUFS];
+      unsigned format_bytes[PIPE_MAX_COLOR_BUFS];
+      uint8_t *depth_row = NULL;
+      unsigned depth_stride = 0;
+      unsigned i;
+
+      /* The 4x4 blocks of a tile sit at fixed strides from each other, so
+       * take the block pointers once for the tile origin and step them
+       * along instead of recomputing every block's offset from scratch.
+       */
+      for (i = 0; i < scene->fb.nr_cbufs; i++){
+         if (scene->fb.cbufs[i]) {
+            stride[i] = scene->cbufs[i].stride;
+            format_bytes[i] = scene->cbufs[i].format_bytes;
+            color_row[i] = lp_rast_get_color_block_pointer(task, i, tile_x,
+                                                           tile_y, inputs->layer);
+         }
+         else {
+            stride[i] = 0;
+            format_bytes[i] = 0;
+            color_row[i] = NULL;
+         }
+      }
+
+      if (scene->zsbuf.map) {
+         depth_row = lp_rast_get_depth_block_pointer(task, tile_x, tile_y,
+                                                     inputs->layer);
+         depth_stride = scene->zsbuf.stride;
+      }
+
+      /* Propagate non-interpolated raster state. */
+      task->thread_data.raster_state.viewport_index = inputs->viewport_index;
+
+      /* render the whole 64x64 tile in 4x4 chunks */
+      for (y = 0; y < task->height; y += 4){
          uint8_t *color[PIPE_MAX_COLOR_BUFS];
-         unsigned stride[PIPE_MAX_COLOR_BUFS];
-         uint8_t *depth = NULL;
-         unsigned depth_stride = 0;
-         unsigned i;
-
-         /* color buffer */
-         for (i = 0; i < scene->fb.nr_cbufs; i++){
-            if (scene->fb.cbufs[i]) {
-               stride[i] = scene->cbufs[i].stride;
-               color[i] = lp_rast_get_color_block_pointer(task, i, tile_x + x,
-                                                          tile_y + y, inputs->layer);
-            }
-            else {
-               stride[i] = 0;
-               color[i] = NULL;
+         uint8_t *depth = depth_row;
+
+         for (i = 0; i < scene->fb.nr_cbufs; i++)
+            color[i] = color_row[i];
+
+         for (x = 0; x < task->width; x += 4) {
+            /* run shader on 4x4 block */
+            BEGIN_JIT_CALL(state, task);
+            variant->jit_function[RAST_WHOLE]( &state->jit_context,
+                                               tile_x + x, tile_y + y,
+                                               inputs->frontfacing,
+                                               GET_A0(inputs),
+                                               GET_DADX(inputs),
+                                               GET_DADY(inputs),
+                                               color,
+                                               depth,
+                                               0xffff,
+                                               &task->thread_data,
+                                               stride,
+                                               depth_stride);
+            END_JIT_CALL();
+
+            for (i = 0; i < scene->fb.nr_cbufs; i++) {
+               if (color[i])
+                  color[i] += 4 * format_bytes[i];
             }
+            if (depth)
+               depth += 4 * scene->zsbuf.format_bytes;
          }
 
-         /* depth buffer */
-         if (scene->zsbuf.map) {
-            depth = lp_rast_get_depth_block_pointer(task, tile_x + x,
-                                                    tile_y + y, inputs->layer);
-            depth_stride = scene->zsbuf.stride;
+         for (i = 0; i < scene->fb.nr_cbufs; i++) {
+            if (color_row[i])
+               color_row[i] += 4 * stride[i];
          }
-
-         /* Propagate non-interpolated raster state. */
-         task->thread_data.raster_state.viewport_index = inputs->viewport_index;
-
-         /* run shader on 4x4 block */
-         BEGIN_JIT_CALL(state, task);
-         variant->jit_function[RAST_WHOLE]( &state->jit_context,
-                                            tile_x + x, tile_y + y,
-                                            inputs->frontfacing,
-                                            GET_A0(inputs),
-                                            GET_DADX(inputs),
-                                            GET_DADY(inputs),
-                                            color,
-                                            depth,
-                                            0xffff,
-                                            &task->thread_data,
-                                            stride,
-                                            depth_stride);
-         END_JIT_CALL();
+         if (depth_row)
+            depth_row += 4 * depth_stride;
       }
    }
 }
@@ -704,10 +732,6 @@ rasterize_scene(struct lp_rasterizer_task *task,
    }
 #endif
 
-   if (scene->fence) {
-      lp_fence_signal(scene->fence);
-   }
-
    task->scene = NULL;
 }
 
@@ -736,6 +760,9 @@ lp_rast_queue_scene( struct lp_rasterizer *rast,
 
       lp_rast_end( rast );
 
+      if (scene->fence)
+         lp_fence_signal(scene->fence);
+
       util_fpstate_set(fpstate);
 
       rast->curr_scene = NULL;
@@ -756,23 +783,6 @@ lp_rast_queue_scene( struct lp_rasterizer *rast,
 }
 
 
-void
-lp_rast_finish( struct lp_rasterizer *rast )
-{
-   if (rast->num_threads == 0) {
-      /* nothing to do */
-   }
-   else {
-      int i;
-
-      /* wait for work to complete */
-      for (i = 0; i < rast->num_threads; i++) {
-         pipe_semaphore_wait(&rast->tasks[i].work_done);
-      }
-   }
-}
-
-
 /**
  * This is the thread's main entrypoint.
  * It's a simple loop:
@@ -785,6 +795,7 @@ thread_function(void *init_data)
 {
    struct lp_rasterizer_task *task = (struct lp_rasterizer_task *) init_data;
    struct lp_rasterizer *rast = task->rast;
+   struct lp_scene *scene;
    boolean debug = false;
    char thread_name[16];
    unsigned fpstate;
@@ -821,27 +832,32 @@ thread_function(void *init_data)
        */
       util_barrier_wait( &rast->barrier );
 
+      scene = rast->curr_scene;
+
       /* do work */
       if (debug)
          debug_printf("thread %d doing work\n", task->thread_index);
 
-      rasterize_scene(task,
-                      rast->curr_scene);
-      
+      rasterize_scene(task, scene);
+
       /* wait for all threads to finish with this scene */
       util_barrier_wait( &rast->barrier );
 
-      /* XXX: shouldn't be necessary:
-       */
       if (task->thread_index == 0) {
          lp_rast_end( rast );
       }
 
-      /* signal done with work */
+      /* Signal the fence only after thread 0 has retired the scene above.
+       * The fence completes with the last of the num_threads signals, which
+       * includes thread 0's, so a completed fence implies the scene's
+       * framebuffer maps and resource references have been dropped and the
+       * scene is safe to reuse.
+       */
+      if (scene->fence)
+         lp_fence_signal(scene->fence);
+
       if (debug)
          debug_printf("thread %d done working\n", task->thread_index);
-
-      pipe_semaphore_signal(&task->work_done);
    }
 
 #ifdef _WIN32
@@ -866,6 +882,15 @@ create_rast_threads(struct lp_rasterizer *rast)
       pipe_semaphore_init(&rast->tasks[i].work_done, 0);
       rast->threads[i] = u_thread_create(thread_function,
                                             (void *) &rast->tasks[i]);
+
+      /* Spread the threads across NUMA nodes so that each thread faults its
+       * tile scratch and JIT working set on the node it runs on instead of
+       * pulling everything across the socket interconnect.
+       */
+      if (util_cpu_caps.num_numa_nodes > 1) {
+         util_pin_thread_to_numa_node(rast->threads[i],
+                                      i % util_cpu_caps.num_numa_nodes);
+      }
    }
 }
 
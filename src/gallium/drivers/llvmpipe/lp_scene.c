@@ -289,7 +289,10 @@ lp_scene_end_rasterization(struct lp_scene *scene )
       list->head->used = 0;
    }
 
-   lp_fence_reference(&scene->fence, NULL);
+   /* Note: scene->fence is not released here.  The fence may complete (and
+    * be waited upon) after this function has run on the rasterizer side, so
+    * the setup module drops the reference when it recycles the scene.
+    */
 
    scene->resources = NULL;
    scene->scene_size = 0;
@@ -449,33 +452,76 @@ lp_scene_is_resource_referenced(const struct lp_scene *scene,
 
 
 
-/** advance curr_x,y to the next bin */
-static boolean
-next_bin(struct lp_scene *scene)
+/** number of commands binned into this bin, as a rough cost estimate */
+static unsigned
+bin_cmd_count(const struct cmd_bin *bin)
 {
-   scene->curr_x++;
-   if (scene->curr_x >= scene->tiles_x) {
-      scene->curr_x = 0;
-      scene->curr_y++;
-   }
-   if (scene->curr_y >= scene->tiles_y) {
-      /* no more bins */
-      return FALSE;
-   }
-   return TRUE;
+   const struct cmd_block *block;
+   unsigned count = 0;
+
+   for (block = bin->head; block; block = block->next)
+      count += block->count;
+   return count;
 }
 
 
+/* Bins are bucketed by log2 of their command count; more buckets than
+ * this buys nothing since such bins are huge either way.
+ */
+#define BIN_ORDER_BUCKETS 16
+
+
+/**
+ * Compute the order in which the rasterizer threads will pick up bins:
+ * bucket bins by the log2 of their command count and hand out the
+ * heaviest buckets first.  A cheap approximation of longest-processing-
+ * time-first scheduling, which keeps a skewed scene's expensive tiles
+ * from all landing at the tail of the linear walk where they serialize
+ * on whichever threads happen to grab them last.
+ */
 void
 lp_scene_bin_iter_begin( struct lp_scene *scene )
 {
-   scene->curr_x = scene->curr_y = -1;
+   unsigned counts[BIN_ORDER_BUCKETS];
+   unsigned offsets[BIN_ORDER_BUCKETS];
+   unsigned x, y, b, pos;
+
+   /* bin_order packs coordinates as x | (y << 8) */
+   STATIC_ASSERT(TILES_X <= 256 && TILES_Y <= 256);
+
+   scene->num_bins = scene->tiles_x * scene->tiles_y;
+   scene->curr_bin = 0;
+
+   memset(counts, 0, sizeof(counts));
+   for (y = 0; y < scene->tiles_y; y++) {
+      for (x = 0; x < scene->tiles_x; x++) {
+         unsigned cost = bin_cmd_count(lp_scene_get_bin(scene, x, y));
+         b = MIN2(util_logbase2(cost + 1), BIN_ORDER_BUCKETS - 1);
+         counts[b]++;
+      }
+   }
+
+   /* heaviest bucket starts at slot 0 */
+   pos = 0;
+   for (b = BIN_ORDER_BUCKETS; b-- > 0; ) {
+      offsets[b] = pos;
+      pos += counts[b];
+   }
+   assert(pos == scene->num_bins);
+
+   for (y = 0; y < scene->tiles_y; y++) {
+      for (x = 0; x < scene->tiles_x; x++) {
+         unsigned cost = bin_cmd_count(lp_scene_get_bin(scene, x, y));
+         b = MIN2(util_logbase2(cost + 1), BIN_ORDER_BUCKETS - 1);
+         scene->bin_order[offsets[b]++] = x | (y << 8);
+      }
+   }
 }
 
 
 /**
  * Return pointer to next bin to be rendered.
- * The lp_scene::curr_x and ::curr_y fields will be advanced.
+ * The lp_scene::curr_bin field will be advanced.
  * Multiple rendering threads will call this function to get a chunk
  * of work (a bin) to work on.
  */
@@ -483,22 +529,19 @@ struct cmd_bin *
 lp_scene_bin_iter_next( struct lp_scene *scene , int *x, int *y)
 {
    struct cmd_bin *bin = NULL;
+   unsigned packed;
 
    mtx_lock(&scene->mutex);
 
-   if (scene->curr_x < 0) {
-      /* first bin */
-      scene->curr_x = 0;
-      scene->curr_y = 0;
-   }
-   else if (!next_bin(scene)) {
+   if (scene->curr_bin >= scene->num_bins) {
       /* no more bins left */
       goto end;
    }
 
-   bin = lp_scene_get_bin(scene, scene->curr_x, scene->curr_y);
-   *x = scene->curr_x;
-   *y = scene->curr_y;
+   packed = scene->bin_order[scene->curr_bin++];
+   *x = packed & 0xff;
+   *y = packed >> 8;
+   bin = lp_scene_get_bin(scene, *x, *y);
 
 end:
    /*printf("return bin %p at %d, %d\n", (void *) bin, *bin_x, *bin_y);*/
@@ -507,6 +550,21 @@ end:
 }
 
 
+/**
+ * Set the conservative depth bound of every tile, e.g. after a depth
+ * clear made the whole buffer a known value (callers pad the value
+ * with LP_SCENE_ZMAX_PAD to cover format quantization).
+ */
+void lp_scene_zmax_set_all( struct lp_scene *scene, float zmax )
+{
+   unsigned x, y;
+
+   for (x = 0; x < scene->tiles_x; x++)
+      for (y = 0; y < scene->tiles_y; y++)
+         scene->tile_zmax[x][y] = zmax;
+}
+
+
 void lp_scene_begin_binning(struct lp_scene *scene,
                             struct pipe_framebuffer_state *fb)
 {
@@ -522,6 +580,11 @@ void lp_scene_begin_binning(struct lp_scene *scene,
    assert(scene->tiles_x <= TILES_X);
    assert(scene->tiles_y <= TILES_Y);
 
+   /* No depth bound information until a clear or a tile-covering
+    * occluder establishes some.
+    */
+   lp_scene_zmax_set_all(scene, INFINITY);
+
    /*
     * Determine how many layers the fb has (used for clamping layer value).
     * OpenGL (but not d3d10) permits different amount of layers per rt, however
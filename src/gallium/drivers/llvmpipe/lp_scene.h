@@ -172,7 +172,26 @@ struct lp_scene {
     */
    unsigned tiles_x, tiles_y;
 
-   int curr_x, curr_y;  /**< for iterating over bins */
+   /**
+    * Conservative per-tile depth bound, maintained while binning:
+    * once the commands binned so far have executed, every value in a
+    * tile's depth buffer is known to be <= tile_zmax[x][y]
+    * (+INFINITY when nothing is known).  Seeded by depth clears,
+    * narrowed by tile-covering occluders and used by
+    * lp_setup_bin_triangle() to drop primitives which cannot pass a
+    * LESS/LEQUAL depth test anywhere in a tile.
+    */
+   float tile_zmax[TILES_X][TILES_Y];
+
+   unsigned num_bins;   /**< tiles_x * tiles_y, set at bin_iter_begin */
+   unsigned curr_bin;   /**< next bin_order entry to hand out */
+   /**
+    * Order in which the rasterizer threads pick up bins, heaviest bins
+    * first so that an expensive tile doesn't end up as the last one a
+    * lone thread chews on while the others idle.  Entries are packed
+    * bin coordinates: x | (y << 8).
+    */
+   uint16_t bin_order[TILES_X * TILES_Y];
    mtx_t mutex;
 
    struct cmd_bin tile[TILES_X][TILES_Y];
@@ -377,6 +396,16 @@ lp_scene_get_num_bins( const struct lp_scene *scene )
 }
 
 
+/* Slack added to tile_zmax values so depth format quantization (which
+ * may round up) can never push a stored depth value above the bound.
+ * One z16 unorm step covers the worst case of the formats we support.
+ */
+#define LP_SCENE_ZMAX_PAD (1.0f / 65536.0f)
+
+void
+lp_scene_zmax_set_all( struct lp_scene *scene, float zmax );
+
+
 void
 lp_scene_bin_iter_begin( struct lp_scene *scene );
 
@@ -80,6 +80,7 @@ lp_setup_get_empty_scene(struct lp_setup_context *setup)
                       __FUNCTION__, setup->scene->fence->id);
 
       lp_fence_wait(setup->scene->fence);
+      lp_fence_reference(&setup->scene->fence, NULL);
    }
 
    lp_scene_begin_binning(setup->scene, &setup->fb);
@@ -167,21 +168,16 @@ lp_setup_rasterize_scene( struct lp_setup_context *setup )
 
    mtx_lock(&screen->rast_mutex);
 
-   /* FIXME: We enqueue the scene then wait on the rasterizer to finish.
-    * This means we never actually run any vertex stuff in parallel to
-    * rasterization (not in the same context at least) which is what the
-    * multiple scenes per setup is about - when we get a new empty scene
-    * any old one is already empty again because we waited here for
-    * raster tasks to be finished. Ideally, we shouldn't need to wait here
-    * and rely on fences elsewhere when waiting is necessary.
-    * Certainly, lp_scene_end_rasterization() would need to be deferred too
-    * and there's probably other bits why this doesn't actually work.
+   /* Hand the scene off to the rasterizer without waiting for it.  The
+    * rasterizer retires the scene itself (lp_rast_end) before the scene's
+    * fence completes, so anyone who needs the results waits on the fence
+    * and lp_setup_get_empty_scene() provides the backpressure when all
+    * scenes are in flight.  In the unthreaded case lp_rast_queue_scene()
+    * rasterizes synchronously and nothing overlaps.
     */
    lp_rast_queue_scene(screen->rast, scene);
-   lp_rast_finish(screen->rast);
    mtx_unlock(&screen->rast_mutex);
 
-   lp_scene_end_rasterization(setup->scene);
    lp_setup_reset( setup );
 
    LP_DBG(DEBUG_SETUP, "%s done \n", __FUNCTION__);
@@ -253,6 +249,10 @@ begin_binning( struct lp_setup_context *setup )
                                           setup->clear.zsmask));
          if (!ok)
             return FALSE;
+
+         if (setup->clear.flags & PIPE_CLEAR_DEPTH)
+            lp_scene_zmax_set_all(scene,
+                                  setup->clear.depth + LP_SCENE_ZMAX_PAD);
       }
    }
 
@@ -343,6 +343,7 @@ set_scene_state( struct lp_setup_context *setup,
 fail:
    if (setup->scene) {
       lp_scene_end_rasterization(setup->scene);
+      lp_fence_reference(&setup->scene->fence, NULL);
       setup->scene = NULL;
    }
 
@@ -367,6 +368,17 @@ lp_setup_flush( struct lp_setup_context *setup,
 }
 
 
+void
+lp_setup_finish( struct lp_setup_context *setup )
+{
+   /* The rasterizer consumes scenes in submission order, so the fence of
+    * the last queued scene covers every scene this context has queued.
+    */
+   if (setup->last_fence)
+      lp_fence_wait(setup->last_fence);
+}
+
+
 void
 lp_setup_bind_framebuffer( struct lp_setup_context *setup,
                            const struct pipe_framebuffer_state *fb )
@@ -516,6 +528,9 @@ lp_setup_try_clear_zs(struct lp_setup_context *setup,
                                    LP_RAST_OP_CLEAR_ZSTENCIL,
                                    lp_rast_arg_clearzs(zsvalue, zsmask)))
          return FALSE;
+
+      if (flags & PIPE_CLEAR_DEPTH)
+         lp_scene_zmax_set_all(scene, (float)depth + LP_SCENE_ZMAX_PAD);
    }
    else {
       /* Put ourselves into the 'pre-clear' state, specifically to try
@@ -527,6 +542,9 @@ lp_setup_try_clear_zs(struct lp_setup_context *setup,
 
       setup->clear.flags |= flags;
 
+      if (flags & PIPE_CLEAR_DEPTH)
+         setup->clear.depth = (float)depth;
+
       setup->clear.zsmask |= zsmask;
       setup->clear.zsvalue =
          (setup->clear.zsvalue & ~zsmask) | (zsvalue & zsmask);
@@ -985,9 +1003,19 @@ lp_setup_is_resource_referenced( const struct lp_setup_context *setup,
       return LP_REFERENCED_FOR_READ | LP_REFERENCED_FOR_WRITE;
    }
 
-   /* check textures referenced by the scene */
+   /* check textures referenced by the scenes */
    for (i = 0; i < ARRAY_SIZE(setup->scenes); i++) {
-      if (lp_scene_is_resource_referenced(setup->scenes[i], texture)) {
+      struct lp_scene *scene = setup->scenes[i];
+
+      /* Scenes that have been handed to the rasterizer drop their resource
+       * references on the rasterizer threads, so don't walk their lists
+       * while that can happen; just report them as referenced.
+       */
+      if (scene->fence && scene->fence->issued &&
+          !lp_fence_signalled(scene->fence))
+         return LP_REFERENCED_FOR_READ;
+
+      if (lp_scene_is_resource_referenced(scene, texture)) {
          return LP_REFERENCED_FOR_READ;
       }
    }
@@ -1291,7 +1319,7 @@ lp_setup_destroy( struct lp_setup_context *setup )
    for (i = 0; i < ARRAY_SIZE(setup->scenes); i++) {
       struct lp_scene *scene = setup->scenes[i];
 
-      if (scene->fence)
+      if (scene->fence && scene->fence->issued)
          lp_fence_wait(scene->fence);
 
       lp_scene_destroy(scene);
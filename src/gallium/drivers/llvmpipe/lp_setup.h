@@ -67,6 +67,9 @@ lp_setup_flush( struct lp_setup_context *setup,
                 struct pipe_fence_handle **fence,
                 const char *reason);
 
+void
+lp_setup_finish( struct lp_setup_context *setup );
+
 
 void
 lp_setup_bind_framebuffer( struct lp_setup_context *setup,
@@ -54,9 +54,11 @@
 struct lp_setup_variant;
 
 
-/** Max number of scenes */
-/* XXX: make multiple scenes per context work, see lp_setup_rasterize_scene */
-#define MAX_SCENES 1
+/** Max number of scenes.  With n scenes, n-1 can be queued or in
+ * rasterization while the nth is being built; lp_setup_get_empty_scene()
+ * waits on the scene's fence before reusing it.
+ */
+#define MAX_SCENES 4
 
 
 
@@ -121,6 +123,8 @@ struct lp_setup_context
       union util_color color_val[PIPE_MAX_COLOR_BUFS];
       uint64_t zsmask;
       uint64_t zsvalue;               /**< lp_rast_clear_zstencil() cmd */
+      float depth;                    /**< clear depth as float, for the
+                                       *   scene's depth bounds */
    } clear;
 
    enum setup_state {
@@ -748,6 +748,50 @@ floor_pot(uint32_t n)
 }
 
 
+/**
+ * Can primitives binned with the current state raise values in the
+ * depth buffer?  If so, the conservative per-tile depth bounds kept
+ * in scene->tile_zmax must be dropped for every tile they touch.
+ */
+static boolean
+lp_setup_depth_may_raise(const struct lp_fragment_shader_variant_key *fskey)
+{
+   return fskey->depth.enabled &&
+          fskey->depth.writemask &&
+          (fskey->depth.func == PIPE_FUNC_GREATER ||
+           fskey->depth.func == PIPE_FUNC_GEQUAL ||
+           fskey->depth.func == PIPE_FUNC_NOTEQUAL ||
+           fskey->depth.func == PIPE_FUNC_ALWAYS);
+}
+
+
+/**
+ * Conservative range of the interpolated position z over a pixel
+ * rectangle, from the plane values at the four corners.  The range is
+ * padded so that neither the float rounding of the rasterizer's own
+ * interpolation nor the depth format conversion can produce a value
+ * outside it.
+ */
+static void
+lp_setup_tri_z_range(const struct lp_rast_triangle *tri,
+                     int x0, int y0, int x1, int y1,
+                     float *zmin, float *zmax)
+{
+   const float a0   = GET_A0(&tri->inputs)[0][2];
+   const float dadx = GET_DADX(&tri->inputs)[0][2];
+   const float dady = GET_DADY(&tri->inputs)[0][2];
+   float z00 = a0 + dadx * x0 + dady * y0;
+   float z10 = a0 + dadx * x1 + dady * y0;
+   float z01 = a0 + dadx * x0 + dady * y1;
+   float z11 = a0 + dadx * x1 + dady * y1;
+   float pad = (fabsf(a0) + fabsf(dadx) * x1 + fabsf(dady) * y1) *
+               (1.0f / (1 << 20)) + LP_SCENE_ZMAX_PAD;
+
+   *zmin = MIN2(MIN2(z00, z10), MIN2(z01, z11)) - pad;
+   *zmax = MAX2(MAX2(z00, z10), MAX2(z01, z11)) + pad;
+}
+
+
 boolean
 lp_setup_bin_triangle(struct lp_setup_context *setup,
                       struct lp_rast_triangle *tri,
@@ -757,7 +801,12 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                       unsigned viewport_index)
 {
    struct lp_scene *scene = setup->scene;
-   struct u_rect trimmed_box = *bbox;   
+   const struct lp_fragment_shader_variant *variant = setup->fs.current.variant;
+   const struct lp_fragment_shader_variant_key *fskey = &variant->key;
+   boolean z_can_cull = FALSE;
+   boolean z_can_update = FALSE;
+   boolean z_may_raise = FALSE;
+   struct u_rect trimmed_box = *bbox;
    int i;
    /* What is the largest power-of-two boundary this triangle crosses:
     */
@@ -789,6 +838,32 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
    u_rect_find_intersection(&setup->draw_regions[viewport_index],
                             &trimmed_box);
 
+   /* Conservative bin-time depth rejection (see scene->tile_zmax).
+    * Only usable when fragment depth is the interpolated position z
+    * and the depth func is a LESS variant; dropping a fully occluded
+    * primitive must also not have observable side effects, so stencil
+    * updates, shader memory writes and binned queries all disqualify.
+    * Narrowing the bound additionally requires that every covered
+    * pixel is guaranteed to get the interpolated z written.
+    */
+   if (scene->fb.zsbuf &&
+       fskey->depth.enabled &&
+       !fskey->depth_clamp &&
+       !fskey->stencil[0].enabled &&
+       !variant->shader->info.base.writes_z &&
+       (fskey->depth.func == PIPE_FUNC_LESS ||
+        fskey->depth.func == PIPE_FUNC_LEQUAL)) {
+      z_can_cull = !variant->shader->info.base.writes_memory &&
+                   setup->active_binned_queries == 0;
+      z_can_update = scene->fb_max_layer == 0 &&
+                     fskey->depth.writemask &&
+                     !fskey->alpha.enabled &&
+                     !fskey->blend.alpha_to_coverage &&
+                     !variant->shader->info.base.uses_kill &&
+                     !variant->shader->info.base.writes_samplemask;
+   }
+   z_may_raise = scene->fb.zsbuf && lp_setup_depth_may_raise(fskey);
+
    /* Determine which tile(s) intersect the triangle's bounding box
     */
    if (dx < TILE_SIZE)
@@ -801,6 +876,19 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
       assert(iy0 == bbox->y1 / TILE_SIZE &&
 	     ix0 == bbox->x1 / TILE_SIZE);
 
+      if (z_can_cull) {
+         float zmin, zmax;
+         lp_setup_tri_z_range(tri, bbox->x0, bbox->y0, bbox->x1, bbox->y1,
+                              &zmin, &zmax);
+         if (zmin > scene->tile_zmax[ix0][iy0]) {
+            /* Everything lies behind the current depth bound. */
+            LP_COUNT(nr_zculled_64);
+            return TRUE;
+         }
+      }
+      if (z_may_raise)
+         scene->tile_zmax[ix0][iy0] = INFINITY;
+
       if (nr_planes == 3) {
          if (sz < 4)
          {
@@ -913,6 +1001,7 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
          {
             int out = 0;
             int partial = 0;
+            float zmin = 0.0f, zmax = 0.0f;
 
             for (i = 0; i < nr_planes; i++) {
                int64_t planeout = cx[i] + eo[i];
@@ -921,19 +1010,33 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                partial |= ((int) (planepartial >> 63)) & (1<<i);
             }
 
+            if (!out && (z_can_cull || z_can_update))
+               lp_setup_tri_z_range(tri,
+                                    x * TILE_SIZE, y * TILE_SIZE,
+                                    x * TILE_SIZE + TILE_SIZE - 1,
+                                    y * TILE_SIZE + TILE_SIZE - 1,
+                                    &zmin, &zmax);
+
             if (out) {
                /* do nothing */
                if (in)
                   break;  /* exiting triangle, all done with this row */
                LP_COUNT(nr_empty_64);
             }
+            else if (z_can_cull && zmin > scene->tile_zmax[x][y]) {
+               /* The tile's part of the triangle lies entirely behind
+                * the depth bound - drop it.
+                */
+               in = TRUE;
+               LP_COUNT(nr_zculled_64);
+            }
             else if (partial) {
                /* Not trivially accepted by at least one plane -
                 * rasterize/shade partial tile
                 */
                int count = util_bitcount(partial);
                in = TRUE;
-               
+
                if (!lp_scene_bin_cmd_with_state( scene, x, y,
                                                  setup->fs.stored,
                                                  use_32bits ?
@@ -943,6 +1046,9 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                   goto fail;
 
                LP_COUNT(nr_partially_covered_64);
+
+               if (z_may_raise)
+                  scene->tile_zmax[x][y] = INFINITY;
             }
             else {
                /* triangle covers the whole tile- shade whole tile */
@@ -950,6 +1056,20 @@ lp_setup_bin_triangle(struct lp_setup_context *setup,
                in = TRUE;
                if (!lp_setup_whole_tile(setup, &tri->inputs, x, y))
                   goto fail;
+
+               if (z_may_raise) {
+                  scene->tile_zmax[x][y] = INFINITY;
+               }
+               else if (z_can_update &&
+                        scene->tile_zmax[x][y] != INFINITY &&
+                        zmax < scene->tile_zmax[x][y]) {
+                  /* The whole tile now holds depths <= zmax.  Don't
+                   * narrow unknown (INFINITY) bounds: buffer contents
+                   * a LESS test never overwrites (e.g. NaNs in a
+                   * float zsbuf) would make that wrong.
+                   */
+                  scene->tile_zmax[x][y] = zmax;
+               }
             }
 
             /* Iterate cx values across the region: */
@@ -76,6 +76,46 @@ panfrost_job_type_for_pipe(enum pipe_shader_type type)
         }
 }
 
+/* The tiler polygon list is statically sized for the worst case of the
+ * *current* framebuffer and hierarchy mask, which is usually a small fraction
+ * of the absolute worst case we used to allocate up front. We round the size
+ * up to a power-of-two page count to bound the number of reallocations. */
+
+static unsigned
+panfrost_polygon_list_size(unsigned needed)
+{
+        return util_next_power_of_two(DIV_ROUND_UP(needed, 4096)) * 4096;
+}
+
+static void
+panfrost_realloc_polygon_list(struct panfrost_context *ctx, unsigned size)
+{
+        struct panfrost_screen *screen = pan_screen(ctx->base.screen);
+
+        /* Jobs still in flight hold their own references to the old buffer,
+         * so our handle can be dropped immediately */
+
+        panfrost_drm_free_slab(screen, &ctx->tiler_polygon_list);
+        panfrost_drm_allocate_slab(screen, &ctx->tiler_polygon_list,
+                        size / 4096, false,
+                        PAN_ALLOCATE_INVISIBLE | PAN_ALLOCATE_GROWABLE,
+                        1, 128);
+}
+
+/* Grow the polygon list on demand, called whenever a framebuffer descriptor
+ * is emitted so the list is always big enough before any job references it */
+
+static void
+panfrost_ensure_polygon_list(struct panfrost_context *ctx, unsigned needed)
+{
+        ctx->tiler_polygon_list_needed = needed;
+
+        if (ctx->tiler_polygon_list.size >= needed)
+                return;
+
+        panfrost_realloc_polygon_list(ctx, panfrost_polygon_list_size(needed));
+}
+
 /* Framebuffer descriptor */
 
 static void
@@ -95,6 +135,15 @@ panfrost_set_framebuffer_resolution(struct mali_single_framebuffer *fb, int w, i
 struct mali_single_framebuffer
 panfrost_emit_sfbd(struct panfrost_context *ctx, unsigned vertex_count)
 {
+        /* The SFBD uses a fixed polygon list layout: header at the start of
+         * the buffer, body at a fixed 40960 byte offset. Mask is 0xF0 */
+
+        unsigned body_size = panfrost_tiler_body_size(
+                        ctx->pipe_framebuffer.width,
+                        ctx->pipe_framebuffer.height, 0xF0);
+
+        panfrost_ensure_polygon_list(ctx, 40960 + body_size);
+
         struct mali_single_framebuffer framebuffer = {
                 .unknown2 = 0x1f,
                 .format = 0x30000000,
@@ -152,7 +201,7 @@ panfrost_emit_mfbd(struct panfrost_context *ctx, unsigned vertex_count)
         unsigned total_size = header_size + body_size;
 
         if (framebuffer.tiler_hierarchy_mask) {
-               assert(ctx->tiler_polygon_list.size >= total_size);
+                panfrost_ensure_polygon_list(ctx, total_size);
 
                 /* Specify allocated tiler structures */
                 framebuffer.tiler_polygon_list = ctx->tiler_polygon_list.gpu;
@@ -251,6 +300,24 @@ panfrost_invalidate_frame(struct panfrost_context *ctx)
         if ((++ctx->cmdstream_i) == (sizeof(ctx->transient_pools) / sizeof(ctx->transient_pools[0])))
                 ctx->cmdstream_i = 0;
 
+        /* If the polygon list has been oversized for a sustained period --
+         * e.g. after switching away from a large FBO -- shrink it back down
+         * rather than pinning the high-water mark forever. The emit below
+         * regrows it if this guess turns out wrong */
+
+        unsigned pl_target =
+                panfrost_polygon_list_size(ctx->tiler_polygon_list_needed);
+
+        if (ctx->tiler_polygon_list_needed &&
+            pl_target < ctx->tiler_polygon_list.size) {
+                if (++ctx->tiler_polygon_list_slack_frames > 128) {
+                        panfrost_realloc_polygon_list(ctx, pl_target);
+                        ctx->tiler_polygon_list_slack_frames = 0;
+                }
+        } else {
+                ctx->tiler_polygon_list_slack_frames = 0;
+        }
+
         if (ctx->require_sfbd)
                 ctx->vt_framebuffer_sfbd = panfrost_emit_sfbd(ctx, ~0);
         else
@@ -2739,7 +2806,10 @@ panfrost_setup_hardware(struct panfrost_context *ctx)
         panfrost_drm_allocate_slab(screen, &ctx->varying_mem, 16384, false, PAN_ALLOCATE_INVISIBLE | PAN_ALLOCATE_COHERENT_LOCAL, 0, 0);
         panfrost_drm_allocate_slab(screen, &ctx->shaders, 4096, true, PAN_ALLOCATE_EXECUTE, 0, 0);
         panfrost_drm_allocate_slab(screen, &ctx->tiler_heap, 32768, false, PAN_ALLOCATE_INVISIBLE | PAN_ALLOCATE_GROWABLE, 1, 128);
-        panfrost_drm_allocate_slab(screen, &ctx->tiler_polygon_list, 128*128, false, PAN_ALLOCATE_INVISIBLE | PAN_ALLOCATE_GROWABLE, 1, 128);
+        /* The polygon list starts small and is grown on demand from the
+         * framebuffer descriptor emission, since the worst case over all
+         * framebuffers is tens of megabytes that most contexts never need */
+        panfrost_drm_allocate_slab(screen, &ctx->tiler_polygon_list, 128, false, PAN_ALLOCATE_INVISIBLE | PAN_ALLOCATE_GROWABLE, 1, 128);
         panfrost_drm_allocate_slab(screen, &ctx->tiler_dummy, 1, false, PAN_ALLOCATE_INVISIBLE, 0, 0);
 }
 
@@ -136,6 +136,12 @@ struct panfrost_context {
         struct panfrost_memory tiler_dummy;
         struct panfrost_memory depth_stencil_buffer;
 
+        /* Bytes of polygon list the current framebuffer configuration
+         * actually needs, and for how many consecutive frames the allocation
+         * has been oversized, used to shrink the list when load drops */
+        unsigned tiler_polygon_list_needed;
+        unsigned tiler_polygon_list_slack_frames;
+
         struct panfrost_query *occlusion_query;
 
         /* Each draw has corresponding vertex and tiler payloads */
@@ -182,6 +182,16 @@ void si_init_resource_fields(struct si_screen *sscreen,
 	if (res->b.b.flags & SI_RESOURCE_FLAG_32BIT)
 		res->flags |= RADEON_FLAG_32BIT;
 
+	/* A buffer taking a large fraction of VRAM is certain to be evicted
+	 * under memory pressure.  List GTT as a secondary placement so the
+	 * kernel can leave it there instead of migrating it back into VRAM
+	 * on every command submission, which thrashes TTM.
+	 */
+	if (res->b.b.target == PIPE_BUFFER &&
+	    res->domains == RADEON_DOMAIN_VRAM &&
+	    res->bo_size >= sscreen->info.vram_size / 4)
+		res->domains |= RADEON_DOMAIN_GTT;
+
 	/* Set expected VRAM and GART usage for the buffer. */
 	res->vram_usage = 0;
 	res->gart_usage = 0;
@@ -284,6 +294,15 @@ si_invalidate_buffer(struct si_context *sctx,
 	if (buf->b.is_user_ptr)
 		return false;
 
+	/* If the CPU kept reading this buffer back, take it out of
+	 * write-combined memory while we're reallocating anyway; uncached
+	 * reads are orders of magnitude slower than cached GTT.
+	 */
+	if (buf->cpu_read_maps > 3 &&
+	    buf->domains & RADEON_DOMAIN_GTT &&
+	    buf->flags & RADEON_FLAG_GTT_WC)
+		buf->flags &= ~RADEON_FLAG_GTT_WC;
+
 	/* Check if mapping this buffer would cause waiting for the GPU. */
 	if (si_rings_is_buffer_referenced(sctx, buf->buf, RADEON_USAGE_READWRITE) ||
 	    !sctx->ws->buffer_wait(buf->buf, 0, RADEON_USAGE_READWRITE)) {
@@ -390,6 +409,10 @@ static void *si_buffer_transfer_map(struct pipe_context *ctx,
 	if (buf->b.is_user_ptr)
 		usage |= PIPE_TRANSFER_PERSISTENT;
 
+	/* Remember CPU read mappings for adaptive placement. */
+	if (usage & PIPE_TRANSFER_READ)
+		p_atomic_inc(&buf->cpu_read_maps);
+
 	/* See if the buffer range being mapped has never been initialized,
 	 * in which case it can be mapped unsynchronized. */
 	if (!(usage & (PIPE_TRANSFER_UNSYNCHRONIZED |
@@ -226,9 +226,10 @@ static bool vi_get_fast_clear_parameters(enum pipe_format base_format,
 	return true;
 }
 
-void vi_dcc_clear_level(struct si_context *sctx,
-			struct si_texture *tex,
-			unsigned level, unsigned clear_value)
+static void vi_dcc_get_clear_info(struct si_context *sctx,
+				  struct si_texture *tex,
+				  unsigned level, unsigned clear_value,
+				  struct si_buffer_clear *out)
 {
 	struct pipe_resource *dcc_buffer;
 	uint64_t dcc_offset, clear_size;
@@ -266,8 +267,21 @@ void vi_dcc_clear_level(struct si_context *sctx,
 			     num_layers;
 	}
 
-	si_clear_buffer(sctx, dcc_buffer, dcc_offset, clear_size,
-			&clear_value, 4, SI_COHERENCY_CB_META, false);
+	out->dst = dcc_buffer;
+	out->offset = dcc_offset;
+	out->size = clear_size;
+	out->value = clear_value;
+}
+
+void vi_dcc_clear_level(struct si_context *sctx,
+			struct si_texture *tex,
+			unsigned level, unsigned clear_value)
+{
+	struct si_buffer_clear clear;
+
+	vi_dcc_get_clear_info(sctx, tex, level, clear_value, &clear);
+	si_clear_buffer(sctx, clear.dst, clear.offset, clear.size,
+			&clear.value, 4, SI_COHERENCY_CB_META, false);
 }
 
 /* Set the same micro tile mode as the destination of the last MSAA resolve.
@@ -383,6 +397,8 @@ static void si_do_fast_color_clear(struct si_context *sctx,
 				   const union pipe_color_union *color)
 {
 	struct pipe_framebuffer_state *fb = &sctx->framebuffer.state;
+	struct si_buffer_clear meta_clears[2 * PIPE_MAX_COLOR_BUFS];
+	unsigned num_meta_clears = 0;
 	int i;
 
 	/* This function is broken in BE, so just disable this path for now */
@@ -497,14 +513,18 @@ static void si_do_fast_color_clear(struct si_context *sctx,
 				if (eliminate_needed)
 					continue;
 
-				uint32_t clear_value = 0xCCCCCCCC;
-				si_clear_buffer(sctx, &tex->cmask_buffer->b.b,
-						tex->cmask_offset, tex->surface.cmask_size,
-						&clear_value, 4, SI_COHERENCY_CB_META, false);
+				struct si_buffer_clear *clear =
+					&meta_clears[num_meta_clears++];
+
+				clear->dst = &tex->cmask_buffer->b.b;
+				clear->offset = tex->cmask_offset;
+				clear->size = tex->surface.cmask_size;
+				clear->value = 0xCCCCCCCC;
 				fmask_decompress_needed = true;
 			}
 
-			vi_dcc_clear_level(sctx, tex, 0, reset_value);
+			vi_dcc_get_clear_info(sctx, tex, 0, reset_value,
+					      &meta_clears[num_meta_clears++]);
 			tex->separate_dcc_dirty = true;
 		} else {
 			if (too_small)
@@ -525,10 +545,13 @@ static void si_do_fast_color_clear(struct si_context *sctx,
 				continue;
 
 			/* Do the fast clear. */
-			uint32_t clear_value = 0;
-			si_clear_buffer(sctx, &tex->cmask_buffer->b.b,
-					tex->cmask_offset, tex->surface.cmask_size,
-					&clear_value, 4, SI_COHERENCY_CB_META, false);
+			struct si_buffer_clear *clear =
+				&meta_clears[num_meta_clears++];
+
+			clear->dst = &tex->cmask_buffer->b.b;
+			clear->offset = tex->cmask_offset;
+			clear->size = tex->surface.cmask_size;
+			clear->value = 0;
 			eliminate_needed = true;
 		}
 
@@ -554,6 +577,10 @@ static void si_do_fast_color_clear(struct si_context *sctx,
 			si_mark_atom_dirty(sctx, &sctx->atoms.s.framebuffer);
 		}
 	}
+
+	/* Execute all gathered CMASK/DCC clears in one batch. */
+	si_execute_buffer_clears(sctx, meta_clears, num_meta_clears,
+				 SI_COHERENCY_CB_META);
 }
 
 static void si_clear(struct pipe_context *ctx, unsigned buffers,
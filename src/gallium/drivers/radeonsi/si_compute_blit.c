@@ -279,6 +279,110 @@ void si_clear_buffer(struct si_context *sctx, struct pipe_resource *dst,
 	}
 }
 
+/**
+ * Execute a batch of small dword-aligned buffer clears as one compute pass:
+ * one dispatch per clear, but a single barrier pair and a single state
+ * save/restore for the whole batch. Clearing each range separately would
+ * serialize the command processor between every operation, which adds up
+ * when many small metadata clears are issued per frame. The cleared ranges
+ * must not overlap.
+ */
+void si_execute_buffer_clears(struct si_context *sctx,
+			      const struct si_buffer_clear *clears,
+			      unsigned num_clears,
+			      enum si_coherency coher)
+{
+	struct pipe_context *ctx = &sctx->b;
+	bool any_bypass = false;
+	unsigned i;
+
+	/* A single clear doesn't benefit from batching; let si_clear_buffer
+	 * pick between CP DMA and compute as usual. */
+	if (num_clears <= 1) {
+		for (i = 0; i < num_clears; i++) {
+			uint32_t value = clears[i].value;
+
+			si_clear_buffer(sctx, clears[i].dst, clears[i].offset,
+					clears[i].size, &value, 4, coher,
+					false);
+		}
+		return;
+	}
+
+	si_compute_internal_begin(sctx);
+	sctx->flags |= SI_CONTEXT_PS_PARTIAL_FLUSH |
+		       SI_CONTEXT_CS_PARTIAL_FLUSH |
+		       si_get_flush_flags(sctx, coher, SI_COMPUTE_DST_CACHE_POLICY);
+
+	/* Save states. */
+	void *saved_cs = sctx->cs_shader_state.program;
+	struct pipe_shader_buffer saved_sb = {};
+	si_get_shader_buffers(sctx, PIPE_SHADER_COMPUTE, 0, 1, &saved_sb);
+
+	unsigned saved_writable_mask =
+		sctx->const_and_shader_buffers[PIPE_SHADER_COMPUTE].writable_mask &
+		(1u << si_get_shaderbuf_slot(0)) ? 1 : 0;
+
+	bool shader_dst_stream_policy = SI_COMPUTE_DST_CACHE_POLICY != L2_LRU;
+
+	if (!sctx->cs_clear_buffer) {
+		sctx->cs_clear_buffer = si_create_dma_compute_shader(&sctx->b,
+						     SI_COMPUTE_CLEAR_DW_PER_THREAD,
+						     shader_dst_stream_policy, false);
+	}
+	ctx->bind_compute_state(ctx, sctx->cs_clear_buffer);
+
+	for (i = 0; i < num_clears; i++) {
+		assert(clears[i].offset % 4 == 0);
+		assert(clears[i].size % 4 == 0);
+		assert(clears[i].size);
+		assert(clears[i].dst->target != PIPE_BUFFER ||
+		       clears[i].offset + clears[i].size <= clears[i].dst->width0);
+
+		/* The grid computation matches si_compute_do_clear_or_copy. */
+		unsigned dwords_per_thread = SI_COMPUTE_CLEAR_DW_PER_THREAD;
+		unsigned instructions_per_thread = MAX2(1, dwords_per_thread / 4);
+		unsigned dwords_per_instruction = dwords_per_thread / instructions_per_thread;
+		unsigned dwords_per_wave = dwords_per_thread * 64;
+
+		unsigned num_dwords = clears[i].size / 4;
+		unsigned num_instructions = DIV_ROUND_UP(num_dwords, dwords_per_instruction);
+
+		struct pipe_grid_info info = {};
+		info.block[0] = MIN2(64, num_instructions);
+		info.block[1] = 1;
+		info.block[2] = 1;
+		info.grid[0] = DIV_ROUND_UP(num_dwords, dwords_per_wave);
+		info.grid[1] = 1;
+		info.grid[2] = 1;
+
+		struct pipe_shader_buffer sb = {};
+		sb.buffer = clears[i].dst;
+		sb.buffer_offset = clears[i].offset;
+		sb.buffer_size = clears[i].size;
+
+		for (unsigned j = 0; j < 4; j++)
+			sctx->cs_user_data[j] = clears[i].value;
+
+		ctx->set_shader_buffers(ctx, PIPE_SHADER_COMPUTE, 0, 1, &sb, 0x1);
+		ctx->launch_grid(ctx, &info);
+
+		if (get_cache_policy(sctx, coher, clears[i].size) == L2_BYPASS)
+			any_bypass = true;
+		else
+			si_resource(clears[i].dst)->TC_L2_dirty = true;
+	}
+
+	sctx->flags |= SI_CONTEXT_CS_PARTIAL_FLUSH |
+		       (any_bypass ? SI_CONTEXT_WB_L2 : 0);
+
+	/* Restore states. */
+	ctx->bind_compute_state(ctx, saved_cs);
+	ctx->set_shader_buffers(ctx, PIPE_SHADER_COMPUTE, 0, 1, &saved_sb,
+				saved_writable_mask);
+	si_compute_internal_end(sctx);
+}
+
 static void si_pipe_clear_buffer(struct pipe_context *ctx,
 				 struct pipe_resource *dst,
 				 unsigned offset, unsigned size,
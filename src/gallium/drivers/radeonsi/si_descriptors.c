@@ -129,6 +129,20 @@ static void si_init_descriptors(struct si_descriptors *desc,
 	desc->num_elements = num_elements;
 	desc->shader_userdata_offset = shader_userdata_rel_index * 4;
 	desc->slot_index_to_bind_directly = -1;
+	desc->dirty_slot_mask = ~0ull;
+}
+
+/**
+ * Mark a descriptor slot as modified since the last upload.
+ *
+ * Slots >= 64 all share the last bit of the mask, which only makes the
+ * tracking conservative: the next upload can't be skipped even if just
+ * those slots are clean.
+ */
+static void si_mark_descriptor_slot_dirty(struct si_descriptors *desc,
+					  unsigned slot)
+{
+	desc->dirty_slot_mask |= 1ull << MIN2(slot, 63);
 }
 
 static void si_release_descriptors(struct si_descriptors *desc)
@@ -151,6 +165,14 @@ static bool si_upload_descriptors(struct si_context *sctx,
 	if (!upload_size)
 		return true;
 
+	/* Skip the upload if no slot has been modified since the last upload.
+	 * The buffer holding the previous upload is still alive and its
+	 * contents still match desc->list, so the current shader pointer can
+	 * simply be re-emitted.
+	 */
+	if (!desc->dirty_slot_mask && desc->gpu_address)
+		return true;
+
 	/* If there is just one active descriptor, bind it directly. */
 	if ((int)desc->first_active_slot == desc->slot_index_to_bind_directly &&
 	    desc->num_active_slots == 1) {
@@ -161,6 +183,7 @@ static bool si_upload_descriptors(struct si_context *sctx,
 		si_resource_reference(&desc->buffer, NULL);
 		desc->gpu_list = NULL;
 		desc->gpu_address = si_desc_extract_buffer_address(descriptor);
+		desc->dirty_slot_mask = 0;
 		si_mark_atom_dirty(sctx, &sctx->atoms.s.shader_pointers);
 		return true;
 	}
@@ -191,6 +214,7 @@ static bool si_upload_descriptors(struct si_context *sctx,
 	assert((desc->buffer->gpu_address >> 32) == sctx->screen->info.address32_hi);
 	assert((desc->gpu_address >> 32) == sctx->screen->info.address32_hi);
 
+	desc->dirty_slot_mask = 0;
 	si_mark_atom_dirty(sctx, &sctx->atoms.s.shader_pointers);
 	return true;
 }
@@ -493,6 +517,7 @@ static void si_set_sampler_view(struct si_context *sctx,
 	struct si_descriptors *descs = si_sampler_and_image_descriptors(sctx, shader);
 	unsigned desc_slot = si_get_sampler_slot(slot);
 	uint32_t *desc = descs->list + desc_slot * 16;
+	bool desc_changed = true;
 
 	if (samplers->views[slot] == view && !disallow_early_out)
 		return;
@@ -500,8 +525,21 @@ static void si_set_sampler_view(struct si_context *sctx,
 	if (view) {
 		struct si_texture *tex = (struct si_texture *)view->texture;
 
-		si_set_sampler_view_desc(sctx, sview,
-					 samplers->sampler_states[slot], desc);
+		if (unlikely(disallow_early_out)) {
+			/* si_update_all_texture_descriptors is re-validating
+			 * a bound slot. Only dirty the list if the descriptor
+			 * actually changed. */
+			uint32_t old_desc[16];
+
+			memcpy(old_desc, desc, sizeof(old_desc));
+			si_set_sampler_view_desc(sctx, sview,
+						 samplers->sampler_states[slot], desc);
+			desc_changed = memcmp(old_desc, desc,
+					      sizeof(old_desc)) != 0;
+		} else {
+			si_set_sampler_view_desc(sctx, sview,
+						 samplers->sampler_states[slot], desc);
+		}
 
 		if (tex->buffer.b.b.target == PIPE_BUFFER) {
 			tex->buffer.bind_history |= PIPE_BIND_SAMPLER_VIEW;
@@ -547,7 +585,11 @@ static void si_set_sampler_view(struct si_context *sctx,
 		samplers->needs_color_decompress_mask &= ~(1u << slot);
 	}
 
-	sctx->descriptors_dirty |= 1u << si_sampler_and_image_descriptors_idx(shader);
+	if (desc_changed) {
+		si_mark_descriptor_slot_dirty(descs, desc_slot);
+		sctx->descriptors_dirty |=
+			1u << si_sampler_and_image_descriptors_idx(shader);
+	}
 }
 
 static void si_update_shader_needs_decompress_mask(struct si_context *sctx,
@@ -652,6 +694,7 @@ si_disable_shader_image(struct si_context *ctx, unsigned shader, unsigned slot)
 
 		memcpy(descs->list + desc_slot*8, null_image_descriptor, 8*4);
 		images->enabled_mask &= ~(1u << slot);
+		si_mark_descriptor_slot_dirty(descs, desc_slot);
 		ctx->descriptors_dirty |= 1u << si_sampler_and_image_descriptors_idx(shader);
 	}
 }
@@ -776,10 +819,21 @@ static void si_set_shader_image(struct si_context *ctx,
 
 	res = si_resource(view->resource);
 
-	if (&images->views[slot] != view)
+	bool desc_changed = true;
+
+	if (&images->views[slot] != view) {
 		util_copy_image_view(&images->views[slot], view);
+		si_set_shader_image_desc(ctx, view, skip_decompress, desc, NULL);
+	} else {
+		/* si_update_all_texture_descriptors is re-validating a bound
+		 * slot. Only dirty the list if the descriptor actually
+		 * changed. */
+		uint32_t old_desc[8];
 
-	si_set_shader_image_desc(ctx, view, skip_decompress, desc, NULL);
+		memcpy(old_desc, desc, sizeof(old_desc));
+		si_set_shader_image_desc(ctx, view, skip_decompress, desc, NULL);
+		desc_changed = memcmp(old_desc, desc, sizeof(old_desc)) != 0;
+	}
 
 	if (res->b.b.target == PIPE_BUFFER ||
 	    view->shader_access & SI_IMAGE_ACCESS_AS_BUFFER) {
@@ -801,7 +855,11 @@ static void si_set_shader_image(struct si_context *ctx,
 	}
 
 	images->enabled_mask |= 1u << slot;
-	ctx->descriptors_dirty |= 1u << si_sampler_and_image_descriptors_idx(shader);
+	if (desc_changed) {
+		si_mark_descriptor_slot_dirty(descs, desc_slot);
+		ctx->descriptors_dirty |=
+			1u << si_sampler_and_image_descriptors_idx(shader);
+	}
 
 	/* Since this can flush, it must be done after enabled_mask is updated. */
 	si_sampler_view_add_buffer(ctx, &res->b.b,
@@ -926,6 +984,7 @@ void si_update_ps_colorbuf0_slot(struct si_context *sctx)
 		buffers->enabled_mask &= ~(1u << slot);
 	}
 
+	si_mark_descriptor_slot_dirty(descs, slot);
 	sctx->descriptors_dirty |= 1u << SI_DESCS_RW_BUFFERS;
 }
 
@@ -975,6 +1034,7 @@ static void si_bind_sampler_states(struct pipe_context *ctx,
 		si_set_sampler_state_desc(sstates[i], sview, tex,
 					  desc->list + desc_slot * 16 + 12);
 
+		si_mark_descriptor_slot_dirty(desc, desc_slot);
 		sctx->descriptors_dirty |= 1u << si_sampler_and_image_descriptors_idx(shader);
 	}
 }
@@ -1251,6 +1311,7 @@ static void si_set_constant_buffer(struct si_context *sctx,
 		buffers->enabled_mask &= ~(1u << slot);
 	}
 
+	si_mark_descriptor_slot_dirty(descs, slot);
 	sctx->descriptors_dirty |= 1u << descriptors_idx;
 }
 
@@ -1305,6 +1366,7 @@ static void si_set_shader_buffer(struct si_context *sctx,
 		memset(desc, 0, sizeof(uint32_t) * 4);
 		buffers->enabled_mask &= ~(1u << slot);
 		buffers->writable_mask &= ~(1u << slot);
+		si_mark_descriptor_slot_dirty(descs, slot);
 		sctx->descriptors_dirty |= 1u << descriptors_idx;
 		return;
 	}
@@ -1335,6 +1397,7 @@ static void si_set_shader_buffer(struct si_context *sctx,
 		buffers->writable_mask &= ~(1u << slot);
 
 	buffers->enabled_mask |= 1u << slot;
+	si_mark_descriptor_slot_dirty(descs, slot);
 	sctx->descriptors_dirty |= 1u << descriptors_idx;
 
 	util_range_add(&buf->valid_buffer_range, sbuffer->buffer_offset,
@@ -1491,6 +1554,7 @@ void si_set_ring_buffer(struct si_context *sctx, uint slot,
 		buffers->enabled_mask &= ~(1u << slot);
 	}
 
+	si_mark_descriptor_slot_dirty(descs, slot);
 	sctx->descriptors_dirty |= 1u << SI_DESCS_RW_BUFFERS;
 }
 
@@ -1592,6 +1656,7 @@ static void si_reset_buffer_resources(struct si_context *sctx,
 		if (buffer && (!buf || buffer == buf)) {
 			si_set_buf_desc_address(si_resource(buffer), buffers->offsets[i],
 						descs->list + i*4);
+			si_mark_descriptor_slot_dirty(descs, i);
 			sctx->descriptors_dirty |= 1u << descriptors_idx;
 
 			radeon_add_to_gfx_buffer_list_check_mem(sctx,
@@ -1656,6 +1721,7 @@ void si_rebind_buffer(struct si_context *sctx, struct pipe_resource *buf)
 
 			si_set_buf_desc_address(si_resource(buffer), buffers->offsets[i],
 						descs->list + i*4);
+			si_mark_descriptor_slot_dirty(descs, i);
 			sctx->descriptors_dirty |= 1u << SI_DESCS_RW_BUFFERS;
 
 			radeon_add_to_gfx_buffer_list_check_mem(sctx,
@@ -1711,6 +1777,7 @@ void si_rebind_buffer(struct si_context *sctx, struct pipe_resource *buf)
 					si_set_buf_desc_address(si_resource(buffer),
 								samplers->views[i]->u.buf.offset,
 								descs->list + desc_slot * 16 + 4);
+					si_mark_descriptor_slot_dirty(descs, desc_slot);
 					sctx->descriptors_dirty |=
 						1u << si_sampler_and_image_descriptors_idx(shader);
 
@@ -1745,6 +1812,7 @@ void si_rebind_buffer(struct si_context *sctx, struct pipe_resource *buf)
 					si_set_buf_desc_address(si_resource(buffer),
 								images->views[i].u.buf.offset,
 								descs->list + desc_slot * 8 + 4);
+					si_mark_descriptor_slot_dirty(descs, desc_slot);
 					sctx->descriptors_dirty |=
 						1u << si_sampler_and_image_descriptors_idx(shader);
 
@@ -2290,6 +2358,7 @@ si_create_bindless_descriptor(struct si_context *sctx, uint32_t *desc_list,
 
 	/* Copy the descriptor into the array. */
 	memcpy(desc->list + desc_slot_offset, desc_list, size);
+	si_mark_descriptor_slot_dirty(desc, desc_slot);
 
 	/* Re-upload the whole array of bindless descriptors into a new buffer.
 	 */
@@ -2893,8 +2962,12 @@ void si_set_active_descriptors(struct si_context *sctx, unsigned desc_idx,
 
 	/* Upload/dump descriptors if slots are being enabled. */
 	if (first < desc->first_active_slot ||
-	    first + count > desc->first_active_slot + desc->num_active_slots)
+	    first + count > desc->first_active_slot + desc->num_active_slots) {
+		/* The active range changed, so the last upload doesn't cover
+		 * the new range even if no slot content changed. */
+		desc->dirty_slot_mask = ~0ull;
 		sctx->descriptors_dirty |= 1u << desc_idx;
+	}
 
 	desc->first_active_slot = first;
 	desc->num_active_slots = count;
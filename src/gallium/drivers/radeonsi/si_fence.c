@@ -191,6 +191,19 @@ static void si_add_syncobj_signal(struct si_context *sctx,
 	sctx->ws->cs_add_syncobj_signal(sctx->gfx_cs, fence);
 }
 
+static void si_free_multi_fence(struct si_screen *sscreen,
+				struct si_multi_fence *fence)
+{
+	mtx_lock(&sscreen->fence_pool_mutex);
+	if (sscreen->num_pooled_fences < ARRAY_SIZE(sscreen->fence_pool)) {
+		sscreen->fence_pool[sscreen->num_pooled_fences++] = fence;
+		fence = NULL;
+	}
+	mtx_unlock(&sscreen->fence_pool_mutex);
+
+	FREE(fence);
+}
+
 static void si_fence_reference(struct pipe_screen *screen,
 			       struct pipe_fence_handle **dst,
 			       struct pipe_fence_handle *src)
@@ -204,16 +217,27 @@ static void si_fence_reference(struct pipe_screen *screen,
 		ws->fence_reference(&(*sdst)->sdma, NULL);
 		tc_unflushed_batch_token_reference(&(*sdst)->tc_token, NULL);
 		si_resource_reference(&(*sdst)->fine.buf, NULL);
-		FREE(*sdst);
+		si_free_multi_fence((struct si_screen *)screen, *sdst);
 	}
         *sdst = ssrc;
 }
 
-static struct si_multi_fence *si_create_multi_fence()
+static struct si_multi_fence *si_create_multi_fence(struct si_screen *sscreen)
 {
-	struct si_multi_fence *fence = CALLOC_STRUCT(si_multi_fence);
-	if (!fence)
-		return NULL;
+	struct si_multi_fence *fence = NULL;
+
+	mtx_lock(&sscreen->fence_pool_mutex);
+	if (sscreen->num_pooled_fences)
+		fence = sscreen->fence_pool[--sscreen->num_pooled_fences];
+	mtx_unlock(&sscreen->fence_pool_mutex);
+
+	if (fence) {
+		memset(fence, 0, sizeof(*fence));
+	} else {
+		fence = CALLOC_STRUCT(si_multi_fence);
+		if (!fence)
+			return NULL;
+	}
 
 	pipe_reference_init(&fence->reference, 1);
 	util_queue_fence_init(&fence->ready);
@@ -224,7 +248,8 @@ static struct si_multi_fence *si_create_multi_fence()
 struct pipe_fence_handle *si_create_fence(struct pipe_context *ctx,
 					  struct tc_unflushed_batch_token *tc_token)
 {
-	struct si_multi_fence *fence = si_create_multi_fence();
+	struct si_multi_fence *fence =
+		si_create_multi_fence((struct si_screen *)ctx->screen);
 	if (!fence)
 		return NULL;
 
@@ -410,7 +435,7 @@ static void si_create_fence_fd(struct pipe_context *ctx,
 
 	*pfence = NULL;
 
-	sfence = si_create_multi_fence();
+	sfence = si_create_multi_fence(sscreen);
 	if (!sfence)
 		return;
 
@@ -435,7 +460,7 @@ static void si_create_fence_fd(struct pipe_context *ctx,
 
 finish:
 	if (!sfence->gfx) {
-		FREE(sfence);
+		si_free_multi_fence(sscreen, sfence);
 		return;
 	}
 
@@ -546,7 +571,8 @@ static void si_flush_from_st(struct pipe_context *ctx,
 			multi_fence = (struct si_multi_fence *)*fence;
 			assert(multi_fence);
 		} else {
-			multi_fence = si_create_multi_fence();
+			multi_fence = si_create_multi_fence(
+					(struct si_screen *)screen);
 			if (!multi_fence) {
 				ws->fence_reference(&sdma_fence, NULL);
 				ws->fence_reference(&gfx_fence, NULL);
@@ -203,6 +203,11 @@ static int si_get_param(struct pipe_screen *pscreen, enum pipe_cap param)
 		return sscreen->info.has_sparse_vm_mappings ?
 				RADEON_SPARSE_PAGE_SIZE : 0;
 
+	case PIPE_CAP_MAX_SPARSE_TEXTURE_SIZE:
+		/* The winsys only maps sparse pages of linear buffers; committing
+		 * texture regions needs per-page tiled address computations. */
+		return 0;
+
 	case PIPE_CAP_PACKED_UNIFORMS:
 		if (sscreen->options.enable_nir)
 			return 1;
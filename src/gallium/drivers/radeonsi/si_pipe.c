@@ -733,6 +733,10 @@ static void si_destroy_screen(struct pipe_screen* pscreen)
 
 	mtx_destroy(&sscreen->gpu_load_mutex);
 
+	for (i = 0; i < sscreen->num_pooled_fences; i++)
+		FREE(sscreen->fence_pool[i]);
+	mtx_destroy(&sscreen->fence_pool_mutex);
+
 	slab_destroy_parent(&sscreen->pool_transfers);
 
 	disk_cache_destroy(sscreen->disk_shader_cache);
@@ -954,6 +958,7 @@ radeonsi_screen_create_impl(struct radeon_winsys *ws,
 
 	(void) mtx_init(&sscreen->aux_context_lock, mtx_plain);
 	(void) mtx_init(&sscreen->gpu_load_mutex, mtx_plain);
+	(void) mtx_init(&sscreen->fence_pool_mutex, mtx_plain);
 
 	si_init_gs_info(sscreen);
 	if (!si_init_shader_cache(sscreen)) {
@@ -988,7 +993,8 @@ radeonsi_screen_create_impl(struct radeon_winsys *ws,
 	if (!util_queue_init(&sscreen->shader_compiler_queue, "sh",
 			     64, num_comp_hi_threads,
 			     UTIL_QUEUE_INIT_RESIZE_IF_FULL |
-			     UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY)) {
+			     UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY |
+			     UTIL_QUEUE_INIT_SCALE_THREADS)) {
 		si_destroy_shader_cache(sscreen);
 		FREE(sscreen);
 		return NULL;
@@ -999,7 +1005,8 @@ radeonsi_screen_create_impl(struct radeon_winsys *ws,
 			     64, num_comp_lo_threads,
 			     UTIL_QUEUE_INIT_RESIZE_IF_FULL |
 			     UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY |
-			     UTIL_QUEUE_INIT_USE_MINIMUM_PRIORITY)) {
+			     UTIL_QUEUE_INIT_USE_MINIMUM_PRIORITY |
+			     UTIL_QUEUE_INIT_SCALE_THREADS)) {
 	       si_destroy_shader_cache(sscreen);
 	       FREE(sscreen);
 	       return NULL;
@@ -261,6 +261,11 @@ struct si_resource {
 	 */
 	bool				TC_L2_dirty;
 
+	/* Number of CPU read mappings, for adaptive placement: buffers the
+	 * CPU keeps reading back are moved out of write-combined memory at
+	 * the next reallocation. */
+	unsigned			cpu_read_maps;
+
 	/* Whether this resource is referenced by bindless handles. */
 	bool				texture_handle_allocated;
 	bool				image_handle_allocated;
@@ -521,6 +526,13 @@ struct si_screen {
 	union si_mmio_counters	mmio_counters;
 	volatile unsigned		gpu_load_stop_thread; /* bool */
 
+	/* Recycled fence allocations, so that frequent flushing doesn't
+	 * malloc and free one si_multi_fence per submit. Managed by
+	 * si_fence.c. */
+	mtx_t				fence_pool_mutex;
+	void				*fence_pool[8];
+	unsigned			num_pooled_fences;
+
 	/* Performance counters. */
 	struct si_perfcounters	*perfcounters;
 
@@ -1249,8 +1261,19 @@ void vi_dcc_clear_level(struct si_context *sctx,
 void si_init_clear_functions(struct si_context *sctx);
 
 /* si_compute_blit.c */
+/* A dword-aligned buffer clear for si_execute_buffer_clears. */
+struct si_buffer_clear {
+	struct pipe_resource	*dst;
+	uint64_t		offset;
+	uint64_t		size;
+	uint32_t		value;
+};
+
 unsigned si_get_flush_flags(struct si_context *sctx, enum si_coherency coher,
 			    enum si_cache_policy cache_policy);
+void si_execute_buffer_clears(struct si_context *sctx,
+			      const struct si_buffer_clear *clears,
+			      unsigned num_clears, enum si_coherency coher);
 void si_clear_buffer(struct si_context *sctx, struct pipe_resource *dst,
 		     uint64_t offset, uint64_t size, uint32_t *clear_value,
 		     uint32_t clear_value_size, enum si_coherency coher,
@@ -325,6 +325,15 @@ struct si_shader_selector {
 	struct si_shader	*first_variant; /* immutable after the first variant */
 	struct si_shader	*last_variant; /* mutable */
 
+	/* Variant warm-start profile: the keys that draw calls requested in
+	 * this and previous runs, saved to the disk cache so that future runs
+	 * can precompile the variants at selector creation.  Protected by
+	 * "mutex".  See si_state_shaders.c.
+	 */
+	struct si_shader_key	*profile_keys;
+	unsigned	num_profile_keys;
+	bool		profile_keys_dirty;
+
 	/* The compiled TGSI shader expecting a prolog and/or epilog (not
 	 * uploaded to a buffer).
 	 */
@@ -435,6 +435,12 @@ struct si_descriptors {
 	uint32_t first_active_slot;
 	uint32_t num_active_slots;
 
+	/* Slots that have been modified since the last upload. If no slot is
+	 * dirty, the last upload is still valid and is reused instead of
+	 * re-uploading the whole list. Slots >= 64 share the last bit.
+	 */
+	uint64_t dirty_slot_mask;
+
 	/* The SH register offset relative to USER_DATA*_0 where the pointer
 	 * to the descriptor array will be stored. */
 	short shader_userdata_offset;
@@ -328,6 +328,214 @@ void si_destroy_shader_cache(struct si_screen *sscreen)
 	mtx_destroy(&sscreen->shader_cache_mutex);
 }
 
+/* VARIANT WARM-START PROFILE
+ *
+ * Remember which shader keys draw calls asked for and store them in the disk
+ * cache next to the shader binaries, so that future runs can compile the
+ * variants at selector creation (on the compiler threads) instead of
+ * stuttering at first use.
+ */
+
+#define SI_MAX_VARIANT_PROFILE_KEYS	32
+
+static bool si_variant_profile_usable(struct si_screen *sscreen,
+				      struct si_shader_selector *sel)
+{
+	/* Merged shader keys contain selector pointers on GFX9+
+	 * (part.tcs.ls, part.gs.es) and can't be serialized. */
+	if (sscreen->info.chip_class >= GFX9 &&
+	    (sel->type == PIPE_SHADER_TESS_CTRL ||
+	     sel->type == PIPE_SHADER_GEOMETRY))
+		return false;
+
+	return sscreen->disk_shader_cache != NULL;
+}
+
+/**
+ * Compute the disk cache key for the variant profile of a selector.
+ * The IR is salted so that the key doesn't collide with the key of
+ * the main shader part, which hashes the same IR binary.
+ */
+static bool si_variant_profile_compute_key(struct si_screen *sscreen,
+					   void *ir_binary,
+					   unsigned char cache_key[CACHE_KEY_SIZE])
+{
+	static const char salt[] = "variant_profile";
+	uint32_t ir_size = *(uint32_t*)ir_binary;
+	char *buffer = (char*)MALLOC(sizeof(salt) + ir_size);
+
+	if (!buffer)
+		return false;
+
+	memcpy(buffer, salt, sizeof(salt));
+	memcpy(buffer + sizeof(salt), ir_binary, ir_size);
+	disk_cache_compute_key(sscreen->disk_shader_cache, buffer,
+			       sizeof(salt) + ir_size, cache_key);
+	FREE(buffer);
+	return true;
+}
+
+/**
+ * Add a variant key to the selector's profile. Called with sel->mutex held.
+ */
+static void si_variant_profile_record(struct si_shader_selector *sel,
+				      const struct si_shader_key *key)
+{
+	unsigned i;
+
+	if (!si_variant_profile_usable(sel->screen, sel))
+		return;
+
+	if (!sel->profile_keys) {
+		sel->profile_keys =
+			(struct si_shader_key*)
+			MALLOC(SI_MAX_VARIANT_PROFILE_KEYS *
+			       sizeof(*sel->profile_keys));
+		if (!sel->profile_keys)
+			return;
+	}
+
+	for (i = 0; i < sel->num_profile_keys; i++) {
+		if (memcmp(&sel->profile_keys[i], key, sizeof(*key)) == 0)
+			return;
+	}
+
+	if (sel->num_profile_keys >= SI_MAX_VARIANT_PROFILE_KEYS)
+		return;
+
+	sel->profile_keys[sel->num_profile_keys++] = *key;
+	sel->profile_keys_dirty = true;
+}
+
+/**
+ * Write the profile back to the disk cache if this run added new keys.
+ * Called at selector destruction; no locking needed.
+ */
+static void si_variant_profile_save(struct si_screen *sscreen,
+				    struct si_shader_selector *sel)
+{
+	unsigned char cache_key[CACHE_KEY_SIZE];
+	uint32_t header[2];
+	unsigned size;
+	void *ir_binary;
+	char *blob;
+
+	if (!sel->profile_keys_dirty || !sel->num_profile_keys ||
+	    (!sel->tokens && !sel->nir))
+		return;
+
+	ir_binary = si_get_ir_binary(sel);
+	if (!ir_binary)
+		return;
+
+	if (!si_variant_profile_compute_key(sscreen, ir_binary, cache_key)) {
+		FREE(ir_binary);
+		return;
+	}
+	FREE(ir_binary);
+
+	header[0] = sizeof(struct si_shader_key);
+	header[1] = sel->num_profile_keys;
+
+	size = sizeof(header) +
+	       sel->num_profile_keys * sizeof(*sel->profile_keys);
+	blob = (char*)MALLOC(size);
+	if (!blob)
+		return;
+
+	memcpy(blob, header, sizeof(header));
+	memcpy(blob + sizeof(header), sel->profile_keys,
+	       sel->num_profile_keys * sizeof(*sel->profile_keys));
+
+	disk_cache_put(sscreen->disk_shader_cache, cache_key, blob, size, NULL);
+	FREE(blob);
+}
+
+/**
+ * Load the variant profile of a previous run and compile the recorded
+ * variants. Called from si_init_shader_selector_async on a compiler thread,
+ * after the main shader part has been built.
+ */
+static void si_variant_profile_prefill(struct si_shader_selector *sel,
+				       int thread_index)
+{
+	struct si_screen *sscreen = sel->screen;
+	unsigned char cache_key[CACHE_KEY_SIZE];
+	struct si_shader_key *keys;
+	uint32_t *header;
+	unsigned num_keys, i;
+	void *ir_binary;
+	uint8_t *data;
+	size_t size;
+
+	if (!si_variant_profile_usable(sscreen, sel) ||
+	    (!sel->tokens && !sel->nir))
+		return;
+
+	ir_binary = si_get_ir_binary(sel);
+	if (!ir_binary)
+		return;
+
+	if (!si_variant_profile_compute_key(sscreen, ir_binary, cache_key)) {
+		FREE(ir_binary);
+		return;
+	}
+	FREE(ir_binary);
+
+	data = disk_cache_get(sscreen->disk_shader_cache, cache_key, &size);
+	if (!data)
+		return;
+
+	header = (uint32_t*)data;
+	if (size < sizeof(uint32_t) * 2 ||
+	    header[0] != sizeof(struct si_shader_key) ||
+	    header[1] > SI_MAX_VARIANT_PROFILE_KEYS ||
+	    size != sizeof(uint32_t) * 2 +
+		    header[1] * sizeof(struct si_shader_key)) {
+		/* A profile from an incompatible build. Drop it. */
+		disk_cache_remove(sscreen->disk_shader_cache, cache_key);
+		free(data);
+		return;
+	}
+
+	num_keys = header[1];
+	keys = (struct si_shader_key*)(header + 2);
+
+	/* Seed the in-memory profile, so that a run using only a subset of
+	 * the variants doesn't shrink it. */
+	mtx_lock(&sel->mutex);
+	if (!sel->profile_keys) {
+		sel->profile_keys =
+			(struct si_shader_key*)
+			MALLOC(SI_MAX_VARIANT_PROFILE_KEYS *
+			       sizeof(*sel->profile_keys));
+	}
+	if (sel->profile_keys) {
+		memcpy(sel->profile_keys, keys, num_keys * sizeof(*keys));
+		sel->num_profile_keys = num_keys;
+		sel->profile_keys_dirty = false;
+	}
+	mtx_unlock(&sel->mutex);
+
+	/* Compile the recorded variants. Passing thread_index compiles
+	 * synchronously on this compiler thread, even optimized variants,
+	 * like the async GS compilation does. */
+	struct si_compiler_ctx_state compiler_state = sel->compiler_ctx_state;
+	compiler_state.compiler = &sscreen->compiler[thread_index];
+
+	for (i = 0; i < num_keys; i++) {
+		struct si_shader_ctx_state state = {};
+		/* The key is copied because the selection can clear key.opt
+		 * when falling back to an unoptimized variant. */
+		struct si_shader_key key = keys[i];
+
+		state.cso = sel;
+		si_shader_select_with_key(sscreen, &state, &compiler_state,
+					  &key, thread_index, false);
+	}
+	free(data);
+}
+
 /* SHADER STATES */
 
 static void si_set_tesseval_regs(struct si_screen *sscreen,
@@ -1875,6 +2083,11 @@ current_not_ready:
 	shader->key = *key;
 	shader->compiler_ctx_state = *compiler_state;
 
+	/* Remember draw-call-requested keys for the next run. Compiler
+	 * threads replay the profile and must not re-record it. */
+	if (thread_index < 0)
+		si_variant_profile_record(sel, key);
+
 	/* If this is a merged shader, get the first shader's selector. */
 	if (sscreen->info.chip_class >= GFX9) {
 		if (sel->type == PIPE_SHADER_TESS_CTRL)
@@ -1995,7 +2208,9 @@ current_not_ready:
 
 	mtx_unlock(&sel->mutex);
 
-	assert(!shader->is_optimized);
+	/* Optimized variants are only compiled synchronously on compiler
+	 * threads, e.g. when replaying the variant profile. */
+	assert(!shader->is_optimized || thread_index >= 0);
 	si_build_shader_variant(shader, thread_index, false);
 
 	util_queue_fence_signal(&shader->ready);
@@ -2181,6 +2396,9 @@ static void si_init_shader_selector_async(void *job, int thread_index)
 
 		si_shader_vs(sscreen, sel->gs_copy_shader, sel);
 	}
+
+	/* Compile the variants recorded by previous runs. */
+	si_variant_profile_prefill(sel, thread_index);
 }
 
 void si_schedule_initial_compile(struct si_context *sctx, unsigned processor,
@@ -2786,6 +3004,9 @@ void si_destroy_shader_selector(struct si_context *sctx,
 	if (sel->gs_copy_shader)
 		si_delete_shader(sctx, sel->gs_copy_shader);
 
+	si_variant_profile_save(sctx->screen, sel);
+	FREE(sel->profile_keys);
+
 	util_queue_fence_destroy(&sel->ready);
 	mtx_destroy(&sel->mutex);
 	free(sel->tokens);
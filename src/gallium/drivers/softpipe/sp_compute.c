@@ -20,6 +20,9 @@
  * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
  * USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "util/u_atomic.h"
+#include "util/u_cpu_detect.h"
+#include "util/u_debug.h"
 #include "util/u_inlines.h"
 #include "util/u_math.h"
 #include "util/u_memory.h"
@@ -164,28 +167,44 @@ fill_grid_size(struct pipe_context *context,
    pipe_buffer_unmap(context, transfer);
 }
 
-void
-softpipe_launch_grid(struct pipe_context *context,
-                     const struct pipe_grid_info *info)
+struct sp_grid_slice_job {
+   struct softpipe_context *softpipe;
+   const struct sp_compute_shader *cs;
+   uint32_t grid_size[3];
+   /* static slice, used when next_group is NULL */
+   unsigned first_group;
+   unsigned count;
+   /* group stealing: shared counter of the next group to run */
+   int *next_group;
+   unsigned num_groups;
+};
+
+
+/**
+ * Run a subset of the grid's workgroups with a private set of interpreter
+ * machines, so that several jobs can execute concurrently on the compute
+ * worker pool.  With group stealing each job pulls the next unclaimed
+ * workgroup off the shared counter until the grid is drained; otherwise it
+ * runs the fixed range [first_group, first_group + count).
+ */
+static void
+run_grid_slice(struct softpipe_context *softpipe,
+               const struct sp_compute_shader *cs,
+               const uint32_t grid_size[3],
+               const struct sp_grid_slice_job *job)
 {
-   struct softpipe_context *softpipe = softpipe_context(context);
-   struct sp_compute_shader *cs = softpipe->cs;
    int num_threads_in_group;
    struct tgsi_exec_machine **machines;
    int bwidth, bheight, bdepth;
    int w, h, d, i;
-   int g_w, g_h, g_d;
-   uint32_t grid_size[3] = {0};
+   unsigned n, num_run = 0;
    void *local_mem = NULL;
 
-   softpipe_update_compute_samplers(softpipe);
    bwidth = cs->info.properties[TGSI_PROPERTY_CS_FIXED_BLOCK_WIDTH];
    bheight = cs->info.properties[TGSI_PROPERTY_CS_FIXED_BLOCK_HEIGHT];
    bdepth = cs->info.properties[TGSI_PROPERTY_CS_FIXED_BLOCK_DEPTH];
    num_threads_in_group = bwidth * bheight * bdepth;
 
-   fill_grid_size(context, info, grid_size);
-
    if (cs->shader.req_local_mem) {
       local_mem = CALLOC(1, cs->shader.req_local_mem);
    }
@@ -219,12 +238,22 @@ softpipe_launch_grid(struct pipe_context *context,
       }
    }
 
-   for (g_d = 0; g_d < grid_size[2]; g_d++) {
-      for (g_h = 0; g_h < grid_size[1]; g_h++) {
-         for (g_w = 0; g_w < grid_size[0]; g_w++) {
-            run_workgroup(cs, g_w, g_h, g_d, num_threads_in_group, machines);
-         }
+   for (;;) {
+      if (job->next_group) {
+         n = p_atomic_inc_return(job->next_group) - 1;
+         if (n >= job->num_groups)
+            break;
+      } else {
+         n = job->first_group + num_run;
+         if (num_run == job->count)
+            break;
+         num_run++;
       }
+      run_workgroup(cs,
+                    n % grid_size[0],
+                    (n / grid_size[0]) % grid_size[1],
+                    n / (grid_size[0] * grid_size[1]),
+                    num_threads_in_group, machines);
    }
 
    for (i = 0; i < num_threads_in_group; i++) {
@@ -235,3 +264,142 @@ softpipe_launch_grid(struct pipe_context *context,
    FREE(local_mem);
    FREE(machines);
 }
+
+
+static void
+run_grid_slice_job(void *data, int thread_index)
+{
+   struct sp_grid_slice_job *job = (struct sp_grid_slice_job *)data;
+
+   run_grid_slice(job->softpipe, job->cs, job->grid_size, job);
+}
+
+
+/**
+ * Whether the grid's workgroups may run concurrently.  Texture sampling
+ * goes through the context's shared tile caches and the buffer/image
+ * atomics are implemented as plain read-modify-writes, so shaders using
+ * either have to stay on one thread.
+ */
+static boolean
+sp_compute_shader_is_parallel_safe(const struct sp_compute_shader *cs)
+{
+   const struct tgsi_shader_info *info = &cs->info;
+   unsigned op;
+
+   if (info->file_max[TGSI_FILE_SAMPLER] >= 0)
+      return FALSE;
+
+   if (info->opcode_count[TGSI_OPCODE_ATOMFADD])
+      return FALSE;
+   for (op = TGSI_OPCODE_ATOMUADD; op <= TGSI_OPCODE_ATOMIMAX; op++) {
+      if (info->opcode_count[op])
+         return FALSE;
+   }
+   return TRUE;
+}
+
+
+/**
+ * How many slices to cut the grid into, creating the worker pool on first
+ * use.  SOFTPIPE_COMPUTE_THREADS overrides the thread count (1 disables)
+ * and SOFTPIPE_COMPUTE_DETERMINISTIC replaces group stealing with fixed
+ * contiguous slices, so a failing workgroup always runs on the same job.
+ */
+static unsigned
+sp_compute_num_jobs(struct softpipe_context *softpipe,
+                    const struct sp_compute_shader *cs,
+                    unsigned num_groups)
+{
+   if (!softpipe->compute_queue_checked) {
+      int threads = debug_get_num_option("SOFTPIPE_COMPUTE_THREADS", -1);
+
+      if (threads < 0) {
+         util_cpu_detect();
+         threads = util_cpu_caps.nr_cpus;
+      }
+      threads = CLAMP(threads, 1, SP_MAX_COMPUTE_THREADS);
+
+      if (threads > 1 &&
+          !util_queue_init(&softpipe->compute_queue, "sp_cs",
+                           SP_MAX_COMPUTE_THREADS, threads, 0))
+         threads = 1;
+
+      softpipe->compute_num_threads = threads;
+      softpipe->compute_deterministic =
+         debug_get_bool_option("SOFTPIPE_COMPUTE_DETERMINISTIC", FALSE);
+      softpipe->compute_queue_checked = TRUE;
+   }
+
+   if (softpipe->compute_num_threads <= 1 ||
+       !sp_compute_shader_is_parallel_safe(cs))
+      return 1;
+
+   return MIN2(softpipe->compute_num_threads, num_groups);
+}
+
+
+void
+softpipe_launch_grid(struct pipe_context *context,
+                     const struct pipe_grid_info *info)
+{
+   struct softpipe_context *softpipe = softpipe_context(context);
+   struct sp_compute_shader *cs = softpipe->cs;
+   uint32_t grid_size[3] = {0};
+   unsigned num_groups, num_jobs;
+
+   softpipe_update_compute_samplers(softpipe);
+
+   fill_grid_size(context, info, grid_size);
+   num_groups = grid_size[0] * grid_size[1] * grid_size[2];
+
+   num_jobs = sp_compute_num_jobs(softpipe, cs, num_groups);
+   if (num_jobs > 1) {
+      struct sp_grid_slice_job jobs[SP_MAX_COMPUTE_THREADS];
+      struct util_queue_fence fences[SP_MAX_COMPUTE_THREADS];
+      int next_group = 0;
+      unsigned groups_per_job = num_groups / num_jobs;
+      unsigned remainder = num_groups % num_jobs;
+      unsigned first = 0;
+      unsigned i;
+
+      for (i = 0; i < num_jobs; i++) {
+         jobs[i].softpipe = softpipe;
+         jobs[i].cs = cs;
+         memcpy(jobs[i].grid_size, grid_size, sizeof(grid_size));
+         jobs[i].num_groups = num_groups;
+         if (softpipe->compute_deterministic) {
+            jobs[i].first_group = first;
+            jobs[i].count = groups_per_job + (i < remainder ? 1 : 0);
+            first += jobs[i].count;
+            jobs[i].next_group = NULL;
+         } else {
+            jobs[i].first_group = 0;
+            jobs[i].count = 0;
+            jobs[i].next_group = &next_group;
+         }
+
+         util_queue_fence_init(&fences[i]);
+         util_queue_add_job(&softpipe->compute_queue, &jobs[i], &fences[i],
+                            run_grid_slice_job, NULL);
+      }
+
+      for (i = 0; i < num_jobs; i++) {
+         util_queue_fence_wait(&fences[i]);
+         util_queue_fence_destroy(&fences[i]);
+      }
+   }
+   else {
+      struct sp_grid_slice_job job;
+
+      job.softpipe = softpipe;
+      job.cs = cs;
+      memcpy(job.grid_size, grid_size, sizeof(grid_size));
+      job.num_groups = num_groups;
+      job.first_group = 0;
+      job.count = num_groups;
+      job.next_group = NULL;
+
+      run_grid_slice(softpipe, cs, grid_size, &job);
+   }
+}
@@ -119,6 +119,9 @@ softpipe_destroy( struct pipe_context *pipe )
 
    tgsi_exec_machine_destroy(softpipe->fs_machine);
 
+   if (softpipe->compute_queue_checked && softpipe->compute_num_threads > 1)
+      util_queue_destroy(&softpipe->compute_queue);
+
    for (i = 0; i < PIPE_SHADER_TYPES; i++) {
       FREE(softpipe->tgsi.sampler[i]);
       FREE(softpipe->tgsi.image[i]);
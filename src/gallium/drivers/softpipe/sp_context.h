@@ -33,6 +33,7 @@
 
 #include "pipe/p_context.h"
 #include "util/u_blitter.h"
+#include "util/u_queue.h"
 
 #include "draw/draw_vertex.h"
 
@@ -180,6 +181,14 @@ struct softpipe_context {
    /** whether early depth testing is enabled */
    bool early_depth;
 
+   /** Worker pool for slicing compute grids over several interpreter
+    * instances; created on demand by softpipe_launch_grid().
+    */
+   struct util_queue compute_queue;
+   unsigned compute_num_threads;
+   boolean compute_deterministic;
+   boolean compute_queue_checked;
+
    /** The primitive drawing context */
    struct draw_context *draw;
 
@@ -39,5 +39,8 @@
 #define MAX_WIDTH (1 << (SP_MAX_TEXTURE_2D_LEVELS - 1))
 #define MAX_HEIGHT (1 << (SP_MAX_TEXTURE_2D_LEVELS - 1))
 
+/** Max worker threads for slicing up compute grids */
+#define SP_MAX_COMPUTE_THREADS 16
+
 
 #endif /* SP_LIMITS_H */
@@ -39,6 +39,7 @@
 
 #include "state_tracker/sw_winsys.h"
 #include "tgsi/tgsi_exec.h"
+#include "tgsi/tgsi_intern.h"
 
 #include "sp_texture.h"
 #include "sp_screen.h"
@@ -509,6 +510,7 @@ softpipe_destroy_screen( struct pipe_screen *screen )
    if(winsys->destroy)
       winsys->destroy(winsys);
 
+   tgsi_token_pool_destroy(sp_screen->token_pool);
    FREE(screen);
 }
 
@@ -604,6 +606,12 @@ softpipe_create_screen(struct sw_winsys *winsys)
 
    screen->winsys = winsys;
 
+   screen->token_pool = tgsi_token_pool_create();
+   if (!screen->token_pool) {
+      FREE(screen);
+      return NULL;
+   }
+
    screen->base.destroy = softpipe_destroy_screen;
 
    screen->base.get_name = softpipe_get_name;
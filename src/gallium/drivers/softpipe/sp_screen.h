@@ -47,6 +47,11 @@ struct softpipe_screen {
     */
    unsigned timestamp;
    boolean use_llvm;
+
+   /* Deduplicates the token streams retained by shader CSOs across all
+    * contexts of this screen.
+    */
+   struct tgsi_token_pool *token_pool;
 };
 
 static inline struct softpipe_screen *
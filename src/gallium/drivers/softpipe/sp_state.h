@@ -134,7 +134,7 @@ struct sp_so_state {
 /** Subclass of pipe_compute_state */
 struct sp_compute_shader {
    struct pipe_compute_state shader;
-   struct tgsi_token *tokens;
+   const struct tgsi_token *tokens;
    struct tgsi_shader_info info;
    int max_sampler;             /* -1 if no samplers */
 };
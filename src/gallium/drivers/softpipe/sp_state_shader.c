@@ -28,6 +28,7 @@
 #include "sp_context.h"
 #include "sp_state.h"
 #include "sp_fs.h"
+#include "sp_screen.h"
 #include "sp_texture.h"
 
 #include "pipe/p_defines.h"
@@ -38,6 +39,7 @@
 #include "draw/draw_vs.h"
 #include "draw/draw_gs.h"
 #include "tgsi/tgsi_dump.h"
+#include "tgsi/tgsi_intern.h"
 #include "tgsi/tgsi_scan.h"
 #include "tgsi/tgsi_parse.h"
 
@@ -126,14 +128,19 @@ softpipe_create_fs_state(struct pipe_context *pipe,
    if (softpipe->dump_fs) 
       tgsi_dump(templ->tokens, 0);
 
-   /* we need to keep a local copy of the tokens */
-   state->shader.tokens = tgsi_dup_tokens(templ->tokens);
+   /* we need to keep a local copy of the tokens; identical shaders share
+    * one interned copy through the screen's token pool
+    */
+   state->shader.tokens =
+      tgsi_token_pool_intern(softpipe_screen(pipe->screen)->token_pool,
+                             templ->tokens);
 
    /* draw's fs state */
    state->draw_shader = draw_create_fragment_shader(softpipe->draw,
                                                     &state->shader);
    if (!state->draw_shader) {
-      tgsi_free_tokens(state->shader.tokens);
+      tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                              state->shader.tokens);
       FREE(state);
       return NULL;
    }
@@ -195,7 +202,8 @@ softpipe_delete_fs_state(struct pipe_context *pipe, void *fs)
 
    draw_delete_fragment_shader(softpipe->draw, state->draw_shader);
 
-   tgsi_free_tokens(state->shader.tokens);
+   tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                           state->shader.tokens);
    FREE(state);
 }
 
@@ -213,12 +221,14 @@ softpipe_create_vs_state(struct pipe_context *pipe,
 
    /* copy shader tokens, the ones passed in will go away.
     */
-   state->shader.tokens = tgsi_dup_tokens(templ->tokens);
+   state->shader.tokens =
+      tgsi_token_pool_intern(softpipe_screen(pipe->screen)->token_pool,
+                             templ->tokens);
    if (state->shader.tokens == NULL)
       goto fail;
 
    state->draw_data = draw_create_vertex_shader(softpipe->draw, templ);
-   if (state->draw_data == NULL) 
+   if (state->draw_data == NULL)
       goto fail;
 
    state->max_sampler = state->draw_data->info.file_max[TGSI_FILE_SAMPLER];
@@ -227,7 +237,8 @@ softpipe_create_vs_state(struct pipe_context *pipe,
 
 fail:
    if (state) {
-      tgsi_free_tokens(state->shader.tokens);
+      tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                              state->shader.tokens);
       FREE( state->draw_data );
       FREE( state );
    }
@@ -257,7 +268,8 @@ softpipe_delete_vs_state(struct pipe_context *pipe, void *vs)
    struct sp_vertex_shader *state = (struct sp_vertex_shader *) vs;
 
    draw_delete_vertex_shader(softpipe->draw, state->draw_data);
-   tgsi_free_tokens(state->shader.tokens);
+   tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                           state->shader.tokens);
    FREE( state );
 }
 
@@ -282,7 +294,9 @@ softpipe_create_gs_state(struct pipe_context *pipe,
 
       /* copy shader tokens, the ones passed in will go away.
        */
-      state->shader.tokens = tgsi_dup_tokens(templ->tokens);
+      state->shader.tokens =
+         tgsi_token_pool_intern(softpipe_screen(pipe->screen)->token_pool,
+                                templ->tokens);
       if (state->shader.tokens == NULL)
          goto fail;
 
@@ -297,7 +311,8 @@ softpipe_create_gs_state(struct pipe_context *pipe,
 
 fail:
    if (state) {
-      tgsi_free_tokens(state->shader.tokens);
+      tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                              state->shader.tokens);
       FREE( state->draw_data );
       FREE( state );
    }
@@ -330,7 +345,8 @@ softpipe_delete_gs_state(struct pipe_context *pipe, void *gs)
    draw_delete_geometry_shader(softpipe->draw,
                                (state) ? state->draw_data : 0);
 
-   tgsi_free_tokens(state->shader.tokens);
+   tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                           state->shader.tokens);
    FREE(state);
 }
 
@@ -396,7 +412,9 @@ softpipe_create_compute_state(struct pipe_context *pipe,
    state = CALLOC_STRUCT(sp_compute_shader);
 
    state->shader = *templ;
-   state->tokens = tgsi_dup_tokens(tokens);
+   state->tokens =
+      tgsi_token_pool_intern(softpipe_screen(pipe->screen)->token_pool,
+                             tokens);
    tgsi_scan_shader(state->tokens, &state->info);
 
    state->max_sampler = state->info.file_max[TGSI_FILE_SAMPLER];
@@ -424,7 +442,8 @@ softpipe_delete_compute_state(struct pipe_context *pipe,
    struct sp_compute_shader *state = (struct sp_compute_shader *)cs;
 
    assert(softpipe->cs != state);
-   tgsi_free_tokens(state->tokens);
+   tgsi_token_pool_release(softpipe_screen(pipe->screen)->token_pool,
+                           state->tokens);
    FREE(state);
 }
 
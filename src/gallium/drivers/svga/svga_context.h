@@ -74,6 +74,9 @@ enum svga_hud {
    SVGA_QUERY_NUM_GENERATE_MIPMAP,
    SVGA_QUERY_NUM_FAILED_ALLOCATIONS,
    SVGA_QUERY_NUM_COMMANDS_PER_DRAW,
+   SVGA_QUERY_NUM_SURFACE_CACHE_HITS,
+   SVGA_QUERY_NUM_SURFACE_CACHE_MISSES,
+   SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS,
 
 /*SVGA_QUERY_MAX has to be last because it is size of an array*/
    SVGA_QUERY_MAX
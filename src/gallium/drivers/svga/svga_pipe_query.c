@@ -752,6 +752,9 @@ svga_create_query(struct pipe_context *pipe,
    case SVGA_QUERY_NUM_CONST_UPDATES:
    case SVGA_QUERY_NUM_FAILED_ALLOCATIONS:
    case SVGA_QUERY_NUM_COMMANDS_PER_DRAW:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_HITS:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_MISSES:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS:
       break;
    case SVGA_QUERY_FLUSH_TIME:
    case SVGA_QUERY_MAP_BUFFER_TIME:
@@ -834,6 +837,9 @@ svga_destroy_query(struct pipe_context *pipe, struct pipe_query *q)
    case SVGA_QUERY_NUM_CONST_UPDATES:
    case SVGA_QUERY_NUM_FAILED_ALLOCATIONS:
    case SVGA_QUERY_NUM_COMMANDS_PER_DRAW:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_HITS:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_MISSES:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS:
       /* nothing */
       break;
    default:
@@ -948,6 +954,9 @@ svga_begin_query(struct pipe_context *pipe, struct pipe_query *q)
    case SVGA_QUERY_NUM_GENERATE_MIPMAP:
    case SVGA_QUERY_NUM_FAILED_ALLOCATIONS:
    case SVGA_QUERY_NUM_COMMANDS_PER_DRAW:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_HITS:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_MISSES:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS:
       /* nothing */
       break;
    default:
@@ -1063,6 +1072,9 @@ svga_end_query(struct pipe_context *pipe, struct pipe_query *q)
    case SVGA_QUERY_NUM_GENERATE_MIPMAP:
    case SVGA_QUERY_NUM_FAILED_ALLOCATIONS:
    case SVGA_QUERY_NUM_COMMANDS_PER_DRAW:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_HITS:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_MISSES:
+   case SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS:
       /* nothing */
       break;
    default:
@@ -1204,6 +1216,15 @@ svga_get_query_result(struct pipe_context *pipe,
       vresult->f = (float) svga->swc->num_commands
          / (float) svga->swc->num_draw_commands;
       break;
+   case SVGA_QUERY_NUM_SURFACE_CACHE_HITS:
+      vresult->u64 = svgascreen->hud.num_surface_cache_hits;
+      break;
+   case SVGA_QUERY_NUM_SURFACE_CACHE_MISSES:
+      vresult->u64 = svgascreen->hud.num_surface_cache_misses;
+      break;
+   case SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS:
+      vresult->u64 = svgascreen->hud.num_surface_cache_evictions;
+      break;
    default:
       assert(!"unexpected query type in svga_get_query_result");
    }
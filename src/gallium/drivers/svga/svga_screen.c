@@ -876,6 +876,12 @@ svga_get_driver_query_info(struct pipe_screen *screen,
             PIPE_DRIVER_QUERY_TYPE_UINT64),
       QUERY("num-commands-per-draw", SVGA_QUERY_NUM_COMMANDS_PER_DRAW,
             PIPE_DRIVER_QUERY_TYPE_FLOAT),
+      QUERY("num-surface-cache-hits", SVGA_QUERY_NUM_SURFACE_CACHE_HITS,
+            PIPE_DRIVER_QUERY_TYPE_UINT64),
+      QUERY("num-surface-cache-misses", SVGA_QUERY_NUM_SURFACE_CACHE_MISSES,
+            PIPE_DRIVER_QUERY_TYPE_UINT64),
+      QUERY("num-surface-cache-evictions", SVGA_QUERY_NUM_SURFACE_CACHE_EVICTIONS,
+            PIPE_DRIVER_QUERY_TYPE_UINT64),
    };
 #undef QUERY
 
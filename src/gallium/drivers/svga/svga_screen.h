@@ -87,6 +87,10 @@ struct svga_screen
       uint64_t total_resource_bytes;
       uint64_t num_resources;
       uint64_t num_failed_allocations;
+      /** Surface cache pressure (see svga_screen_cache.c) */
+      uint64_t num_surface_cache_hits;
+      uint64_t num_surface_cache_misses;
+      uint64_t num_surface_cache_evictions;
    } hud;
 };
 
@@ -156,6 +156,11 @@ svga_screen_cache_lookup(struct svga_screen *svgascreen,
       next = curr->next;
    }
 
+   if (handle)
+      svgascreen->hud.num_surface_cache_hits++;
+   else
+      svgascreen->hud.num_surface_cache_misses++;
+
    mtx_unlock(&cache->mutex);
 
    if (SVGA_DEBUG & DEBUG_DMA)
@@ -192,6 +197,8 @@ svga_screen_cache_shrink(struct svga_screen *svgascreen,
          assert(entry->handle);
          sws->surface_reference(sws, &entry->handle, NULL);
 
+         svgascreen->hud.num_surface_cache_evictions++;
+
          LIST_DEL(&entry->bucket_head);
          LIST_DEL(&entry->head);
          LIST_ADD(&entry->head, &cache->empty);
@@ -277,6 +284,8 @@ svga_screen_cache_add(struct svga_screen *svgascreen,
 
       sws->surface_reference(sws, &entry->handle, NULL);
 
+      svgascreen->hud.num_surface_cache_evictions++;
+
       /* Remove from hash table */
       LIST_DEL(&entry->bucket_head);
 
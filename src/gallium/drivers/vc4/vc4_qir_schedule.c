@@ -65,6 +65,14 @@ struct schedule_state {
         uint32_t *temp_writes;
 
         BITSET_WORD *temp_live;
+
+        /* Number of bits set in temp_live. */
+        uint32_t temps_live;
+
+        /* Once temps_live reaches this, reducing register pressure wins
+         * over hiding latency when choosing the next instruction.
+         */
+        uint32_t pressure_threshold;
 };
 
 /* When walking the instructions in reverse, we need to swap before/after in
@@ -481,6 +489,27 @@ choose_instruction(struct schedule_state *state)
                         continue;
                 }
 
+                int register_pressure_cost =
+                        get_register_pressure_cost(state, n->inst);
+                int chosen_register_pressure_cost =
+                        get_register_pressure_cost(state, chosen->inst);
+
+                /* Near the register allocation limit, reducing pressure wins
+                 * over hiding latency: stretching live ranges any further
+                 * may force the threaded fallback or fail allocation
+                 * entirely, which costs more than a stall.
+                 */
+                if (state->temps_live >= state->pressure_threshold) {
+                        if (register_pressure_cost <
+                            chosen_register_pressure_cost) {
+                                chosen = n;
+                                continue;
+                        } else if (register_pressure_cost >
+                                   chosen_register_pressure_cost) {
+                                continue;
+                        }
+                }
+
                 /* If we would block on the previously chosen node, but would
                  * block less on this one, then prefer it.
                  */
@@ -496,10 +525,6 @@ choose_instruction(struct schedule_state *state)
                 /* If we can definitely reduce register pressure, do so
                  * immediately.
                  */
-                int register_pressure_cost =
-                        get_register_pressure_cost(state, n->inst);
-                int chosen_register_pressure_cost =
-                        get_register_pressure_cost(state, chosen->inst);
 
                 if (register_pressure_cost < chosen_register_pressure_cost) {
                         chosen = n;
@@ -659,13 +684,20 @@ schedule_instructions(struct vc4_compile *c,
 
                 /* Update our tracking of register pressure. */
                 for (int i = 0; i < qir_get_nsrc(inst); i++) {
-                        if (inst->src[i].file == QFILE_TEMP)
+                        if (inst->src[i].file == QFILE_TEMP &&
+                            !BITSET_TEST(state->temp_live,
+                                         inst->src[i].index)) {
                                 BITSET_SET(state->temp_live, inst->src[i].index);
+                                state->temps_live++;
+                        }
                 }
                 if (inst->dst.file == QFILE_TEMP) {
                         state->temp_writes[inst->dst.index]--;
-                        if (state->temp_writes[inst->dst.index] == 0)
+                        if (state->temp_writes[inst->dst.index] == 0 &&
+                            BITSET_TEST(state->temp_live, inst->dst.index)) {
                                 BITSET_CLEAR(state->temp_live, inst->dst.index);
+                                state->temps_live--;
+                        }
                 }
 
                 state->time++;
@@ -683,6 +715,13 @@ qir_schedule_instructions_block(struct vc4_compile *c,
                                          BITSET_WORDS(c->num_temps));
         state->dag = dag_create(state);
 
+        /* The QPU has 64 general purpose registers plus the accumulators,
+         * and threaded fragment shaders only get half of them.  Leave some
+         * headroom for values live across block boundaries and for RA's
+         * other constraints.
+         */
+        state->pressure_threshold = c->fs_threaded ? 24 : 48;
+
         struct list_head setup_list;
         list_inithead(&setup_list);
 
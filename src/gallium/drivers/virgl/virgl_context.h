@@ -28,6 +28,7 @@
 #include "util/slab.h"
 #include "util/list.h"
 
+#include "virgl_protocol.h"
 #include "virgl_staging_mgr.h"
 #include "virgl_transfer_queue.h"
 
@@ -94,6 +95,13 @@ struct virgl_context {
    struct virgl_so_target so_targets[PIPE_MAX_SO_BUFFERS];
    unsigned num_so_targets;
 
+   /* Last handle emitted for each bind point, used to drop redundant binds
+    * from the command stream. Handles are never reused within a screen, so
+    * a matching handle always refers to the same object. Indexed by
+    * VIRGL_OBJECT_* resp. PIPE_SHADER_*. */
+   uint32_t bound_handles[VIRGL_MAX_OBJECTS];
+   uint32_t bound_shader_handles[PIPE_SHADER_TYPES];
+
    uint32_t num_draws, num_compute;
 
    struct primconvert_context *primconvert;
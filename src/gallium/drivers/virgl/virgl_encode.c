@@ -73,6 +73,15 @@ static void virgl_encoder_write_res(struct virgl_context *ctx,
 int virgl_encode_bind_object(struct virgl_context *ctx,
                             uint32_t handle, uint32_t object)
 {
+   /* Bound state is retained by the host across command buffers, so a
+    * rebind of the current handle is a no-op and need not be encoded.
+    * Every bind point funnels through here, which keeps app-driven
+    * redundant state changes off the virtqueue entirely.
+    */
+   if (ctx->bound_handles[object] == handle)
+      return 0;
+   ctx->bound_handles[object] = handle;
+
    virgl_encoder_write_cmd_dword(ctx, VIRGL_CMD0(VIRGL_CCMD_BIND_OBJECT, object, 1));
    virgl_encoder_write_dword(ctx->cbuf, handle);
    return 0;
@@ -81,6 +90,24 @@ int virgl_encode_bind_object(struct virgl_context *ctx,
 int virgl_encode_delete_object(struct virgl_context *ctx,
                               uint32_t handle, uint32_t object)
 {
+   /* Deleting the bound object leaves the host bind point in a state we
+    * can no longer reason about, so force the next bind to be encoded
+    * whatever its handle is (handles are never reused, so ~0 is safe).
+    */
+   if (ctx->bound_handles[object] == handle)
+      ctx->bound_handles[object] = ~0;
+
+   /* Shaders are bound per-stage rather than through BIND_OBJECT, but are
+    * deleted through here, so invalidate the per-stage tracking as well.
+    */
+   if (object == VIRGL_OBJECT_SHADER) {
+      int i;
+      for (i = 0; i < PIPE_SHADER_TYPES; i++) {
+         if (ctx->bound_shader_handles[i] == handle)
+            ctx->bound_shader_handles[i] = ~0;
+      }
+   }
+
    virgl_encoder_write_cmd_dword(ctx, VIRGL_CMD0(VIRGL_CCMD_DESTROY_OBJECT, object, 1));
    virgl_encoder_write_dword(ctx->cbuf, handle);
    return 0;
@@ -958,6 +985,13 @@ int virgl_encoder_destroy_sub_ctx(struct virgl_context *ctx, uint32_t sub_ctx_id
 int virgl_encode_bind_shader(struct virgl_context *ctx,
                              uint32_t handle, uint32_t type)
 {
+   /* As with virgl_encode_bind_object, skip rebinds of the current
+    * shader; the host retains the binding across command buffers.
+    */
+   if (ctx->bound_shader_handles[type] == handle)
+      return 0;
+   ctx->bound_shader_handles[type] = handle;
+
    virgl_encoder_write_cmd_dword(ctx, VIRGL_CMD0(VIRGL_CCMD_BIND_SHADER, 0, 2));
    virgl_encoder_write_dword(ctx->cbuf, handle);
    virgl_encoder_write_dword(ctx->cbuf, type);
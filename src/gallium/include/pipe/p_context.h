@@ -665,6 +665,11 @@ struct pipe_context {
     * Change the commitment status of a part of the given resource, which must
     * have been created with the PIPE_RESOURCE_FLAG_SPARSE bit.
     *
+    * Sparse textures may only be created when
+    * PIPE_CAP_MAX_SPARSE_TEXTURE_SIZE is non-zero; see the documentation of
+    * resource_commit in context.rst for the texture box alignment and mip
+    * tail rules.
+    *
     * \param level The texture level whose commitment should be changed.
     * \param box The region of the resource whose commitment should be changed.
     * \param commit Whether memory should be committed or un-committed.
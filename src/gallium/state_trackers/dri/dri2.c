@@ -1963,6 +1963,20 @@ dri2_init_screen(__DRIscreen * sPriv)
    screen->default_throttle_frames =
       pscreen->get_param(pscreen, PIPE_CAP_MAX_FRAMES_IN_FLIGHT);
 
+   /* Let the user cap the frame queue depth explicitly; 0 keeps the
+    * driver's default from the cap above.
+    */
+   {
+      int throttle_frames =
+         driQueryOptioni(&screen->dev->option_cache, "max_frames_in_flight");
+
+      if (throttle_frames > 0)
+         screen->default_throttle_frames = throttle_frames;
+   }
+
+   screen->throttle_at_first_draw =
+      driQueryOptionb(&screen->dev->option_cache, "throttle_at_first_draw");
+
    if (pscreen->resource_create_with_modifiers)
       dri2ImageExtension.createImageWithModifiers =
          dri2_create_image_with_modifiers;
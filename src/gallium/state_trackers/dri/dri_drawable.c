@@ -58,6 +58,19 @@ dri_st_framebuffer_validate(struct st_context_iface *stctx,
    boolean new_stamp;
    int i;
    unsigned int lastStamp;
+
+   /* If the last SwapBuffers parked a throttle fence here instead of
+    * waiting on it, this validate is the first use of the new back
+    * buffer: block now, after the application has had the chance to do
+    * its CPU-side frame setup in parallel with the GPU.
+    */
+   if (drawable->throttle_fence) {
+      struct pipe_screen *pscreen = screen->base.screen;
+
+      pscreen->fence_finish(pscreen, NULL, drawable->throttle_fence,
+                            PIPE_TIMEOUT_INFINITE);
+      pscreen->fence_reference(pscreen, &drawable->throttle_fence, NULL);
+   }
    struct pipe_resource **textures =
       drawable->stvis.samples > 1 ? drawable->msaa_textures
                                   : drawable->textures;
@@ -199,6 +212,12 @@ dri_destroy_buffer(__DRIdrawable * dPriv)
 
    swap_fences_unref(drawable);
 
+   if (drawable->throttle_fence) {
+      struct pipe_screen *pscreen = screen->base.screen;
+
+      pscreen->fence_reference(pscreen, &drawable->throttle_fence, NULL);
+   }
+
    /* Notify the st manager that this drawable is no longer valid */
    stapi->destroy_drawable(stapi, &drawable->base);
 
@@ -568,8 +587,18 @@ dri_flush(__DRIcontext *cPriv,
 
       oldest_fence = swap_fences_pop_front(drawable);
       if (oldest_fence) {
-         screen->fence_finish(screen, NULL, oldest_fence, PIPE_TIMEOUT_INFINITE);
-         screen->fence_reference(screen, &oldest_fence, NULL);
+         if (dri_screen(ctx->sPriv)->throttle_at_first_draw) {
+            /* Park the fence on the drawable; the wait happens in
+             * dri_st_framebuffer_validate() at the first use of the new
+             * back buffer instead of blocking the swap itself.
+             */
+            screen->fence_reference(screen, &drawable->throttle_fence, NULL);
+            drawable->throttle_fence = oldest_fence;
+         } else {
+            screen->fence_finish(screen, NULL, oldest_fence,
+                                 PIPE_TIMEOUT_INFINITE);
+            screen->fence_reference(screen, &oldest_fence, NULL);
+         }
       }
 
       if (new_fence) {
@@ -67,6 +67,10 @@ struct dri_drawable
    unsigned int desired_fences;
    boolean flushing; /* prevents recursion in dri_flush */
 
+   /* oldest throttle fence, parked at SwapBuffers to be waited on at the
+    * first use of the new back buffer (throttle_at_first_draw) */
+   struct pipe_fence_handle *throttle_fence;
+
    /* used only by DRISW */
    struct pipe_surface *drisw_surface;
 
@@ -59,6 +59,10 @@ struct dri_screen
    __DRIscreen *sPriv;
    unsigned default_throttle_frames;
 
+   /* defer the throttle wait from SwapBuffers to the first use of the new
+    * back buffer, so it overlaps the CPU-side setup of the next frame */
+   boolean throttle_at_first_draw;
+
    struct st_config_options options;
 
    /* Which postprocessing filters are enabled. */
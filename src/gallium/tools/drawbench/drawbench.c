@@ -0,0 +1,463 @@
+/**************************************************************************
+ *
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+/*
+ * Draw-overhead microbenchmark at the pipe_context level, in the spirit of
+ * piglit's drawoverhead but without GL and the state tracker in the way, so
+ * regressions can be attributed to the driver (or to cso/u_threaded_context
+ * sitting directly below us) rather than to st/mesa.
+ *
+ * Each benchmark issues a large number of tiny draws, with a particular
+ * piece of state re-bound between every pair of draws, and reports the
+ * average cost per draw in nanoseconds.
+ */
+
+#define WIDTH 64
+#define HEIGHT 64
+
+/* pipe_*_state structs */
+#include "pipe/p_state.h"
+/* pipe_context */
+#include "pipe/p_context.h"
+/* pipe_screen */
+#include "pipe/p_screen.h"
+/* PIPE_* */
+#include "pipe/p_defines.h"
+/* TGSI_SEMANTIC_{POSITION|GENERIC} */
+#include "pipe/p_shader_tokens.h"
+/* pipe_buffer_* helpers */
+#include "util/u_inlines.h"
+
+/* constant state object helper */
+#include "cso_cache/cso_context.h"
+
+/* u_sampler_view_default_template */
+#include "util/u_sampler.h"
+/* FREE & CALLOC_STRUCT */
+#include "util/u_memory.h"
+/* util_make_[fragment|vertex]_passthrough_shader */
+#include "util/u_simple_shaders.h"
+/* os_time_get_nano */
+#include "util/os_time.h"
+/* to get a hardware pipe driver */
+#include "pipe-loader/pipe_loader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_DRAWS (100 * 1000)
+#define FLUSH_INTERVAL 1024
+
+struct program
+{
+	struct pipe_loader_device *dev;
+	struct pipe_screen *screen;
+	struct pipe_context *pipe;
+	struct cso_context *cso;
+
+	struct pipe_blend_state blend[2];
+	struct pipe_depth_stencil_alpha_state depthstencil;
+	struct pipe_rasterizer_state rasterizer;
+	struct pipe_sampler_state sampler;
+	struct pipe_viewport_state viewport;
+	struct pipe_framebuffer_state framebuffer;
+	struct pipe_vertex_element velem[2];
+
+	void *vs;
+	void *fs[2];
+	void *fs_tex;
+
+	union pipe_color_union clear_color;
+
+	struct pipe_resource *vbuf;
+	struct pipe_resource *target;
+	struct pipe_resource *tex[2];
+	struct pipe_sampler_view *view[2];
+
+	unsigned num_draws;
+};
+
+static void init_prog(struct program *p)
+{
+	struct pipe_surface surf_tmpl;
+	int i, ret;
+
+	/* find a hardware device */
+	ret = pipe_loader_probe(&p->dev, 1);
+	assert(ret);
+
+	/* init a pipe screen */
+	p->screen = pipe_loader_create_screen(p->dev);
+	assert(p->screen);
+
+	/* create the pipe driver context and cso context */
+	p->pipe = p->screen->context_create(p->screen, NULL, 0);
+	p->cso = cso_create_context(p->pipe, 0);
+
+	p->clear_color.f[0] = 0.1;
+	p->clear_color.f[1] = 0.1;
+	p->clear_color.f[2] = 0.1;
+	p->clear_color.f[3] = 1.0;
+
+	/* vertex buffer: one tiny triangle */
+	{
+		float vertices[3][2][4] = {
+			{
+				{ 0.0f, -0.1f, 0.0f, 1.0f },
+				{ 1.0f, 0.0f, 0.0f, 1.0f }
+			},
+			{
+				{ -0.1f, 0.1f, 0.0f, 1.0f },
+				{ 0.0f, 1.0f, 0.0f, 1.0f }
+			},
+			{
+				{ 0.1f, 0.1f, 0.0f, 1.0f },
+				{ 0.0f, 0.0f, 1.0f, 1.0f }
+			}
+		};
+
+		p->vbuf = pipe_buffer_create(p->screen, PIPE_BIND_VERTEX_BUFFER,
+					     PIPE_USAGE_DEFAULT, sizeof(vertices));
+		pipe_buffer_write(p->pipe, p->vbuf, 0, sizeof(vertices), vertices);
+	}
+
+	/* render target texture */
+	{
+		struct pipe_resource tmplt;
+		memset(&tmplt, 0, sizeof(tmplt));
+		tmplt.target = PIPE_TEXTURE_2D;
+		tmplt.format = PIPE_FORMAT_B8G8R8A8_UNORM; /* All drivers support this */
+		tmplt.width0 = WIDTH;
+		tmplt.height0 = HEIGHT;
+		tmplt.depth0 = 1;
+		tmplt.array_size = 1;
+		tmplt.last_level = 0;
+		tmplt.bind = PIPE_BIND_RENDER_TARGET;
+
+		p->target = p->screen->resource_create(p->screen, &tmplt);
+	}
+
+	/* two sampler textures to swap between */
+	for (i = 0; i < 2; i++) {
+		struct pipe_resource t_tmplt;
+		struct pipe_sampler_view v_tmplt;
+
+		memset(&t_tmplt, 0, sizeof(t_tmplt));
+		t_tmplt.target = PIPE_TEXTURE_2D;
+		t_tmplt.format = PIPE_FORMAT_B8G8R8A8_UNORM;
+		t_tmplt.width0 = 2;
+		t_tmplt.height0 = 2;
+		t_tmplt.depth0 = 1;
+		t_tmplt.array_size = 1;
+		t_tmplt.last_level = 0;
+		t_tmplt.bind = PIPE_BIND_SAMPLER_VIEW;
+
+		p->tex[i] = p->screen->resource_create(p->screen, &t_tmplt);
+
+		u_sampler_view_default_template(&v_tmplt, p->tex[i],
+						p->tex[i]->format);
+		p->view[i] = p->pipe->create_sampler_view(p->pipe, p->tex[i],
+							  &v_tmplt);
+	}
+
+	/* two blend states to swap between: masked and unmasked */
+	memset(&p->blend, 0, sizeof(p->blend));
+	p->blend[0].rt[0].colormask = PIPE_MASK_RGBA;
+	p->blend[1].rt[0].colormask = PIPE_MASK_R | PIPE_MASK_G | PIPE_MASK_B;
+
+	/* no-op depth/stencil/alpha */
+	memset(&p->depthstencil, 0, sizeof(p->depthstencil));
+
+	/* rasterizer */
+	memset(&p->rasterizer, 0, sizeof(p->rasterizer));
+	p->rasterizer.cull_face = PIPE_FACE_NONE;
+	p->rasterizer.half_pixel_center = 1;
+	p->rasterizer.bottom_edge_rule = 1;
+	p->rasterizer.depth_clip_near = 1;
+	p->rasterizer.depth_clip_far = 1;
+
+	/* sampler */
+	memset(&p->sampler, 0, sizeof(p->sampler));
+	p->sampler.wrap_s = PIPE_TEX_WRAP_CLAMP_TO_EDGE;
+	p->sampler.wrap_t = PIPE_TEX_WRAP_CLAMP_TO_EDGE;
+	p->sampler.wrap_r = PIPE_TEX_WRAP_CLAMP_TO_EDGE;
+	p->sampler.min_mip_filter = PIPE_TEX_MIPFILTER_NONE;
+	p->sampler.min_img_filter = PIPE_TEX_FILTER_NEAREST;
+	p->sampler.mag_img_filter = PIPE_TEX_FILTER_NEAREST;
+	p->sampler.normalized_coords = 1;
+
+	surf_tmpl.format = PIPE_FORMAT_B8G8R8A8_UNORM;
+	surf_tmpl.u.tex.level = 0;
+	surf_tmpl.u.tex.first_layer = 0;
+	surf_tmpl.u.tex.last_layer = 0;
+	/* drawing destination */
+	memset(&p->framebuffer, 0, sizeof(p->framebuffer));
+	p->framebuffer.width = WIDTH;
+	p->framebuffer.height = HEIGHT;
+	p->framebuffer.nr_cbufs = 1;
+	p->framebuffer.cbufs[0] = p->pipe->create_surface(p->pipe, p->target, &surf_tmpl);
+
+	/* viewport */
+	p->viewport.scale[0] = (float)WIDTH / 2.0f;
+	p->viewport.scale[1] = (float)HEIGHT / 2.0f;
+	p->viewport.scale[2] = 0.5f;
+	p->viewport.translate[0] = (float)WIDTH / 2.0f;
+	p->viewport.translate[1] = (float)HEIGHT / 2.0f;
+	p->viewport.translate[2] = 0.5f;
+
+	/* vertex elements state */
+	memset(p->velem, 0, sizeof(p->velem));
+	p->velem[0].src_offset = 0 * 4 * sizeof(float);
+	p->velem[0].instance_divisor = 0;
+	p->velem[0].vertex_buffer_index = 0;
+	p->velem[0].src_format = PIPE_FORMAT_R32G32B32A32_FLOAT;
+
+	p->velem[1].src_offset = 1 * 4 * sizeof(float);
+	p->velem[1].instance_divisor = 0;
+	p->velem[1].vertex_buffer_index = 0;
+	p->velem[1].src_format = PIPE_FORMAT_R32G32B32A32_FLOAT;
+
+	/* vertex shader */
+	{
+		const enum tgsi_semantic semantic_names[] =
+			{ TGSI_SEMANTIC_POSITION, TGSI_SEMANTIC_GENERIC };
+		const uint semantic_indexes[] = { 0, 0 };
+		p->vs = util_make_vertex_passthrough_shader(p->pipe, 2,
+							    semantic_names,
+							    semantic_indexes,
+							    FALSE);
+	}
+
+	/* two identical fragment shaders with distinct handles, plus a
+	 * texturing one */
+	for (i = 0; i < 2; i++) {
+		p->fs[i] = util_make_fragment_passthrough_shader(p->pipe,
+				TGSI_SEMANTIC_GENERIC,
+				TGSI_INTERPOLATE_PERSPECTIVE, TRUE);
+	}
+	p->fs_tex = util_make_fragment_tex_shader(p->pipe, TGSI_TEXTURE_2D,
+						  TGSI_INTERPOLATE_LINEAR,
+						  TGSI_RETURN_TYPE_FLOAT,
+						  TGSI_RETURN_TYPE_FLOAT,
+						  false, false);
+}
+
+static void close_prog(struct program *p)
+{
+	int i;
+
+	cso_destroy_context(p->cso);
+
+	p->pipe->delete_vs_state(p->pipe, p->vs);
+	p->pipe->delete_fs_state(p->pipe, p->fs[0]);
+	p->pipe->delete_fs_state(p->pipe, p->fs[1]);
+	p->pipe->delete_fs_state(p->pipe, p->fs_tex);
+
+	pipe_surface_reference(&p->framebuffer.cbufs[0], NULL);
+	for (i = 0; i < 2; i++) {
+		pipe_sampler_view_reference(&p->view[i], NULL);
+		pipe_resource_reference(&p->tex[i], NULL);
+	}
+	pipe_resource_reference(&p->target, NULL);
+	pipe_resource_reference(&p->vbuf, NULL);
+
+	p->pipe->destroy(p->pipe);
+	p->screen->destroy(p->screen);
+	pipe_loader_release(&p->dev, 1);
+
+	FREE(p);
+}
+
+/* Bind all the state any of the benchmarks needs, in tri.c fashion. */
+static void bind_base_state(struct program *p)
+{
+	struct pipe_vertex_buffer vb;
+	const struct pipe_sampler_state *samplers[] = {&p->sampler};
+
+	cso_set_framebuffer(p->cso, &p->framebuffer);
+	p->pipe->clear(p->pipe, PIPE_CLEAR_COLOR, &p->clear_color, 0, 0);
+
+	cso_set_blend(p->cso, &p->blend[0]);
+	cso_set_depth_stencil_alpha(p->cso, &p->depthstencil);
+	cso_set_rasterizer(p->cso, &p->rasterizer);
+	cso_set_viewport(p->cso, &p->viewport);
+	cso_set_samplers(p->cso, PIPE_SHADER_FRAGMENT, 1, samplers);
+	cso_set_sampler_views(p->cso, PIPE_SHADER_FRAGMENT, 1, &p->view[0]);
+
+	cso_set_fragment_shader_handle(p->cso, p->fs[0]);
+	cso_set_vertex_shader_handle(p->cso, p->vs);
+
+	cso_set_vertex_elements(p->cso, 2, p->velem);
+
+	memset(&vb, 0, sizeof(vb));
+	vb.buffer.resource = p->vbuf;
+	vb.stride = 2 * 4 * sizeof(float);
+	cso_set_vertex_buffers(p->cso, 0, 1, &vb);
+}
+
+/* Submit periodically so no driver accumulates an unbounded command
+ * stream, then wait for the tail end so GPU time can't leak into the
+ * next benchmark.
+ */
+static void maybe_flush(struct program *p, unsigned i)
+{
+	if (i % FLUSH_INTERVAL == FLUSH_INTERVAL - 1)
+		p->pipe->flush(p->pipe, NULL, 0);
+}
+
+static void finish(struct program *p)
+{
+	struct pipe_fence_handle *fence = NULL;
+
+	p->pipe->flush(p->pipe, &fence, 0);
+	if (fence) {
+		p->screen->fence_finish(p->screen, NULL, fence,
+					PIPE_TIMEOUT_INFINITE);
+		p->screen->fence_reference(p->screen, &fence, NULL);
+	}
+}
+
+static void report(struct program *p, const char *name, int64_t ns)
+{
+	printf("%-18s %8.1f ns/op  (%u draws)\n", name,
+	       (double)ns / p->num_draws, p->num_draws);
+}
+
+static void bench_draw_only(struct program *p)
+{
+	unsigned i;
+	int64_t start;
+
+	bind_base_state(p);
+	start = os_time_get_nano();
+	for (i = 0; i < p->num_draws; i++) {
+		cso_draw_arrays(p->cso, PIPE_PRIM_TRIANGLES, 0, 3);
+		maybe_flush(p, i);
+	}
+	finish(p);
+	report(p, "draw", os_time_get_nano() - start);
+}
+
+static void bench_cso_rebind(struct program *p)
+{
+	unsigned i;
+	int64_t start;
+
+	bind_base_state(p);
+	start = os_time_get_nano();
+	for (i = 0; i < p->num_draws; i++) {
+		cso_set_blend(p->cso, &p->blend[i & 1]);
+		cso_draw_arrays(p->cso, PIPE_PRIM_TRIANGLES, 0, 3);
+		maybe_flush(p, i);
+	}
+	finish(p);
+	report(p, "draw+blend", os_time_get_nano() - start);
+}
+
+static void bench_shader_swap(struct program *p)
+{
+	unsigned i;
+	int64_t start;
+
+	bind_base_state(p);
+	start = os_time_get_nano();
+	for (i = 0; i < p->num_draws; i++) {
+		cso_set_fragment_shader_handle(p->cso, p->fs[i & 1]);
+		cso_draw_arrays(p->cso, PIPE_PRIM_TRIANGLES, 0, 3);
+		maybe_flush(p, i);
+	}
+	finish(p);
+	report(p, "draw+shader", os_time_get_nano() - start);
+}
+
+static void bench_constant_update(struct program *p)
+{
+	float constants[4] = { 0.0f, 0.25f, 0.5f, 1.0f };
+	unsigned i;
+	int64_t start;
+
+	bind_base_state(p);
+	start = os_time_get_nano();
+	for (i = 0; i < p->num_draws; i++) {
+		constants[0] = (float)(i & 255) / 255.0f;
+		cso_set_constant_user_buffer(p->cso, PIPE_SHADER_FRAGMENT, 0,
+					     constants, sizeof(constants));
+		cso_draw_arrays(p->cso, PIPE_PRIM_TRIANGLES, 0, 3);
+		maybe_flush(p, i);
+	}
+	finish(p);
+	cso_set_constant_user_buffer(p->cso, PIPE_SHADER_FRAGMENT, 0, NULL, 0);
+	report(p, "draw+constants", os_time_get_nano() - start);
+}
+
+static void bench_texture_swap(struct program *p)
+{
+	unsigned i;
+	int64_t start;
+
+	bind_base_state(p);
+	cso_set_fragment_shader_handle(p->cso, p->fs_tex);
+	start = os_time_get_nano();
+	for (i = 0; i < p->num_draws; i++) {
+		cso_set_sampler_views(p->cso, PIPE_SHADER_FRAGMENT, 1,
+				      &p->view[i & 1]);
+		cso_draw_arrays(p->cso, PIPE_PRIM_TRIANGLES, 0, 3);
+		maybe_flush(p, i);
+	}
+	finish(p);
+	report(p, "draw+texture", os_time_get_nano() - start);
+}
+
+int main(int argc, char **argv)
+{
+	struct program *p = CALLOC_STRUCT(program);
+
+	p->num_draws = DEFAULT_DRAWS;
+	if (argc > 1) {
+		p->num_draws = atoi(argv[1]);
+		if (!p->num_draws) {
+			fprintf(stderr, "usage: %s [draws-per-benchmark]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	init_prog(p);
+
+	/* warm up clocks, caches and any lazily created driver state */
+	bench_draw_only(p);
+	printf("-- warmup done --\n");
+
+	bench_draw_only(p);
+	bench_cso_rebind(p);
+	bench_shader_swap(p);
+	bench_constant_update(p);
+	bench_texture_swap(p);
+
+	close_prog(p);
+
+	return 0;
+}
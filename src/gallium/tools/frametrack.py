@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+##########################################################################
+#
+# Copyright 2019 Advanced Micro Devices, Inc.
+# All Rights Reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+##########################################################################
+
+'''Post-process a frame latency log written with ST_FRAMETRACK=<file>.
+
+The log format is described in src/mesa/state_tracker/st_frametrack.h:
+a small header followed by one fixed-size record per frame, holding the
+CPU and GPU timestamps of the two end-of-frame flushes bounding the
+frame. Prints per-frame CPU time, GPU time and the CPU/GPU bubble
+(CPU time not covered by GPU work), plus a summary.
+'''
+
+import struct
+import sys
+
+MAGIC = 0x314b5446  # "FTK1"
+HEADER = struct.Struct('=II')
+RECORD = struct.Struct('=QQQQQ')
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write('usage: frametrack.py <logfile>\n')
+        sys.exit(1)
+
+    with open(sys.argv[1], 'rb') as f:
+        data = f.read()
+
+    if len(data) < HEADER.size:
+        sys.stderr.write('error: truncated header\n')
+        sys.exit(1)
+
+    magic, record_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.stderr.write('error: bad magic 0x%08x\n' % magic)
+        sys.exit(1)
+    if record_size != RECORD.size:
+        sys.stderr.write('error: record size %u, expected %u\n'
+                         % (record_size, RECORD.size))
+        sys.exit(1)
+
+    cpu_total = 0
+    gpu_total = 0
+    bubble_total = 0
+    num_frames = 0
+
+    print('%8s %10s %10s %10s' % ('frame', 'cpu (ms)', 'gpu (ms)',
+                                  'bubble (ms)'))
+
+    offset = HEADER.size
+    while offset + record_size <= len(data):
+        frame, cpu_begin, cpu_end, gpu_begin, gpu_end = \
+            RECORD.unpack_from(data, offset)
+        offset += record_size
+
+        cpu_ns = cpu_end - cpu_begin
+        gpu_ns = gpu_end - gpu_begin if gpu_end else 0
+        bubble_ns = cpu_ns - gpu_ns if cpu_ns > gpu_ns else 0
+
+        print('%8u %10.3f %10.3f %10.3f' % (frame, cpu_ns * 1e-6,
+                                            gpu_ns * 1e-6, bubble_ns * 1e-6))
+
+        cpu_total += cpu_ns
+        gpu_total += gpu_ns
+        bubble_total += bubble_ns
+        num_frames += 1
+
+    if num_frames:
+        print('%u frames, avg cpu %.3f ms, avg gpu %.3f ms, '
+              'avg bubble %.3f ms'
+              % (num_frames, cpu_total * 1e-6 / num_frames,
+                 gpu_total * 1e-6 / num_frames,
+                 bubble_total * 1e-6 / num_frames))
+
+
+if __name__ == '__main__':
+    main()
@@ -581,12 +581,30 @@ gbm_dri_is_format_supported(struct gbm_device *gbm,
       }
    }
 
+   mtx_lock(&dri->mutex);
+   for (unsigned i = 0; i < dri->format_cache_count; i++) {
+      if (dri->format_cache[i].format == format) {
+         int supported = dri->format_cache[i].supported;
+         mtx_unlock(&dri->mutex);
+         return supported;
+      }
+   }
+   mtx_unlock(&dri->mutex);
+
    /* Check if the driver returns any modifiers for this format; since linear
     * is counted as a modifier, we will have at least one modifier for any
     * supported format. */
    if (!dri->image->queryDmaBufModifiers(dri->screen, format, 0, NULL, NULL,
                                          &count))
-      return 0;
+      count = 0;
+
+   mtx_lock(&dri->mutex);
+   if (dri->format_cache_count < ARRAY_SIZE(dri->format_cache)) {
+      dri->format_cache[dri->format_cache_count].format = format;
+      dri->format_cache[dri->format_cache_count].supported = (count > 0);
+      dri->format_cache_count++;
+   }
+   mtx_unlock(&dri->mutex);
 
    return (count > 0);
 }
@@ -598,6 +616,7 @@ gbm_dri_get_format_modifier_plane_count(struct gbm_device *gbm,
 {
    struct gbm_dri_device *dri = gbm_dri_device(gbm);
    uint64_t plane_count;
+   int result;
 
    if (dri->image->base.version < 16 ||
        !dri->image->queryDmaBufFormatModifierAttribs)
@@ -607,12 +626,34 @@ gbm_dri_get_format_modifier_plane_count(struct gbm_device *gbm,
    if (gbm_format_to_dri_format(format) == 0)
       return -1;
 
-   if (!dri->image->queryDmaBufFormatModifierAttribs(
+   mtx_lock(&dri->mutex);
+   for (unsigned i = 0; i < dri->plane_count_cache_count; i++) {
+      if (dri->plane_count_cache[i].format == format &&
+          dri->plane_count_cache[i].modifier == modifier) {
+         int count = dri->plane_count_cache[i].plane_count;
+         mtx_unlock(&dri->mutex);
+         return count;
+      }
+   }
+   mtx_unlock(&dri->mutex);
+
+   if (dri->image->queryDmaBufFormatModifierAttribs(
          dri->screen, format, modifier,
          __DRI_IMAGE_FORMAT_MODIFIER_ATTRIB_PLANE_COUNT, &plane_count))
-      return -1;
+      result = plane_count;
+   else
+      result = -1;
+
+   mtx_lock(&dri->mutex);
+   if (dri->plane_count_cache_count < ARRAY_SIZE(dri->plane_count_cache)) {
+      dri->plane_count_cache[dri->plane_count_cache_count].format = format;
+      dri->plane_count_cache[dri->plane_count_cache_count].modifier = modifier;
+      dri->plane_count_cache[dri->plane_count_cache_count].plane_count = result;
+      dri->plane_count_cache_count++;
+   }
+   mtx_unlock(&dri->mutex);
 
-   return plane_count;
+   return result;
 }
 
 static int
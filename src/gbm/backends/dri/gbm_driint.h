@@ -111,6 +111,23 @@ struct gbm_dri_device {
 
    const struct gbm_dri_visual *visual_table;
    int num_visuals;
+
+   /* Memoized dmabuf capability queries. The answers are fixed for the
+    * lifetime of the device, but compositors re-ask on every output
+    * reconfiguration, so keep small caches rather than re-entering the
+    * driver each time. Guarded by mutex. */
+   struct {
+      uint32_t format;
+      int supported;
+   } format_cache[32];
+   unsigned format_cache_count;
+
+   struct {
+      uint32_t format;
+      uint64_t modifier;
+      int plane_count;
+   } plane_count_cache[64];
+   unsigned plane_count_cache_count;
 };
 
 struct gbm_dri_bo {
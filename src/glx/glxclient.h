@@ -304,6 +304,15 @@ struct glx_context
      */
    GLboolean imported;
 
+    /**
+     * Sequence number of the GLXIsDirect request queued by CreateContext
+     * to verify server-side context creation, or 0 if no reply is
+     * outstanding.  Direct rendering contexts defer collecting the reply
+     * (see __glXCheckPendingIsDirect) so that creating a context does not
+     * require a synchronous round trip.
+     */
+   unsigned int isdirect_seq;
+
     /**
      * The context tag returned by MakeCurrent when this context is made
      * current. This tag is used to identify the context that a thread has
@@ -823,6 +832,8 @@ applegl_create_display(struct glx_display *display);
 extern Bool validate_renderType_against_config(const struct glx_config *config,
                                                int renderType);
 
+extern Bool __glXCheckPendingIsDirect(Display *dpy, struct glx_context *gc);
+
 
 extern struct glx_drawable *GetGLXDrawable(Display *dpy, GLXDrawable drawable);
 extern int InitGLXDrawable(Display *dpy, struct glx_drawable *glxDraw,
@@ -311,6 +311,43 @@ __glXIsDirect(Display * dpy, GLXContextID contextID, Bool *error)
    return is_direct;
 }
 
+/**
+ * Collect the deferred GLXIsDirect reply which \c CreateContext issues for
+ * direct rendering contexts instead of synchronizing at creation time.
+ *
+ * \returns \c True unless the server reported an error for the original
+ * CreateContext request, or disagrees about the context being direct.
+ */
+_X_HIDDEN Bool
+__glXCheckPendingIsDirect(Display *dpy, struct glx_context *gc)
+{
+   xcb_connection_t *c;
+   xcb_glx_is_direct_cookie_t cookie;
+   xcb_glx_is_direct_reply_t *reply;
+   xcb_generic_error_t *err = NULL;
+   Bool result = True;
+
+   if (gc->isdirect_seq == 0)
+      return True;
+
+   c = XGetXCBConnection(dpy);
+   cookie.sequence = gc->isdirect_seq;
+   gc->isdirect_seq = 0;
+
+   reply = xcb_glx_is_direct_reply(c, cookie, &err);
+   if (err != NULL) {
+      __glXSendErrorForXcb(dpy, err);
+      free(err);
+      result = False;
+   } else if (reply == NULL || !reply->is_direct) {
+      result = False;
+   }
+
+   free(reply);
+
+   return result;
+}
+
 /**
  * Create a new context.
  *
@@ -418,8 +455,18 @@ CreateContext(Display *dpy, int generic_id, struct glx_config *config,
     * with client-side state, not just an XID. To simplify error handling
     * elsewhere in libGL, force a round-trip here to ensure the CreateContext
     * request above succeeded.
+    *
+    * For direct rendering contexts, nothing consults the server's answer
+    * until the context is actually used, so just queue the request and
+    * collect the reply when the context is first made current (see
+    * __glXCheckPendingIsDirect).  Applications which create and switch
+    * between many contexts would otherwise pay a round trip per context.
     */
-   {
+   if (gc->isDirect) {
+      xcb_connection_t *c = XGetXCBConnection(dpy);
+
+      gc->isdirect_seq = xcb_glx_is_direct(c, gc->xid).sequence;
+   } else {
       Bool error = False;
       int isDirect = __glXIsDirect(dpy, gc->xid, &error);
 
@@ -510,6 +557,12 @@ glXDestroyContext(Display * dpy, GLXContext ctx)
       return;
 
    __glXLock();
+   if (gc->isdirect_seq) {
+      /* Nobody ever looked at the deferred creation check; drop it. */
+      xcb_discard_reply(XGetXCBConnection(dpy), gc->isdirect_seq);
+      gc->isdirect_seq = 0;
+   }
+
    if (!gc->imported)
       glx_send_destroy_context(dpy, gc->xid);
 
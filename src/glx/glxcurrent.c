@@ -194,6 +194,14 @@ MakeContextCurrent(Display * dpy, GLXDrawable draw,
       return True;
    }
 
+   /* Collect the deferred creation-error check, if one is still pending -
+    * direct contexts don't synchronize with the server at creation time.
+    */
+   if (gc != NULL && !__glXCheckPendingIsDirect(dpy, gc)) {
+      __glXUnlock();
+      return GL_FALSE;
+   }
+
    /* can't have only one be 0 */
    if (!!draw != !!read) {
       __glXUnlock();
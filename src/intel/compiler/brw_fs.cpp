@@ -8074,6 +8074,28 @@ brw_compile_fs(const struct brw_compiler *compiler, void *log_data,
       }
    }
 
+   /* The scheduler annotates each CFG with an estimated cycle count (post
+    * register allocation, so spill code is included). A SIMD32 thread does
+    * the work of two SIMD16 threads, so shipping the SIMD32 variant only
+    * makes sense when it is expected to finish in less than twice the
+    * cycles; the hardware prefers the widest enabled dispatch, so a
+    * regressing SIMD32 kernel would actually get used.
+    */
+   if (simd32_cfg && simd16_cfg) {
+      compiler->shader_perf_log(log_data,
+                                "Estimated cycles for 32 fragments: "
+                                "SIMD16 %u, SIMD32 %u",
+                                2 * simd16_cfg->cycle_count,
+                                simd32_cfg->cycle_count);
+
+      if (simd32_cfg->cycle_count >= 2 * simd16_cfg->cycle_count) {
+         compiler->shader_perf_log(log_data,
+                                   "SIMD32 shader estimated to be slower "
+                                   "than SIMD16, dropping it");
+         simd32_cfg = NULL;
+      }
+   }
+
    /* When the caller requests a repclear shader, they want SIMD16-only */
    if (use_rep_send)
       simd8_cfg = NULL;
@@ -8358,10 +8380,40 @@ brw_compile_cs(const struct brw_compiler *compiler, void *log_data,
                "enough threads for SIMD16";
          }
       } else {
-         cfg = v32->cfg;
-         cs_set_simd_size(prog_data, 32);
-         cs_fill_push_const_info(compiler->devinfo, prog_data);
-         promoted_constants = v32->promoted_constants;
+         /* When a narrower variant is available, use the scheduler's cycle
+          * estimates (which include spill code, since the final schedule
+          * runs after register allocation) to decide whether SIMD32 helps:
+          * a SIMD32 thread does the work of two SIMD16 or four SIMD8
+          * threads, so it only wins if it is estimated to finish in less
+          * than that many times the cycles.
+          */
+         bool keep_simd32 = true;
+
+         if (cfg && min_dispatch_width <= 16) {
+            const unsigned narrow_cycles =
+               cfg->cycle_count * (32 / prog_data->simd_size);
+
+            compiler->shader_perf_log(log_data,
+                                      "Estimated cycles for 32 invocations: "
+                                      "SIMD%u %u, SIMD32 %u",
+                                      prog_data->simd_size, narrow_cycles,
+                                      v32->cfg->cycle_count);
+
+            if (v32->cfg->cycle_count >= narrow_cycles) {
+               compiler->shader_perf_log(log_data,
+                                         "SIMD32 shader estimated to be "
+                                         "slower than SIMD%u, dropping it",
+                                         prog_data->simd_size);
+               keep_simd32 = false;
+            }
+         }
+
+         if (keep_simd32) {
+            cfg = v32->cfg;
+            cs_set_simd_size(prog_data, 32);
+            cs_fill_push_const_info(compiler->devinfo, prog_data);
+            promoted_constants = v32->promoted_constants;
+         }
       }
    }
 
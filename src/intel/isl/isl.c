@@ -35,6 +35,9 @@
 #include "isl_gen9.h"
 #include "isl_priv.h"
 
+static void
+isl_device_setup_dispatch(struct isl_device *dev);
+
 void
 isl_memcpy_linear_to_tiled(uint32_t xt1, uint32_t xt2,
                            uint32_t yt1, uint32_t yt2,
@@ -44,6 +47,16 @@ isl_memcpy_linear_to_tiled(uint32_t xt1, uint32_t xt2,
                            enum isl_tiling tiling,
                            isl_memcpy_type copy_type)
 {
+#ifdef USE_AVX2
+   if (copy_type == ISL_MEMCPY_STREAMING_LOAD &&
+       __builtin_cpu_supports("avx2")) {
+      _isl_memcpy_linear_to_tiled_avx2(
+         xt1, xt2, yt1, yt2, dst, src, dst_pitch, src_pitch, has_swizzling,
+         tiling, copy_type);
+      return;
+   }
+#endif
+
 #ifdef USE_SSE41
    if (copy_type == ISL_MEMCPY_STREAMING_LOAD) {
       _isl_memcpy_linear_to_tiled_sse41(
@@ -67,6 +80,16 @@ isl_memcpy_tiled_to_linear(uint32_t xt1, uint32_t xt2,
                            enum isl_tiling tiling,
                            isl_memcpy_type copy_type)
 {
+#ifdef USE_AVX2
+   if (copy_type == ISL_MEMCPY_STREAMING_LOAD &&
+       __builtin_cpu_supports("avx2")) {
+      _isl_memcpy_tiled_to_linear_avx2(
+         xt1, xt2, yt1, yt2, dst, src, dst_pitch, src_pitch, has_swizzling,
+         tiling, copy_type);
+      return;
+   }
+#endif
+
 #ifdef USE_SSE41
    if (copy_type == ISL_MEMCPY_STREAMING_LOAD) {
       _isl_memcpy_tiled_to_linear_sse41(
@@ -106,6 +129,8 @@ isl_device_init(struct isl_device *dev,
    dev->use_separate_stencil = ISL_DEV_GEN(dev) >= 6;
    dev->has_bit6_swizzling = has_bit6_swizzling;
 
+   isl_device_setup_dispatch(dev);
+
    /* The ISL_DEV macros may be defined in the CFLAGS, thus hardcoding some
     * device properties at buildtime. Verify that the macros with the device
     * properties chosen during runtime.
@@ -1865,45 +1890,60 @@ isl_surf_get_ccs_surf(const struct isl_device *dev,
                         .tiling_flags = ISL_TILING_CCS_BIT);
 }
 
-#define isl_genX_call(dev, func, ...)              \
-   switch (ISL_DEV_GEN(dev)) {                     \
-   case 4:                                         \
-      /* G45 surface state is the same as gen5 */  \
-      if (ISL_DEV_IS_G4X(dev)) {                   \
-         isl_gen5_##func(__VA_ARGS__);             \
-      } else {                                     \
-         isl_gen4_##func(__VA_ARGS__);             \
-      }                                            \
-      break;                                       \
-   case 5:                                         \
-      isl_gen5_##func(__VA_ARGS__);                \
-      break;                                       \
-   case 6:                                         \
-      isl_gen6_##func(__VA_ARGS__);                \
-      break;                                       \
-   case 7:                                         \
-      if (ISL_DEV_IS_HASWELL(dev)) {               \
-         isl_gen75_##func(__VA_ARGS__);            \
-      } else {                                     \
-         isl_gen7_##func(__VA_ARGS__);             \
-      }                                            \
-      break;                                       \
-   case 8:                                         \
-      isl_gen8_##func(__VA_ARGS__);                \
-      break;                                       \
-   case 9:                                         \
-      isl_gen9_##func(__VA_ARGS__);                \
-      break;                                       \
-   case 10:                                        \
-      isl_gen10_##func(__VA_ARGS__);               \
-      break;                                       \
-   case 11:                                        \
-      isl_gen11_##func(__VA_ARGS__);               \
-      break;                                       \
-   default:                                        \
-      assert(!"Unknown hardware generation");      \
+static void
+isl_device_setup_dispatch(struct isl_device *dev)
+{
+#define isl_genX_bind(gen)                                            \
+   do {                                                               \
+      dev->dispatch.surf_fill_state_s =                               \
+         isl_##gen##_surf_fill_state_s;                               \
+      dev->dispatch.buffer_fill_state_s =                             \
+         isl_##gen##_buffer_fill_state_s;                             \
+      dev->dispatch.emit_depth_stencil_hiz_s =                        \
+         isl_##gen##_emit_depth_stencil_hiz_s;                        \
+      dev->dispatch.null_fill_state =                                 \
+         isl_##gen##_null_fill_state;                                 \
+   } while (0)
+
+   switch (ISL_DEV_GEN(dev)) {
+   case 4:
+      /* G45 surface state is the same as gen5 */
+      if (ISL_DEV_IS_G4X(dev))
+         isl_genX_bind(gen5);
+      else
+         isl_genX_bind(gen4);
+      break;
+   case 5:
+      isl_genX_bind(gen5);
+      break;
+   case 6:
+      isl_genX_bind(gen6);
+      break;
+   case 7:
+      if (ISL_DEV_IS_HASWELL(dev))
+         isl_genX_bind(gen75);
+      else
+         isl_genX_bind(gen7);
+      break;
+   case 8:
+      isl_genX_bind(gen8);
+      break;
+   case 9:
+      isl_genX_bind(gen9);
+      break;
+   case 10:
+      isl_genX_bind(gen10);
+      break;
+   case 11:
+      isl_genX_bind(gen11);
+      break;
+   default:
+      assert(!"Unknown hardware generation");
    }
 
+#undef isl_genX_bind
+}
+
 void
 isl_surf_fill_state_s(const struct isl_device *dev, void *state,
                       const struct isl_surf_fill_state_info *restrict info)
@@ -1927,21 +1967,21 @@ isl_surf_fill_state_s(const struct isl_device *dev, void *state,
              info->surf->logical_level0_px.array_len);
    }
 
-   isl_genX_call(dev, surf_fill_state_s, dev, state, info);
+   dev->dispatch.surf_fill_state_s(dev, state, info);
 }
 
 void
 isl_buffer_fill_state_s(const struct isl_device *dev, void *state,
                         const struct isl_buffer_fill_state_info *restrict info)
 {
-   isl_genX_call(dev, buffer_fill_state_s, state, info);
+   dev->dispatch.buffer_fill_state_s(state, info);
 }
 
 void
 isl_null_fill_state(const struct isl_device *dev, void *state,
                     struct isl_extent3d size)
 {
-   isl_genX_call(dev, null_fill_state, state, size);
+   dev->dispatch.null_fill_state(state, size);
 }
 
 void
@@ -1978,7 +2018,7 @@ isl_emit_depth_stencil_hiz_s(const struct isl_device *dev, void *batch,
       }
    }
 
-   isl_genX_call(dev, emit_depth_stencil_hiz_s, dev, batch, info);
+   dev->dispatch.emit_depth_stencil_hiz_s(dev, batch, info);
 }
 
 /**
@@ -51,6 +51,11 @@ extern "C" {
 
 struct gen_device_info;
 struct brw_image_param;
+struct isl_device;
+struct isl_surf_fill_state_info;
+struct isl_buffer_fill_state_info;
+struct isl_depth_stencil_hiz_emit_info;
+struct isl_extent3d;
 
 #ifndef ISL_DEV_GEN
 /**
@@ -992,6 +997,23 @@ struct isl_device {
       uint8_t stencil_offset;
       uint8_t hiz_offset;
    } ds;
+
+   /**
+    * Gen-specific entry points for the state fill/emit paths, resolved
+    * once at isl_device_init() time so that the hot paths (surface and
+    * buffer fills for descriptor writes in particular) don't redo the
+    * generation dispatch on every call.
+    */
+   struct {
+      void (*surf_fill_state_s)(const struct isl_device *dev, void *state,
+                                const struct isl_surf_fill_state_info *info);
+      void (*buffer_fill_state_s)(void *state,
+                                  const struct isl_buffer_fill_state_info *info);
+      void (*emit_depth_stencil_hiz_s)(const struct isl_device *dev,
+                                       void *batch,
+                                       const struct isl_depth_stencil_hiz_emit_info *info);
+      void (*null_fill_state)(void *state, struct isl_extent3d size);
+   } dispatch;
 };
 
 struct isl_extent2d {
@@ -285,6 +285,7 @@ anv_batch_emit_batch(struct anv_batch *batch, struct anv_batch *other)
 
 static VkResult
 anv_batch_bo_create(struct anv_cmd_buffer *cmd_buffer,
+                    uint32_t size,
                     struct anv_batch_bo **bbo_out)
 {
    VkResult result;
@@ -295,7 +296,7 @@ anv_batch_bo_create(struct anv_cmd_buffer *cmd_buffer,
       return vk_error(VK_ERROR_OUT_OF_HOST_MEMORY);
 
    result = anv_bo_pool_alloc(&cmd_buffer->device->batch_bo_pool, &bbo->bo,
-                              ANV_CMD_BUFFER_BATCH_SIZE);
+                              size);
    if (result != VK_SUCCESS)
       goto fail_alloc;
 
@@ -560,7 +561,18 @@ anv_cmd_buffer_chain_batch(struct anv_batch *batch, void *_data)
    struct anv_cmd_buffer *cmd_buffer = _data;
    struct anv_batch_bo *new_bbo;
 
-   VkResult result = anv_batch_bo_create(cmd_buffer, &new_bbo);
+   /* Cap the size of the new BO to prevent it from getting out of hand but
+    * double it each time we chain so that command-heavy command buffers
+    * settle into a small number of large BOs instead of a long chain of
+    * small ones.  The BOs come from a power-of-two bucketed pool and get
+    * recycled on reset, so over-allocating the tail costs very little.
+    */
+   struct anv_batch_bo *current_bbo =
+      anv_cmd_buffer_current_batch_bo(cmd_buffer);
+   uint32_t new_size = MIN2(current_bbo->bo.size * 2,
+                            ANV_MAX_CMD_BUFFER_BATCH_SIZE);
+
+   VkResult result = anv_batch_bo_create(cmd_buffer, new_size, &new_bbo);
    if (result != VK_SUCCESS)
       return result;
 
@@ -734,7 +746,8 @@ anv_cmd_buffer_init_batch_bo_chain(struct anv_cmd_buffer *cmd_buffer)
 
    list_inithead(&cmd_buffer->batch_bos);
 
-   result = anv_batch_bo_create(cmd_buffer, &batch_bo);
+   result = anv_batch_bo_create(cmd_buffer,
+                                ANV_CMD_BUFFER_BATCH_SIZE, &batch_bo);
    if (result != VK_SUCCESS)
       return result;
 
@@ -1916,6 +1916,19 @@ void genX(CmdPipelineBarrier)(
    for (uint32_t i = 0; i < imageMemoryBarrierCount; i++) {
       src_flags |= pImageMemoryBarriers[i].srcAccessMask;
       dst_flags |= pImageMemoryBarriers[i].dstAccessMask;
+   }
+
+   /* Schedule the source-side flushes before we perform any image layout
+    * transitions.  The resolve and ambiguate operations implied by a
+    * transition consume whatever the caller wrote to the image, so these
+    * flushes have to land first anyway, and accumulating them in the
+    * pending set here lets the first resolve's pipe flush cover both
+    * instead of emitting a second PIPE_CONTROL at the next draw.
+    */
+   cmd_buffer->state.pending_pipe_bits |=
+      anv_pipe_flush_bits_for_access_flags(src_flags);
+
+   for (uint32_t i = 0; i < imageMemoryBarrierCount; i++) {
       ANV_FROM_HANDLE(anv_image, image, pImageMemoryBarriers[i].image);
       const VkImageSubresourceRange *range =
          &pImageMemoryBarriers[i].subresourceRange;
@@ -1959,8 +1972,12 @@ void genX(CmdPipelineBarrier)(
       }
    }
 
+   /* The destination-side invalidations must stay behind the transitions:
+    * they may only happen once the resolved data has actually reached
+    * memory, which the trailing render target flush from the last
+    * transition guarantees.
+    */
    cmd_buffer->state.pending_pipe_bits |=
-      anv_pipe_flush_bits_for_access_flags(src_flags) |
       anv_pipe_invalidate_bits_for_access_flags(dst_flags);
 }
 
@@ -273,9 +273,34 @@ dri3_fence_await(xcb_connection_t *c, struct loader_dri3_drawable *draw,
 static void
 dri3_update_num_back(struct loader_dri3_drawable *draw)
 {
-   if (draw->last_present_mode == XCB_PRESENT_COMPLETE_MODE_FLIP)
-      draw->num_back = 3;
-   else
+   if (draw->last_present_mode == XCB_PRESENT_COMPLETE_MODE_FLIP) {
+      /* When flipping, one buffer can be on the scanout and another queued
+       * for the next vblank, so we need a third to render to.  With swap
+       * interval 0, a fourth buffer lets rendering run ahead while a
+       * queued flip waits for vblank.
+       */
+      draw->max_num_back = draw->swap_interval == 0 ? 4 : 3;
+
+      /* With only two buffers, rendering the next frame can't start until
+       * the previous flip has completed, so nothing ever sits queued behind
+       * a pending present and the present-to-present latency stays at its
+       * stable minimum.  Opt-in, since it costs throughput whenever a frame
+       * misses its vblank.
+       */
+      if (draw->block_on_depleted_buffers && draw->swap_interval != 0)
+         draw->max_num_back = 2;
+   } else {
+      draw->max_num_back = 2;
+   }
+
+   assert(draw->max_num_back <= LOADER_DRI3_MAX_BACK);
+
+   /* The swapchain only grows on demand, when dri3_find_back would
+    * otherwise have to block on a PresentIdleNotify event.
+    */
+   if (draw->num_back > draw->max_num_back)
+      draw->num_back = draw->max_num_back;
+   else if (draw->num_back < 2)
       draw->num_back = 2;
 }
 
@@ -359,6 +384,7 @@ loader_dri3_drawable_init(xcb_connection_t *conn,
    draw->first_init = true;
    draw->adaptive_sync = false;
    draw->adaptive_sync_active = false;
+   draw->block_on_depleted_buffers = false;
 
    draw->cur_blit_source = -1;
    draw->back_format = __DRI_IMAGE_FORMAT_NONE;
@@ -367,6 +393,7 @@ loader_dri3_drawable_init(xcb_connection_t *conn,
 
    if (draw->ext->config) {
       unsigned char adaptive_sync = 0;
+      unsigned char block_on_depleted_buffers = 0;
 
       draw->ext->config->configQueryi(draw->dri_screen,
                                       "vblank_mode", &vblank_mode);
@@ -376,6 +403,12 @@ loader_dri3_drawable_init(xcb_connection_t *conn,
                                       &adaptive_sync);
 
       draw->adaptive_sync = adaptive_sync;
+
+      draw->ext->config->configQueryb(draw->dri_screen,
+                                      "block_on_depleted_buffers",
+                                      &block_on_depleted_buffers);
+
+      draw->block_on_depleted_buffers = block_on_depleted_buffers;
    }
 
    if (!draw->adaptive_sync)
@@ -667,6 +700,21 @@ dri3_find_back(struct loader_dri3_drawable *draw)
             return id;
          }
       }
+
+      /* All buffers are busy.  If the present mode allows a deeper
+       * swapchain, claim a fresh buffer slot rather than blocking here
+       * until the server idles one; the caller allocates the new back
+       * buffer lazily.
+       */
+      if (num_to_consider == draw->num_back &&
+          draw->num_back < draw->max_num_back) {
+         int id = LOADER_DRI3_BACK_ID(draw->num_back++);
+
+         draw->cur_back = id;
+         mtx_unlock(&draw->mtx);
+         return id;
+      }
+
       if (!dri3_wait_for_event_locked(draw)) {
          mtx_unlock(&draw->mtx);
          return -1;
@@ -147,6 +147,7 @@ struct loader_dri3_drawable {
    struct loader_dri3_buffer *buffers[LOADER_DRI3_NUM_BUFFERS];
    int cur_back;
    int num_back;
+   int max_num_back;
    int cur_blit_source;
 
    uint32_t *stamp;
@@ -158,6 +159,7 @@ struct loader_dri3_drawable {
    bool first_init;
    bool adaptive_sync;
    bool adaptive_sync_active;
+   bool block_on_depleted_buffers;
    int swap_interval;
 
    struct loader_dri3_extensions *ext;
@@ -61,18 +61,71 @@ __asm__(".text\n"
 #define MAPI_TMP_STUB_ASM_GCC
 #include "mapi_tmp.h"
 
+__asm__(".balign 32\n"
+        "x86_64_entry_end:");
+
 #ifndef MAPI_MODE_BRIDGE
 
+#include <stdint.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "u_execmem.h"
 
+extern char
+x86_64_entry_start[] HIDDEN;
+
+extern char
+x86_64_entry_end[] HIDDEN;
+
 void
 entry_patch_public(void)
 {
-}
+   /* Rewrite the TLS access in each public stub from the two-instruction
+    * GOT-indirect form emitted by STUB_ASM_CODE into the direct
+    * "mov %fs:tpoff, %r11" form that entry_generate() uses, saving a
+    * dependent load from the GOT on every call.  The stubs live in
+    * read-only text, so the pages are made writable only while patching.
+    * If that fails, or the offset does not fit in a sign-extended 32-bit
+    * displacement, the unpatched stubs keep working through the GOT.
+    */
+   char patch[11] = {
+#ifndef __ILP32__
+      /* movq %fs:0x0, %r11 */
+      0x64, 0x4c, 0x8b, 0x1c, 0x25, 0x00, 0x00, 0x00, 0x00,
+#else
+      /* movl %fs:0x0, %r11d */
+      0x64, 0x44, 0x8b, 0x1c, 0x25, 0x00, 0x00, 0x00, 0x00,
+#endif
+      0x90, 0x90                                /* nop's */
+   };
+   unsigned long long addr;
+   uintptr_t page_start;
+   long page_size;
+   size_t len;
+   char *entry;
 
-extern char
-x86_64_entry_start[] HIDDEN;
+   __asm__("movq " ENTRY_CURRENT_TABLE "@GOTTPOFF(%%rip), %0"
+           : "=r" (addr));
+   if ((addr >> 32) != 0xffffffff)
+      return;
+   addr &= 0xffffffff;
+
+   *((unsigned int *) (patch + 5)) = addr;
+
+   page_size = sysconf(_SC_PAGESIZE);
+   page_start = (uintptr_t) x86_64_entry_start & ~((uintptr_t) page_size - 1);
+   len = (uintptr_t) x86_64_entry_end - page_start;
+
+   if (mprotect((void *) page_start, len,
+                PROT_READ | PROT_WRITE | PROT_EXEC))
+      return;
+
+   for (entry = x86_64_entry_start; entry < x86_64_entry_end; entry += 32)
+      memcpy(entry, patch, sizeof(patch));
+
+   mprotect((void *) page_start, len, PROT_READ | PROT_EXEC);
+}
 
 mapi_func
 entry_get_public(int slot)
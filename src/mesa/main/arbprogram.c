@@ -39,6 +39,7 @@
 #include "main/shaderapi.h"
 #include "main/state.h"
 #include "program/arbprogparse.h"
+#include "util/mesa-sha1.h"
 #include "program/program.h"
 #include "program/prog_print.h"
 
@@ -349,15 +350,18 @@ _mesa_ProgramStringARB(GLenum target, GLenum format, GLsizei len,
 
 #ifdef ENABLE_SHADER_CACHE
    GLcharARB *replacement;
+   unsigned char sha1[20];
 
    gl_shader_stage stage = _mesa_program_enum_to_shader_stage(target);
 
+   _mesa_sha1_compute(string, strlen(string), sha1);
+
    /* Dump original shader source to MESA_SHADER_DUMP_PATH and replace
     * if corresponding entry found from MESA_SHADER_READ_PATH.
     */
-   _mesa_dump_shader_source(stage, string);
+   _mesa_dump_shader_source(stage, string, sha1);
 
-   replacement = _mesa_read_shader_source(stage, string);
+   replacement = _mesa_read_shader_source(stage, string, sha1);
    if (replacement)
       string = replacement;
 #endif /* ENABLE_SHADER_CACHE */
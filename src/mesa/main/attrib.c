@@ -1583,6 +1583,12 @@ copy_array_object(struct gl_context *ctx,
    dest->VertexAttribBufferMask = src->VertexAttribBufferMask;
    dest->_AttributeMapMode = src->_AttributeMapMode;
    dest->NewArrays = src->NewArrays;
+
+   /* The array contents changed without going through the varray API, so
+    * memoized per-VAO derived state (see st_update_array) must not be
+    * reused against the old generation.
+    */
+   dest->Generation = ++ctx->Array.VAOGeneration;
 }
 
 /**
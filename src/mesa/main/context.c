@@ -1124,11 +1124,64 @@ create_beginend_table(const struct gl_context *ctx)
    return table;
 }
 
+/**
+ * The code-generated _mesa_initialize_exec_table() fills ~1500 dispatch
+ * slots and its conditions only read ctx->API and ctx->Version, so keep a
+ * copy of each table we build and memcpy it into later contexts with the
+ * same API/version.  Apps that create many short-lived contexts
+ * (thumbnailers, compositors) pay this on every context otherwise.
+ */
+static struct {
+   gl_api api;
+   uint32_t version;
+   struct _glapi_table *table;
+} exec_table_cache[8];
+
+static mtx_t exec_table_cache_mutex = _MTX_INITIALIZER_NP;
+
+static void
+initialize_exec_table_cached(struct gl_context *ctx)
+{
+   const int numEntries = MAX2(_glapi_get_dispatch_table_size(),
+                               _gloffset_COUNT);
+   const size_t size = numEntries * sizeof(_glapi_proc);
+   unsigned i;
+
+   mtx_lock(&exec_table_cache_mutex);
+
+   for (i = 0; i < ARRAY_SIZE(exec_table_cache); i++) {
+      if (!exec_table_cache[i].table)
+         break;
+
+      if (exec_table_cache[i].api == ctx->API &&
+          exec_table_cache[i].version == ctx->Version) {
+         memcpy(ctx->Exec, exec_table_cache[i].table, size);
+         mtx_unlock(&exec_table_cache_mutex);
+         return;
+      }
+   }
+
+   _mesa_initialize_exec_table(ctx);
+
+   if (i < ARRAY_SIZE(exec_table_cache)) {
+      struct _glapi_table *copy = malloc(size);
+
+      if (copy) {
+         memcpy(copy, ctx->Exec, size);
+         exec_table_cache[i].api = ctx->API;
+         exec_table_cache[i].version = ctx->Version;
+         exec_table_cache[i].table = copy;
+      }
+   }
+
+   mtx_unlock(&exec_table_cache_mutex);
+}
+
 void
 _mesa_initialize_dispatch_tables(struct gl_context *ctx)
 {
    /* Do the code-generated setup of the exec table in api_exec.c. */
-   _mesa_initialize_exec_table(ctx);
+   initialize_exec_table_cached(ctx);
 
    if (ctx->Save)
       _mesa_initialize_save_table(ctx);
@@ -1305,6 +1305,18 @@ struct dd_function_table {
    void (*SetMaxShaderCompilerThreads)(struct gl_context *ctx, unsigned count);
    bool (*GetShaderProgramCompletionStatus)(struct gl_context *ctx,
                                             struct gl_shader_program *shprog);
+
+   /**
+    * Poll whether an individual shader's compile job has finished, for
+    * GL_COMPLETION_STATUS_ARB on shader objects.  Drivers that offload
+    * glCompileShader work to a thread pool should return false while the
+    * job is still queued or running; returning true must guarantee that a
+    * following glGetShaderiv(GL_COMPILE_STATUS) does not block.  Optional -
+    * when unset, core Mesa reports completion since the front-end compile
+    * ran synchronously.
+    */
+   bool (*GetShaderCompletionStatus)(struct gl_context *ctx,
+                                     struct gl_shader *sh);
 };
 
 
@@ -9665,7 +9665,7 @@ execute_list(struct gl_context *ctx, GLuint list)
    Node *n;
    GLboolean done;
 
-   if (list == 0 || !islist(ctx, list))
+   if (list == 0)
       return;
 
    if (ctx->ListState.CallDepth == MAX_LIST_NESTING) {
@@ -9673,6 +9673,9 @@ execute_list(struct gl_context *ctx, GLuint list)
       return;
    }
 
+   /* This also performs the islist() check; don't pay for the name hash
+    * lookup twice on this extremely hot path.
+    */
    dlist = _mesa_lookup_list(ctx, list);
    if (!dlist)
       return;
@@ -370,6 +370,71 @@ extension_compare(const void *p1, const void *p2)
 }
 
 
+/**
+ * Memo of the most recently built extension string.  All contexts on the
+ * same screen enable the same extensions, so a process creating many
+ * contexts sorts and concatenates the full list only once; the key is the
+ * set of supported extensions rather than the context that asked.
+ */
+static struct {
+   bool valid;
+   uint32_t supported[(MESA_EXTENSION_COUNT + 31) / 32];
+   char *unrecognized[MAX_UNRECOGNIZED_EXTENSIONS];
+   char *string;
+   size_t size;
+} extension_string_memo;
+
+static mtx_t extension_string_memo_mutex = _MTX_INITIALIZER_NP;
+
+static bool
+extension_string_memo_matches(const struct gl_context *ctx,
+                              const uint32_t *supported)
+{
+   unsigned k;
+
+   if (!extension_string_memo.valid ||
+       memcmp(extension_string_memo.supported, supported,
+              sizeof(extension_string_memo.supported)) != 0)
+      return false;
+
+   for (k = 0; k < MAX_UNRECOGNIZED_EXTENSIONS; k++) {
+      const char *a = extension_string_memo.unrecognized[k];
+      const char *b = ctx->Extensions.unrecognized_extensions[k];
+
+      if (!a != !b || (a && strcmp(a, b) != 0))
+         return false;
+   }
+
+   return true;
+}
+
+static void
+extension_string_memo_store(const struct gl_context *ctx,
+                            const uint32_t *supported,
+                            const char *exts, size_t size)
+{
+   unsigned k;
+   char *copy = malloc(size);
+
+   if (!copy)
+      return;
+   memcpy(copy, exts, size);
+
+   free(extension_string_memo.string);
+   for (k = 0; k < MAX_UNRECOGNIZED_EXTENSIONS; k++) {
+      free(extension_string_memo.unrecognized[k]);
+      extension_string_memo.unrecognized[k] =
+         ctx->Extensions.unrecognized_extensions[k] ?
+         strdup(ctx->Extensions.unrecognized_extensions[k]) : NULL;
+   }
+
+   memcpy(extension_string_memo.supported, supported,
+          sizeof(extension_string_memo.supported));
+   extension_string_memo.string = copy;
+   extension_string_memo.size = size;
+   extension_string_memo.valid = true;
+}
+
 /**
  * Construct the GL_EXTENSIONS string.  Called the first time that
  * glGetString(GL_EXTENSIONS) is called.
@@ -385,6 +450,8 @@ _mesa_make_extension_string(struct gl_context *ctx)
    unsigned count;
    /* Indices of the extensions sorted by year */
    extension_index extension_indices[MESA_EXTENSION_COUNT];
+   /* Bitset of the emitted extensions, the key for the memo */
+   uint32_t supported[(MESA_EXTENSION_COUNT + 31) / 32] = { 0 };
    unsigned k;
    unsigned j;
    unsigned maxYear = ~0;
@@ -408,14 +475,27 @@ _mesa_make_extension_string(struct gl_context *ctx)
           _mesa_extension_supported(ctx, k)) {
 	 length += strlen(i->name) + 1; /* +1 for space */
 	 ++count;
+	 supported[k / 32] |= 1u << (k % 32);
       }
    }
    for (k = 0; k < MAX_UNRECOGNIZED_EXTENSIONS; k++)
       if (ctx->Extensions.unrecognized_extensions[k])
          length += 1 + strlen(ctx->Extensions.unrecognized_extensions[k]); /* +1 for space */
 
+   mtx_lock(&extension_string_memo_mutex);
+
+   if (extension_string_memo_matches(ctx, supported)) {
+      exts = calloc(extension_string_memo.size, sizeof(char));
+      if (exts)
+         memcpy(exts, extension_string_memo.string,
+                extension_string_memo.size);
+      mtx_unlock(&extension_string_memo_mutex);
+      return (GLubyte *) exts;
+   }
+
    exts = calloc(ALIGN(length + 1, 4), sizeof(char));
    if (exts == NULL) {
+      mtx_unlock(&extension_string_memo_mutex);
       return NULL;
    }
 
@@ -451,6 +531,9 @@ _mesa_make_extension_string(struct gl_context *ctx)
       }
    }
 
+   extension_string_memo_store(ctx, supported, exts, ALIGN(length + 1, 4));
+   mtx_unlock(&extension_string_memo_mutex);
+
    return (GLubyte *) exts;
 }
 
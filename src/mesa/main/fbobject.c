@@ -962,6 +962,81 @@ test_attachment_completeness(const struct gl_context *ctx, GLenum format,
 }
 
 
+/**
+ * Record everything the completeness test below reads that can change
+ * between two validations of the same FBO.  The stamp must be filled
+ * deterministically, (memset first, since it is compared with memcmp).
+ */
+static void
+framebuffer_validation_stamp(const struct gl_framebuffer *fb,
+                             struct gl_framebuffer_stamp *stamp)
+{
+   GLuint i;
+
+   memset(stamp, 0, sizeof(*stamp));
+
+   memcpy(stamp->ColorDrawBuffer, fb->ColorDrawBuffer,
+          sizeof(stamp->ColorDrawBuffer));
+   stamp->ColorReadBuffer = fb->ColorReadBuffer;
+   stamp->DefaultWidth = fb->DefaultGeometry.Width;
+   stamp->DefaultHeight = fb->DefaultGeometry.Height;
+
+   for (i = 0; i < BUFFER_COUNT; i++) {
+      const struct gl_renderbuffer_attachment *att = &fb->Attachment[i];
+      struct gl_attachment_stamp *s = &stamp->Attachment[i];
+
+      s->Type = att->Type;
+
+      if (att->Type == GL_TEXTURE) {
+         const struct gl_texture_object *texObj = att->Texture;
+
+         s->Object = texObj;
+         s->Level = att->TextureLevel;
+         s->Face = att->CubeMapFace;
+         s->Zoffset = att->Zoffset;
+         s->Layered = att->Layered;
+         s->NumSamples = att->NumSamples;
+
+         if (texObj) {
+            const struct gl_texture_image *texImage =
+               texObj->Image[att->CubeMapFace][att->TextureLevel];
+
+            s->Target = texObj->Target;
+            s->IsFloat = texObj->_IsFloat || texObj->_IsHalfFloat;
+            s->Image = texImage;
+
+            if (texImage) {
+               s->Width = texImage->Width;
+               s->Height = texImage->Height;
+               s->Depth = texImage->Depth;
+               s->Format = texImage->TexFormat;
+               s->InternalFormat = texImage->InternalFormat;
+               s->BaseFormat = texImage->_BaseFormat;
+               s->ImageNumSamples = texImage->NumSamples;
+               s->ImageNumStorageSamples = texImage->NumSamples;
+               s->FixedSampleLocations = texImage->FixedSampleLocations;
+            }
+         }
+      }
+      else if (att->Type == GL_RENDERBUFFER_EXT) {
+         const struct gl_renderbuffer *rb = att->Renderbuffer;
+
+         s->Object = rb;
+
+         if (rb) {
+            s->Width = rb->Width;
+            s->Height = rb->Height;
+            s->Format = rb->Format;
+            s->InternalFormat = rb->InternalFormat;
+            s->BaseFormat = rb->_BaseFormat;
+            s->ImageNumSamples = rb->NumSamples;
+            s->ImageNumStorageSamples = rb->NumStorageSamples;
+         }
+      }
+   }
+}
+
+
 /**
  * Test if the given framebuffer object is complete and update its
  * Status field with the results.
@@ -970,9 +1045,9 @@ test_attachment_completeness(const struct gl_context *ctx, GLenum format,
  * Also update the framebuffer's Width and Height fields if the
  * framebuffer is complete.
  */
-void
-_mesa_test_framebuffer_completeness(struct gl_context *ctx,
-                                    struct gl_framebuffer *fb)
+static void
+test_framebuffer_completeness(struct gl_context *ctx,
+                              struct gl_framebuffer *fb)
 {
    GLuint numImages;
    GLenum intFormat = GL_NONE; /* color buffers' internal format */
@@ -1392,6 +1467,39 @@ _mesa_test_framebuffer_completeness(struct gl_context *ctx,
 }
 
 
+/**
+ * Memoizing wrapper around the completeness test above.
+ *
+ * invalidate_framebuffer() resets _Status whenever an attachment call
+ * touches an FBO, but applications, (deferred renderers in particular),
+ * commonly re-attach the same images every frame.  If nothing the test
+ * depends on has changed since the last walk, all the derived fields,
+ * (which invalidation leaves in place), are still correct, so just
+ * restore the previous status instead of re-walking every attachment
+ * and re-querying the driver.
+ */
+void
+_mesa_test_framebuffer_completeness(struct gl_context *ctx,
+                                    struct gl_framebuffer *fb)
+{
+   struct gl_framebuffer_stamp stamp;
+
+   framebuffer_validation_stamp(fb, &stamp);
+
+   if (fb->_ValidationStampValid &&
+       memcmp(&stamp, &fb->_ValidationStamp, sizeof(stamp)) == 0) {
+      fb->_Status = fb->_ValidationStatus;
+      return;
+   }
+
+   test_framebuffer_completeness(ctx, fb);
+
+   fb->_ValidationStamp = stamp;
+   fb->_ValidationStatus = fb->_Status;
+   fb->_ValidationStampValid = GL_TRUE;
+}
+
+
 GLboolean GLAPIENTRY
 _mesa_IsRenderbuffer(GLuint renderbuffer)
 {
@@ -27,6 +27,12 @@
 #include "glformats.h"
 #include "format_pack.h"
 #include "format_unpack.h"
+#include "util/u_cpu_detect.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define USE_X86_64_SIMD
+#include <immintrin.h>
+#endif
 
 const mesa_array_format RGBA32_FLOAT =
    MESA_ARRAY_FORMAT(4, 1, 1, 1, 4, 0, 1, 2, 3);
@@ -181,6 +187,45 @@ _mesa_compute_rgba2base2rgba_component_mapping(GLenum baseFormat, uint8_t *map)
 }
 
 
+#ifdef USE_X86_64_SIMD
+/**
+ * SSSE3 version of the r/b swap below: one pshufb handles four pixels,
+ * and since the swap is its own inverse it covers both directions.
+ */
+__attribute__((target("ssse3")))
+static void
+convert_ubyte_rgba_to_bgra_ssse3(size_t width, size_t height,
+                                 const uint8_t *src, size_t src_stride,
+                                 uint8_t *dst, size_t dst_stride)
+{
+   const __m128i shuffle = _mm_set_epi8(15, 12, 13, 14, 11, 8, 9, 10,
+                                        7, 4, 5, 6, 3, 0, 1, 2);
+   size_t row;
+
+   for (row = 0; row < height; row++) {
+      const uint8_t *s = src;
+      uint8_t *d = dst;
+      size_t i;
+
+      for (i = 0; i + 4 <= width; i += 4) {
+         const __m128i pixels =
+            _mm_loadu_si128((const __m128i *)(s + i * 4));
+         _mm_storeu_si128((__m128i *)(d + i * 4),
+                          _mm_shuffle_epi8(pixels, shuffle));
+      }
+      for (; i < width; i++) {
+         const GLuint p = ((const GLuint *) s)[i];
+         ((GLuint *) d)[i] = ( (p & 0xff00ff00) |
+                              ((p &       0xff) << 16) |
+                              ((p &   0xff0000) >> 16));
+      }
+      src += src_stride;
+      dst += dst_stride;
+   }
+}
+#endif
+
+
 /**
  * Special case conversion function to swap r/b channels from the source
  * image to the dest image.
@@ -192,6 +237,15 @@ convert_ubyte_rgba_to_bgra(size_t width, size_t height,
 {
    int row;
 
+#ifdef USE_X86_64_SIMD
+   util_cpu_detect();
+   if (util_cpu_caps.has_ssse3) {
+      convert_ubyte_rgba_to_bgra_ssse3(width, height, src, src_stride,
+                                       dst, dst_stride);
+      return;
+   }
+#endif
+
    if (sizeof(void *) == 8 &&
        src_stride % 8 == 0 &&
        dst_stride % 8 == 0 &&
@@ -1058,6 +1112,48 @@ convert_half_float(void *void_dst, int num_dst_channels,
    }
 }
 
+#ifdef USE_X86_64_SIMD
+/**
+ * Converts full RGBA float pixels to unorm8, optionally swapping r/b.
+ *
+ * Clamp, scale and round-to-nearest-even match _mesa_float_to_unorm()
+ * exactly (_mm_cvtps_epi32 rounds to nearest even, like
+ * _mesa_lroundevenf), so this produces the same bytes as the scalar
+ * loop.  SSE2 is baseline on x86-64, so no runtime dispatch is needed.
+ */
+static void
+convert_float_rgba_to_unorm8_sse2(uint8_t *dst, const float *src,
+                                  int count, bool swap_rb)
+{
+   const __m128 zero = _mm_setzero_ps();
+   const __m128 one = _mm_set1_ps(1.0f);
+   const __m128 scale = _mm_set1_ps(255.0f);
+   int i, p, j;
+
+   for (i = 0; i + 4 <= count; i += 4) {
+      __m128i quad[4];
+
+      for (p = 0; p < 4; p++) {
+         __m128 v = _mm_loadu_ps(src + (i + p) * 4);
+         if (swap_rb)
+            v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 1, 2));
+         v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, zero), one), scale);
+         quad[p] = _mm_cvtps_epi32(v);
+      }
+      _mm_storeu_si128((__m128i *)(dst + i * 4),
+                       _mm_packus_epi16(_mm_packs_epi32(quad[0], quad[1]),
+                                        _mm_packs_epi32(quad[2], quad[3])));
+   }
+   for (; i < count; i++) {
+      for (j = 0; j < 4; j++) {
+         const int c = (swap_rb && j < 3) ? 2 - j : j;
+         dst[i * 4 + j] = _mesa_float_to_unorm(src[i * 4 + c], 8);
+      }
+   }
+}
+#endif
+
+
 static void
 convert_ubyte(void *void_dst, int num_dst_channels,
               const void *void_src, GLenum src_type, int num_src_channels,
@@ -1068,6 +1164,20 @@ convert_ubyte(void *void_dst, int num_dst_channels,
    switch (src_type) {
    case MESA_ARRAY_FORMAT_TYPE_FLOAT:
       if (normalized) {
+#ifdef USE_X86_64_SIMD
+         /* Full RGBA pixels with at most the r/b channels swapped cover
+          * nearly all float->unorm8 traffic from glReadPixels and texture
+          * uploads.
+          */
+         if (num_dst_channels == 4 && num_src_channels == 4 &&
+             swizzle[1] == 1 && swizzle[3] == 3 &&
+             ((swizzle[0] == 0 && swizzle[2] == 2) ||
+              (swizzle[0] == 2 && swizzle[2] == 0))) {
+            convert_float_rgba_to_unorm8_sse2(void_dst, void_src, count,
+                                              swizzle[0] == 2);
+            break;
+         }
+#endif
          SWIZZLE_CONVERT(uint8_t, float, _mesa_float_to_unorm(src, 8));
       } else {
          SWIZZLE_CONVERT(uint8_t, float, _mesa_float_to_unsigned(src, 8));
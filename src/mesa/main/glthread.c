@@ -73,8 +73,12 @@ _mesa_glthread_init(struct gl_context *ctx)
    if (!glthread)
       return;
 
+   /* The app thread and the single worker only exchange whole batches, so
+    * the lock-free queue mode keeps batch submission from bouncing the
+    * queue mutex between the two threads.
+    */
    if (!util_queue_init(&glthread->queue, "gl", MARSHAL_MAX_BATCHES - 2,
-                        1, 0)) {
+                        1, UTIL_QUEUE_INIT_LOCKLESS)) {
       free(glthread);
       return;
    }
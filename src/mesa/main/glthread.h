@@ -50,8 +50,19 @@
 enum marshal_dispatch_cmd_id;
 struct gl_context;
 
+/* The app thread fills one batch while the worker executes another one in
+ * place, so keep each ring slot on its own set of cache lines: without this
+ * the tail of one slot's buffer shares a line with the next slot's fence and
+ * header, which both threads then bounce between their caches.
+ */
+#ifdef _MSC_VER
+#define GLTHREAD_BATCH_ALIGN __declspec(align(64))
+#else
+#define GLTHREAD_BATCH_ALIGN __attribute__((aligned(64)))
+#endif
+
 /** A single batch of commands queued up for execution. */
-struct glthread_batch
+struct GLTHREAD_BATCH_ALIGN glthread_batch
 {
    /** Batch fence for waiting for the execution to finish. */
    struct util_queue_fence fence;
@@ -38,6 +38,7 @@
 #include "glheader.h"
 #include "hash.h"
 #include "util/hash_table.h"
+#include "util/u_atomic.h"
 
 
 /**
@@ -60,6 +61,10 @@ _mesa_NewHashTable(void)
       }
 
       _mesa_hash_table_set_deleted_key(table->ht, uint_key(DELETED_KEY_VALUE));
+      /* Lookups don't take the mutex (see _mesa_HashLookup), so old entry
+       * arrays must stay valid until the table is destroyed.
+       */
+      _mesa_hash_table_set_deferred_reclaim(table->ht);
       /*
        * Needs to be recursive, since the callback in _mesa_HashWalk()
        * is allowed to call _mesa_HashRemove().
@@ -100,6 +105,47 @@ _mesa_DeleteHashTable(struct _mesa_HashTable *table)
 
 
 
+/**
+ * \name Seqlock protecting lock-free lookups
+ *
+ * Every glBindTexture/glBindBuffer/glCallList does a name lookup, so the
+ * object name tables are read vastly more often than they are written and
+ * the per-lookup mutex shows up in bind-heavy profiles (and bounces between
+ * the application thread and the glthread worker).  Lookups therefore run
+ * without the mutex: a writer (which always holds the mutex) bumps
+ * \c Generation to an odd value before mutating the underlying table and to
+ * an even value afterwards, and a reader that observes an odd or changed
+ * generation across its probe retries or falls back to the mutex.  Rehashed
+ * entry arrays are retired instead of freed (deferred reclaim), so a reader
+ * that lost the race only ever probes valid, well-formed memory.
+ */
+/*@{*/
+
+static inline void
+hash_write_begin(struct _mesa_HashTable *table)
+{
+   /* Full barrier: the odd generation must be visible before any store to
+    * the table itself.  Only the outermost writer toggles the generation;
+    * nested writers (a DeleteAll callback removing entries) leave it odd.
+    */
+   if (table->WriteDepth++ == 0)
+      p_atomic_inc(&table->Generation);
+}
+
+
+static inline void
+hash_write_end(struct _mesa_HashTable *table)
+{
+   /* Full barrier: all table stores must be visible before the generation
+    * becomes even again.
+    */
+   if (--table->WriteDepth == 0)
+      p_atomic_inc(&table->Generation);
+}
+
+/*@}*/
+
+
 /**
  * Lookup an entry in the hash table, without locking.
  * \sa _mesa_HashLookup
@@ -137,6 +183,53 @@ void *
 _mesa_HashLookup(struct _mesa_HashTable *table, GLuint key)
 {
    void *res;
+
+   assert(table);
+   assert(key);
+
+   /* A single pointer read; writers only ever replace it atomically. */
+   if (key == DELETED_KEY_VALUE)
+      return table->deleted_key_data;
+
+   /* Lock-free fast path: probe a snapshot of the table header and accept
+    * the result only if no writer was active across the whole probe.  The
+    * snapshot guarantees that size/magic/array all belong to one version of
+    * the table, and deferred reclaim guarantees the array is still valid
+    * memory even if a rehash won the race.
+    */
+   for (unsigned i = 0; i < 4; i++) {
+      const struct hash_entry *entry;
+      struct hash_table snapshot;
+
+      const uint32_t generation = p_atomic_read(&table->Generation);
+      if (generation & 1)
+         break;
+
+      snapshot = *table->ht;
+
+      /* Seqlock reader rmb: an acquire load only orders the loads that come
+       * after it, so without this fence the snapshot reads above could sink
+       * past the generation re-check and defeat the validation.
+       */
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (p_atomic_read(&table->Generation) != generation)
+         continue;
+
+      entry = _mesa_hash_table_search_pre_hashed(&snapshot,
+                                                 uint_hash(key),
+                                                 uint_key(key));
+      res = entry ? entry->data : NULL;
+
+      /* If the generation is unchanged, no writer ran between the two reads
+       * and the probe saw a quiescent table.  Fence first so the probe's
+       * loads can't be reordered after the re-check.
+       */
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      if (p_atomic_read(&table->Generation) == generation)
+         return res;
+   }
+
+   /* A writer is active or kept interfering; fall back to the mutex. */
    _mesa_HashLockMutex(table);
    res = _mesa_HashLookup_unlocked(table, key);
    _mesa_HashUnlockMutex(table);
@@ -174,6 +267,8 @@ _mesa_HashInsert_unlocked(struct _mesa_HashTable *table, GLuint key, void *data)
    if (key > table->MaxKey)
       table->MaxKey = key;
 
+   hash_write_begin(table);
+
    if (key == DELETED_KEY_VALUE) {
       table->deleted_key_data = data;
    } else {
@@ -184,6 +279,8 @@ _mesa_HashInsert_unlocked(struct _mesa_HashTable *table, GLuint key, void *data)
          _mesa_hash_table_insert_pre_hashed(table->ht, hash, uint_key(key), data);
       }
    }
+
+   hash_write_end(table);
 }
 
 
@@ -244,6 +341,8 @@ _mesa_HashRemove_unlocked(struct _mesa_HashTable *table, GLuint key)
     */
    assert(!table->InDeleteAll);
 
+   hash_write_begin(table);
+
    if (key == DELETED_KEY_VALUE) {
       table->deleted_key_data = NULL;
    } else {
@@ -252,6 +351,8 @@ _mesa_HashRemove_unlocked(struct _mesa_HashTable *table, GLuint key)
                                                  uint_key(key));
       _mesa_hash_table_remove(table->ht, entry);
    }
+
+   hash_write_end(table);
 }
 
 
@@ -286,6 +387,10 @@ _mesa_HashDeleteAll(struct _mesa_HashTable *table,
    assert(callback);
    _mesa_HashLockMutex(table);
    table->InDeleteAll = GL_TRUE;
+   /* Keep the generation odd for the whole traversal so that concurrent
+    * lookups fall back to the mutex rather than retrying the fast path.
+    */
+   hash_write_begin(table);
    hash_table_foreach(table->ht, entry) {
       callback((uintptr_t)entry->key, entry->data, userData);
       _mesa_hash_table_remove(table->ht, entry);
@@ -294,6 +399,7 @@ _mesa_HashDeleteAll(struct _mesa_HashTable *table,
       callback(DELETED_KEY_VALUE, table->deleted_key_data, userData);
       table->deleted_key_data = NULL;
    }
+   hash_write_end(table);
    table->InDeleteAll = GL_FALSE;
    _mesa_HashUnlockMutex(table);
 }
@@ -100,6 +100,18 @@ struct _mesa_HashTable {
    struct hash_table *ht;
    GLuint MaxKey;                        /**< highest key inserted so far */
    mtx_t Mutex;                          /**< mutual exclusion lock */
+   /**
+    * Seqlock generation for lock-free lookups.  Writers (which always hold
+    * \c Mutex) bump this to an odd value before touching \c ht and back to
+    * an even value when done; see _mesa_HashLookup().
+    */
+   uint32_t Generation;
+   /**
+    * Write-bracket nesting depth (protected by \c Mutex): a DeleteAll
+    * callback may legally call _mesa_HashRemove(), and only the outermost
+    * writer may toggle \c Generation.
+    */
+   uint32_t WriteDepth;
    GLboolean InDeleteAll;                /**< Debug check */
    /** Value that would be in the table for DELETED_KEY_VALUE. */
    void *deleted_key_data;
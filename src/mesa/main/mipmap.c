@@ -186,7 +186,35 @@ do_row(GLenum datatype, GLuint comps, GLint srcWidth,
    assert(srcWidth == dstWidth || srcWidth == 2 * dstWidth);
    */
 
-   if (datatype == GL_UNSIGNED_BYTE && comps == 4) {
+   if (datatype == GL_UNSIGNED_BYTE && comps == 4 && colStride == 2) {
+      GLuint i;
+      const GLubyte *rowA = (const GLubyte *) srcRowA;
+      const GLubyte *rowB = (const GLubyte *) srcRowB;
+      GLubyte *dst = (GLubyte *) dstRow;
+      /* Average the 2x2 source pixels word-parallel: each 8-byte load
+       * covers both horizontally adjacent pixels, the byte lanes are
+       * widened into alternating 16-bit lanes so the four-sample sums
+       * (at most 1020) can't carry into a neighboring component, and
+       * the two pixels are then added lane-wise.  The result matches
+       * the scalar (a + b + c + d) / 4 exactly, for any component
+       * order and endianness, since every memory byte stays in its
+       * own lane throughout.
+       */
+      const uint64_t mask = 0x00ff00ff00ff00ffull;
+      for (i = 0; i < (GLuint) dstWidth; i++) {
+         uint64_t a, b, even, odd;
+         uint32_t lo, hi, pix;
+         memcpy(&a, rowA + i * 8, 8);
+         memcpy(&b, rowB + i * 8, 8);
+         even = (a & mask) + (b & mask);
+         odd = ((a >> 8) & mask) + ((b >> 8) & mask);
+         lo = (uint32_t) even + (uint32_t) (even >> 32);
+         hi = (uint32_t) odd + (uint32_t) (odd >> 32);
+         pix = ((lo >> 2) & 0x00ff00ff) | (((hi >> 2) & 0x00ff00ff) << 8);
+         memcpy(dst + i * 4, &pix, 4);
+      }
+   }
+   else if (datatype == GL_UNSIGNED_BYTE && comps == 4) {
       GLuint i, j, k;
       const GLubyte(*rowA)[4] = (const GLubyte(*)[4]) srcRowA;
       const GLubyte(*rowB)[4] = (const GLubyte(*)[4]) srcRowB;
@@ -1568,6 +1568,15 @@ struct gl_vertex_array_object
    /** Mask of VERT_BIT_* values indicating changed/dirty arrays */
    GLbitfield NewArrays;
 
+   /**
+    * Stamp of the last state change, taken from
+    * gl_array_attrib::VAOGeneration.  Since the counter is context-global,
+    * a (VAO pointer, Generation) pair is never reused even if a deleted
+    * VAO's memory is recycled, which lets drivers key derived-state caches
+    * on it safely.
+    */
+   GLuint Generation;
+
    /** The index buffer (also known as the element array buffer in OpenGL). */
    struct gl_buffer_object *IndexBufferObj;
 };
@@ -1635,6 +1644,9 @@ struct gl_array_attrib
    /** Legal array datatypes and the API for which they have been computed */
    GLbitfield LegalTypesMask;
    gl_api LegalTypesMaskAPI;
+
+   /** Counter backing gl_vertex_array_object::Generation */
+   GLuint VAOGeneration;
 };
 
 
@@ -2604,6 +2616,7 @@ struct gl_shader
    GLint RefCount;  /**< Reference count */
    GLchar *Label;   /**< GL_KHR_debug */
    unsigned char sha1[20]; /**< SHA1 hash of pre-processed source */
+   unsigned char source_sha1[20]; /**< SHA1 of the original source before replacement */
    GLboolean DeletePending;
    bool IsES;              /**< True if this shader uses GLSL ES */
 
@@ -3436,6 +3449,48 @@ struct gl_renderbuffer_attachment
 };
 
 
+/**
+ * Per-attachment snapshot of the state that framebuffer completeness
+ * validation depends on.  See _mesa_test_framebuffer_completeness().
+ */
+struct gl_attachment_stamp
+{
+   GLenum16 Type;
+   GLenum16 Target;        /**< texture target, for texture attachments */
+   const void *Object;     /**< texture object or renderbuffer */
+   const void *Image;      /**< texture image, for texture attachments */
+   GLuint Level;
+   GLuint Face;
+   GLuint Zoffset;
+   GLboolean Layered;
+   GLboolean IsFloat;      /**< texObj->_IsFloat / _IsHalfFloat, for GLES */
+   GLsizei NumSamples;     /**< from the FramebufferTexture*MultisampleEXT call */
+   GLuint Width, Height, Depth;
+   GLuint Format;          /**< mesa_format of the image */
+   GLint InternalFormat;
+   GLenum16 BaseFormat;
+   GLuint ImageNumSamples;
+   GLuint ImageNumStorageSamples;
+   GLboolean FixedSampleLocations;
+};
+
+
+/**
+ * Everything _mesa_test_framebuffer_completeness() reads that can change
+ * between two validations of the same FBO.  When re-validation sees an
+ * identical stamp, the previously computed status and derived fields are
+ * still correct and the whole attachment walk, (including the driver's
+ * ValidateFramebuffer hook), can be skipped.
+ */
+struct gl_framebuffer_stamp
+{
+   GLenum16 ColorDrawBuffer[MAX_DRAW_BUFFERS];
+   GLenum16 ColorReadBuffer;
+   GLuint DefaultWidth, DefaultHeight;
+   struct gl_attachment_stamp Attachment[BUFFER_COUNT];
+};
+
+
 /**
  * A framebuffer is a collection of renderbuffers (color, depth, stencil, etc).
  * In C++ terms, think of this as a base class from which device drivers
@@ -3503,6 +3558,16 @@ struct gl_framebuffer
    /** One of the GL_FRAMEBUFFER_(IN)COMPLETE_* tokens */
    GLenum16 _Status;
 
+   /**
+    * Memoized completeness result: _ValidationStamp records the inputs
+    * that produced _ValidationStatus, so that re-validating an unchanged
+    * FBO doesn't have to walk the attachments again.  Only meaningful
+    * while _ValidationStampValid is set.
+    */
+   struct gl_framebuffer_stamp _ValidationStamp;
+   GLenum16 _ValidationStatus;
+   GLboolean _ValidationStampValid;
+
    /** Whether one of Attachment has Type != GL_NONE
     * NOTE: the values for Width and Height are set to 0 in case of having
     * no attachments, a backend driver supporting the extension
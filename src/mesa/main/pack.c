@@ -1113,10 +1113,7 @@ _mesa_pack_depth_span( struct gl_context *ctx, GLuint n, GLvoid *dest,
    case GL_HALF_FLOAT_OES:
       {
          GLhalfARB *dst = (GLhalfARB *) dest;
-         GLuint i;
-         for (i = 0; i < n; i++) {
-            dst[i] = _mesa_float_to_half(depthSpan[i]);
-         }
+         _mesa_float_to_half_array(dst, depthSpan, n);
          if (dstPacking->SwapBytes) {
             _mesa_swap2( (GLushort *) dst, n );
          }
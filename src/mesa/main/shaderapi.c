@@ -969,8 +969,10 @@ get_shaderiv(struct gl_context *ctx, GLuint name, GLenum pname, GLint *params)
       *params = shader->DeletePending;
       break;
    case GL_COMPLETION_STATUS_ARB:
-      /* _mesa_glsl_compile_shader is not offloaded to other threads. */
-      *params = GL_TRUE;
+      if (ctx->Driver.GetShaderCompletionStatus)
+         *params = ctx->Driver.GetShaderCompletionStatus(ctx, shader);
+      else
+         *params = GL_TRUE; /* front-end compile ran synchronously */
       return;
    case GL_COMPILE_STATUS:
       *params = shader->CompileStatus ? GL_TRUE : GL_FALSE;
@@ -1131,6 +1133,19 @@ _mesa_compile_shader(struct gl_context *ctx, struct gl_shader *sh)
        */
       sh->CompileStatus = COMPILE_FAILURE;
    } else {
+#ifdef ENABLE_SHADER_CACHE
+      /* Re-read the MESA_SHADER_READ_PATH replacement file, keyed by the
+       * sha1 of the original source, so that edits to the file take effect
+       * on a recompile without restarting the application.
+       */
+      GLcharARB *replacement =
+         _mesa_read_shader_source(sh->Stage, sh->Source, sh->source_sha1);
+      if (replacement) {
+         free((void *)sh->Source);
+         sh->Source = replacement;
+      }
+#endif /* ENABLE_SHADER_CACHE */
+
       if (ctx->_Shader->Flags & GLSL_DUMP) {
          _mesa_log("GLSL source for %s shader %d:\n",
                  _mesa_shader_stage_to_string(sh->Stage), sh->Name);
@@ -1810,27 +1825,19 @@ _mesa_LinkProgram(GLuint programObj)
 }
 
 #ifdef ENABLE_SHADER_CACHE
-/**
- * Generate a SHA-1 hash value string for given source string.
- */
-static void
-generate_sha1(const char *source, char sha_str[64])
-{
-   unsigned char sha[20];
-   _mesa_sha1_compute(source, strlen(source), sha);
-   _mesa_sha1_format(sha_str, sha);
-}
-
 /**
  * Construct a full path for shader replacement functionality using
  * following format:
  *
  * <path>/<stage prefix>_<CHECKSUM>.glsl
  * <path>/<stage prefix>_<CHECKSUM>.arb
+ *
+ * The checksum is the SHA-1 of the original source as supplied by the
+ * application, so that replacing the source does not change the file name.
  */
 static char *
-construct_name(const gl_shader_stage stage, const char *source,
-               const char *path)
+construct_name(const gl_shader_stage stage, const unsigned char *sha1,
+               const char *source, const char *path)
 {
    char sha[64];
    static const char *types[] = {
@@ -1839,7 +1846,7 @@ construct_name(const gl_shader_stage stage, const char *source,
 
    const char *format = strncmp(source, "!!ARB", 5) ? "glsl" : "arb";
 
-   generate_sha1(source, sha);
+   _mesa_sha1_format(sha, sha1);
    return ralloc_asprintf(NULL, "%s/%s_%s.%s", path, types[stage], sha, format);
 }
 
@@ -1847,7 +1854,8 @@ construct_name(const gl_shader_stage stage, const char *source,
  * Write given shader source to a file in MESA_SHADER_DUMP_PATH.
  */
 void
-_mesa_dump_shader_source(const gl_shader_stage stage, const char *source)
+_mesa_dump_shader_source(const gl_shader_stage stage, const char *source,
+                         const unsigned char sha1[20])
 {
    static bool path_exists = true;
    char *dump_path;
@@ -1862,7 +1870,7 @@ _mesa_dump_shader_source(const gl_shader_stage stage, const char *source)
       return;
    }
 
-   char *name = construct_name(stage, source, dump_path);
+   char *name = construct_name(stage, sha1, source, dump_path);
 
    f = fopen(name, "w");
    if (f) {
@@ -1881,7 +1889,8 @@ _mesa_dump_shader_source(const gl_shader_stage stage, const char *source)
  * Useful for debugging to override an app's shader.
  */
 GLcharARB *
-_mesa_read_shader_source(const gl_shader_stage stage, const char *source)
+_mesa_read_shader_source(const gl_shader_stage stage, const char *source,
+                         const unsigned char sha1[20])
 {
    char *read_path;
    static bool path_exists = true;
@@ -1898,7 +1907,7 @@ _mesa_read_shader_source(const gl_shader_stage stage, const char *source)
       return NULL;
    }
 
-   char *name = construct_name(stage, source, read_path);
+   char *name = construct_name(stage, sha1, source, read_path);
    f = fopen(name, "r");
    ralloc_free(name);
    if (!f)
@@ -2002,12 +2011,18 @@ shader_source(struct gl_context *ctx, GLuint shaderObj, GLsizei count,
 #ifdef ENABLE_SHADER_CACHE
    GLcharARB *replacement;
 
+   /* Remember the sha1 of the original source: it names the dump and
+    * replacement files, and glCompileShader uses it to re-read the
+    * replacement file on every compile.
+    */
+   _mesa_sha1_compute(source, strlen(source), sh->source_sha1);
+
    /* Dump original shader source to MESA_SHADER_DUMP_PATH and replace
     * if corresponding entry found from MESA_SHADER_READ_PATH.
     */
-   _mesa_dump_shader_source(sh->Stage, source);
+   _mesa_dump_shader_source(sh->Stage, source, sh->source_sha1);
 
-   replacement = _mesa_read_shader_source(sh->Stage, source);
+   replacement = _mesa_read_shader_source(sh->Stage, source, sh->source_sha1);
    if (replacement) {
       free(source);
       source = replacement;
@@ -375,10 +375,12 @@ _mesa_GetProgramStageiv(GLuint program, GLenum shadertype,
                         GLenum pname, GLint *values);
 
 GLcharARB *
-_mesa_read_shader_source(const gl_shader_stage stage, const char *source);
+_mesa_read_shader_source(const gl_shader_stage stage, const char *source,
+                         const unsigned char sha1[20]);
 
 void
-_mesa_dump_shader_source(const gl_shader_stage stage, const char *source);
+_mesa_dump_shader_source(const gl_shader_stage stage, const char *source,
+                         const unsigned char sha1[20]);
 
 #ifdef __cplusplus
 }
@@ -313,7 +313,14 @@ _mesa_update_state_locked( struct gl_context *ctx )
          prog_flags |= (_NEW_BUFFERS | _NEW_TEXTURE_OBJECT | _NEW_FOG |
                         _NEW_VARYING_VP_INPUTS | _NEW_LIGHT | _NEW_POINT |
                         _NEW_RENDERMODE | _NEW_PROGRAM | _NEW_FRAG_CLAMP |
-                        _NEW_COLOR | _NEW_TEXTURE_STATE);
+                        _NEW_TEXTURE_STATE);
+         /* The fixed-function fragment program key depends on _NEW_COLOR
+          * only through the alpha-test-with-no-color-buffers corner case,
+          * so don't re-derive the program for every blend or alpha state
+          * change.
+          */
+         if (ctx->DrawBuffer->_NumColorDrawBuffers == 0)
+            prog_flags |= _NEW_COLOR;
       }
       if (ctx->VertexProgram._MaintainTnlProgram) {
          prog_flags |= (_NEW_VARYING_VP_INPUTS | _NEW_TEXTURE_OBJECT |
@@ -372,7 +379,10 @@ _mesa_update_state_locked( struct gl_context *ctx )
    new_prog_state |= update_program_constants(ctx);
 
    ctx->NewState |= new_prog_state;
-   vbo_exec_invalidate_state(ctx);
+
+   /* The eval maps are the only derived state vbo consumes. */
+   if (new_state & _NEW_EVAL)
+      vbo_exec_invalidate_state(ctx);
 
    /*
     * Give the driver a chance to act upon the new_state flags.
@@ -38,6 +38,7 @@
  */
 
 #include <stdbool.h>
+#include "c11/threads.h"
 #include "texcompress.h"
 #include "texcompress_etc.h"
 #include "texstore.h"
@@ -45,6 +46,8 @@
 #include "macros.h"
 #include "format_unpack.h"
 #include "util/format_srgb.h"
+#include "util/u_cpu_detect.h"
+#include "util/u_queue.h"
 
 
 struct etc2_block {
@@ -1210,15 +1213,15 @@ _mesa_texstore_etc2_srgb8_punchthrough_alpha1(UNUSED_TEXSTORE_PARAMS)
  * \param dst_stride in bytes
  */
 
-void
-_mesa_unpack_etc2_format(uint8_t *dst_row,
-                         unsigned dst_stride,
-                         const uint8_t *src_row,
-                         unsigned src_stride,
-                         unsigned src_width,
-                         unsigned src_height,
-			 mesa_format format,
-			 bool bgra)
+static void
+unpack_etc2_rect(uint8_t *dst_row,
+                 unsigned dst_stride,
+                 const uint8_t *src_row,
+                 unsigned src_stride,
+                 unsigned src_width,
+                 unsigned src_height,
+                 mesa_format format,
+                 bool bgra)
 {
    if (format == MESA_FORMAT_ETC2_RGB8)
       etc2_unpack_rgb8(dst_row, dst_stride,
@@ -1263,6 +1266,122 @@ _mesa_unpack_etc2_format(uint8_t *dst_row,
 }
 
 
+/**
+ * \name Threaded ETC2 unpacking
+ *
+ * On drivers without native ETC2 support every glTexImage/glTexSubImage
+ * with an ETC2 format funnels through _mesa_unpack_etc2_format, and
+ * decoding a large atlas on the API thread takes long enough to cause
+ * visible hitches.  Since blocks are independent, large images are split
+ * into strips of block rows and decoded on a small lazily-created queue
+ * shared by all contexts.  The queue registers itself for cleanup at exit
+ * (see add_to_atexit_list in u_queue.c), so no teardown hook is needed.
+ */
+/*@{*/
+
+#define ETC2_MAX_UNPACK_THREADS 8
+
+/* Don't spin up threads for images where the decode takes less time than
+ * the thread wakeups.
+ */
+#define ETC2_MIN_PARALLEL_PIXELS (256 * 256)
+
+static struct util_queue etc2_unpack_queue;
+static bool etc2_unpack_queue_ready = false;
+static once_flag etc2_unpack_queue_once = ONCE_FLAG_INIT;
+
+struct etc2_unpack_job {
+   uint8_t *dst_row;
+   const uint8_t *src_row;
+   unsigned dst_stride;
+   unsigned src_stride;
+   unsigned width;
+   unsigned height;
+   mesa_format format;
+   bool bgra;
+};
+
+static void
+etc2_unpack_queue_init(void)
+{
+   unsigned num_threads;
+
+   util_cpu_detect();
+   num_threads = MIN2(util_cpu_caps.nr_cpus, ETC2_MAX_UNPACK_THREADS);
+   if (num_threads > 1) {
+      etc2_unpack_queue_ready =
+         util_queue_init(&etc2_unpack_queue, "etc2", ETC2_MAX_UNPACK_THREADS,
+                         num_threads, 0);
+   }
+}
+
+static void
+etc2_unpack_job_execute(void *data, int thread_index)
+{
+   const struct etc2_unpack_job *job = data;
+
+   unpack_etc2_rect(job->dst_row, job->dst_stride,
+                    job->src_row, job->src_stride,
+                    job->width, job->height, job->format, job->bgra);
+}
+
+/*@}*/
+
+
+void
+_mesa_unpack_etc2_format(uint8_t *dst_row,
+                         unsigned dst_stride,
+                         const uint8_t *src_row,
+                         unsigned src_stride,
+                         unsigned src_width,
+                         unsigned src_height,
+			 mesa_format format,
+			 bool bgra)
+{
+   call_once(&etc2_unpack_queue_once, etc2_unpack_queue_init);
+
+   if (etc2_unpack_queue_ready &&
+       (uint64_t) src_width * src_height >= ETC2_MIN_PARALLEL_PIXELS) {
+      struct etc2_unpack_job jobs[ETC2_MAX_UNPACK_THREADS];
+      struct util_queue_fence fences[ETC2_MAX_UNPACK_THREADS];
+      const unsigned block_rows = DIV_ROUND_UP(src_height, 4);
+      const unsigned num_jobs =
+         MIN2(etc2_unpack_queue.num_threads, block_rows);
+      /* Strips must start on a block row. */
+      const unsigned strip_height = DIV_ROUND_UP(block_rows, num_jobs) * 4;
+      unsigned num_queued = 0, y, i;
+
+      for (y = 0; y < src_height; y += strip_height) {
+         struct etc2_unpack_job *job = &jobs[num_queued];
+
+         assert(num_queued < ARRAY_SIZE(jobs));
+         job->dst_row = dst_row + (size_t) y * dst_stride;
+         job->src_row = src_row + (size_t) (y / 4) * src_stride;
+         job->dst_stride = dst_stride;
+         job->src_stride = src_stride;
+         job->width = src_width;
+         job->height = MIN2(strip_height, src_height - y);
+         job->format = format;
+         job->bgra = bgra;
+
+         util_queue_fence_init(&fences[num_queued]);
+         util_queue_add_job(&etc2_unpack_queue, job, &fences[num_queued],
+                            etc2_unpack_job_execute, NULL);
+         num_queued++;
+      }
+
+      for (i = 0; i < num_queued; i++) {
+         util_queue_fence_wait(&fences[i]);
+         util_queue_fence_destroy(&fences[i]);
+      }
+      return;
+   }
+
+   unpack_etc2_rect(dst_row, dst_stride, src_row, src_stride,
+                    src_width, src_height, format, bgra);
+}
+
+
 
 static void
 fetch_etc1_rgb8(const GLubyte *map,
@@ -2878,6 +2878,31 @@ strip_texture_border(GLenum target,
 }
 
 
+/**
+ * Check whether re-specifying a texture image with the given parameters
+ * changes any state that texture completeness depends on.  Completeness only
+ * looks at image sizes, border, formats and sample counts, not at the texel
+ * data, so respecifying an image with identical parameters (a common texture
+ * streaming pattern) keeps the memoized _BaseComplete/_MipmapComplete flags
+ * valid and the O(faces * levels) completeness re-walk can be skipped.
+ */
+static bool
+texture_image_respecified(const struct gl_texture_image *img,
+                          GLsizei width, GLsizei height, GLsizei depth,
+                          GLint border, GLenum internalFormat,
+                          mesa_format format)
+{
+   return img->Width != width ||
+          img->Height != height ||
+          img->Depth != depth ||
+          img->Border != border ||
+          img->InternalFormat != internalFormat ||
+          img->TexFormat != format ||
+          img->NumSamples != 0 ||
+          img->FixedSampleLocations != GL_TRUE;
+}
+
+
 /**
  * Common code to implement all the glTexImage1D/2D/3D functions
  * as well as glCompressedTexImage1D/2D/3D.
@@ -3067,6 +3092,10 @@ teximage(struct gl_context *ctx, GLboolean compressed, GLuint dims,
             _mesa_error(ctx, GL_OUT_OF_MEMORY, "%s%uD", func, dims);
          }
          else {
+            const bool respecified =
+               texture_image_respecified(texImage, width, height, depth,
+                                         border, internalFormat, texFormat);
+
             ctx->Driver.FreeTextureImageBuffer(ctx, texImage);
 
             _mesa_init_teximage_fields(ctx, texImage,
@@ -3089,7 +3118,13 @@ teximage(struct gl_context *ctx, GLboolean compressed, GLuint dims,
 
             _mesa_update_fbo_texture(ctx, texObj, face, level);
 
-            _mesa_dirty_texobj(ctx, texObj);
+            /* If only the texel data changed, the completeness memo is still
+             * valid; we still have to revalidate the driver's texture state.
+             */
+            if (respecified)
+               _mesa_dirty_texobj(ctx, texObj);
+            else
+               ctx->NewState |= _NEW_TEXTURE_OBJECT;
          }
       }
       _mesa_unlock_texture(ctx, texObj);
@@ -4107,6 +4142,9 @@ copyteximage(struct gl_context *ctx, GLuint dims,
       else {
          GLint srcX = x, srcY = y, dstX = 0, dstY = 0, dstZ = 0;
          const GLuint face = _mesa_tex_target_to_face(target);
+         const bool respecified =
+            texture_image_respecified(texImage, width, height, 1,
+                                      border, internalFormat, texFormat);
 
          /* Free old texture image */
          ctx->Driver.FreeTextureImageBuffer(ctx, texImage);
@@ -4133,7 +4171,10 @@ copyteximage(struct gl_context *ctx, GLuint dims,
 
          _mesa_update_fbo_texture(ctx, texObj, face, level);
 
-         _mesa_dirty_texobj(ctx, texObj);
+         if (respecified)
+            _mesa_dirty_texobj(ctx, texObj);
+         else
+            ctx->NewState |= _NEW_TEXTURE_OBJECT;
       }
    }
    _mesa_unlock_texture(ctx, texObj);
@@ -1645,16 +1645,15 @@ bind_texture_object(struct gl_context *ctx, unsigned unit,
    /* Check if this texture is only used by this context and is already bound.
     * If so, just return. For GL_OES_image_external, rebinding the texture
     * always must invalidate cached resources.
+    *
+    * No lock is needed here: the comparison itself is atomic, and if
+    * another thread happens to be creating a share context (bumping the
+    * RefCount) concurrently, it cannot have modified our bindings yet.
     */
    if (targetIndex != TEXTURE_EXTERNAL_INDEX) {
-      bool early_out;
-      simple_mtx_lock(&ctx->Shared->Mutex);
-      early_out = ((ctx->Shared->RefCount == 1)
-                   && (texObj == texUnit->CurrentTex[targetIndex]));
-      simple_mtx_unlock(&ctx->Shared->Mutex);
-      if (early_out) {
+      if (ctx->Shared->RefCount == 1 &&
+          texObj == texUnit->CurrentTex[targetIndex])
          return;
-      }
    }
 
    /* flush before changing binding */
@@ -1795,9 +1794,31 @@ static ALWAYS_INLINE void
 bind_texture(struct gl_context *ctx, GLenum target, GLuint texName,
              GLenum texunit, bool no_error, const char *caller)
 {
-   struct gl_texture_object *newTexObj =
-      _mesa_lookup_or_create_texture(ctx, target, texName, no_error, false,
-                                     "glBindTexture");
+   struct gl_texture_object *newTexObj;
+
+   /* Rebinding the texture already bound to this unit is common enough in
+    * replayed traces to be worth catching before the name lookup, which
+    * takes the shared texture hash lock.  This is only safe when no other
+    * context shares our namespace (the name could have been deleted and
+    * reused there, leaving our binding stale), mirroring the early-out in
+    * bind_texture_object.  A name can only be bound where its target
+    * lives, so a matching name in the target's slot implies the target
+    * check would pass too.
+    */
+   if (texName != 0 && ctx->Shared->RefCount == 1) {
+      const int targetIndex = _mesa_tex_target_to_index(ctx, target);
+
+      if (targetIndex >= 0 && targetIndex != TEXTURE_EXTERNAL_INDEX) {
+         const struct gl_texture_object *texObj =
+            ctx->Texture.Unit[texunit].CurrentTex[targetIndex];
+
+         if (texObj && texObj->Name == texName)
+            return;
+      }
+   }
+
+   newTexObj = _mesa_lookup_or_create_texture(ctx, target, texName, no_error,
+                                              false, "glBindTexture");
    if (!newTexObj)
       return;
 
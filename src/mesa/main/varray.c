@@ -179,6 +179,7 @@ _mesa_vertex_attrib_binding(struct gl_context *ctx,
       array->BufferBindingIndex = bindingIndex;
 
       vao->NewArrays |= vao->Enabled & array_bit;
+      vao->Generation = ++ctx->Array.VAOGeneration;
    }
 }
 
@@ -215,6 +216,7 @@ _mesa_bind_vertex_buffer(struct gl_context *ctx,
       }
 
       vao->NewArrays |= vao->Enabled & binding->_BoundArrays;
+      vao->Generation = ++ctx->Array.VAOGeneration;
    }
 }
 
@@ -236,6 +238,7 @@ vertex_binding_divisor(struct gl_context *ctx,
    if (binding->InstanceDivisor != divisor) {
       binding->InstanceDivisor = divisor;
       vao->NewArrays |= vao->Enabled & binding->_BoundArrays;
+      vao->Generation = ++ctx->Array.VAOGeneration;
    }
 }
 
@@ -354,6 +357,7 @@ _mesa_update_array_format(struct gl_context *ctx,
                            normalized, integer, doubles);
 
    vao->NewArrays |= vao->Enabled & VERT_BIT(attrib);
+   vao->Generation = ++ctx->Array.VAOGeneration;
 }
 
 /**
@@ -1089,6 +1093,7 @@ _mesa_enable_vertex_array_attribs(struct gl_context *ctx,
       /* was disabled, now being enabled */
       vao->Enabled |= attrib_bits;
       vao->NewArrays |= attrib_bits;
+      vao->Generation = ++ctx->Array.VAOGeneration;
 
       /* Update the map mode if needed */
       if (attrib_bits & (VERT_BIT_POS|VERT_BIT_GENERIC0))
@@ -1173,6 +1178,7 @@ _mesa_disable_vertex_array_attribs(struct gl_context *ctx,
       /* was enabled, now being disabled */
       vao->Enabled &= ~attrib_bits;
       vao->NewArrays |= attrib_bits;
+      vao->Generation = ++ctx->Array.VAOGeneration;
 
       /* Update the map mode if needed */
       if (attrib_bits & (VERT_BIT_POS|VERT_BIT_GENERIC0))
@@ -135,7 +135,14 @@ lookup_parameter_constant(const struct gl_program_parameter_list *list,
 struct gl_program_parameter_list *
 _mesa_new_parameter_list(void)
 {
-   return CALLOC_STRUCT(gl_program_parameter_list);
+   struct gl_program_parameter_list *p =
+      CALLOC_STRUCT(gl_program_parameter_list);
+
+   if (p) {
+      /* empty range until the first PROGRAM_STATE_VAR is added */
+      p->FirstStateVarIndex = ~0u;
+   }
+   return p;
 }
 
 
@@ -306,6 +313,12 @@ _mesa_add_parameter(struct gl_program_parameter_list *paramList,
          paramList->Parameters[oldNum].StateIndexes[i] = state[i];
    }
 
+   if (type == PROGRAM_STATE_VAR) {
+      paramList->FirstStateVarIndex =
+         MIN2(paramList->FirstStateVarIndex, oldNum);
+      paramList->LastStateVarIndex = oldNum;
+   }
+
    return (GLint) oldNum;
 }
 
@@ -126,6 +126,15 @@ struct gl_program_parameter_list
    gl_constant_value *ParameterValues; /**< Array [Size] of gl_constant_value */
    GLbitfield StateFlags; /**< _NEW_* flags indicating which state changes
                                might invalidate ParameterValues[] */
+
+   /**
+    * Range of Parameters[] occupied by PROGRAM_STATE_VAR entries, so that
+    * _mesa_load_state_parameters() doesn't have to walk the (possibly long)
+    * run of uniforms and constants around them on every constant upload.
+    * FirstStateVarIndex > LastStateVarIndex means there are no state vars.
+    */
+   GLuint FirstStateVarIndex;
+   GLuint LastStateVarIndex;
 };
 
 
@@ -112,6 +112,14 @@ copy_indirect_accessed_array(struct gl_program_parameter_list *src,
        */
       curr->Name = NULL;
 
+      /* This bypasses _mesa_add_parameter(), so maintain the state var
+       * range by hand.
+       */
+      if (curr->Type == PROGRAM_STATE_VAR) {
+	 dst->FirstStateVarIndex = MIN2(dst->FirstStateVarIndex, j);
+	 dst->LastStateVarIndex = MAX2(dst->LastStateVarIndex, j);
+      }
+
       dst->NumParameters++;
    }
 
@@ -1057,6 +1057,28 @@ _mesa_program_state_string(const gl_state_index16 state[STATE_LENGTH])
 }
 
 
+/**
+ * Return true if the state var is a single row of one of the tracked
+ * matrices, (state[2] = first row = state[3] = last row), so that
+ * _mesa_load_state_parameters() may consider batching it with adjacent
+ * rows of the same matrix.
+ */
+static bool
+is_single_matrix_row(const gl_state_index16 state[STATE_LENGTH])
+{
+   switch (state[0]) {
+   case STATE_MODELVIEW_MATRIX:
+   case STATE_PROJECTION_MATRIX:
+   case STATE_MVP_MATRIX:
+   case STATE_TEXTURE_MATRIX:
+   case STATE_PROGRAM_MATRIX:
+      return state[2] == state[3];
+   default:
+      return false;
+   }
+}
+
+
 /**
  * Loop over all the parameters in a parameter list.  If the parameter
  * is a GL state reference, look up the current value of that state
@@ -1074,12 +1096,57 @@ _mesa_load_state_parameters(struct gl_context *ctx,
    if (!paramList)
       return;
 
-   for (i = 0; i < paramList->NumParameters; i++) {
+   /* Only walk the range of the list which actually holds state vars;
+    * uniform-heavy GLSL programs often track just a few matrices at the
+    * tail of a list with hundreds of entries.
+    */
+   for (i = paramList->FirstStateVarIndex;
+        i <= paramList->LastStateVarIndex && i < paramList->NumParameters;
+        i++) {
       if (paramList->Parameters[i].Type == PROGRAM_STATE_VAR) {
          unsigned pvo = paramList->ParameterValueOffset[i];
-         _mesa_fetch_state(ctx,
-			   paramList->Parameters[i].StateIndexes,
-                           paramList->ParameterValues + pvo);
+         const gl_state_index16 *state = paramList->Parameters[i].StateIndexes;
+
+         /* Matrices are tracked one row per parameter, but
+          * _mesa_fetch_state() can fill any row range of a matrix in a
+          * single call.  When consecutive parameters are consecutive rows
+          * of the same matrix stored at consecutive value offsets, fetch
+          * the whole run at once; a full matrix then refreshes as one
+          * contiguous 16-float block instead of four dispatched calls.
+          */
+         if (is_single_matrix_row(state)) {
+            GLuint last = i;
+
+            while (last + 1 <= paramList->LastStateVarIndex &&
+                   last + 1 < paramList->NumParameters) {
+               const struct gl_program_parameter *n =
+                  &paramList->Parameters[last + 1];
+
+               if (n->Type != PROGRAM_STATE_VAR ||
+                   !is_single_matrix_row(n->StateIndexes) ||
+                   n->StateIndexes[0] != state[0] ||  /* same matrix */
+                   n->StateIndexes[1] != state[1] ||  /* same index */
+                   n->StateIndexes[4] != state[4] ||  /* same modifier */
+                   n->StateIndexes[2] != state[2] + (last + 1 - i) ||
+                   paramList->ParameterValueOffset[last + 1] !=
+                   pvo + 4 * (last + 1 - i))
+                  break;
+
+               last++;
+            }
+
+            if (last > i) {
+               gl_state_index16 run[STATE_LENGTH];
+
+               memcpy(run, state, sizeof(run));
+               run[3] = paramList->Parameters[last].StateIndexes[3];
+               _mesa_fetch_state(ctx, run, paramList->ParameterValues + pvo);
+               i = last;
+               continue;
+            }
+         }
+
+         _mesa_fetch_state(ctx, state, paramList->ParameterValues + pvo);
       }
    }
 }
@@ -31,6 +31,14 @@ struct symbol {
    /** Symbol name. */
    char *name;
 
+   /**
+    * Hash of \c name
+    *
+    * Cached so that scope pops and shadowed-symbol updates never have to
+    * re-hash the name string.
+    */
+   uint32_t name_hash;
+
     /**
      * Link to the next symbol in the table with the same name
      *
@@ -96,8 +104,9 @@ _mesa_symbol_table_pop_scope(struct _mesa_symbol_table *table)
 
     while (sym != NULL) {
         struct symbol *const next = sym->next_with_same_scope;
-        struct hash_entry *hte = _mesa_hash_table_search(table->ht,
-                                                         sym->name);
+        struct hash_entry *hte =
+           _mesa_hash_table_search_pre_hashed(table->ht, sym->name_hash,
+                                              sym->name);
         if (sym->next_with_same_name) {
            /* If there is a symbol with this name in an outer scope update
             * the hash table to point to it.
@@ -131,13 +140,22 @@ _mesa_symbol_table_push_scope(struct _mesa_symbol_table *table)
 
 
 static struct symbol *
-find_symbol(struct _mesa_symbol_table *table, const char *name)
+find_symbol_pre_hashed(struct _mesa_symbol_table *table, uint32_t hash,
+                       const char *name)
 {
-   struct hash_entry *entry = _mesa_hash_table_search(table->ht, name);
+   struct hash_entry *entry =
+      _mesa_hash_table_search_pre_hashed(table->ht, hash, name);
    return entry ? (struct symbol *) entry->data : NULL;
 }
 
 
+static struct symbol *
+find_symbol(struct _mesa_symbol_table *table, const char *name)
+{
+   return find_symbol_pre_hashed(table, _mesa_hash_string(name), name);
+}
+
+
 /**
  * Determine the scope "distance" of a symbol from the current scope
  *
@@ -178,7 +196,8 @@ _mesa_symbol_table_add_symbol(struct _mesa_symbol_table *table,
                               const char *name, void *declaration)
 {
    struct symbol *new_sym;
-   struct symbol *sym = find_symbol(table, name);
+   const uint32_t hash = _mesa_hash_string(name);
+   struct symbol *sym = find_symbol_pre_hashed(table, hash, name);
 
    if (sym && sym->depth == table->depth)
       return -1;
@@ -202,13 +221,15 @@ _mesa_symbol_table_add_symbol(struct _mesa_symbol_table *table,
       }
    }
 
+   new_sym->name_hash = hash;
    new_sym->next_with_same_scope = table->current_scope->symbols;
    new_sym->data = declaration;
    new_sym->depth = table->depth;
 
    table->current_scope->symbols = new_sym;
 
-   _mesa_hash_table_insert(table->ht, new_sym->name, new_sym);
+   _mesa_hash_table_insert_pre_hashed(table->ht, hash, new_sym->name,
+                                      new_sym);
 
    return 0;
 }
@@ -234,7 +255,8 @@ _mesa_symbol_table_add_global_symbol(struct _mesa_symbol_table *table,
 {
    struct scope_level *top_scope;
    struct symbol *inner_sym = NULL;
-   struct symbol *sym = find_symbol(table, name);
+   const uint32_t hash = _mesa_hash_string(name);
+   struct symbol *sym = find_symbol_pre_hashed(table, hash, name);
 
    while (sym) {
       if (sym->depth == 0)
@@ -274,12 +296,13 @@ _mesa_symbol_table_add_global_symbol(struct _mesa_symbol_table *table,
       }
    }
 
+   sym->name_hash = hash;
    sym->next_with_same_scope = top_scope->symbols;
    sym->data = declaration;
 
    top_scope->symbols = sym;
 
-   _mesa_hash_table_insert(table->ht, sym->name, sym);
+   _mesa_hash_table_insert_pre_hashed(table->ht, hash, sym->name, sym);
 
    return 0;
 }
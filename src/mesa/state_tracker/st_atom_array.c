@@ -383,6 +383,35 @@ set_vertex_attribs(struct st_context *st,
    cso_set_vertex_elements(cso, num_velements, velements);
 }
 
+/**
+ * Resolve a vertex buffer binding into a pipe_vertex_buffer.  This re-reads
+ * the bound buffer object's storage, which may have been orphaned by
+ * glBufferData since the binding was last seen.
+ */
+static void
+init_vbuffer_from_binding(struct st_context *st,
+                          const struct gl_vertex_buffer_binding *binding,
+                          struct pipe_vertex_buffer *vbuffer)
+{
+   if (_mesa_is_bufferobj(binding->BufferObj)) {
+      /* Set the binding */
+      struct st_buffer_object *stobj = st_buffer_object(binding->BufferObj);
+      vbuffer->buffer.resource = stobj ? stobj->buffer : NULL;
+      vbuffer->is_user_buffer = false;
+      vbuffer->buffer_offset = _mesa_draw_binding_offset(binding);
+   } else {
+      /* Set the binding */
+      const void *ptr = (const void *)_mesa_draw_binding_offset(binding);
+      vbuffer->buffer.user = ptr;
+      vbuffer->is_user_buffer = true;
+      vbuffer->buffer_offset = 0;
+
+      if (!binding->InstanceDivisor)
+         st->draw_needs_minmax_index = true;
+   }
+   vbuffer->stride = binding->Stride; /* in bytes */
+}
+
 void
 st_setup_arrays(struct st_context *st,
                 const struct st_vertex_program *vp,
@@ -395,6 +424,11 @@ st_setup_arrays(struct st_context *st,
    const GLbitfield inputs_read = vp_variant->vert_attrib_mask;
    const ubyte *input_to_index = vp->input_to_index;
 
+   /* Invalidate the snapshot; st_update_array re-validates it once the
+    * translation below has run to completion.
+    */
+   st->last_arrays.vao = NULL;
+
    /* Process attribute array data. */
    GLbitfield mask = inputs_read & _mesa_draw_array_bits(ctx);
    while (mask) {
@@ -404,23 +438,8 @@ st_setup_arrays(struct st_context *st,
          = _mesa_draw_buffer_binding(vao, i);
       const unsigned bufidx = (*num_vbuffers)++;
 
-      if (_mesa_is_bufferobj(binding->BufferObj)) {
-         /* Set the binding */
-         struct st_buffer_object *stobj = st_buffer_object(binding->BufferObj);
-         vbuffer[bufidx].buffer.resource = stobj ? stobj->buffer : NULL;
-         vbuffer[bufidx].is_user_buffer = false;
-         vbuffer[bufidx].buffer_offset = _mesa_draw_binding_offset(binding);
-      } else {
-         /* Set the binding */
-         const void *ptr = (const void *)_mesa_draw_binding_offset(binding);
-         vbuffer[bufidx].buffer.user = ptr;
-         vbuffer[bufidx].is_user_buffer = true;
-         vbuffer[bufidx].buffer_offset = 0;
-
-         if (!binding->InstanceDivisor)
-            st->draw_needs_minmax_index = true;
-      }
-      vbuffer[bufidx].stride = binding->Stride; /* in bytes */
+      init_vbuffer_from_binding(st, binding, &vbuffer[bufidx]);
+      st->last_arrays.bindings[bufidx] = binding;
 
       const GLbitfield boundmask = _mesa_draw_bound_attrib_bits(binding);
       GLbitfield attrmask = mask & boundmask;
@@ -536,6 +555,9 @@ st_setup_current_user(struct st_context *st,
 void
 st_update_array(struct st_context *st)
 {
+   struct gl_context *ctx = st->ctx;
+   const struct gl_vertex_array_object *vao = ctx->Array._DrawVAO;
+
    /* vertex program validation must be done before this */
    /* _NEW_PROGRAM, ST_NEW_VS_STATE */
    const struct st_vertex_program *vp = st->vp;
@@ -548,6 +570,29 @@ st_update_array(struct st_context *st)
 
    st->draw_needs_minmax_index = false;
 
+   /* If the inputs of the last translation are unchanged, reuse its result:
+    * re-read the recorded buffer bindings (the buffer storage may have been
+    * orphaned by glBufferData) and re-install the saved vertex elements.
+    */
+   if (st->last_arrays.vao == vao &&
+       st->last_arrays.vao_generation == vao->Generation &&
+       st->last_arrays.enabled_attribs == ctx->Array._DrawVAOEnabledAttribs &&
+       st->last_arrays.attribute_map_mode == vao->_AttributeMapMode &&
+       st->last_arrays.vp == vp &&
+       st->last_arrays.vp_variant == vp_variant &&
+       !(vp_variant->vert_attrib_mask & _mesa_draw_current_bits(ctx))) {
+      num_vbuffers = st->last_arrays.num_vbuffers;
+
+      for (unsigned i = 0; i < num_vbuffers; i++) {
+         init_vbuffer_from_binding(st, st->last_arrays.bindings[i],
+                                   &vbuffer[i]);
+      }
+
+      set_vertex_attribs(st, vbuffer, num_vbuffers,
+                         st->last_arrays.velements, vp_variant->num_inputs);
+      return;
+   }
+
    /* ST_NEW_VERTEX_ARRAYS alias ctx->DriverFlags.NewArray */
    /* Setup arrays */
    st_setup_arrays(st, vp, vp_variant, velements, vbuffer, &num_vbuffers);
@@ -565,4 +610,19 @@ st_update_array(struct st_context *st)
    for (unsigned i = first_upload_vbuffer; i < num_vbuffers; ++i) {
       pipe_resource_reference(&vbuffer[i].buffer.resource, NULL);
    }
+
+   /* Take a snapshot for reuse by the next call.  Draws with current values
+    * involve a fresh upload each time and are not snapshotted.
+    */
+   if (first_upload_vbuffer == num_vbuffers) {
+      st->last_arrays.vao = vao;
+      st->last_arrays.vao_generation = vao->Generation;
+      st->last_arrays.enabled_attribs = ctx->Array._DrawVAOEnabledAttribs;
+      st->last_arrays.attribute_map_mode = vao->_AttributeMapMode;
+      st->last_arrays.vp = vp;
+      st->last_arrays.vp_variant = vp_variant;
+      st->last_arrays.num_vbuffers = num_vbuffers;
+      memcpy(st->last_arrays.velements, velements,
+             num_velements * sizeof(velements[0]));
+   }
 }
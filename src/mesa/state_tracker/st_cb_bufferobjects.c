@@ -131,10 +131,32 @@ st_bufferobj_subdata(struct gl_context *ctx,
     * even if the buffer is currently referenced by hardware - they
     * just queue the upload as dma rather than mapping the underlying
     * buffer directly.
+    *
+    * Ranges which have never held defined contents can't be in use by the
+    * GPU at all, so writes to them can additionally skip synchronization
+    * and the driver's busy-buffer staging copy.  Bindings that let the GPU
+    * define buffer contents behind our back (images/texture buffers,
+    * atomics, SSBOs, transform feedback, pixel pack) make the tracking
+    * unreliable, so fall back to the plain write once the buffer has ever
+    * been bound that way.
     */
-   pipe_buffer_write(st_context(ctx)->pipe,
-                     st_obj->buffer,
-                     offset, size, data);
+   if (!(obj->UsageHistory & (USAGE_TEXTURE_BUFFER |
+                              USAGE_ATOMIC_COUNTER_BUFFER |
+                              USAGE_SHADER_STORAGE_BUFFER |
+                              USAGE_TRANSFORM_FEEDBACK_BUFFER |
+                              USAGE_PIXEL_PACK_BUFFER)) &&
+       !util_interval_set_overlaps(&st_obj->written_ranges,
+                                   offset, offset + size)) {
+      pipe_buffer_write_nooverlap(st_context(ctx)->pipe,
+                                  st_obj->buffer,
+                                  offset, size, data);
+   } else {
+      pipe_buffer_write(st_context(ctx)->pipe,
+                        st_obj->buffer,
+                        offset, size, data);
+   }
+
+   util_interval_set_add(&st_obj->written_ranges, offset, offset + size);
 }
 
 
@@ -242,10 +264,8 @@ buffer_usage(GLenum target, GLboolean immutable,
       /* BufferData */
       switch (usage) {
       case GL_DYNAMIC_DRAW:
-      case GL_DYNAMIC_COPY:
          return PIPE_USAGE_DYNAMIC;
       case GL_STREAM_DRAW:
-      case GL_STREAM_COPY:
          /* XXX: Remove this test and fall-through when we have PBO unpacking
           * acceleration. Right now, PBO unpacking is done by the CPU, so we
           * have to make sure CPU reads are fast.
@@ -260,6 +280,15 @@ buffer_usage(GLenum target, GLboolean immutable,
          return PIPE_USAGE_STAGING;
       case GL_STATIC_DRAW:
       case GL_STATIC_COPY:
+      case GL_DYNAMIC_COPY:
+      case GL_STREAM_COPY:
+         /* The COPY usages promise that the CPU neither writes nor reads the
+          * buffer, so device memory is the right place for them.  This
+          * matters for transform feedback: GL_*_COPY is the recommended
+          * usage for buffers the GPU writes and then consumes as vertex
+          * input, and the DYNAMIC/STREAM pools are optimized for CPU access
+          * instead.
+          */
       default:
          return PIPE_USAGE_DEFAULT;
       }
@@ -297,9 +326,12 @@ bufferobj_data(struct gl_context *ctx,
          pipe->buffer_subdata(pipe, st_obj->buffer,
                               PIPE_TRANSFER_DISCARD_WHOLE_RESOURCE,
                               0, size, data);
+         util_interval_set_clear(&st_obj->written_ranges);
+         util_interval_set_add(&st_obj->written_ranges, 0, size);
          return GL_TRUE;
       } else if (screen->get_param(screen, PIPE_CAP_INVALIDATE_BUFFER)) {
          pipe->invalidate_resource(pipe, st_obj->buffer);
+         util_interval_set_clear(&st_obj->written_ranges);
          return GL_TRUE;
       }
    }
@@ -309,6 +341,7 @@ bufferobj_data(struct gl_context *ctx,
    st_obj->Base.StorageFlags = storageFlags;
 
    pipe_resource_reference( &st_obj->buffer, NULL );
+   util_interval_set_clear(&st_obj->written_ranges);
 
    const unsigned bindings = buffer_target_to_bind_flags(target);
 
@@ -336,16 +369,21 @@ bufferobj_data(struct gl_context *ctx,
          st_obj->buffer = screen->resource_from_memobj(screen, &buffer,
                                                        st_mem_obj->memory,
                                                        offset);
+         /* External memory can be written behind our back. */
+         util_interval_set_add(&st_obj->written_ranges, 0, UINT64_MAX);
       }
       else if (target == GL_EXTERNAL_VIRTUAL_MEMORY_BUFFER_AMD) {
          st_obj->buffer =
             screen->resource_from_user_memory(screen, &buffer, (void*)data);
+         util_interval_set_add(&st_obj->written_ranges, 0, UINT64_MAX);
       }
       else {
          st_obj->buffer = screen->resource_create(screen, &buffer);
 
-         if (st_obj->buffer && data)
+         if (st_obj->buffer && data) {
             pipe_buffer_write(pipe, st_obj->buffer, 0, size, data);
+            util_interval_set_add(&st_obj->written_ranges, 0, size);
+         }
       }
 
       if (!st_obj->buffer) {
@@ -427,6 +465,7 @@ st_bufferobj_invalidate(struct gl_context *ctx,
       return;
 
    pipe->invalidate_resource(pipe, st_obj->buffer);
+   util_interval_set_clear(&st_obj->written_ranges);
 }
 
 
@@ -507,6 +546,9 @@ st_bufferobj_map_range(struct gl_context *ctx,
       obj->Mappings[index].Offset = offset;
       obj->Mappings[index].Length = length;
       obj->Mappings[index].AccessFlags = access;
+
+      if (access & GL_MAP_WRITE_BIT)
+         util_interval_set_add(&st_obj->written_ranges, offset, offset + length);
    }
    else {
       st_obj->transfer[index] = NULL;
@@ -587,6 +629,8 @@ st_copy_buffer_subdata(struct gl_context *ctx,
 
    pipe->resource_copy_region(pipe, dstObj->buffer, 0, writeOffset, 0, 0,
                               srcObj->buffer, 0, &box);
+   util_interval_set_add(&dstObj->written_ranges, writeOffset,
+                         writeOffset + size);
 }
 
 /**
@@ -614,6 +658,7 @@ st_clear_buffer_subdata(struct gl_context *ctx,
 
    pipe->clear_buffer(pipe, buf->buffer, offset, size,
                       clearValue, clearValueSize);
+   util_interval_set_add(&buf->written_ranges, offset, offset + size);
 }
 
 static void
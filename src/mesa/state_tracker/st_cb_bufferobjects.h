@@ -29,6 +29,7 @@
 #define ST_CB_BUFFEROBJECTS_H
 
 #include "main/mtypes.h"
+#include "util/u_interval_set.h"
 
 struct dd_function_table;
 struct pipe_resource;
@@ -44,6 +45,15 @@ struct st_buffer_object
    struct gl_buffer_object Base;
    struct pipe_resource *buffer;     /* GPU storage */
    struct pipe_transfer *transfer[MAP_COUNT];
+
+   /**
+    * Byte ranges of the buffer that have been given defined contents since
+    * the current storage was allocated.  glBufferSubData uploads outside
+    * these ranges cannot conflict with any GPU use of the buffer and may be
+    * written unsynchronized.  The tracking is conservative: whole-buffer
+    * events just mark everything written.
+    */
+   struct util_interval_set written_ranges;
 };
 
 
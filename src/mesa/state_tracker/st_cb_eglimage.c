@@ -148,6 +148,21 @@ st_egl_image_target_renderbuffer_storage(struct gl_context *ctx,
       struct pipe_context *pipe = st_context(ctx)->pipe;
       struct pipe_surface *ps, surf_tmpl;
 
+      /* Rebinding the same EGLImage every frame is common for streaming
+       * producers; keep the existing surface in that case and just tell
+       * the driver that the contents may have changed.
+       */
+      ps = strb->surface;
+      if (ps && ps->texture == stimg.texture &&
+          ps->format == stimg.format &&
+          ps->u.tex.level == stimg.level &&
+          ps->u.tex.first_layer == stimg.layer) {
+         if (pipe->screen->resource_changed)
+            pipe->screen->resource_changed(pipe->screen, ps->texture);
+         pipe_resource_reference(&stimg.texture, NULL);
+         return;
+      }
+
       u_surface_default_template(&surf_tmpl, stimg.texture);
       surf_tmpl.format = stimg.format;
       surf_tmpl.u.tex.level = stimg.level;
@@ -190,6 +205,22 @@ st_bind_egl_image(struct gl_context *ctx,
    stObj = st_texture_object(texObj);
    stImage = st_texture_image(texImage);
 
+   /* Rebinding the same EGLImage: if only the contents may have changed,
+    * keep the binding as-is instead of dropping all sampler views and
+    * re-initializing the texture image, and let resource_changed tell
+    * the driver to revalidate what it has imported.
+    */
+   if (stObj->surface_based &&
+       stObj->pt == stimg->texture &&
+       stImage->pt == stObj->pt &&
+       stObj->surface_format == stimg->format &&
+       stObj->level_override == stimg->level &&
+       stObj->layer_override == stimg->layer) {
+      if (st->pipe->screen->resource_changed)
+         st->pipe->screen->resource_changed(st->pipe->screen, stImage->pt);
+      return;
+   }
+
    /* switch to surface based */
    if (!stObj->surface_based) {
       _mesa_clear_texture_object(ctx, texObj, NULL);
@@ -388,6 +388,11 @@ st_StoreQueryResult(struct gl_context *ctx, struct gl_query_object *q,
    struct st_query_object *stq = st_query_object(q);
    struct st_buffer_object *stObj = st_buffer_object(buf);
    boolean wait = pname == GL_QUERY_RESULT;
+
+   /* Results are at most 64 bits; record the write for the buffer's
+    * written-range tracking.
+    */
+   util_interval_set_add(&stObj->written_ranges, offset, offset + 8);
    enum pipe_query_value_type result_type;
    int index;
 
@@ -466,19 +466,32 @@ st_ReadPixels(struct gl_context *ctx, GLint x, GLint y,
     * for the format+type combo. */
    dst_format = st_choose_matching_format(st, bind, format, type,
                                           pack->SwapBytes);
-   if (dst_format == PIPE_FORMAT_NONE) {
-      goto fallback;
-   }
 
    if (st->pbo.download_enabled && _mesa_is_bufferobj(pack->BufferObj)) {
-      if (try_pbo_readpixels(st, strb,
+      enum pipe_format pbo_format = dst_format;
+
+      /* The PBO path writes the destination with shader image stores, so
+       * it doesn't need a renderable format - retry the format match
+       * without the bind requirement before giving up on it.
+       */
+      if (pbo_format == PIPE_FORMAT_NONE && bind == PIPE_BIND_RENDER_TARGET) {
+         pbo_format = st_choose_matching_format(st, 0, format, type,
+                                                pack->SwapBytes);
+      }
+
+      if (pbo_format != PIPE_FORMAT_NONE &&
+          try_pbo_readpixels(st, strb,
                              st_fb_orientation(ctx->ReadBuffer) == Y_0_TOP,
                              x, y, width, height,
-                             src_format, dst_format,
+                             src_format, pbo_format,
                              pack, pixels))
          return;
    }
 
+   if (dst_format == PIPE_FORMAT_NONE) {
+      goto fallback;
+   }
+
    if (needs_integer_signed_unsigned_conversion(ctx, format, type)) {
       goto fallback;
    }
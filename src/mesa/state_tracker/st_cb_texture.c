@@ -1623,8 +1623,8 @@ st_TexSubImage(struct gl_context *ctx, GLuint dims,
       const uint bytesPerRow = width * util_format_get_blocksize(src_format);
       GLuint row, slice;
 
-      for (slice = 0; slice < (unsigned) depth; slice++) {
-         if (gl_target == GL_TEXTURE_1D_ARRAY) {
+      if (gl_target == GL_TEXTURE_1D_ARRAY) {
+         for (slice = 0; slice < (unsigned) depth; slice++) {
             /* 1D array textures.
              * We need to convert gallium coords to GL coords.
              */
@@ -1632,19 +1632,41 @@ st_TexSubImage(struct gl_context *ctx, GLuint dims,
                                                 width, depth, format,
                                                 type, slice, 0);
             memcpy(map, src, bytesPerRow);
+            map += transfer->layer_stride;
          }
-         else {
-            ubyte *slice_map = map;
-
-            for (row = 0; row < (unsigned) height; row++) {
-               void *src = _mesa_image_address(dims, unpack, pixels,
-                                                 width, height, format,
-                                                 type, slice, row, 0);
-               memcpy(slice_map, src, bytesPerRow);
-               slice_map += transfer->stride;
+      }
+      else {
+         /* The image address only moves by fixed strides between rows and
+          * slices; don't redo the full addressing math per row.  The map
+          * usually points at write-combined memory, so the copies below
+          * stay strictly sequential.
+          */
+         const int srcRowStride =
+            _mesa_image_row_stride(unpack, width, format, type);
+         const int srcImageStride = dims == 3 ?
+            _mesa_image_image_stride(unpack, width, height, format, type) : 0;
+         const GLubyte *src_base =
+            _mesa_image_address(dims, unpack, pixels, width, height,
+                                format, type, 0, 0, 0);
+
+         for (slice = 0; slice < (unsigned) depth; slice++) {
+            const GLubyte *src = src_base + slice * (size_t) srcImageStride;
+
+            if (bytesPerRow == transfer->stride &&
+                (int) bytesPerRow == srcRowStride) {
+               /* Tightly packed on both sides: one copy per slice. */
+               memcpy(map, src, (size_t) bytesPerRow * height);
+            } else {
+               ubyte *slice_map = map;
+
+               for (row = 0; row < (unsigned) height; row++) {
+                  memcpy(slice_map, src, bytesPerRow);
+                  src += srcRowStride;
+                  slice_map += transfer->stride;
+               }
             }
+            map += transfer->layer_stride;
          }
-         map += transfer->layer_stride;
       }
    }
 
@@ -1879,6 +1901,204 @@ st_CompressedTexImage(struct gl_context *ctx, GLuint dims,
 }
 
 
+/**
+ * Reads back the texture image into the PBO entirely on the GPU, using the
+ * same shader-based download that glReadPixels uses.  Nothing is mapped, so
+ * the readback completes asynchronously: the application observes the data
+ * through the usual buffer object synchronization (fences, or mapping the
+ * PBO later), and back-to-back readbacks can stay in flight.
+ */
+static bool
+try_pbo_download(struct st_context *st,
+                 struct gl_texture_image *texImage,
+                 enum pipe_format src_format, enum pipe_format dst_format,
+                 GLint xoffset, GLint yoffset, GLint zoffset,
+                 GLsizei width, GLsizei height, GLint depth,
+                 const struct gl_pixelstore_attrib *pack, void *pixels)
+{
+   struct st_texture_image *stImage = st_texture_image(texImage);
+   struct st_texture_object *stObj = st_texture_object(texImage->TexObject);
+   struct pipe_context *pipe = st->pipe;
+   struct pipe_screen *screen = pipe->screen;
+   struct pipe_resource *texture = stImage->pt;
+   struct cso_context *cso = st->cso_context;
+   const struct util_format_description *desc;
+   struct st_pbo_addresses addr;
+   struct pipe_framebuffer_state fb;
+   enum pipe_texture_target view_target;
+   GLenum gl_target = texImage->TexObject->Target;
+   unsigned level;
+   bool success = false;
+
+   if (texture->nr_samples > 1)
+      return false;
+
+   /* GetTexImage only returns a single face for cubemaps. */
+   if (gl_target == GL_TEXTURE_CUBE_MAP)
+      gl_target = GL_TEXTURE_2D;
+
+   /* From now on, we need the gallium representation of dimensions. */
+   if (gl_target == GL_TEXTURE_1D_ARRAY) {
+      zoffset = yoffset;
+      yoffset = 0;
+      depth = height;
+      height = 1;
+   }
+
+   if (depth != 1 && !st->pbo.layers)
+      return false;
+
+   /* The shader samples the texture with texel fetches; keep compressed
+    * formats on the blit path, which also handles the decompression. */
+   if (util_format_is_compressed(texture->format))
+      return false;
+
+   if (!screen->is_format_supported(screen, dst_format, PIPE_BUFFER, 0, 0,
+                                    PIPE_BIND_SHADER_IMAGE))
+      return false;
+
+   desc = util_format_description(dst_format);
+
+   /* Compute PBO addresses */
+   addr.bytes_per_pixel = desc->block.bits / 8;
+   addr.xoffset = xoffset;
+   addr.yoffset = yoffset;
+   addr.width = width;
+   addr.height = height;
+   addr.depth = depth;
+   if (!st_pbo_addresses_pixelstore(st, gl_target, depth != 1, pack, pixels,
+                                    &addr))
+      return false;
+
+   cso_save_state(cso, (CSO_BIT_FRAGMENT_SAMPLER_VIEWS |
+                        CSO_BIT_FRAGMENT_SAMPLERS |
+                        CSO_BIT_FRAGMENT_IMAGE0 |
+                        CSO_BIT_BLEND |
+                        CSO_BIT_VERTEX_ELEMENTS |
+                        CSO_BIT_AUX_VERTEX_BUFFER_SLOT |
+                        CSO_BIT_FRAMEBUFFER |
+                        CSO_BIT_VIEWPORT |
+                        CSO_BIT_RASTERIZER |
+                        CSO_BIT_DEPTH_STENCIL_ALPHA |
+                        CSO_BIT_STREAM_OUTPUTS |
+                        CSO_BIT_PAUSE_QUERIES |
+                        CSO_BIT_SAMPLE_MASK |
+                        CSO_BIT_MIN_SAMPLES |
+                        CSO_BIT_RENDER_CONDITION |
+                        CSO_BITS_ALL_SHADERS));
+   cso_save_constant_buffer_slot0(cso, PIPE_SHADER_FRAGMENT);
+
+   cso_set_sample_mask(cso, ~0);
+   cso_set_min_samples(cso, 1);
+   cso_set_render_condition(cso, NULL, FALSE, 0);
+
+   /* Set up the sampler_view */
+   {
+      struct pipe_sampler_view templ;
+      struct pipe_sampler_view *sampler_view;
+      struct pipe_sampler_state sampler = {0};
+      const struct pipe_sampler_state *samplers[1] = {&sampler};
+      unsigned max_layer;
+
+      level = texImage->TexObject->MinLevel + texImage->Level;
+      max_layer = util_max_layer(texture, level);
+
+      u_sampler_view_default_template(&templ, texture, src_format);
+
+      switch (texture->target) {
+      case PIPE_TEXTURE_CUBE:
+      case PIPE_TEXTURE_CUBE_ARRAY:
+         view_target = PIPE_TEXTURE_2D_ARRAY;
+         break;
+      default:
+         view_target = texture->target;
+         break;
+      }
+
+      templ.target = view_target;
+      templ.u.tex.first_level = level;
+      templ.u.tex.last_level = level;
+
+      zoffset += texImage->Face + texImage->TexObject->MinLayer;
+
+      if (view_target != PIPE_TEXTURE_3D) {
+         templ.u.tex.first_layer = MIN2(zoffset, max_layer);
+         templ.u.tex.last_layer = MIN2(zoffset + depth - 1, max_layer);
+      } else {
+         addr.constants.layer_offset = zoffset;
+      }
+
+      sampler_view = pipe->create_sampler_view(pipe, texture, &templ);
+      if (sampler_view == NULL)
+         goto fail;
+
+      cso_set_sampler_views(cso, PIPE_SHADER_FRAGMENT, 1, &sampler_view);
+
+      pipe_sampler_view_reference(&sampler_view, NULL);
+
+      cso_set_samplers(cso, PIPE_SHADER_FRAGMENT, 1, samplers);
+   }
+
+   /* Set up destination image */
+   {
+      struct pipe_image_view image;
+
+      memset(&image, 0, sizeof(image));
+      image.resource = addr.buffer;
+      image.format = dst_format;
+      image.access = PIPE_IMAGE_ACCESS_WRITE;
+      image.shader_access = PIPE_IMAGE_ACCESS_WRITE;
+      image.u.buf.offset = addr.first_element * addr.bytes_per_pixel;
+      image.u.buf.size = (addr.last_element - addr.first_element + 1) *
+                         addr.bytes_per_pixel;
+
+      cso_set_shader_images(cso, PIPE_SHADER_FRAGMENT, 0, 1, &image);
+   }
+
+   /* Set up no-attachment framebuffer */
+   memset(&fb, 0, sizeof(fb));
+   fb.width = u_minify(texture->width0, level);
+   fb.height = u_minify(texture->height0, level);
+   fb.samples = 1;
+   fb.layers = addr.depth;
+   cso_set_framebuffer(cso, &fb);
+
+   /* Any blend state would do. Set this just to prevent drivers having
+    * blend == NULL.
+    */
+   cso_set_blend(cso, &st->pbo.upload_blend);
+
+   cso_set_viewport_dims(cso, fb.width, fb.height, FALSE);
+
+   {
+      struct pipe_depth_stencil_alpha_state dsa;
+      memset(&dsa, 0, sizeof(dsa));
+      cso_set_depth_stencil_alpha(cso, &dsa);
+   }
+
+   /* Set up the fragment shader */
+   {
+      void *fs = st_pbo_get_download_fs(st, view_target, src_format,
+                                        dst_format);
+      if (!fs)
+         goto fail;
+
+      cso_set_fragment_shader_handle(cso, fs);
+   }
+
+   success = st_pbo_draw(st, &addr, fb.width, fb.height);
+
+   /* Buffer written via shader images needs explicit synchronization. */
+   pipe->memory_barrier(pipe, PIPE_BARRIER_ALL);
+
+fail:
+   cso_restore_state(cso);
+   cso_restore_constant_buffer_slot0(cso, PIPE_SHADER_FRAGMENT);
+
+   return success;
+}
+
+
 /**
  * Called via ctx->Driver.GetTexSubImage()
  *
@@ -2083,6 +2303,14 @@ st_GetTexSubImage(struct gl_context * ctx,
       }
    }
 
+   if (st->pbo.download_enabled && _mesa_is_bufferobj(ctx->Pack.BufferObj)) {
+      if (try_pbo_download(st, texImage, src_format, dst_format,
+                           xoffset, yoffset, zoffset,
+                           width, height, depth,
+                           &ctx->Pack, pixels))
+         return;
+   }
+
    /* create the destination texture of size (width X height X depth) */
    memset(&dst_templ, 0, sizeof(dst_templ));
    dst_templ.target = pipe_target;
@@ -68,6 +68,7 @@
 #include "st_cb_strings.h"
 #include "st_cb_texturebarrier.h"
 #include "st_cb_viewport.h"
+#include "st_frametrack.h"
 #include "st_atom.h"
 #include "st_draw.h"
 #include "st_extensions.h"
@@ -434,6 +435,7 @@ st_destroy_context_priv(struct st_context *st, bool destroy_pipe)
    st_destroy_drawpix(st);
    st_destroy_drawtex(st);
    st_destroy_perfmon(st);
+   st_destroy_frametrack(st);
    st_destroy_pbo_helpers(st);
    st_destroy_bound_texture_handles(st);
    st_destroy_bound_image_handles(st);
@@ -738,6 +740,8 @@ st_create_context_priv(struct gl_context *ctx, struct pipe_context *pipe,
    LIST_INITHEAD(&st->zombie_shaders.list.node);
    mtx_init(&st->zombie_shaders.mutex, mtx_plain);
 
+   st_init_frametrack(st);
+
    return st;
 }
 
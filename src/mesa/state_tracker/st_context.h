@@ -125,6 +125,8 @@ struct st_context
 
    struct pipe_context *pipe;
 
+   struct st_frametrack *frametrack; /**< optional frame latency log */
+
    struct draw_context *draw;  /**< For selection/feedback/rastpos only */
    struct draw_stage *feedback_stage;  /**< For GL_FEEDBACK rendermode */
    struct draw_stage *selection_stage;  /**< For GL_SELECT rendermode */
@@ -305,6 +307,25 @@ struct st_context
    /* The number of vertex buffers from the last call of validate_arrays. */
    unsigned last_num_vbuffers;
 
+   /**
+    * Snapshot of the translated vertex arrays installed by st_update_array.
+    * As long as the inputs recorded here are unchanged, the next
+    * st_update_array only re-reads the buffer bindings (buffer storage may
+    * have been orphaned) and re-installs the saved vertex elements instead
+    * of re-deriving everything.  'vao' is NULL when the snapshot is invalid.
+    */
+   struct {
+      const struct gl_vertex_array_object *vao;
+      GLuint vao_generation;
+      GLbitfield enabled_attribs;
+      gl_attribute_map_mode attribute_map_mode;
+      const struct st_vertex_program *vp;
+      const struct st_vp_variant *vp_variant;
+      unsigned num_vbuffers;
+      const struct gl_vertex_buffer_binding *bindings[PIPE_MAX_ATTRIBS];
+      struct pipe_vertex_element velements[PIPE_MAX_ATTRIBS];
+   } last_arrays;
+
    int32_t draw_stamp;
    int32_t read_stamp;
 
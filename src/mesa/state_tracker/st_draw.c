@@ -157,6 +157,106 @@ prepare_draw(struct st_context *st, struct gl_context *ctx)
    }
 }
 
+/**
+ * Minimum number of primitives in a _mesa_prim array before we try to
+ * combine them into one multi-draw-indirect submission.  Building and
+ * uploading the draw records isn't free, so short runs go through the
+ * plain loop.
+ */
+#define ST_MIN_MULTI_DRAW_PRIMS 8
+
+
+/**
+ * Try to submit all primitives as one multi-draw.  glMultiDraw* and
+ * display lists can hand us thousands of small draws in a single
+ * _mesa_prim array, and issuing them one by one pays the full per-draw
+ * overhead in the driver every time.  When the driver can consume an
+ * indirect buffer with draw_count > 1, build the draw records on the fly
+ * and submit the whole array in one call instead.
+ *
+ * \return true if the primitives were drawn, false to use the plain loop.
+ */
+static bool
+st_try_multi_draw(struct st_context *st, struct gl_context *ctx,
+                  const struct _mesa_prim *prims, GLuint nr_prims,
+                  unsigned start, struct pipe_draw_info *info)
+{
+   struct pipe_draw_indirect_info indirect;
+   const unsigned record_size =
+      (info->index_size ? 5 : 4) * sizeof(uint32_t);
+   const struct gl_program *vp = ctx->VertexProgram._Current;
+   uint32_t *record;
+   unsigned offset;
+   GLuint i;
+
+   if (!st->has_multi_draw_indirect)
+      return false;
+
+   /* Indirect records can't describe user-pointer indices, and without
+    * per-draw index bounds user vertex arrays can't be uploaded.
+    */
+   if (info->has_user_indices || st->draw_needs_minmax_index)
+      return false;
+
+   /* The records collapse into one pipe_draw_info, so gl_DrawID would no
+    * longer advance per draw.
+    */
+   if (vp->info.system_values_read & (1ull << SYSTEM_VALUE_DRAW_ID))
+      return false;
+
+   /* An indirect submission has a single primitive type. */
+   for (i = 1; i < nr_prims; i++) {
+      if (prims[i].mode != prims[0].mode)
+         return false;
+   }
+
+   memset(&indirect, 0, sizeof(indirect));
+   u_upload_alloc(st->pipe->stream_uploader, 0, nr_prims * record_size, 4,
+                  &offset, &indirect.buffer, (void **) &record);
+   if (!indirect.buffer)
+      return false;
+
+   for (i = 0; i < nr_prims; i++, record += record_size / sizeof(uint32_t)) {
+      record[0] = prims[i].count;
+      record[1] = prims[i].num_instances;
+      record[2] = start + prims[i].start;
+      if (info->index_size) {
+         record[3] = prims[i].basevertex;
+         record[4] = prims[i].base_instance;
+      } else {
+         record[3] = prims[i].base_instance;
+      }
+   }
+   u_upload_unmap(st->pipe->stream_uploader);
+
+   indirect.offset = offset;
+   indirect.stride = record_size;
+   indirect.draw_count = nr_prims;
+
+   info->mode = translate_prim(ctx, prims[0].mode);
+   info->indirect = &indirect;
+   /* The union of the per-draw index bounds isn't known. */
+   info->min_index = 0;
+   info->max_index = ~0u;
+   info->start = 0;
+   info->count = 0;
+   info->index_bias = 0;
+   info->drawid = 0;
+   info->start_instance = 0;
+   info->instance_count = 1;
+
+   if (ST_DEBUG & DEBUG_DRAW) {
+      debug_printf("st/draw multi: mode %s  draw_count %u  index_size %d\n",
+                   u_prim_name(info->mode), nr_prims, info->index_size);
+   }
+
+   cso_draw_vbo(st->cso_context, info);
+
+   pipe_resource_reference(&indirect.buffer, NULL);
+   return true;
+}
+
+
 /**
  * This function gets plugged into the VBO module and is called when
  * we have something to render.
@@ -237,6 +337,11 @@ st_draw_vbo(struct gl_context *ctx,
 
    assert(!indirect);
 
+   /* Long runs of small draws are cheaper as one multi-draw. */
+   if (nr_prims >= ST_MIN_MULTI_DRAW_PRIMS && !tfb_vertcount &&
+       st_try_multi_draw(st, ctx, prims, nr_prims, start, &info))
+      return;
+
    /* do actual drawing */
    for (i = 0; i < nr_prims; i++) {
       info.count = prims[i].count;
@@ -0,0 +1,193 @@
+/**************************************************************************
+ *
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+/**
+ * Frame latency tracking.
+ *
+ * Every end-of-frame flush records a frame boundary: a CPU timestamp plus
+ * a GPU timestamp query emitted into the frame's command stream. Query
+ * results are collected a few frames later without waiting, and each
+ * completed pair of consecutive boundaries is written to the log file as
+ * one frame record. See st_frametrack.h for the file format.
+ */
+
+#include <stdio.h>
+
+#include "pipe/p_context.h"
+#include "pipe/p_defines.h"
+#include "util/u_memory.h"
+#include "util/os_time.h"
+
+#include "st_context.h"
+#include "st_frametrack.h"
+
+/* Number of frame boundaries kept in flight while their timestamp
+ * queries finish. */
+#define ST_FRAMETRACK_MAX_PENDING 8
+
+struct st_frametrack_boundary {
+   uint64_t frame;            /* the frame this boundary ends */
+   uint64_t cpu_ns;
+   struct pipe_query *query;  /* timestamp query, NULL if unsupported */
+};
+
+struct st_frametrack {
+   FILE *file;
+   uint64_t frame;
+
+   /* ring of boundaries whose GPU timestamps haven't landed yet */
+   struct st_frametrack_boundary pending[ST_FRAMETRACK_MAX_PENDING];
+   unsigned head, tail;
+
+   /* the newest fully resolved boundary */
+   uint64_t prev_cpu_ns;
+   uint64_t prev_gpu_ns;
+   bool have_prev;
+};
+
+void
+st_init_frametrack(struct st_context *st)
+{
+   const char *path = getenv("ST_FRAMETRACK");
+   struct st_frametrack *ft;
+   struct st_frametrack_header header;
+
+   if (!path)
+      return;
+
+   ft = CALLOC_STRUCT(st_frametrack);
+   if (!ft)
+      return;
+
+   ft->file = fopen(path, "wb");
+   if (!ft->file) {
+      fprintf(stderr, "mesa: ST_FRAMETRACK: can't open %s\n", path);
+      FREE(ft);
+      return;
+   }
+
+   header.magic = ST_FRAMETRACK_MAGIC;
+   header.record_size = sizeof(struct st_frametrack_record);
+   fwrite(&header, sizeof(header), 1, ft->file);
+
+   st->frametrack = ft;
+}
+
+/**
+ * Fetch the GPU timestamp of the oldest pending boundary and, once both
+ * ends of a frame are known, write the frame's record. Returns FALSE if
+ * the query result isn't available yet (only possible with wait=FALSE).
+ */
+static boolean
+resolve_oldest_boundary(struct st_context *st, boolean wait)
+{
+   struct st_frametrack *ft = st->frametrack;
+   struct pipe_context *pipe = st->pipe;
+   struct st_frametrack_boundary *b =
+      &ft->pending[ft->tail % ST_FRAMETRACK_MAX_PENDING];
+   uint64_t gpu_ns = 0;
+
+   if (b->query) {
+      union pipe_query_result result;
+
+      if (!pipe->get_query_result(pipe, b->query, wait, &result))
+         return FALSE;
+
+      gpu_ns = result.u64;
+      pipe->destroy_query(pipe, b->query);
+      b->query = NULL;
+   }
+
+   if (ft->have_prev) {
+      struct st_frametrack_record rec;
+
+      rec.frame = b->frame;
+      rec.cpu_begin = ft->prev_cpu_ns;
+      rec.cpu_end = b->cpu_ns;
+      rec.gpu_begin = ft->prev_gpu_ns;
+      rec.gpu_end = gpu_ns;
+      fwrite(&rec, sizeof(rec), 1, ft->file);
+   }
+
+   ft->prev_cpu_ns = b->cpu_ns;
+   ft->prev_gpu_ns = gpu_ns;
+   ft->have_prev = true;
+   ft->tail++;
+   return TRUE;
+}
+
+void
+st_frametrack_end_frame(struct st_context *st)
+{
+   struct st_frametrack *ft = st->frametrack;
+   struct pipe_context *pipe = st->pipe;
+   struct st_frametrack_boundary *b;
+
+   if (!ft)
+      return;
+
+   /* Collect whatever has finished without stalling. */
+   while (ft->tail != ft->head && resolve_oldest_boundary(st, FALSE))
+      ;
+
+   /* Only wait if the ring is full; with 8 frames in flight this
+    * doesn't happen in practice. */
+   if (ft->head - ft->tail == ST_FRAMETRACK_MAX_PENDING)
+      resolve_oldest_boundary(st, TRUE);
+
+   b = &ft->pending[ft->head % ST_FRAMETRACK_MAX_PENDING];
+   b->frame = ++ft->frame;
+   b->cpu_ns = os_time_get_nano();
+   b->query = pipe->create_query(pipe, PIPE_QUERY_TIMESTAMP, 0);
+   if (b->query)
+      pipe->end_query(pipe, b->query);
+   ft->head++;
+}
+
+void
+st_destroy_frametrack(struct st_context *st)
+{
+   struct st_frametrack *ft = st->frametrack;
+   struct pipe_context *pipe = st->pipe;
+
+   if (!ft)
+      return;
+
+   while (ft->tail != ft->head) {
+      struct st_frametrack_boundary *b =
+         &ft->pending[ft->tail % ST_FRAMETRACK_MAX_PENDING];
+
+      /* Don't wait for outstanding results at teardown. */
+      if (b->query)
+         pipe->destroy_query(pipe, b->query);
+      ft->tail++;
+   }
+
+   fclose(ft->file);
+   FREE(ft);
+   st->frametrack = NULL;
+}
@@ -0,0 +1,67 @@
+/**************************************************************************
+ *
+ * Copyright 2019 Advanced Micro Devices, Inc.
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sub license, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the
+ * next paragraph) shall be included in all copies or substantial portions
+ * of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS AND/OR ITS SUPPLIERS BE LIABLE FOR
+ * ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ **************************************************************************/
+
+#ifndef ST_FRAMETRACK_H
+#define ST_FRAMETRACK_H
+
+#include "pipe/p_compiler.h"
+
+struct st_context;
+
+/* Per-frame latency log, enabled with ST_FRAMETRACK=<file>.
+ *
+ * The file starts with st_frametrack_header, followed by one
+ * st_frametrack_record per frame in submission order. cpu_* are
+ * os_time_get_nano() values taken at the end-of-frame flushes bounding
+ * the frame; gpu_* are PIPE_QUERY_TIMESTAMP results from the same two
+ * boundaries (0 if the driver has no timestamp support). CPU and GPU
+ * timestamps are each internally consistent but use different clocks.
+ * Post-process with src/gallium/tools/frametrack.py.
+ */
+
+#define ST_FRAMETRACK_MAGIC 0x314b5446 /* "FTK1" */
+
+struct st_frametrack_header {
+   uint32_t magic;
+   uint32_t record_size;
+};
+
+struct st_frametrack_record {
+   uint64_t frame;      /* frame sequence number, starting at 1 */
+   uint64_t cpu_begin;  /* CPU time of the flush starting the frame */
+   uint64_t cpu_end;    /* CPU time of the flush ending the frame */
+   uint64_t gpu_begin;  /* GPU time at the flush starting the frame */
+   uint64_t gpu_end;    /* GPU time at the flush ending the frame */
+};
+
+void st_init_frametrack(struct st_context *st);
+
+void st_destroy_frametrack(struct st_context *st);
+
+void st_frametrack_end_frame(struct st_context *st);
+
+#endif /* ST_FRAMETRACK_H */
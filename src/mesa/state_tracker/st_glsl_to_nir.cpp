@@ -717,8 +717,10 @@ st_nir_link_shaders(nir_shader **producer, nir_shader **consumer, bool scalar)
        */
       nir_variable_mode indirect_mask = nir_var_function_temp;
 
-      NIR_PASS_V(*producer, nir_lower_indirect_derefs, indirect_mask);
-      NIR_PASS_V(*consumer, nir_lower_indirect_derefs, indirect_mask);
+      NIR_PASS_V(*producer, nir_lower_indirect_derefs, indirect_mask,
+                 UINT32_MAX);
+      NIR_PASS_V(*consumer, nir_lower_indirect_derefs, indirect_mask,
+                 UINT32_MAX);
 
       st_nir_opts(*producer, scalar);
       st_nir_opts(*consumer, scalar);
@@ -48,6 +48,7 @@
 #include "st_cb_bitmap.h"
 #include "st_cb_fbo.h"
 #include "st_cb_flush.h"
+#include "st_frametrack.h"
 #include "st_manager.h"
 #include "st_sampler_view.h"
 
@@ -668,6 +669,11 @@ st_context_flush(struct st_context_iface *stctxi, unsigned flags,
 
    FLUSH_VERTICES(st->ctx, 0);
    FLUSH_CURRENT(st->ctx, 0);
+
+   /* Emit the frame-boundary timestamp into this frame's command stream. */
+   if (flags & ST_FLUSH_END_OF_FRAME)
+      st_frametrack_end_frame(st);
+
    st_flush(st, fence, pipe_flags);
 
    if ((flags & ST_FLUSH_WAIT) && fence && *fence) {
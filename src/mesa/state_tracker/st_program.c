@@ -709,11 +709,22 @@ st_get_vp_variant(struct st_context *st,
                   struct st_vertex_program *stvp,
                   const struct st_vp_variant_key *key)
 {
-   struct st_vp_variant *vpv;
+   struct st_vp_variant *vpv, **prevPtr = &stvp->variants;
 
    /* Search for existing variant */
-   for (vpv = stvp->variants; vpv; vpv = vpv->next) {
+   for (vpv = stvp->variants; vpv; prevPtr = &vpv->next, vpv = vpv->next) {
       if (memcmp(&vpv->key, key, sizeof(*key)) == 0) {
+         /* Move the variant to the front of the list so that repeated
+          * per-draw lookups of the same variant stop at the first entry.
+          * The program may be visible to other contexts in a share group,
+          * which walk this list without a lock, so only rewrite it when
+          * this context has the share group to itself.
+          */
+         if (vpv != stvp->variants && st->ctx->Shared->RefCount == 1) {
+            *prevPtr = vpv->next;
+            vpv->next = stvp->variants;
+            stvp->variants = vpv;
+         }
          break;
       }
    }
@@ -1359,11 +1370,25 @@ st_get_fp_variant(struct st_context *st,
                   struct st_fragment_program *stfp,
                   const struct st_fp_variant_key *key)
 {
-   struct st_fp_variant *fpv;
+   struct st_fp_variant *fpv, **prevPtr = &stfp->variants;
 
    /* Search for existing variant */
-   for (fpv = stfp->variants; fpv; fpv = fpv->next) {
+   for (fpv = stfp->variants; fpv; prevPtr = &fpv->next, fpv = fpv->next) {
       if (memcmp(&fpv->key, key, sizeof(*key)) == 0) {
+         /* Move the variant to the front of the list so that repeated
+          * per-draw lookups of the same variant stop at the first entry.
+          * Bitmap/drawpixels variants stay put: they must not displace a
+          * regular variant from the head (see the insertion code below).
+          * The program may be visible to other contexts in a share group,
+          * which walk this list without a lock, so only rewrite it when
+          * this context has the share group to itself.
+          */
+         if (fpv != stfp->variants && !fpv->key.bitmap &&
+             !fpv->key.drawpixels && st->ctx->Shared->RefCount == 1) {
+            *prevPtr = fpv->next;
+            fpv->next = stfp->variants;
+            stfp->variants = fpv;
+         }
          break;
       }
    }
@@ -1636,12 +1661,23 @@ st_get_basic_variant(struct st_context *st,
                      const struct st_basic_variant_key *key)
 {
    struct pipe_context *pipe = st->pipe;
-   struct st_basic_variant *v;
+   struct st_basic_variant *v, **prevPtr = &prog->variants;
    struct pipe_shader_state tgsi = {0};
 
    /* Search for existing variant */
-   for (v = prog->variants; v; v = v->next) {
+   for (v = prog->variants; v; prevPtr = &v->next, v = v->next) {
       if (memcmp(&v->key, key, sizeof(*key)) == 0) {
+         /* Move the variant to the front of the list so that repeated
+          * per-draw lookups of the same variant stop at the first entry.
+          * The program may be visible to other contexts in a share group,
+          * which walk this list without a lock, so only rewrite it when
+          * this context has the share group to itself.
+          */
+         if (v != prog->variants && st->ctx->Shared->RefCount == 1) {
+            *prevPtr = v->next;
+            v->next = prog->variants;
+            prog->variants = v;
+         }
          break;
       }
    }
@@ -1822,7 +1858,7 @@ st_get_cp_variant(struct st_context *st,
                   struct st_basic_variant **variants)
 {
    struct pipe_context *pipe = st->pipe;
-   struct st_basic_variant *v;
+   struct st_basic_variant *v, **prevPtr = variants;
    struct st_basic_variant_key key;
 
    /* use memset, not an initializer to be sure all memory is zeroed */
@@ -1831,8 +1867,19 @@ st_get_cp_variant(struct st_context *st,
    key.st = st->has_shareable_shaders ? NULL : st;
 
    /* Search for existing variant */
-   for (v = *variants; v; v = v->next) {
+   for (v = *variants; v; prevPtr = &v->next, v = v->next) {
       if (memcmp(&v->key, &key, sizeof(key)) == 0) {
+         /* Move the variant to the front of the list so that repeated
+          * per-dispatch lookups of the same variant stop at the first
+          * entry.  The program may be visible to other contexts in a
+          * share group, which walk this list without a lock, so only
+          * rewrite it when this context has the share group to itself.
+          */
+         if (v != *variants && st->ctx->Shared->RefCount == 1) {
+            *prevPtr = v->next;
+            v->next = *variants;
+            *variants = v;
+         }
          break;
       }
    }
@@ -152,6 +152,8 @@ found:
    sv->view = view;
    sv->st = st;
 
+   p_atomic_set(&stObj->sampler_view_hint, sv);
+
 out:
    simple_mtx_unlock(&stObj->validate_mutex);
    return view;
@@ -170,10 +172,27 @@ st_texture_get_current_sampler_view(const struct st_context *st,
 {
    const struct st_sampler_views *views = p_atomic_read(&stObj->sampler_views);
 
+   /* Check the last looked-up entry first.  The hint may point into an old
+    * container or at an entry which has since been released or taken over
+    * by another context, so it is only trusted after re-checking the
+    * context; dereferencing it is safe because containers are kept alive
+    * until the texture object is deleted.
+    */
+   const struct st_sampler_view *hint =
+      p_atomic_read(&stObj->sampler_view_hint);
+   if (hint && hint->view && hint->view->context == st->pipe)
+      return hint;
+
    for (unsigned i = 0; i < views->count; ++i) {
-      const struct st_sampler_view *sv = &views->views[i];
-      if (sv->view && sv->view->context == st->pipe)
+      struct st_sampler_view *sv = (struct st_sampler_view *) &views->views[i];
+      if (sv->view && sv->view->context == st->pipe) {
+         /* The hint is just a cache, so updating it does not count as a
+          * modification of the container and needs no lock.
+          */
+         struct st_texture_object *obj = (struct st_texture_object *) stObj;
+         p_atomic_set(&obj->sampler_view_hint, sv);
          return sv;
+      }
    }
 
    return NULL;
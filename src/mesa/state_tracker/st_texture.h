@@ -153,6 +153,14 @@ struct st_texture_object
     */
    struct st_sampler_views *sampler_views_old;
 
+   /* Hint pointing at the most recently looked-up sampler view entry, so
+    * that repeated lookups from the same context skip the scan over the
+    * entries of other contexts.  May be stale: it is re-validated against
+    * the calling context on every use, which is safe because view
+    * containers are kept alive until the texture object is deleted.
+    */
+   struct st_sampler_view *sampler_view_hint;
+
    /* True if this texture comes from the window system. Such a texture
     * cannot be reallocated and the format can only be changed with a sampler
     * view or a surface.
@@ -832,6 +832,9 @@ _swrast_DestroyContext( struct gl_context *ctx )
    free(swrast->stencil_temp.buf3);
    free(swrast->stencil_temp.buf4);
 
+   if (swrast->DrawPixQueueChecked && swrast->DrawPixNumThreads > 1)
+      util_queue_destroy(&swrast->DrawPixQueue);
+
    free( swrast );
 
    ctx->swrast_context = 0;
@@ -46,6 +46,7 @@
 #include "main/mtypes.h"
 #include "main/texcompress.h"
 #include "program/prog_execute.h"
+#include "util/u_queue.h"
 #include "swrast.h"
 #include "s_fragprog.h"
 #include "s_span.h"
@@ -330,6 +331,13 @@ typedef struct
       GLubyte *buf1, *buf2, *buf3, *buf4;
    } stencil_temp;
 
+   /** Worker pool for the tiled glDrawPixels/glCopyPixels fast paths,
+    * created on first use.
+    */
+   struct util_queue DrawPixQueue;
+   GLuint DrawPixNumThreads;
+   GLboolean DrawPixQueueChecked;
+
 } SWcontext;
 
 
@@ -33,6 +33,7 @@
 
 #include "s_context.h"
 #include "s_depth.h"
+#include "s_drawpix.h"
 #include "s_span.h"
 #include "s_stencil.h"
 #include "s_zoom.h"
@@ -547,11 +548,27 @@ swrast_fast_copy_pixels(struct gl_context *ctx,
       }
    }
 
-   for (row = 0; row < height; row++) {
-      /* memmove() in case of overlap */
-      memmove(dstMap, srcMap, widthInBytes);
-      dstMap += dstRowStride;
-      srcMap += srcRowStride;
+   if (srcRb != dstRb) {
+      /* rows can't overlap, so large copies may go to the worker pool */
+      struct swrast_pixel_tile tile;
+
+      tile.op = SWRAST_TILE_MEMCPY;
+      tile.src = srcMap;
+      tile.srcRowStride = srcRowStride;
+      tile.dst = dstMap;
+      tile.dstRowStride = dstRowStride;
+      tile.width = width;
+      tile.height = height;
+      tile.rowLength = widthInBytes;
+      _swrast_run_pixel_tiles(ctx, &tile);
+   }
+   else {
+      for (row = 0; row < height; row++) {
+         /* memmove() in case of overlap */
+         memmove(dstMap, srcMap, widthInBytes);
+         dstMap += dstRowStride;
+         srcMap += srcRowStride;
+      }
    }
 
    ctx->Driver.UnmapRenderbuffer(ctx, srcRb);
@@ -38,13 +38,127 @@
 #include "main/pbo.h"
 #include "main/pixeltransfer.h"
 #include "main/state.h"
+#include "util/u_cpu_detect.h"
+#include "util/u_debug.h"
 
 #include "s_context.h"
+#include "s_drawpix.h"
 #include "s_span.h"
 #include "s_stencil.h"
 #include "s_zoom.h"
 
 
+/** Maximum worker threads for the tiled fast paths */
+#define MAX_DRAWPIX_THREADS 16
+
+/** Don't bother splitting images with fewer rows per tile than this */
+#define MIN_ROWS_PER_TILE 64
+
+
+static void
+run_pixel_tile(void *data, int thread_index)
+{
+   const struct swrast_pixel_tile *tile = data;
+   const GLubyte *src = tile->src;
+   GLubyte *dst = tile->dst;
+   GLint i, j;
+
+   switch (tile->op) {
+   case SWRAST_TILE_RGB_UBYTE_TO_8888:
+      for (i = 0; i < tile->height; i++) {
+         GLuint *dst4 = (GLuint *) dst;
+         for (j = 0; j < tile->width; j++) {
+            dst4[j] = PACK_COLOR_8888(0xff, src[j*3+0], src[j*3+1],
+                                      src[j*3+2]);
+         }
+         dst += tile->dstRowStride;
+         src += tile->srcRowStride;
+      }
+      break;
+   case SWRAST_TILE_RGBA_UBYTE_TO_8888:
+      for (i = 0; i < tile->height; i++) {
+         GLuint *dst4 = (GLuint *) dst;
+         for (j = 0; j < tile->width; j++) {
+            dst4[j] = PACK_COLOR_8888(src[j*4+3], src[j*4+0],
+                                      src[j*4+1], src[j*4+2]);
+         }
+         dst += tile->dstRowStride;
+         src += tile->srcRowStride;
+      }
+      break;
+   case SWRAST_TILE_MEMCPY:
+      for (i = 0; i < tile->height; i++) {
+         memcpy(dst, src, tile->rowLength);
+         dst += tile->dstRowStride;
+         src += tile->srcRowStride;
+      }
+      break;
+   }
+}
+
+
+/**
+ * Run one of the simple per-row operations over an image, splitting it
+ * into horizontal tiles across the worker pool when it is big enough to
+ * be worth it.  The pool is created on first use;
+ * SWRAST_DRAWPIX_THREADS overrides the thread count (1 disables).
+ */
+void
+_swrast_run_pixel_tiles(struct gl_context *ctx,
+                        const struct swrast_pixel_tile *tile)
+{
+   SWcontext *swrast = SWRAST_CONTEXT(ctx);
+   struct swrast_pixel_tile tiles[MAX_DRAWPIX_THREADS];
+   struct util_queue_fence fences[MAX_DRAWPIX_THREADS];
+   GLuint num_tiles, rows_per_tile, remainder, first, i;
+
+   if (!swrast->DrawPixQueueChecked) {
+      GLint threads = debug_get_num_option("SWRAST_DRAWPIX_THREADS", -1);
+
+      if (threads < 0) {
+         util_cpu_detect();
+         threads = util_cpu_caps.nr_cpus;
+      }
+      threads = CLAMP(threads, 1, MAX_DRAWPIX_THREADS);
+
+      if (threads > 1 &&
+          !util_queue_init(&swrast->DrawPixQueue, "swrast_dp",
+                           MAX_DRAWPIX_THREADS, threads, 0))
+         threads = 1;
+
+      swrast->DrawPixNumThreads = threads;
+      swrast->DrawPixQueueChecked = GL_TRUE;
+   }
+
+   num_tiles = MIN2(swrast->DrawPixNumThreads,
+                    (GLuint) tile->height / MIN_ROWS_PER_TILE);
+   if (num_tiles <= 1) {
+      run_pixel_tile((void *) tile, 0);
+      return;
+   }
+
+   rows_per_tile = tile->height / num_tiles;
+   remainder = tile->height % num_tiles;
+   first = 0;
+   for (i = 0; i < num_tiles; i++) {
+      tiles[i] = *tile;
+      tiles[i].src = tile->src + (GLint) first * tile->srcRowStride;
+      tiles[i].dst = tile->dst + (GLint) first * tile->dstRowStride;
+      tiles[i].height = rows_per_tile + (i < remainder ? 1 : 0);
+      first += tiles[i].height;
+
+      util_queue_fence_init(&fences[i]);
+      util_queue_add_job(&swrast->DrawPixQueue, &tiles[i], &fences[i],
+                         run_pixel_tile, NULL);
+   }
+
+   for (i = 0; i < num_tiles; i++) {
+      util_queue_fence_wait(&fences[i]);
+      util_queue_fence_destroy(&fences[i]);
+   }
+}
+
+
 /**
  * Handle a common case of drawing GL_RGB/GL_UNSIGNED_BYTE into a
  * MESA_FORMAT_XRGB888 or MESA_FORMAT_ARGB888 renderbuffer.
@@ -63,7 +177,7 @@ fast_draw_rgb_ubyte_pixels(struct gl_context *ctx,
                             height, GL_RGB, GL_UNSIGNED_BYTE, 0, 0);
    const GLint srcRowStride = _mesa_image_row_stride(unpack, width,
                                                      GL_RGB, GL_UNSIGNED_BYTE);
-   GLint i, j;
+   struct swrast_pixel_tile tile;
    GLubyte *dst;
    GLint dstRowStride;
 
@@ -81,14 +195,15 @@ fast_draw_rgb_ubyte_pixels(struct gl_context *ctx,
       dstRowStride = -dstRowStride;
    }
 
-   for (i = 0; i < height; i++) {
-      GLuint *dst4 = (GLuint *) dst;
-      for (j = 0; j < width; j++) {
-         dst4[j] = PACK_COLOR_8888(0xff, src[j*3+0], src[j*3+1], src[j*3+2]);
-      }
-      dst += dstRowStride;
-      src += srcRowStride;
-   }
+   tile.op = SWRAST_TILE_RGB_UBYTE_TO_8888;
+   tile.src = src;
+   tile.srcRowStride = srcRowStride;
+   tile.dst = dst;
+   tile.dstRowStride = dstRowStride;
+   tile.width = width;
+   tile.height = height;
+   tile.rowLength = 0;
+   _swrast_run_pixel_tiles(ctx, &tile);
 
    ctx->Driver.UnmapRenderbuffer(ctx, rb);
 }
@@ -112,7 +227,7 @@ fast_draw_rgba_ubyte_pixels(struct gl_context *ctx,
                             height, GL_RGBA, GL_UNSIGNED_BYTE, 0, 0);
    const GLint srcRowStride =
       _mesa_image_row_stride(unpack, width, GL_RGBA, GL_UNSIGNED_BYTE);
-   GLint i, j;
+   struct swrast_pixel_tile tile;
    GLubyte *dst;
    GLint dstRowStride;
 
@@ -130,15 +245,15 @@ fast_draw_rgba_ubyte_pixels(struct gl_context *ctx,
       dstRowStride = -dstRowStride;
    }
 
-   for (i = 0; i < height; i++) {
-      GLuint *dst4 = (GLuint *) dst;
-      for (j = 0; j < width; j++) {
-         dst4[j] = PACK_COLOR_8888(src[j*4+3], src[j*4+0],
-                                   src[j*4+1], src[j*4+2]);
-      }
-      dst += dstRowStride;
-      src += srcRowStride;
-   }
+   tile.op = SWRAST_TILE_RGBA_UBYTE_TO_8888;
+   tile.src = src;
+   tile.srcRowStride = srcRowStride;
+   tile.dst = dst;
+   tile.dstRowStride = dstRowStride;
+   tile.width = width;
+   tile.height = height;
+   tile.rowLength = 0;
+   _swrast_run_pixel_tiles(ctx, &tile);
 
    ctx->Driver.UnmapRenderbuffer(ctx, rb);
 }
@@ -164,7 +279,7 @@ fast_draw_generic_pixels(struct gl_context *ctx,
    const GLint srcRowStride =
       _mesa_image_row_stride(unpack, width, format, type);
    const GLint rowLength = width * _mesa_get_format_bytes(rb->Format);
-   GLint i;
+   struct swrast_pixel_tile tile;
    GLubyte *dst;
    GLint dstRowStride;
 
@@ -182,11 +297,15 @@ fast_draw_generic_pixels(struct gl_context *ctx,
       dstRowStride = -dstRowStride;
    }
 
-   for (i = 0; i < height; i++) {
-      memcpy(dst, src, rowLength);
-      dst += dstRowStride;
-      src += srcRowStride;
-   }
+   tile.op = SWRAST_TILE_MEMCPY;
+   tile.src = src;
+   tile.srcRowStride = srcRowStride;
+   tile.dst = dst;
+   tile.dstRowStride = dstRowStride;
+   tile.width = width;
+   tile.height = height;
+   tile.rowLength = rowLength;
+   _swrast_run_pixel_tiles(ctx, &tile);
 
    ctx->Driver.UnmapRenderbuffer(ctx, rb);
 }
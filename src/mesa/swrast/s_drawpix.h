@@ -0,0 +1,64 @@
+/*
+ * Mesa 3-D graphics library
+ *
+ * Copyright (C) 1999-2007  Brian Paul   All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef S_DRAWPIX_H
+#define S_DRAWPIX_H
+
+
+#include "main/glheader.h"
+
+struct gl_context;
+
+
+/** Per-row operation for _swrast_run_pixel_tiles() */
+enum swrast_pixel_tile_op {
+   SWRAST_TILE_RGB_UBYTE_TO_8888,  /**< GL_RGB/ubyte -> x8r8g8b8 */
+   SWRAST_TILE_RGBA_UBYTE_TO_8888, /**< GL_RGBA/ubyte -> a8r8g8b8 */
+   SWRAST_TILE_MEMCPY              /**< same layout, straight row copy */
+};
+
+
+/**
+ * A rectangle of rows to process with one of the simple per-row
+ * operations above.  Large images are split into horizontal tiles and
+ * run on a worker pool; src and dst must not overlap.
+ */
+struct swrast_pixel_tile {
+   enum swrast_pixel_tile_op op;
+   const GLubyte *src;
+   GLint srcRowStride;
+   GLubyte *dst;
+   GLint dstRowStride;
+   GLsizei width;       /**< pixels per row */
+   GLsizei height;      /**< number of rows */
+   GLuint rowLength;    /**< bytes per row, for SWRAST_TILE_MEMCPY */
+};
+
+
+extern void
+_swrast_run_pixel_tiles(struct gl_context *ctx,
+                        const struct swrast_pixel_tile *tile);
+
+#endif
@@ -1492,6 +1492,76 @@ opt_sample_rgba_2d(struct gl_context *ctx,
 }
 
 
+/**
+ * Optimized 2-D texture sampling:
+ *    S and T wrap mode == GL_REPEAT
+ *    GL_LINEAR min/mag filter
+ *    No border
+ *    RowStride == Width,
+ *    Format = GL_RGBA
+ *
+ * Filters the whole span with fixed-point weights on the raw texels
+ * instead of four FetchTexel calls and float lerps per fragment.
+ */
+static void
+opt_sample_rgba_2d_linear(struct gl_context *ctx,
+                          const struct gl_sampler_object *samp,
+                          const struct gl_texture_object *tObj,
+                          GLuint n, const GLfloat texcoords[][4],
+                          const GLfloat lambda[], GLfloat rgba[][4])
+{
+   const struct gl_texture_image *img = _mesa_base_tex_image(tObj);
+   const struct swrast_texture_image *swImg = swrast_texture_image_const(img);
+   const GLfloat width = (GLfloat) img->Width;
+   const GLfloat height = (GLfloat) img->Height;
+   const GLint colMask = img->Width - 1;
+   const GLint rowMask = img->Height - 1;
+   const GLint shift = img->WidthLog2;
+   const GLuint *data = (const GLuint *) swImg->ImageSlices[0];
+   GLuint i;
+   (void) ctx;
+   (void) lambda;
+   assert(samp->WrapS==GL_REPEAT);
+   assert(samp->WrapT==GL_REPEAT);
+   assert(img->Border==0);
+   assert(img->TexFormat == MESA_FORMAT_A8B8G8R8_UNORM);
+   assert(swImg->_IsPowerOfTwo);
+
+   for (i = 0; i < n; i++) {
+      const GLfloat u = texcoords[i][0] * width - 0.5F;
+      const GLfloat v = texcoords[i][1] * height - 0.5F;
+      const GLint i0 = IFLOOR(u);
+      const GLint j0 = IFLOOR(v);
+      /* 8-bit fixed-point filter weights */
+      const GLint wi = (GLint) ((u - (GLfloat) i0) * 256.0F);
+      const GLint wj = (GLint) ((v - (GLfloat) j0) * 256.0F);
+      const GLint w00 = (256 - wi) * (256 - wj);
+      const GLint w10 = wi * (256 - wj);
+      const GLint w01 = (256 - wi) * wj;
+      const GLint w11 = wi * wj;
+      const GLint col0 = i0 & colMask;
+      const GLint col1 = (i0 + 1) & colMask;
+      const GLint row0 = (j0 & rowMask) << shift;
+      const GLint row1 = ((j0 + 1) & rowMask) << shift;
+      const GLuint t00 = data[row0 | col0];
+      const GLuint t10 = data[row0 | col1];
+      const GLuint t01 = data[row1 | col0];
+      const GLuint t11 = data[row1 | col1];
+      GLuint comp;
+
+      /* RCOMP..ACOMP are the texel's bytes from high to low */
+      for (comp = 0; comp < 4; comp++) {
+         const GLint sh = 24 - comp * 8;
+         const GLuint c = (w00 * ((t00 >> sh) & 0xff) +
+                           w10 * ((t10 >> sh) & 0xff) +
+                           w01 * ((t01 >> sh) & 0xff) +
+                           w11 * ((t11 >> sh) & 0xff)) >> 16;
+         rgba[i][comp] = UBYTE_TO_FLOAT(c);
+      }
+   }
+}
+
+
 /** Sample 2D texture, using lambda to choose between min/magnification */
 static void
 sample_lambda_2d(struct gl_context *ctx,
@@ -1542,8 +1612,13 @@ sample_lambda_2d(struct gl_context *ctx,
          }
          break;
       case GL_LINEAR:
-	 sample_linear_2d(ctx, samp, tObj, m, texcoords + minStart,
-			  NULL, rgba + minStart);
+         if (repeatNoBorderPOT &&
+             tImg->TexFormat == MESA_FORMAT_A8B8G8R8_UNORM)
+            opt_sample_rgba_2d_linear(ctx, samp, tObj, m, texcoords + minStart,
+                                      NULL, rgba + minStart);
+         else
+            sample_linear_2d(ctx, samp, tObj, m, texcoords + minStart,
+                             NULL, rgba + minStart);
          break;
       case GL_NEAREST_MIPMAP_NEAREST:
          sample_2d_nearest_mipmap_nearest(ctx, samp, tObj, m,
@@ -1599,8 +1674,13 @@ sample_lambda_2d(struct gl_context *ctx,
          }
          break;
       case GL_LINEAR:
-	 sample_linear_2d(ctx, samp, tObj, m, texcoords + magStart,
-			  NULL, rgba + magStart);
+         if (repeatNoBorderPOT &&
+             tImg->TexFormat == MESA_FORMAT_A8B8G8R8_UNORM)
+            opt_sample_rgba_2d_linear(ctx, samp, tObj, m, texcoords + magStart,
+                                      NULL, rgba + magStart);
+         else
+            sample_linear_2d(ctx, samp, tObj, m, texcoords + magStart,
+                             NULL, rgba + magStart);
          break;
       default:
          _mesa_problem(ctx, "Bad mag filter in sample_lambda_2d");
@@ -3747,7 +3827,20 @@ _swrast_choose_texture_sample_func( struct gl_context *ctx,
             return sample_lambda_2d;
          }
          else if (sampler->MinFilter == GL_LINEAR) {
-            return sample_linear_2d;
+            /* check for the optimized bilinear case */
+            const struct gl_texture_image *img = _mesa_base_tex_image(t);
+            const struct swrast_texture_image *swImg =
+               swrast_texture_image_const(img);
+            texture_sample_func func = &sample_linear_2d;
+
+            if (sampler->WrapS == GL_REPEAT &&
+                sampler->WrapT == GL_REPEAT &&
+                swImg->_IsPowerOfTwo &&
+                img->Border == 0 &&
+                img->TexFormat == MESA_FORMAT_A8B8G8R8_UNORM)
+               func = &opt_sample_rgba_2d_linear;
+
+            return func;
          }
          else {
             /* check for a few optimized cases */
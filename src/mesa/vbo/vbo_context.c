@@ -153,8 +153,9 @@ vbo_exec_invalidate_state(struct gl_context *ctx)
    struct vbo_context *vbo = vbo_context(ctx);
    struct vbo_exec_context *exec = &vbo->exec;
 
-   if (ctx->NewState & _NEW_EVAL)
-      exec->eval.recalculate_maps = GL_TRUE;
+   /* Only called when _NEW_EVAL is set; see _mesa_update_state_locked(). */
+   assert(ctx->NewState & _NEW_EVAL);
+   exec->eval.recalculate_maps = GL_TRUE;
 }
 
 
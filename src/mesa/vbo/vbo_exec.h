@@ -48,8 +48,12 @@ USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 /**
  * Size (in bytes) of the VBO to use for glBegin/glVertex/glEnd-style rendering.
+ * Vertices are written into the (unsynchronized-mapped) buffer exactly once,
+ * so the size mainly determines how often we pay for a buffer reallocation,
+ * remap and draw split; apps that push millions of immediate mode vertices
+ * per frame wrap a small buffer hundreds of times per frame.
  */
-#define VBO_VERT_BUFFER_SIZE (1024 * 64)
+#define VBO_VERT_BUFFER_SIZE (1024 * 512)
 
 
 struct vbo_exec_eval1_map {
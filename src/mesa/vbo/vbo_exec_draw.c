@@ -27,6 +27,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include "main/arrayobj.h"
 #include "main/glheader.h"
 #include "main/bufferobj.h"
@@ -167,6 +168,183 @@ vbo_copy_vertices(struct vbo_exec_context *exec)
 
 
 
+/**
+ * Index patterns for decomposing the legacy quad primitives into
+ * GL_TRIANGLES.  The triangles are rotated so that the default
+ * GL_LAST_VERTEX_CONVENTION provoking vertex of each decomposed
+ * primitive (the last vertex of a quad, the first vertex of a polygon)
+ * stays in provoking position and the original winding is preserved,
+ * so flat shading and face culling are unaffected.  With
+ * GL_EXT_provoking_vertex's first-vertex convention these rotations
+ * provoke the wrong vertices, so the decomposition backs off then.
+ */
+static const GLubyte quad_indices[6] = { 0, 1, 3, 1, 2, 3 };
+static const GLubyte quad_strip_indices[6] = { 0, 1, 3, 2, 0, 3 };
+
+
+static GLboolean
+vbo_exec_prim_decomposes(GLenum mode)
+{
+   return mode == GL_QUADS || mode == GL_QUAD_STRIP || mode == GL_POLYGON;
+}
+
+
+/**
+ * Number of triangles a decomposable primitive expands to.  Trailing
+ * vertices which do not complete a quad (or a triangle for GL_POLYGON)
+ * draw nothing, matching the non-indexed rendering of the primitive.
+ */
+static GLuint
+vbo_exec_tri_count(const struct _mesa_prim *prim)
+{
+   switch (prim->mode) {
+   case GL_QUADS:
+      return prim->count / 4 * 2;
+   case GL_QUAD_STRIP:
+      return prim->count >= 4 ? (prim->count - 2) / 2 * 2 : 0;
+   case GL_POLYGON:
+      return prim->count >= 3 ? prim->count - 2 : 0;
+   default:
+      unreachable("Unexpected primitive type");
+      return 0;
+   }
+}
+
+
+/**
+ * Whether quads, quad strips and polygons in the vertex store can be
+ * drawn as indexed GL_TRIANGLES without a visible difference.  Unfilled
+ * polygon modes and edge flags depend on the original primitive
+ * boundaries, feedback mode reports primitive types back to the
+ * application, and the index patterns above assume the default
+ * last-vertex provoking convention.
+ */
+static GLboolean
+vbo_exec_can_decompose_quads(const struct gl_context *ctx,
+                             const struct vbo_exec_context *exec)
+{
+   return ctx->RenderMode == GL_RENDER &&
+          ctx->Polygon.FrontMode == GL_FILL &&
+          ctx->Polygon.BackMode == GL_FILL &&
+          ctx->Light.ProvokingVertex == GL_LAST_VERTEX_CONVENTION_EXT &&
+          !(exec->vtx.enabled & BITFIELD64_BIT(VBO_ATTRIB_EDGEFLAG));
+}
+
+
+/**
+ * Draw the accumulated primitives as one indexed draw, decomposing
+ * quads, quad strips and polygons into GL_TRIANGLES with the
+ * table-driven patterns above.  Primitives of other types keep their
+ * mode and get identity indices, so mixed begin/end sequences still go
+ * out in a single draw call.
+ * \return GL_TRUE if the draw was issued, GL_FALSE to use the
+ *         non-indexed path.
+ */
+static GLboolean
+vbo_exec_draw_decomposed(struct vbo_exec_context *exec)
+{
+   struct gl_context *ctx = exec->ctx;
+   struct _mesa_prim prims[VBO_MAX_PRIM];
+   struct _mesa_index_buffer ib;
+   GLuint num_indices = 0, num_tris = 0, nr_prims = 0;
+   GLuint *indices;
+   GLuint i, j, k;
+
+   if (!vbo_exec_can_decompose_quads(ctx, exec))
+      return GL_FALSE;
+
+   for (i = 0; i < exec->vtx.prim_count; i++) {
+      const struct _mesa_prim *prim = &exec->vtx.prim[i];
+
+      if (vbo_exec_prim_decomposes(prim->mode)) {
+         const GLuint tris = vbo_exec_tri_count(prim);
+         num_tris += tris;
+         num_indices += tris * 3;
+      } else {
+         num_indices += prim->count;
+      }
+   }
+
+   if (!num_tris)
+      return GL_FALSE;
+
+   indices = malloc(num_indices * sizeof(*indices));
+   if (!indices)
+      return GL_FALSE;
+
+   num_indices = 0;
+   for (i = 0; i < exec->vtx.prim_count; i++) {
+      const struct _mesa_prim *prim = &exec->vtx.prim[i];
+      const GLuint start = prim->start;
+      GLuint *out = indices + num_indices;
+      GLuint count = 0;
+
+      if (vbo_exec_prim_decomposes(prim->mode)) {
+         switch (prim->mode) {
+         case GL_QUADS:
+            for (j = 0; j + 4 <= prim->count; j += 4) {
+               for (k = 0; k < 6; k++)
+                  out[count++] = start + j + quad_indices[k];
+            }
+            break;
+         case GL_QUAD_STRIP:
+            for (j = 0; j + 4 <= prim->count; j += 2) {
+               for (k = 0; k < 6; k++)
+                  out[count++] = start + j + quad_strip_indices[k];
+            }
+            break;
+         case GL_POLYGON:
+            /* A fan, rotated so that the first vertex, which provides
+             * the flatshaded color of a polygon, stays provoking.
+             */
+            for (j = 2; j < prim->count; j++) {
+               out[count++] = start + j - 1;
+               out[count++] = start + j;
+               out[count++] = start;
+            }
+            break;
+         }
+
+         if (!count)
+            continue;   /* incomplete primitive, draws nothing */
+
+         prims[nr_prims] = *prim;
+         prims[nr_prims].mode = GL_TRIANGLES;
+      } else {
+         for (j = 0; j < prim->count; j++)
+            out[count++] = start + j;
+
+         if (!count)
+            continue;
+
+         prims[nr_prims] = *prim;
+      }
+
+      prims[nr_prims].indexed = 1;
+      prims[nr_prims].start = num_indices;
+      prims[nr_prims].count = count;
+      num_indices += count;
+      nr_prims++;
+   }
+
+   if (!nr_prims) {
+      free(indices);
+      return GL_FALSE;
+   }
+
+   ib.count = num_indices;
+   ib.index_size = sizeof(GLuint);
+   ib.obj = ctx->Shared->NullBufferObj;
+   ib.ptr = indices;
+
+   ctx->Driver.Draw(ctx, prims, nr_prims, &ib, GL_TRUE,
+                    0, exec->vtx.vert_count - 1, NULL, 0, NULL);
+
+   free(indices);
+   return GL_TRUE;
+}
+
+
 /* TODO: populate these as the vertex is defined:
  */
 static void
@@ -383,9 +561,11 @@ vbo_exec_vtx_flush(struct vbo_exec_context *exec, GLboolean keepUnmapped)
             printf("%s %d %d\n", __func__, exec->vtx.prim_count,
                    exec->vtx.vert_count);
 
-         ctx->Driver.Draw(ctx, exec->vtx.prim, exec->vtx.prim_count,
-                          NULL, GL_TRUE, 0, exec->vtx.vert_count - 1,
-                          NULL, 0, NULL);
+         if (!vbo_exec_draw_decomposed(exec)) {
+            ctx->Driver.Draw(ctx, exec->vtx.prim, exec->vtx.prim_count,
+                             NULL, GL_TRUE, 0, exec->vtx.vert_count - 1,
+                             NULL, 0, NULL);
+         }
 
          /* Get new storage -- unless asked not to. */
          if (!keepUnmapped)
@@ -725,6 +725,33 @@ write_all(int fd, const void *buf, size_t count)
  */
 #define BUFSIZE 256 * 1024
 
+/* Preset dictionary for the zlib streams.  Deflate can only refer back to
+ * data inside its 32KB window, so byte patterns that a cache entry opens
+ * with are normally spelled out in full once; seeding the window with the
+ * patterns that serialized NIR and shader binaries typically start with
+ * shaves a few percent off small entries, which are the majority.
+ *
+ * Hand-assembled from common serialization patterns; zlib prefers matches
+ * near the end of the dictionary, so entries are ordered least to most
+ * common.  Old cache entries remain readable because streams written
+ * without the dictionary never request one.
+ */
+static const char cache_entry_dictionary[] =
+   /* identifiers kept in shader metadata */
+   "gl_PerVertexgl_FragCoordgl_FragDatagl_Positionmain"
+   /* float constants as little-endian IEEE bit patterns */
+   "\x00\x00\x80\xbf"             /* -1.0f */
+   "\x00\x00\x00\x3f"             /*  0.5f */
+   "\x00\x00\x80\x3f"             /*  1.0f */
+   /* small little-endian dwords, the bulk of serialized headers */
+   "\x20\x00\x00\x00" "\x10\x00\x00\x00" "\x08\x00\x00\x00"
+   "\x04\x00\x00\x00" "\x03\x00\x00\x00" "\x02\x00\x00\x00"
+   "\x01\x00\x00\x00"
+   /* all-ones dwords and zero runs last: most common by far */
+   "\xff\xff\xff\xff\xff\xff\xff\xff"
+   "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+   "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00";
+
 /**
  * Compresses cache entry in memory and writes it to disk. Returns the size
  * of the data written to disk.
@@ -747,6 +774,11 @@ deflate_and_write_to_disk(const void *in_data, size_t in_data_size, int dest,
    if (ret != Z_OK)
        return 0;
 
+   /* Failure to set the dictionary only costs compression ratio. */
+   (void)deflateSetDictionary(&strm,
+                              (const Bytef *) cache_entry_dictionary,
+                              sizeof(cache_entry_dictionary));
+
    /* compress until end of in_data */
    size_t compressed_size = 0;
    int flush;
@@ -1060,6 +1092,17 @@ inflate_cache_data(uint8_t *in_data, size_t in_data_size,
       return false;
 
    ret = inflate(&strm, Z_NO_FLUSH);
+   if (ret == Z_NEED_DICT) {
+      ret = inflateSetDictionary(&strm,
+                                 (const Bytef *) cache_entry_dictionary,
+                                 sizeof(cache_entry_dictionary));
+      if (ret != Z_OK) {
+         (void)inflateEnd(&strm);
+         return false;
+      }
+
+      ret = inflate(&strm, Z_NO_FLUSH);
+   }
    assert(ret != Z_STREAM_ERROR);  /* state not clobbered */
 
    /* Unless there was an error we should have decompressed everything in one
@@ -1084,7 +1127,6 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
    char *filename = NULL;
    uint8_t *data = NULL;
    uint8_t *uncompressed_data = NULL;
-   uint8_t *file_header = NULL;
 
    if (size)
       *size = 0;
@@ -1122,40 +1164,44 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
    if (fstat(fd, &sb) == -1)
       goto fail;
 
+   /* Slurp the whole entry with a single read and parse it from memory.
+    * Multi-process deployments that warm the same cache are syscall bound
+    * here, and the entry layout is just a few small headers in front of the
+    * compressed payload.
+    */
    data = malloc(sb.st_size);
    if (data == NULL)
       goto fail;
 
-   size_t ck_size = cache->driver_keys_blob_size;
-   file_header = malloc(ck_size);
-   if (!file_header)
+   ret = read_all(fd, data, sb.st_size);
+   if (ret == -1)
       goto fail;
 
-   if (sb.st_size < ck_size)
-      goto fail;
+   const uint8_t *p = data;
+   const uint8_t *end = data + sb.st_size;
 
-   ret = read_all(fd, file_header, ck_size);
-   if (ret == -1)
+   size_t ck_size = cache->driver_keys_blob_size;
+   if ((size_t)(end - p) < ck_size)
       goto fail;
 
    /* Check for extremely unlikely hash collisions */
-   if (memcmp(cache->driver_keys_blob, file_header, ck_size) != 0) {
+   if (memcmp(cache->driver_keys_blob, p, ck_size) != 0) {
       assert(!"Mesa cache keys mismatch!");
       goto fail;
    }
+   p += ck_size;
 
-   size_t cache_item_md_size = sizeof(uint32_t);
    uint32_t md_type;
-   ret = read_all(fd, &md_type, cache_item_md_size);
-   if (ret == -1)
+   if ((size_t)(end - p) < sizeof(md_type))
       goto fail;
+   memcpy(&md_type, p, sizeof(md_type));
+   p += sizeof(md_type);
 
    if (md_type == CACHE_ITEM_TYPE_GLSL) {
       uint32_t num_keys;
-      cache_item_md_size += sizeof(uint32_t);
-      ret = read_all(fd, &num_keys, sizeof(uint32_t));
-      if (ret == -1)
+      if ((size_t)(end - p) < sizeof(num_keys))
          goto fail;
+      memcpy(&num_keys, p, sizeof(num_keys));
 
       /* The cache item metadata is currently just used for distributing
        * precompiled shaders, they are not used by Mesa so just skip them for
@@ -1163,29 +1209,25 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
        * TODO: pass the metadata back to the caller and do some basic
        * validation.
        */
-      cache_item_md_size += num_keys * sizeof(cache_key);
-      ret = lseek(fd, num_keys * sizeof(cache_key), SEEK_CUR);
-      if (ret == -1)
+      p += sizeof(num_keys);
+      if ((size_t)(end - p) < num_keys * sizeof(cache_key))
          goto fail;
+      p += num_keys * sizeof(cache_key);
    }
 
    /* Load the CRC that was created when the file was written. */
    struct cache_entry_file_data cf_data;
-   size_t cf_data_size = sizeof(cf_data);
-   ret = read_all(fd, &cf_data, cf_data_size);
-   if (ret == -1)
+   if ((size_t)(end - p) < sizeof(cf_data))
       goto fail;
+   memcpy(&cf_data, p, sizeof(cf_data));
+   p += sizeof(cf_data);
 
-   /* Load the actual cache data. */
-   size_t cache_data_size =
-      sb.st_size - cf_data_size - ck_size - cache_item_md_size;
-   ret = read_all(fd, data, cache_data_size);
-   if (ret == -1)
-      goto fail;
+   /* What's left is the actual cache data. */
+   size_t cache_data_size = end - p;
 
    /* Uncompress the cache data */
    uncompressed_data = malloc(cf_data.uncompressed_size);
-   if (!inflate_cache_data(data, cache_data_size, uncompressed_data,
+   if (!inflate_cache_data((uint8_t *) p, cache_data_size, uncompressed_data,
                            cf_data.uncompressed_size))
       goto fail;
 
@@ -1196,7 +1238,6 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
 
    free(data);
    free(filename);
-   free(file_header);
    close(fd);
 
    if (size)
@@ -1211,8 +1252,6 @@ disk_cache_get(struct disk_cache *cache, const cache_key key, size_t *size)
       free(uncompressed_data);
    if (filename)
       free(filename);
-   if (file_header)
-      free(file_header);
    if (fd != -1)
       close(fd);
 
@@ -29,6 +29,12 @@
 #include "half_float.h"
 #include "rounding.h"
 #include "macros.h"
+#include "u_cpu_detect.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define USE_F16C
+#include <immintrin.h>
+#endif
 
 typedef union { float f; int32_t i; uint32_t u; } fi_type;
 
@@ -179,6 +185,85 @@ _mesa_half_to_float(uint16_t val)
    return result;
 }
 
+#ifdef USE_F16C
+
+/* These kernels use VCVTPS2PH/VCVTPH2PS, which round to nearest-even and
+ * handle fp16 subnormals in hardware, matching the scalar paths above (the
+ * only difference is that hardware preserves NaN payloads).  They are
+ * compiled with a target attribute instead of a global -mf16c so that the
+ * file stays runnable on any CPU; util_cpu_caps gates their use below.
+ */
+
+static void
+__attribute__((target("avx,f16c")))
+float_to_half_array_f16c(uint16_t *dst, const float *src, unsigned count)
+{
+   unsigned i = 0;
+
+   for (; i + 8 <= count; i += 8) {
+      __m256 f = _mm256_loadu_ps(src + i);
+      __m128i h = _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT |
+                                     _MM_FROUND_NO_EXC);
+      _mm_storeu_si128((__m128i *)(dst + i), h);
+   }
+
+   for (; i < count; i++)
+      dst[i] = _mesa_float_to_half(src[i]);
+}
+
+static void
+__attribute__((target("avx,f16c")))
+half_to_float_array_f16c(float *dst, const uint16_t *src, unsigned count)
+{
+   unsigned i = 0;
+
+   for (; i + 8 <= count; i += 8) {
+      __m128i h = _mm_loadu_si128((const __m128i *)(src + i));
+      _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+   }
+
+   for (; i < count; i++)
+      dst[i] = _mesa_half_to_float(src[i]);
+}
+
+#endif /* USE_F16C */
+
+/**
+ * Convert an array of floats to half floats.
+ */
+void
+_mesa_float_to_half_array(uint16_t *dst, const float *src, unsigned count)
+{
+#ifdef USE_F16C
+   util_cpu_detect();
+   if (util_cpu_caps.has_avx && util_cpu_caps.has_f16c) {
+      float_to_half_array_f16c(dst, src, count);
+      return;
+   }
+#endif
+
+   for (unsigned i = 0; i < count; i++)
+      dst[i] = _mesa_float_to_half(src[i]);
+}
+
+/**
+ * Convert an array of half floats to floats.
+ */
+void
+_mesa_half_to_float_array(float *dst, const uint16_t *src, unsigned count)
+{
+#ifdef USE_F16C
+   util_cpu_detect();
+   if (util_cpu_caps.has_avx && util_cpu_caps.has_f16c) {
+      half_to_float_array_f16c(dst, src, count);
+      return;
+   }
+#endif
+
+   for (unsigned i = 0; i < count; i++)
+      dst[i] = _mesa_half_to_float(src[i]);
+}
+
 /**
   * Convert 0.0 to 0x00, 1.0 to 0xff.
   * Values outside the range [0.0, 1.0] will give undefined results.
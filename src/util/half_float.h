@@ -37,6 +37,10 @@ extern "C" {
 
 uint16_t _mesa_float_to_half(float val);
 float _mesa_half_to_float(uint16_t val);
+void _mesa_float_to_half_array(uint16_t *dst, const float *src,
+                               unsigned count);
+void _mesa_half_to_float_array(float *dst, const uint16_t *src,
+                               unsigned count);
 uint8_t _mesa_half_to_unorm8(uint16_t v);
 uint16_t _mesa_uint16_div_64k_to_half(uint16_t v);
 
@@ -49,6 +49,7 @@
 #include "macros.h"
 #include "main/hash.h"
 #include "fast_urem_by_const.h"
+#include "xxh32.h"
 
 static const uint32_t deleted_key_value;
 
@@ -141,6 +142,7 @@ _mesa_hash_table_init(struct hash_table *ht,
    ht->entries = 0;
    ht->deleted_entries = 0;
    ht->deleted_key = &deleted_key_value;
+   ht->deferred_reclaim = false;
 
    return ht->table != NULL;
 }
@@ -253,6 +255,25 @@ _mesa_hash_table_set_deleted_key(struct hash_table *ht, const void *deleted_key)
    ht->deleted_key = deleted_key;
 }
 
+/** Makes the table keep old entry arrays alive on rehash instead of freeing
+ * them.
+ *
+ * This is meant for callers that probe the table without taking its owner's
+ * lock (see _mesa_HashLookup): a reader racing against a rehash may still be
+ * walking the old array, so that memory must not be returned to the
+ * allocator until the table itself is destroyed.  Since the array sizes grow
+ * roughly geometrically, the retired arrays cost less additional memory than
+ * one extra copy of the current array.
+ *
+ * Only valid for tables allocated with _mesa_hash_table_create(); there the
+ * entry arrays are ralloc children of the table and are freed with it.
+ */
+void
+_mesa_hash_table_set_deferred_reclaim(struct hash_table *ht)
+{
+   ht->deferred_reclaim = true;
+}
+
 static struct hash_entry *
 hash_table_search(struct hash_table *ht, uint32_t hash, const void *key)
 {
@@ -365,7 +386,11 @@ _mesa_hash_table_rehash(struct hash_table *ht, unsigned new_size_index)
 
    ht->entries = old_ht.entries;
 
-   ralloc_free(old_ht.table);
+   /* With deferred reclaim, lockless readers may still be probing the old
+    * array; leave it parented to the table so it's freed on destroy.
+    */
+   if (!ht->deferred_reclaim)
+      ralloc_free(old_ht.table);
 }
 
 static struct hash_entry *
@@ -554,12 +579,15 @@ _mesa_hash_table_random_entry(struct hash_table *ht,
  * to be quite good, and it probably beats FNV.  But FNV has the advantage
  * that it involves almost no code.  For an improvement on both, see Paul
  * Hsieh's http://www.azillionmonkeys.com/qed/hash.html
+ *
+ * Block keying now goes through XXH32 instead, which processes a word per
+ * step rather than a byte; FNV-1a is kept for the incremental string and
+ * struct accumulators spread around the tree.
  */
 uint32_t
 _mesa_hash_data(const void *data, size_t size)
 {
-   return _mesa_fnv32_1a_accumulate_block(_mesa_fnv32_1a_offset_bias,
-                                          data, size);
+   return xxh32(data, size, 0);
 }
 
 /** FNV-1a string hash implementation */
@@ -604,32 +632,32 @@ _mesa_pointer_hash_table_create(void *mem_ctx)
 }
 
 /**
- * Hash table wrapper which supports 64-bit keys.
+ * Hash table with inline uint64_t keys.
+ *
+ * The generic table above stores key pointers in the entry array, so every
+ * probe that passes the cached-hash check chases a pointer and makes an
+ * indirect key_equals call.  64-bit keys fit in the entry itself, so these
+ * probes stay within the entry array and compare the key inline.
  *
- * TODO: unify all hash table implementations.
+ * Key 0 (FREED_KEY_VALUE) marks a free entry and key 1 (DELETED_KEY_VALUE)
+ * marks a tombstone; data stored under either of those two keys lives out
+ * of line in the table struct, as it did in the old wrapper.
  */
 
-struct hash_key_u64 {
-   uint64_t value;
-};
+#define FREED_KEY_VALUE 0
 
 static uint32_t
-key_u64_hash(const void *key)
+key_u64_hash(uint64_t key)
 {
-   return _mesa_hash_data(key, sizeof(struct hash_key_u64));
+   return _mesa_hash_data(&key, sizeof(key));
 }
 
-static bool
-key_u64_equals(const void *a, const void *b)
+static inline bool
+entry_u64_is_present(const struct hash_entry_u64 *entry)
 {
-   const struct hash_key_u64 *aa = a;
-   const struct hash_key_u64 *bb = b;
-
-   return aa->value == bb->value;
+   return entry->key != FREED_KEY_VALUE && entry->key != DELETED_KEY_VALUE;
 }
 
-#define FREED_KEY_VALUE 0
-
 struct hash_table_u64 *
 _mesa_hash_table_u64_create(void *mem_ctx)
 {
@@ -640,17 +668,19 @@ _mesa_hash_table_u64_create(void *mem_ctx)
    if (!ht)
       return NULL;
 
-   if (sizeof(void *) == 8) {
-      ht->table = _mesa_hash_table_create(mem_ctx, _mesa_hash_pointer,
-                                          _mesa_key_pointer_equal);
-   } else {
-      ht->table = _mesa_hash_table_create(mem_ctx, key_u64_hash,
-                                          key_u64_equals);
+   ht->mem_ctx = mem_ctx;
+   ht->size_index = 0;
+   ht->size = hash_sizes[ht->size_index].size;
+   ht->rehash = hash_sizes[ht->size_index].rehash;
+   ht->size_magic = hash_sizes[ht->size_index].size_magic;
+   ht->rehash_magic = hash_sizes[ht->size_index].rehash_magic;
+   ht->max_entries = hash_sizes[ht->size_index].max_entries;
+   ht->table = rzalloc_array(mem_ctx, struct hash_entry_u64, ht->size);
+   if (!ht->table) {
+      free(ht);
+      return NULL;
    }
 
-   if (ht->table)
-      _mesa_hash_table_set_deleted_key(ht->table, uint_key(DELETED_KEY_VALUE));
-
    return ht;
 }
 
@@ -663,12 +693,11 @@ _mesa_hash_table_u64_clear(struct hash_table_u64 *ht,
 
    if (ht->deleted_key_data) {
       if (delete_function) {
-         struct hash_table *table = ht->table;
          struct hash_entry entry;
 
          /* Create a fake entry for the delete function. */
-         entry.hash = table->key_hash_function(table->deleted_key);
-         entry.key = table->deleted_key;
+         entry.hash = key_u64_hash(DELETED_KEY_VALUE);
+         entry.key = uint_key(DELETED_KEY_VALUE);
          entry.data = ht->deleted_key_data;
 
          delete_function(&entry);
@@ -678,11 +707,10 @@ _mesa_hash_table_u64_clear(struct hash_table_u64 *ht,
 
    if (ht->freed_key_data) {
       if (delete_function) {
-         struct hash_table *table = ht->table;
          struct hash_entry entry;
 
          /* Create a fake entry for the delete function. */
-         entry.hash = table->key_hash_function(uint_key(FREED_KEY_VALUE));
+         entry.hash = key_u64_hash(FREED_KEY_VALUE);
          entry.key = uint_key(FREED_KEY_VALUE);
          entry.data = ht->freed_key_data;
 
@@ -691,7 +719,31 @@ _mesa_hash_table_u64_clear(struct hash_table_u64 *ht,
       ht->freed_key_data = NULL;
    }
 
-   _mesa_hash_table_clear(ht->table, delete_function);
+   for (struct hash_entry_u64 *e = ht->table; e != ht->table + ht->size; e++) {
+      if (!entry_u64_is_present(e)) {
+         e->key = FREED_KEY_VALUE;
+         continue;
+      }
+
+      if (delete_function) {
+         struct hash_entry entry;
+
+         /* Create a fake entry for the delete function.  The key is
+          * truncated to a pointer, but every caller in the tree only looks
+          * at the data.
+          */
+         entry.hash = key_u64_hash(e->key);
+         entry.key = (void *)(uintptr_t) e->key;
+         entry.data = e->data;
+
+         delete_function(&entry);
+      }
+
+      e->key = FREED_KEY_VALUE;
+   }
+
+   ht->entries = 0;
+   ht->deleted_entries = 0;
 }
 
 void
@@ -702,10 +754,72 @@ _mesa_hash_table_u64_destroy(struct hash_table_u64 *ht,
       return;
 
    _mesa_hash_table_u64_clear(ht, delete_function);
-   _mesa_hash_table_destroy(ht->table, delete_function);
+   ralloc_free(ht->table);
    free(ht);
 }
 
+static void
+hash_table_u64_insert_rehash(struct hash_table_u64 *ht, uint32_t hash,
+                             uint64_t key, void *data)
+{
+   uint32_t size = ht->size;
+   uint32_t start_hash_address = util_fast_urem32(hash, size, ht->size_magic);
+   uint32_t double_hash = 1 + util_fast_urem32(hash, ht->rehash,
+                                               ht->rehash_magic);
+   uint32_t hash_address = start_hash_address;
+   do {
+      struct hash_entry_u64 *entry = ht->table + hash_address;
+
+      if (likely(entry->key == FREED_KEY_VALUE)) {
+         entry->key = key;
+         entry->data = data;
+         return;
+      }
+
+      hash_address += double_hash;
+      if (hash_address >= size)
+         hash_address -= size;
+   } while (true);
+}
+
+static void
+hash_table_u64_rehash(struct hash_table_u64 *ht, unsigned new_size_index)
+{
+   struct hash_table_u64 old_ht;
+   struct hash_entry_u64 *table;
+
+   if (new_size_index >= ARRAY_SIZE(hash_sizes))
+      return;
+
+   table = rzalloc_array(ht->mem_ctx, struct hash_entry_u64,
+                         hash_sizes[new_size_index].size);
+   if (table == NULL)
+      return;
+
+   old_ht = *ht;
+
+   ht->table = table;
+   ht->size_index = new_size_index;
+   ht->size = hash_sizes[ht->size_index].size;
+   ht->rehash = hash_sizes[ht->size_index].rehash;
+   ht->size_magic = hash_sizes[ht->size_index].size_magic;
+   ht->rehash_magic = hash_sizes[ht->size_index].rehash_magic;
+   ht->max_entries = hash_sizes[ht->size_index].max_entries;
+   ht->entries = 0;
+   ht->deleted_entries = 0;
+
+   for (struct hash_entry_u64 *e = old_ht.table;
+        e != old_ht.table + old_ht.size; e++) {
+      if (entry_u64_is_present(e))
+         hash_table_u64_insert_rehash(ht, key_u64_hash(e->key), e->key,
+                                      e->data);
+   }
+
+   ht->entries = old_ht.entries;
+
+   ralloc_free(old_ht.table);
+}
+
 void
 _mesa_hash_table_u64_insert(struct hash_table_u64 *ht, uint64_t key,
                             void *data)
@@ -720,34 +834,82 @@ _mesa_hash_table_u64_insert(struct hash_table_u64 *ht, uint64_t key,
       return;
    }
 
-   if (sizeof(void *) == 8) {
-      _mesa_hash_table_insert(ht->table, (void *)(uintptr_t)key, data);
-   } else {
-      struct hash_key_u64 *_key = CALLOC_STRUCT(hash_key_u64);
+   if (ht->entries >= ht->max_entries) {
+      hash_table_u64_rehash(ht, ht->size_index + 1);
+   } else if (ht->deleted_entries + ht->entries >= ht->max_entries) {
+      hash_table_u64_rehash(ht, ht->size_index);
+   }
+
+   uint32_t hash = key_u64_hash(key);
+   uint32_t size = ht->size;
+   uint32_t start_hash_address = util_fast_urem32(hash, size, ht->size_magic);
+   uint32_t double_hash = 1 + util_fast_urem32(hash, ht->rehash,
+                                               ht->rehash_magic);
+   uint32_t hash_address = start_hash_address;
+   struct hash_entry_u64 *available_entry = NULL;
+   do {
+      struct hash_entry_u64 *entry = ht->table + hash_address;
+
+      if (entry->key == FREED_KEY_VALUE) {
+         if (available_entry == NULL)
+            available_entry = entry;
+         break;
+      }
 
-      if (!_key)
+      if (entry->key == DELETED_KEY_VALUE) {
+         /* Stash the first available entry we find */
+         if (available_entry == NULL)
+            available_entry = entry;
+      } else if (entry->key == key) {
+         /* Replace the data on a matching key, like the generic table. */
+         entry->data = data;
          return;
-      _key->value = key;
+      }
 
-      _mesa_hash_table_insert(ht->table, _key, data);
+      hash_address += double_hash;
+      if (hash_address >= size)
+         hash_address -= size;
+   } while (hash_address != start_hash_address);
+
+   if (available_entry) {
+      if (available_entry->key == DELETED_KEY_VALUE)
+         ht->deleted_entries--;
+      available_entry->key = key;
+      available_entry->data = data;
+      ht->entries++;
    }
 }
 
-static struct hash_entry *
+static struct hash_entry_u64 *
 hash_table_u64_search(struct hash_table_u64 *ht, uint64_t key)
 {
-   if (sizeof(void *) == 8) {
-      return _mesa_hash_table_search(ht->table, (void *)(uintptr_t)key);
-   } else {
-      struct hash_key_u64 _key = { .value = key };
-      return _mesa_hash_table_search(ht->table, &_key);
-   }
+   uint32_t hash = key_u64_hash(key);
+   uint32_t size = ht->size;
+   uint32_t start_hash_address = util_fast_urem32(hash, size, ht->size_magic);
+   uint32_t double_hash = 1 + util_fast_urem32(hash, ht->rehash,
+                                               ht->rehash_magic);
+   uint32_t hash_address = start_hash_address;
+
+   do {
+      struct hash_entry_u64 *entry = ht->table + hash_address;
+
+      if (entry->key == FREED_KEY_VALUE)
+         return NULL;
+      else if (entry->key == key)
+         return entry;
+
+      hash_address += double_hash;
+      if (hash_address >= size)
+         hash_address -= size;
+   } while (hash_address != start_hash_address);
+
+   return NULL;
 }
 
 void *
 _mesa_hash_table_u64_search(struct hash_table_u64 *ht, uint64_t key)
 {
-   struct hash_entry *entry;
+   struct hash_entry_u64 *entry;
 
    if (key == FREED_KEY_VALUE)
       return ht->freed_key_data;
@@ -765,7 +927,7 @@ _mesa_hash_table_u64_search(struct hash_table_u64 *ht, uint64_t key)
 void
 _mesa_hash_table_u64_remove(struct hash_table_u64 *ht, uint64_t key)
 {
-   struct hash_entry *entry;
+   struct hash_entry_u64 *entry;
 
    if (key == FREED_KEY_VALUE) {
       ht->freed_key_data = NULL;
@@ -781,12 +943,8 @@ _mesa_hash_table_u64_remove(struct hash_table_u64 *ht, uint64_t key)
    if (!entry)
       return;
 
-   if (sizeof(void *) == 8) {
-      _mesa_hash_table_remove(ht->table, entry);
-   } else {
-      struct hash_key *_key = (struct hash_key *)entry->key;
-
-      _mesa_hash_table_remove(ht->table, entry);
-      free(_key);
-   }
+   entry->key = DELETED_KEY_VALUE;
+   entry->data = NULL;
+   ht->entries--;
+   ht->deleted_entries++;
 }
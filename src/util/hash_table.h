@@ -57,6 +57,7 @@ struct hash_table {
    uint32_t size_index;
    uint32_t entries;
    uint32_t deleted_entries;
+   bool deferred_reclaim;
 };
 
 struct hash_table *
@@ -80,6 +81,7 @@ void _mesa_hash_table_clear(struct hash_table *ht,
                             void (*delete_function)(struct hash_entry *entry));
 void _mesa_hash_table_set_deleted_key(struct hash_table *ht,
                                       const void *deleted_key);
+void _mesa_hash_table_set_deferred_reclaim(struct hash_table *ht);
 
 static inline uint32_t _mesa_hash_table_num_entries(struct hash_table *ht)
 {
@@ -169,10 +171,32 @@ hash_table_call_foreach(struct hash_table *ht,
 }
 
 /**
- * Hash table wrapper which supports 64-bit keys.
+ * Hash table entry with an inline uint64_t key.
+ */
+struct hash_entry_u64 {
+   uint64_t key;
+   void *data;
+};
+
+/**
+ * Open-addressing hash table with inline uint64_t keys.
+ *
+ * Unlike struct hash_table, the key is stored in the entry array itself,
+ * so probing never chases a key pointer or makes an indirect key-equality
+ * call.  Keys 0 and 1 are reserved as the free and deleted markers; data
+ * stored under those keys is kept out of line.
  */
 struct hash_table_u64 {
-   struct hash_table *table;
+   void *mem_ctx;
+   struct hash_entry_u64 *table;
+   uint32_t size;
+   uint32_t rehash;
+   uint64_t size_magic;
+   uint64_t rehash_magic;
+   uint32_t max_entries;
+   uint32_t size_index;
+   uint32_t entries;
+   uint32_t deleted_entries;
    void *freed_key_data;
    void *deleted_key_data;
 };
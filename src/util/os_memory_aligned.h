@@ -38,6 +38,9 @@
 
 #include "pipe/p_compiler.h"
 
+#if defined(PIPE_OS_LINUX)
+#include <sys/mman.h>
+#endif
 
 
 /**
@@ -80,6 +83,21 @@ os_malloc_aligned(size_t size, size_t alignment)
    buf = (char *)(((uintptr_t)ptr + sizeof(void *) + alignment - 1) & ~((uintptr_t)(alignment - 1)));
    *(char **)(buf - sizeof(void *)) = ptr;
 
+#if defined(PIPE_OS_LINUX) && defined(MADV_HUGEPAGE)
+   /* Ask for transparent huge pages behind large allocations; they cut
+    * TLB misses when such memory is streamed through every frame.
+    * madvise wants page-aligned bounds, so shrink the range to them.
+    */
+   if (size >= (2u << 20)) {
+      uintptr_t page = 4096;
+      uintptr_t start = ((uintptr_t)buf + page - 1) & ~(page - 1);
+      uintptr_t end = ((uintptr_t)buf + size) & ~(page - 1);
+
+      if (end > start)
+         (void) madvise((void *)start, end - start, MADV_HUGEPAGE);
+   }
+#endif
+
    return buf;
 }
 
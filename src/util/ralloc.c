@@ -36,6 +36,9 @@ _CRTIMP int _vscprintf(const char *format, va_list argptr);
 
 #include "ralloc.h"
 
+#include "c11/threads.h"
+#include "macros.h"
+
 #ifndef va_copy
 #ifdef __va_copy
 #define va_copy(dest, src) __va_copy((dest), (src))
@@ -76,6 +79,11 @@ struct
    struct ralloc_header *next;
 
    void (*destructor)(void *);
+
+   /* Index + 1 of the magazine bucket this block was carved from, or 0 if
+    * it came straight from malloc.  See the magazine layer below.
+    */
+   unsigned magazine_bucket;
 };
 
 typedef struct ralloc_header ralloc_header;
@@ -83,6 +91,137 @@ typedef struct ralloc_header ralloc_header;
 static void unlink_block(ralloc_header *info);
 static void unsafe_free(ralloc_header *info);
 
+/* Thread-local magazines of recently freed small blocks.
+ *
+ * Shader compilation produces a torrent of small ralloc allocations
+ * (instructions, sources, list nodes), and when several compiler threads run
+ * at once they contend on the system allocator's locks.  Instead of
+ * forwarding every allocation to malloc, small blocks are rounded up to a
+ * few fixed sizes and recycled through a per-thread cache, so the common
+ * alloc/free cycle never leaves the thread.
+ *
+ * The magazines are keyed off the total block size (header included); the
+ * bucket a block belongs to is remembered in its header so freeing from a
+ * different thread than the allocating one simply refills the freeing
+ * thread's magazine.  Blocks are pushed back only while a magazine has room;
+ * overflow and blocks larger than the largest bucket go back to malloc.
+ */
+
+static const unsigned magazine_block_sizes[] = { 64, 128, 256 };
+
+#define MAGAZINE_NUM_BUCKETS ARRAY_SIZE(magazine_block_sizes)
+#define MAGAZINE_MAX_BLOCKS 64
+
+struct ralloc_magazine {
+   /* Singly linked free lists, threaded through the blocks themselves. */
+   void *head[MAGAZINE_NUM_BUCKETS];
+   unsigned count[MAGAZINE_NUM_BUCKETS];
+};
+
+static once_flag magazine_once = ONCE_FLAG_INIT;
+static tss_t magazine_tss;
+static bool magazine_tss_valid = false;
+
+static void
+magazine_destroy(void *data)
+{
+   struct ralloc_magazine *mag = data;
+
+   for (unsigned i = 0; i < MAGAZINE_NUM_BUCKETS; i++) {
+      while (mag->head[i]) {
+         void *block = mag->head[i];
+         mag->head[i] = *(void **)block;
+         free(block);
+      }
+   }
+
+   free(mag);
+}
+
+static void
+magazine_create_tss(void)
+{
+   magazine_tss_valid =
+      tss_create(&magazine_tss, magazine_destroy) == thrd_success;
+}
+
+static struct ralloc_magazine *
+get_magazine(void)
+{
+   struct ralloc_magazine *mag;
+
+   call_once(&magazine_once, magazine_create_tss);
+   if (unlikely(!magazine_tss_valid))
+      return NULL;
+
+   mag = tss_get(magazine_tss);
+   if (unlikely(mag == NULL)) {
+      mag = calloc(1, sizeof(*mag));
+      if (mag != NULL && tss_set(magazine_tss, mag) != thrd_success) {
+         free(mag);
+         return NULL;
+      }
+   }
+
+   return mag;
+}
+
+/**
+ * Allocate a block of at least \p size bytes, preferring the current
+ * thread's magazine.  Returns the bucket index + 1 in \p *bucket, or 0 if
+ * the block came straight from malloc.
+ */
+static void *
+magazine_alloc_block(size_t size, unsigned *bucket)
+{
+   for (unsigned i = 0; i < MAGAZINE_NUM_BUCKETS; i++) {
+      if (size > magazine_block_sizes[i])
+         continue;
+
+      struct ralloc_magazine *mag = get_magazine();
+      void *block;
+
+      if (mag != NULL && mag->head[i] != NULL) {
+         block = mag->head[i];
+         mag->head[i] = *(void **)block;
+         mag->count[i]--;
+      } else {
+         block = malloc(magazine_block_sizes[i]);
+      }
+
+      *bucket = i + 1;
+      return block;
+   }
+
+   *bucket = 0;
+   return malloc(size);
+}
+
+/**
+ * Return a block to the current thread's magazine, or to malloc if the
+ * magazine is full (or the block never belonged to a bucket).
+ *
+ * This intentionally never creates a magazine: during thread teardown the
+ * magazine may already have been destroyed, and freshly freed blocks should
+ * not resurrect it.
+ */
+static void
+magazine_free_block(void *block, unsigned bucket)
+{
+   if (bucket != 0 && magazine_tss_valid) {
+      struct ralloc_magazine *mag = tss_get(magazine_tss);
+
+      if (mag != NULL && mag->count[bucket - 1] < MAGAZINE_MAX_BLOCKS) {
+         *(void **)block = mag->head[bucket - 1];
+         mag->head[bucket - 1] = block;
+         mag->count[bucket - 1]++;
+         return;
+      }
+   }
+
+   free(block);
+}
+
 static ralloc_header *
 get_header(const void *ptr)
 {
@@ -116,7 +255,8 @@ ralloc_context(const void *ctx)
 void *
 ralloc_size(const void *ctx, size_t size)
 {
-   void *block = malloc(size + sizeof(ralloc_header));
+   unsigned bucket;
+   void *block = magazine_alloc_block(size + sizeof(ralloc_header), &bucket);
    ralloc_header *info;
    ralloc_header *parent;
 
@@ -133,6 +273,7 @@ ralloc_size(const void *ctx, size_t size)
    info->prev = NULL;
    info->next = NULL;
    info->destructor = NULL;
+   info->magazine_bucket = bucket;
 
    parent = ctx != NULL ? get_header(ctx) : NULL;
 
@@ -168,6 +309,11 @@ resize(void *ptr, size_t size)
    if (info == NULL)
       return NULL;
 
+   /* realloc may shrink the block below its bucket size, so it may no
+    * longer be recycled through the magazines.
+    */
+   info->magazine_bucket = 0;
+
    /* Update parent and sibling's links to the reallocated node. */
    if (info != old && info->parent != NULL) {
       if (info->parent->child == old)
@@ -296,7 +442,7 @@ unsafe_free(ralloc_header *info)
    if (info->destructor != NULL)
       info->destructor(PTR_FROM_HEADER(info));
 
-   free(info);
+   magazine_free_block(info, info->magazine_bucket);
 }
 
 void
@@ -124,9 +124,9 @@ struct ra_node {
    /** @{
     *
     * List of which nodes this node interferes with.  This should be
-    * symmetric with the other node.
+    * symmetric with the other node.  The bitset row lives in
+    * ra_graph::adjacency.
     */
-   BITSET_WORD *adjacency;
    unsigned int *adjacency_list;
    unsigned int adjacency_list_size;
    unsigned int adjacency_count;
@@ -171,6 +171,15 @@ struct ra_graph {
 
    unsigned int alloc; /**< count of nodes allocated. */
 
+   /**
+    * Interference bit matrix.  The matrix is symmetric with an empty
+    * diagonal, so only the strictly lower triangle is stored: the bit for
+    * the node pair (n1, n2) with n1 > n2 lives at bit index
+    * n1 * (n1 - 1) / 2 + n2.  This halves the matrix footprint and makes
+    * growing the graph a plain append instead of a row-by-row re-pack.
+    */
+   BITSET_WORD *adjacency;
+
    unsigned int (*select_reg_callback)(struct ra_graph *g, BITSET_WORD *regs,
                                        void *data);
    void *select_reg_callback_data;
@@ -417,11 +426,55 @@ ra_set_finalize(struct ra_regs *regs, unsigned int **q_values)
    }
 }
 
+/* Bit index of the node pair (n1, n2) in the lower-triangular interference
+ * matrix.  64-bit math: the index overflows 32 bits somewhere around 93k
+ * nodes, which large compute shaders do reach.
+ */
+static inline uint64_t
+ra_adjacency_bit(unsigned int n1, unsigned int n2)
+{
+   assert(n1 != n2);
+   if (n1 < n2) {
+      unsigned int tmp = n1;
+      n1 = n2;
+      n2 = tmp;
+   }
+   return (uint64_t)n1 * (n1 - 1) / 2 + n2;
+}
+
+/* Number of BITSET_WORDs needed for the triangular matrix of `alloc` nodes. */
+static inline uint64_t
+ra_adjacency_words(unsigned int alloc)
+{
+   uint64_t bits = (uint64_t)alloc * (alloc - 1) / 2;
+   return (bits + BITSET_WORDBITS - 1) / BITSET_WORDBITS;
+}
+
+static inline bool
+ra_test_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
+{
+   uint64_t b = ra_adjacency_bit(n1, n2);
+   return (g->adjacency[b / BITSET_WORDBITS] >> (b % BITSET_WORDBITS)) & 1;
+}
+
+static inline void
+ra_set_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
+{
+   uint64_t b = ra_adjacency_bit(n1, n2);
+   g->adjacency[b / BITSET_WORDBITS] |= (BITSET_WORD)1 << (b % BITSET_WORDBITS);
+}
+
+static inline void
+ra_clear_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
+{
+   uint64_t b = ra_adjacency_bit(n1, n2);
+   g->adjacency[b / BITSET_WORDBITS] &=
+      ~((BITSET_WORD)1 << (b % BITSET_WORDBITS));
+}
+
 static void
 ra_add_node_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
 {
-   BITSET_SET(g->nodes[n1].adjacency, n2);
-
    assert(n1 != n2);
 
    int n1_class = g->nodes[n1].class;
@@ -443,8 +496,6 @@ ra_add_node_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
 static void
 ra_node_remove_adjacency(struct ra_graph *g, unsigned int n1, unsigned int n2)
 {
-   BITSET_CLEAR(g->nodes[n1].adjacency, n2);
-
    assert(n1 != n2);
 
    int n1_class = g->nodes[n1].class;
@@ -479,19 +530,21 @@ ra_realloc_interference_graph(struct ra_graph *g, unsigned int alloc)
 
    g->nodes = reralloc(g, g->nodes, struct ra_node, alloc);
 
-   unsigned g_bitset_count = BITSET_WORDS(g->alloc);
    unsigned bitset_count = BITSET_WORDS(alloc);
-   /* For nodes already in the graph, we just have to grow the adjacency set */
-   for (unsigned i = 0; i < g->alloc; i++) {
-      assert(g->nodes[i].adjacency != NULL);
-      g->nodes[i].adjacency = rerzalloc(g, g->nodes[i].adjacency, BITSET_WORD,
-                                        g_bitset_count, bitset_count);
-   }
+
+   /* The triangular matrix grows by appending rows, so the bits of the
+    * existing nodes stay where they are and only the new words need
+    * clearing.
+    */
+   uint64_t g_adjacency_words = ra_adjacency_words(g->alloc);
+   uint64_t adjacency_words = ra_adjacency_words(alloc);
+   g->adjacency = reralloc(g, g->adjacency, BITSET_WORD, adjacency_words);
+   memset(g->adjacency + g_adjacency_words, 0,
+          (adjacency_words - g_adjacency_words) * sizeof(BITSET_WORD));
 
    /* For new nodes, we have to fully initialize them */
    for (unsigned i = g->alloc; i < alloc; i++) {
       memset(&g->nodes[i], 0, sizeof(g->nodes[i]));
-      g->nodes[i].adjacency = rzalloc_array(g, BITSET_WORD, bitset_count);
       g->nodes[i].adjacency_list_size = 4;
       g->nodes[i].adjacency_list =
          ralloc_array(g, unsigned int, g->nodes[i].adjacency_list_size);
@@ -573,7 +626,8 @@ ra_add_node_interference(struct ra_graph *g,
                          unsigned int n1, unsigned int n2)
 {
    assert(n1 < g->count && n2 < g->count);
-   if (n1 != n2 && !BITSET_TEST(g->nodes[n1].adjacency, n2)) {
+   if (n1 != n2 && !ra_test_adjacency(g, n1, n2)) {
+      ra_set_adjacency(g, n1, n2);
       ra_add_node_adjacency(g, n1, n2);
       ra_add_node_adjacency(g, n2, n1);
    }
@@ -582,11 +636,13 @@ ra_add_node_interference(struct ra_graph *g,
 void
 ra_reset_node_interference(struct ra_graph *g, unsigned int n)
 {
-   for (unsigned int i = 0; i < g->nodes[n].adjacency_count; i++)
-      ra_node_remove_adjacency(g, g->nodes[n].adjacency_list[i], n);
+   for (unsigned int i = 0; i < g->nodes[n].adjacency_count; i++) {
+      unsigned int n2 = g->nodes[n].adjacency_list[i];
+
+      ra_clear_adjacency(g, n, n2);
+      ra_node_remove_adjacency(g, n2, n);
+   }
 
-   memset(g->nodes[n].adjacency, 0,
-          BITSET_WORDS(g->count) * sizeof(BITSET_WORD));
    g->nodes[n].adjacency_count = 0;
 }
 
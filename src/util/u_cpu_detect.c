@@ -62,6 +62,8 @@
 #include <signal.h>
 #include <fcntl.h>
 #include <elf.h>
+#include <stdio.h>
+#include <string.h>
 #endif
 
 #ifdef PIPE_OS_UNIX
@@ -394,6 +396,42 @@ get_cpu_topology(void)
          util_cpu_caps.cores_per_L3 = cores_per_cache;
    }
 #endif
+
+   /* Default. This is correct on non-NUMA and unknown systems. */
+   util_cpu_caps.num_numa_nodes = 1;
+
+#if defined(PIPE_OS_LINUX)
+   {
+      /* The kernel lists online NUMA nodes as ranges, e.g. "0" or "0-1". */
+      FILE *f = fopen("/sys/devices/system/node/online", "r");
+
+      if (f) {
+         char buf[128];
+
+         if (fgets(buf, sizeof(buf), f)) {
+            unsigned num_nodes = 0;
+            const char *p = buf;
+
+            while (*p) {
+               unsigned first, last;
+
+               if (sscanf(p, "%u-%u", &first, &last) == 2)
+                  num_nodes += last - first + 1;
+               else if (sscanf(p, "%u", &first) == 1)
+                  num_nodes++;
+
+               p = strchr(p, ',');
+               if (!p)
+                  break;
+               p++;
+            }
+            if (num_nodes)
+               util_cpu_caps.num_numa_nodes = num_nodes;
+         }
+         fclose(f);
+      }
+   }
+#endif
 }
 
 static void
@@ -554,6 +592,7 @@ util_cpu_detect_once(void)
 #ifdef DEBUG
    if (debug_get_option_dump_cpu()) {
       debug_printf("util_cpu_caps.nr_cpus = %u\n", util_cpu_caps.nr_cpus);
+      debug_printf("util_cpu_caps.num_numa_nodes = %u\n", util_cpu_caps.num_numa_nodes);
 
       debug_printf("util_cpu_caps.x86_cpu_type = %u\n", util_cpu_caps.x86_cpu_type);
       debug_printf("util_cpu_caps.cacheline = %u\n", util_cpu_caps.cacheline);
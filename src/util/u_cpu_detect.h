@@ -52,6 +52,7 @@ struct util_cpu_caps {
    int x86_cpu_type;
    unsigned cacheline;
    unsigned cores_per_L3;
+   unsigned num_numa_nodes;
 
    unsigned has_intel:1;
    unsigned has_tsc:1;
@@ -0,0 +1,134 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef U_INTERVAL_SET_H
+#define U_INTERVAL_SET_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A small, inline set of disjoint half-open intervals [start, end), kept
+ * sorted by start.  It is meant for conservative dirty/valid range tracking
+ * where an over-approximation is always safe: when the fixed capacity is
+ * exceeded, neighboring intervals are collapsed into their convex hull, so
+ * the set may report overlaps that were never added but never loses one
+ * that was.
+ */
+
+#define UTIL_INTERVAL_SET_MAX_INTERVALS 32
+
+struct util_interval
+{
+   uint64_t start;
+   uint64_t end;
+};
+
+struct util_interval_set
+{
+   unsigned count;
+   struct util_interval intervals[UTIL_INTERVAL_SET_MAX_INTERVALS];
+};
+
+static inline void
+util_interval_set_clear(struct util_interval_set *set)
+{
+   set->count = 0;
+}
+
+/**
+ * Return whether [start, end) intersects any interval in the set.
+ */
+static inline bool
+util_interval_set_overlaps(const struct util_interval_set *set,
+                           uint64_t start, uint64_t end)
+{
+   for (unsigned i = 0; i < set->count; i++) {
+      if (set->intervals[i].start >= end)
+         return false;
+      if (set->intervals[i].end > start)
+         return true;
+   }
+   return false;
+}
+
+/**
+ * Add [start, end) to the set, merging it with any intervals it overlaps
+ * or touches.
+ */
+static inline void
+util_interval_set_add(struct util_interval_set *set,
+                      uint64_t start, uint64_t end)
+{
+   unsigned i = 0, j;
+
+   if (start >= end)
+      return;
+
+   /* Skip the intervals entirely before the new one. */
+   while (i < set->count && set->intervals[i].end < start)
+      i++;
+
+   /* Fold every interval overlapping or touching [start, end) into it. */
+   j = i;
+   while (j < set->count && set->intervals[j].start <= end) {
+      start = MIN2(start, set->intervals[j].start);
+      end = MAX2(end, set->intervals[j].end);
+      j++;
+   }
+
+   if (j == i) {
+      if (set->count == UTIL_INTERVAL_SET_MAX_INTERVALS) {
+         /* Full: collapse everything into one conservative interval. */
+         start = MIN2(start, set->intervals[0].start);
+         end = MAX2(end, set->intervals[set->count - 1].end);
+         set->count = 0;
+         i = 0;
+      } else {
+         memmove(&set->intervals[i + 1], &set->intervals[i],
+                 (set->count - i) * sizeof(set->intervals[0]));
+      }
+      set->count++;
+   } else {
+      memmove(&set->intervals[i + 1], &set->intervals[j],
+              (set->count - j) * sizeof(set->intervals[0]));
+      set->count -= j - i - 1;
+   }
+
+   set->intervals[i].start = start;
+   set->intervals[i].end = end;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* U_INTERVAL_SET_H */
@@ -29,6 +29,7 @@
 #include <time.h>
 
 #include "util/os_time.h"
+#include "util/u_math.h"
 #include "util/u_string.h"
 #include "util/u_thread.h"
 #include "u_process.h"
@@ -228,6 +229,97 @@ util_queue_fence_destroy(struct util_queue_fence *fence)
  * util_queue implementation
  */
 
+/****************************************************************************
+ * Lock-free bounded MPMC ring (UTIL_QUEUE_INIT_LOCKLESS), after Dmitry
+ * Vyukov's well-known design.
+ *
+ * Each cell carries a sequence number: a cell is ready for the producer at
+ * position "pos" when sequence == pos, and ready for the consumer when
+ * sequence == pos + 1.  Claiming a position is a single compare-and-swap on
+ * the shared enqueue/dequeue counter, so producers and consumers never take
+ * the queue lock to move jobs.  The lock and condvars are only used to sleep
+ * when the ring is empty or full; num_job_waiters/num_space_waiters tell the
+ * fast paths whether anybody might be sleeping.  The atomic num_queued
+ * update after each push/pop doubles as the full barrier that makes the
+ * waiter-count check safe.
+ */
+
+struct util_queue_lockless_cell {
+   uint32_t sequence;
+   struct util_queue_job job;
+};
+
+static bool
+util_queue_lockless_push(struct util_queue *queue,
+                         const struct util_queue_job *job)
+{
+   uint32_t pos = p_atomic_read(&queue->enqueue_pos);
+
+   for (;;) {
+      struct util_queue_lockless_cell *cell =
+         &queue->cells[pos & queue->ring_mask];
+      int32_t dif = (int32_t)p_atomic_read(&cell->sequence) - (int32_t)pos;
+
+      if (dif == 0) {
+         if (p_atomic_cmpxchg(&queue->enqueue_pos, pos, pos + 1) == pos) {
+            cell->job = *job;
+            p_atomic_set(&cell->sequence, pos + 1);
+            p_atomic_inc(&queue->num_queued);
+            return true;
+         }
+         pos = p_atomic_read(&queue->enqueue_pos);
+      } else if (dif < 0) {
+         /* The cell still holds the job from the previous lap: full. */
+         return false;
+      } else {
+         pos = p_atomic_read(&queue->enqueue_pos);
+      }
+   }
+}
+
+static bool
+util_queue_lockless_pop(struct util_queue *queue, struct util_queue_job *job)
+{
+   uint32_t pos = p_atomic_read(&queue->dequeue_pos);
+
+   for (;;) {
+      struct util_queue_lockless_cell *cell =
+         &queue->cells[pos & queue->ring_mask];
+      int32_t dif =
+         (int32_t)p_atomic_read(&cell->sequence) - (int32_t)(pos + 1);
+
+      if (dif == 0) {
+         if (p_atomic_cmpxchg(&queue->dequeue_pos, pos, pos + 1) == pos) {
+            *job = cell->job;
+            p_atomic_set(&cell->sequence, pos + queue->ring_mask + 1);
+            p_atomic_dec(&queue->num_queued);
+            return true;
+         }
+         pos = p_atomic_read(&queue->dequeue_pos);
+      } else if (dif < 0) {
+         /* The cell hasn't been filled on this lap yet: empty. */
+         return false;
+      } else {
+         pos = p_atomic_read(&queue->dequeue_pos);
+      }
+   }
+}
+
+static void
+util_queue_lockless_wake(struct util_queue *queue, cnd_t *cond, int *waiters)
+{
+   /* The waiter registers itself and re-checks the ring before sleeping,
+    * and both sides order their ring access against the waiter count with
+    * atomic read-modify-writes, so a sleeping waiter can't be missed here.
+    */
+   if (p_atomic_read(waiters) == 0)
+      return;
+
+   mtx_lock(&queue->lock);
+   cnd_signal(cond);
+   mtx_unlock(&queue->lock);
+}
+
 struct thread_input {
    struct util_queue *queue;
    int thread_index;
@@ -264,26 +356,52 @@ util_queue_thread_func(void *input)
    while (1) {
       struct util_queue_job job;
 
-      mtx_lock(&queue->lock);
-      assert(queue->num_queued >= 0 && queue->num_queued <= queue->max_jobs);
+      if (queue->flags & UTIL_QUEUE_INIT_LOCKLESS) {
+         /* only kill threads that are above "num_threads" */
+         if (thread_index >= queue->num_threads)
+            break;
 
-      /* wait if the queue is empty */
-      while (thread_index < queue->num_threads && queue->num_queued == 0)
-         cnd_wait(&queue->has_queued_cond, &queue->lock);
+         bool have_job = util_queue_lockless_pop(queue, &job);
+
+         if (!have_job) {
+            /* Slow path: register as a waiter and sleep on the condvar. */
+            mtx_lock(&queue->lock);
+            p_atomic_inc(&queue->num_job_waiters);
+            while (thread_index < queue->num_threads &&
+                   !(have_job = util_queue_lockless_pop(queue, &job)))
+               cnd_wait(&queue->has_queued_cond, &queue->lock);
+            p_atomic_dec(&queue->num_job_waiters);
+            mtx_unlock(&queue->lock);
+
+            /* only kill threads that are above "num_threads" */
+            if (!have_job)
+               break;
+         }
 
-      /* only kill threads that are above "num_threads" */
-      if (thread_index >= queue->num_threads) {
-         mtx_unlock(&queue->lock);
-         break;
-      }
+         util_queue_lockless_wake(queue, &queue->has_space_cond,
+                                  &queue->num_space_waiters);
+      } else {
+         mtx_lock(&queue->lock);
+         assert(queue->num_queued >= 0 && queue->num_queued <= queue->max_jobs);
 
-      job = queue->jobs[queue->read_idx];
-      memset(&queue->jobs[queue->read_idx], 0, sizeof(struct util_queue_job));
-      queue->read_idx = (queue->read_idx + 1) % queue->max_jobs;
+         /* wait if the queue is empty */
+         while (thread_index < queue->num_threads && queue->num_queued == 0)
+            cnd_wait(&queue->has_queued_cond, &queue->lock);
 
-      queue->num_queued--;
-      cnd_signal(&queue->has_space_cond);
-      mtx_unlock(&queue->lock);
+         /* only kill threads that are above "num_threads" */
+         if (thread_index >= queue->num_threads) {
+            mtx_unlock(&queue->lock);
+            break;
+         }
+
+         job = queue->jobs[queue->read_idx];
+         memset(&queue->jobs[queue->read_idx], 0, sizeof(struct util_queue_job));
+         queue->read_idx = (queue->read_idx + 1) % queue->max_jobs;
+
+         queue->num_queued--;
+         cnd_signal(&queue->has_space_cond);
+         mtx_unlock(&queue->lock);
+      }
 
       if (job.job) {
          job.execute(job.job, thread_index);
@@ -296,15 +414,24 @@ util_queue_thread_func(void *input)
    /* signal remaining jobs if all threads are being terminated */
    mtx_lock(&queue->lock);
    if (queue->num_threads == 0) {
-      for (unsigned i = queue->read_idx; i != queue->write_idx;
-           i = (i + 1) % queue->max_jobs) {
-         if (queue->jobs[i].job) {
-            util_queue_fence_signal(queue->jobs[i].fence);
-            queue->jobs[i].job = NULL;
+      if (queue->flags & UTIL_QUEUE_INIT_LOCKLESS) {
+         struct util_queue_job job;
+
+         while (util_queue_lockless_pop(queue, &job)) {
+            if (job.job)
+               util_queue_fence_signal(job.fence);
          }
+      } else {
+         for (unsigned i = queue->read_idx; i != queue->write_idx;
+              i = (i + 1) % queue->max_jobs) {
+            if (queue->jobs[i].job) {
+               util_queue_fence_signal(queue->jobs[i].fence);
+               queue->jobs[i].job = NULL;
+            }
+         }
+         queue->read_idx = queue->write_idx;
+         queue->num_queued = 0;
       }
-      queue->read_idx = queue->write_idx;
-      queue->num_queued = 0;
    }
    mtx_unlock(&queue->lock);
    return 0;
@@ -413,13 +540,33 @@ util_queue_init(struct util_queue *queue,
 
    queue->flags = flags;
    queue->max_threads = num_threads;
-   queue->num_threads = num_threads;
-   queue->max_jobs = max_jobs;
+   queue->num_threads = (flags & UTIL_QUEUE_INIT_SCALE_THREADS) ? 1 : num_threads;
 
-   queue->jobs = (struct util_queue_job*)
-                 calloc(max_jobs, sizeof(struct util_queue_job));
-   if (!queue->jobs)
-      goto fail;
+   if (flags & UTIL_QUEUE_INIT_LOCKLESS) {
+      /* The ring can't be reallocated while producers and consumers access
+       * it without the lock.
+       */
+      assert(!(flags & UTIL_QUEUE_INIT_RESIZE_IF_FULL));
+
+      max_jobs = util_next_power_of_two(max_jobs);
+      queue->max_jobs = max_jobs;
+      queue->ring_mask = max_jobs - 1;
+
+      queue->cells = (struct util_queue_lockless_cell*)
+                     calloc(max_jobs, sizeof(struct util_queue_lockless_cell));
+      if (!queue->cells)
+         goto fail;
+
+      for (i = 0; i < max_jobs; i++)
+         queue->cells[i].sequence = i;
+   } else {
+      queue->max_jobs = max_jobs;
+
+      queue->jobs = (struct util_queue_job*)
+                    calloc(max_jobs, sizeof(struct util_queue_job));
+      if (!queue->jobs)
+         goto fail;
+   }
 
    (void) mtx_init(&queue->lock, mtx_plain);
    (void) mtx_init(&queue->finish_lock, mtx_plain);
@@ -433,7 +580,7 @@ util_queue_init(struct util_queue *queue,
       goto fail;
 
    /* start threads */
-   for (i = 0; i < num_threads; i++) {
+   for (i = 0; i < queue->num_threads; i++) {
       if (!util_queue_create_thread(queue, i)) {
          if (i == 0) {
             /* no threads created, fail */
@@ -452,11 +599,12 @@ util_queue_init(struct util_queue *queue,
 fail:
    free(queue->threads);
 
-   if (queue->jobs) {
+   if (queue->jobs || queue->cells) {
       cnd_destroy(&queue->has_space_cond);
       cnd_destroy(&queue->has_queued_cond);
       mtx_destroy(&queue->lock);
       free(queue->jobs);
+      free(queue->cells);
    }
    /* also util_queue_is_initialized can be used to check for success */
    memset(queue, 0, sizeof(*queue));
@@ -505,6 +653,7 @@ util_queue_destroy(struct util_queue *queue)
    mtx_destroy(&queue->finish_lock);
    mtx_destroy(&queue->lock);
    free(queue->jobs);
+   free(queue->cells);
    free(queue->threads);
 }
 
@@ -517,6 +666,47 @@ util_queue_add_job(struct util_queue *queue,
 {
    struct util_queue_job *ptr;
 
+   /* Scale the number of threads up if there is already work waiting; the
+    * counters are read unlocked since this is only a heuristic and
+    * util_queue_adjust_num_threads does its own locking.
+    */
+   if ((queue->flags & UTIL_QUEUE_INIT_SCALE_THREADS) &&
+       queue->num_queued > 0 &&
+       queue->num_threads < queue->max_threads)
+      util_queue_adjust_num_threads(queue, queue->num_threads + 1);
+
+   if (queue->flags & UTIL_QUEUE_INIT_LOCKLESS) {
+      struct util_queue_job new_job;
+
+      if (queue->num_threads == 0) {
+         /* well no good option here, but any leaks will be
+          * short-lived as things are shutting down..
+          */
+         return;
+      }
+
+      util_queue_fence_reset(fence);
+
+      new_job.job = job;
+      new_job.fence = fence;
+      new_job.execute = execute;
+      new_job.cleanup = cleanup;
+
+      if (!util_queue_lockless_push(queue, &new_job)) {
+         /* Wait until there is a free slot. */
+         mtx_lock(&queue->lock);
+         p_atomic_inc(&queue->num_space_waiters);
+         while (!util_queue_lockless_push(queue, &new_job))
+            cnd_wait(&queue->has_space_cond, &queue->lock);
+         p_atomic_dec(&queue->num_space_waiters);
+         mtx_unlock(&queue->lock);
+      }
+
+      util_queue_lockless_wake(queue, &queue->has_queued_cond,
+                               &queue->num_job_waiters);
+      return;
+   }
+
    mtx_lock(&queue->lock);
    if (queue->num_threads == 0) {
       mtx_unlock(&queue->lock);
@@ -595,6 +785,14 @@ util_queue_drop_job(struct util_queue *queue, struct util_queue_fence *fence)
    if (util_queue_fence_is_signalled(fence))
       return;
 
+   if (queue->flags & UTIL_QUEUE_INIT_LOCKLESS) {
+      /* The ring cells can't be cleared from under the consumers, so just
+       * wait for the job to complete.
+       */
+      util_queue_fence_wait(fence);
+      return;
+   }
+
    mtx_lock(&queue->lock);
    for (unsigned i = queue->read_idx; i != queue->write_idx;
         i = (i + 1) % queue->max_jobs) {
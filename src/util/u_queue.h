@@ -49,6 +49,18 @@ extern "C" {
 #define UTIL_QUEUE_INIT_USE_MINIMUM_PRIORITY      (1 << 0)
 #define UTIL_QUEUE_INIT_RESIZE_IF_FULL            (1 << 1)
 #define UTIL_QUEUE_INIT_SET_FULL_THREAD_AFFINITY  (1 << 2)
+/* Use a lock-free bounded ring instead of the mutex-protected job array.
+ * Jobs are added and taken without holding the queue lock; the lock is only
+ * entered to sleep on an empty or full queue.  max_jobs is rounded up to a
+ * power of two.  Incompatible with UTIL_QUEUE_INIT_RESIZE_IF_FULL.
+ */
+#define UTIL_QUEUE_INIT_LOCKLESS                  (1 << 3)
+/* Spawn the worker threads lazily: start with a single thread and add more,
+ * up to the count given at init time, only while jobs are piling up.  Useful
+ * for queues sized for worst-case parallelism that are idle most of the
+ * time, so a process doesn't carry dozens of sleeping compiler threads.
+ */
+#define UTIL_QUEUE_INIT_SCALE_THREADS             (1 << 4)
 
 #if defined(__GNUC__) && defined(HAVE_LINUX_FUTEX_H)
 #define UTIL_QUEUE_FENCE_FUTEX
@@ -214,6 +226,14 @@ struct util_queue {
    int write_idx, read_idx; /* ring buffer pointers */
    struct util_queue_job *jobs;
 
+   /* Lock-free ring used instead of "jobs" with UTIL_QUEUE_INIT_LOCKLESS. */
+   struct util_queue_lockless_cell *cells;
+   uint32_t ring_mask;        /* max_jobs - 1 (max_jobs is a power of two) */
+   uint32_t enqueue_pos;
+   uint32_t dequeue_pos;
+   int num_job_waiters;       /* threads sleeping on an empty queue */
+   int num_space_waiters;     /* threads sleeping on a full queue */
+
    /* for cleanup at exit(), protected by exit_mutex */
    struct list_head head;
 };
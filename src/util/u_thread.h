@@ -29,6 +29,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "c11/threads.h"
 
@@ -127,6 +129,58 @@ util_get_L3_for_pinned_thread(thrd_t thread, unsigned cores_per_L3)
    return -1;
 }
 
+/**
+ * Pin a thread to the CPUs of one NUMA node. On multi-socket systems this
+ * keeps the thread's working set behind the memory controller next to the
+ * cores that touch it. The node's CPU list comes from sysfs because the
+ * kernel doesn't guarantee contiguous CPU numbering within a node.
+ *
+ * \param thread  thread
+ * \param node    index of the NUMA node
+ */
+static inline void
+util_pin_thread_to_numa_node(thrd_t thread, unsigned node)
+{
+#if defined(HAVE_PTHREAD_SETAFFINITY)
+   char path[64], list[256];
+   cpu_set_t cpuset;
+   FILE *f;
+
+   snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist",
+            node);
+   f = fopen(path, "r");
+   if (!f)
+      return;
+
+   CPU_ZERO(&cpuset);
+   if (fgets(list, sizeof(list), f)) {
+      /* The list has the form "0-15,32-47". */
+      const char *p = list;
+
+      while (*p) {
+         unsigned first, last;
+
+         if (sscanf(p, "%u-%u", &first, &last) != 2) {
+            if (sscanf(p, "%u", &first) != 1)
+               break;
+            last = first;
+         }
+         for (unsigned i = first; i <= last && i < CPU_SETSIZE; i++)
+            CPU_SET(i, &cpuset);
+
+         p = strchr(p, ',');
+         if (!p)
+            break;
+         p++;
+      }
+   }
+   fclose(f);
+
+   if (CPU_COUNT(&cpuset))
+      pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset);
+#endif
+}
+
 /*
  * Thread statistics.
  */
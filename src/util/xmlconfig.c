@@ -42,8 +42,12 @@
 #include <errno.h>
 #include <dirent.h>
 #include <fnmatch.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include "macros.h"
 #include "xmlconfig.h"
 #include "u_process.h"
+#include "crc32.h"
 
 /* For systems like Hurd */
 #ifndef PATH_MAX
@@ -705,8 +709,301 @@ struct OptConfData {
     uint32_t inDevice;
     uint32_t inApp;
     uint32_t inOption;
+    struct driConfRecorder *rec;
 };
 
+/* Binary cache of a parsed configuration file.
+ *
+ * Parsing the system drirc with expat costs a few milliseconds in every
+ * process at screen creation. Since the files change rarely, the parse
+ * result is compiled once into a flat list of (matchers, option, value)
+ * entries plus a string table, written next to the user's other caches
+ * and validated against the source file's mtime and size. Replaying the
+ * entries applies the same driver/screen/executable filters the XML
+ * handlers would, so the cache is shared between drivers and processes.
+ */
+#define DRI_CONF_CACHE_MAGIC   0x43524944 /* "DIRC" */
+#define DRI_CONF_CACHE_VERSION 1
+
+struct driConfCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t mtime;             /* of the source file */
+    uint64_t fileSize;          /* of the source file */
+    uint32_t numEntries;
+    uint32_t stringsSize;
+    /* followed by numEntries driConfCacheEntry, then the string table */
+};
+
+struct driConfCacheEntry {
+    /* matchers; offsets into the string table, 0 = not specified */
+    uint32_t driver;
+    uint32_t kernelDriver;
+    uint32_t exec;
+    int32_t screen;             /* -1 = any screen */
+    /* the option itself */
+    uint32_t name;
+    uint32_t value;
+};
+
+/** \brief Accumulates cache entries while expat runs. */
+struct driConfRecorder {
+    struct driConfCacheEntry *entries;
+    uint32_t numEntries, maxEntries;
+    char *strings;
+    uint32_t stringsSize, maxStrings;
+    /* matchers of the enclosing <device> and <application> elements */
+    uint32_t curDriver, curKernel, curExec;
+    int32_t curScreen;
+    bool failed;
+};
+
+/** \brief Copy a string into the recorder's string table. */
+static uint32_t
+recAddString(struct driConfRecorder *rec, const char *s)
+{
+    uint32_t len = strlen (s) + 1, offset = rec->stringsSize;
+
+    if (offset + len > rec->maxStrings) {
+        uint32_t newMax = MAX2 (rec->maxStrings * 2, offset + len + 1024);
+        char *strings = realloc (rec->strings, newMax);
+
+        if (!strings) {
+            rec->failed = true;
+            return 0;
+        }
+        rec->strings = strings;
+        rec->maxStrings = newMax;
+    }
+    memcpy (rec->strings + offset, s, len);
+    rec->stringsSize += len;
+    return offset;
+}
+
+static void
+recDeviceAttr(struct driConfRecorder *rec, const XML_Char **attr)
+{
+    uint32_t i;
+
+    for (i = 0; attr[i]; i += 2) {
+        if (!strcmp (attr[i], "driver"))
+            rec->curDriver = recAddString (rec, attr[i+1]);
+        else if (!strcmp (attr[i], "kernel_driver"))
+            rec->curKernel = recAddString (rec, attr[i+1]);
+        else if (!strcmp (attr[i], "screen")) {
+            driOptionValue screenNum;
+
+            if (parseValue (&screenNum, DRI_INT, attr[i+1]))
+                rec->curScreen = screenNum._int;
+        }
+    }
+}
+
+static void
+recAppAttr(struct driConfRecorder *rec, const XML_Char **attr)
+{
+    uint32_t i;
+
+    for (i = 0; attr[i]; i += 2) {
+        if (!strcmp (attr[i], "executable"))
+            rec->curExec = recAddString (rec, attr[i+1]);
+    }
+}
+
+static void
+recOptionAttr(struct driConfRecorder *rec, const XML_Char **attr)
+{
+    const XML_Char *name = NULL, *value = NULL;
+    struct driConfCacheEntry *entry;
+    uint32_t i;
+
+    for (i = 0; attr[i]; i += 2) {
+        if (!strcmp (attr[i], "name")) name = attr[i+1];
+        else if (!strcmp (attr[i], "value")) value = attr[i+1];
+    }
+    if (!name || !value)
+        return;
+
+    if (rec->numEntries == rec->maxEntries) {
+        uint32_t newMax = MAX2 (rec->maxEntries * 2, 64);
+        struct driConfCacheEntry *entries =
+            realloc (rec->entries, newMax * sizeof (*entries));
+
+        if (!entries) {
+            rec->failed = true;
+            return;
+        }
+        rec->entries = entries;
+        rec->maxEntries = newMax;
+    }
+
+    entry = &rec->entries[rec->numEntries++];
+    entry->driver = rec->curDriver;
+    entry->kernelDriver = rec->curKernel;
+    entry->exec = rec->curExec;
+    entry->screen = rec->curScreen;
+    entry->name = recAddString (rec, name);
+    entry->value = recAddString (rec, value);
+}
+
+/** \brief Apply one replayed option, like parseOptConfAttr does. */
+static void
+applyOptConf(struct OptConfData *data, const char *name, const char *value)
+{
+    driOptionCache *cache = data->cache;
+    uint32_t opt = findOption (cache, name);
+
+    if (cache->info[opt].name == NULL)
+        return;
+    else if (getenv (cache->info[opt].name))
+        fprintf (stderr, "ATTENTION: option value of option %s ignored.\n",
+                 cache->info[opt].name);
+    else
+        parseValue (&cache->values[opt], cache->info[opt].type, value);
+}
+
+/** \brief Compute the cache file name for a configuration file. */
+static bool
+getConfigCacheName(const char *filename, char *cachename)
+{
+    char cachedir[PATH_MAX];
+    const char *base = getenv ("XDG_CACHE_HOME");
+    const char *slash = strrchr (filename, '/');
+
+    if (getenv ("MESA_NO_DRICONF_CACHE"))
+        return false;
+
+    if (!base || !base[0]) {
+        const char *home = getenv ("HOME");
+
+        if (!home)
+            return false;
+        if (snprintf (cachedir, PATH_MAX, "%s/.cache", home) >= PATH_MAX)
+            return false;
+        mkdir (cachedir, 0755);
+        base = cachedir;
+    }
+
+    if (snprintf (cachename, PATH_MAX, "%s/mesa_driconf", base) >= PATH_MAX)
+        return false;
+    mkdir (cachename, 0755);
+
+    return snprintf (cachename, PATH_MAX, "%s/mesa_driconf/%08x-%s.bin", base,
+                     util_hash_crc32 (filename, strlen (filename)),
+                     slash ? slash + 1 : filename) < PATH_MAX;
+}
+
+/** \brief Replay a cached configuration file, if it is still valid. */
+static bool
+loadConfigCache(struct OptConfData *data, const char *cachename,
+                const struct stat *st)
+{
+    const struct driConfCacheHeader *header;
+    const struct driConfCacheEntry *entries;
+    const char *strings;
+    struct stat cst;
+    size_t size;
+    void *map;
+    uint32_t i;
+    int fd;
+
+    if ((fd = open (cachename, O_RDONLY)) == -1)
+        return false;
+    if (fstat (fd, &cst) != 0 || (size_t) cst.st_size < sizeof (*header)) {
+        close (fd);
+        return false;
+    }
+    size = cst.st_size;
+
+    map = mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (map == MAP_FAILED)
+        return false;
+
+    header = map;
+    entries = (const struct driConfCacheEntry *) (header + 1);
+    if (header->magic != DRI_CONF_CACHE_MAGIC ||
+        header->version != DRI_CONF_CACHE_VERSION ||
+        header->mtime != (uint64_t) st->st_mtime ||
+        header->fileSize != (uint64_t) st->st_size ||
+        header->stringsSize == 0 ||
+        sizeof (*header) + (uint64_t) header->numEntries * sizeof (*entries)
+        + header->stringsSize != size) {
+        munmap (map, size);
+        return false;
+    }
+    strings = (const char *) (entries + header->numEntries);
+    if (strings[header->stringsSize - 1] != '\0') {
+        munmap (map, size);
+        return false;
+    }
+
+    for (i = 0; i < header->numEntries; i++) {
+        const struct driConfCacheEntry *e = &entries[i];
+
+        if (e->driver >= header->stringsSize ||
+            e->kernelDriver >= header->stringsSize ||
+            e->exec >= header->stringsSize ||
+            e->name >= header->stringsSize ||
+            e->value >= header->stringsSize)
+            continue;
+
+        /* The same filters parseDeviceAttr and parseAppAttr apply. */
+        if (e->driver && strcmp (strings + e->driver, data->driverName))
+            continue;
+        if (e->kernelDriver && (!data->kernelDriverName ||
+            strcmp (strings + e->kernelDriver, data->kernelDriverName)))
+            continue;
+        if (e->screen >= 0 && e->screen != data->screenNum)
+            continue;
+        if (e->exec && strcmp (strings + e->exec, data->execName))
+            continue;
+
+        applyOptConf (data, strings + e->name, strings + e->value);
+    }
+
+    munmap (map, size);
+    return true;
+}
+
+/** \brief Write the recorded entries, atomically via rename. */
+static void
+writeConfigCache(const struct driConfRecorder *rec, const char *cachename,
+                 const struct stat *st)
+{
+    struct driConfCacheHeader header;
+    char tmpname[PATH_MAX];
+    FILE *f;
+
+    if (snprintf (tmpname, PATH_MAX, "%s.tmp%d", cachename,
+                  (int) getpid()) >= PATH_MAX)
+        return;
+
+    if (!(f = fopen (tmpname, "wb")))
+        return;
+
+    memset (&header, 0, sizeof (header));
+    header.magic = DRI_CONF_CACHE_MAGIC;
+    header.version = DRI_CONF_CACHE_VERSION;
+    header.mtime = (uint64_t) st->st_mtime;
+    header.fileSize = (uint64_t) st->st_size;
+    header.numEntries = rec->numEntries;
+    header.stringsSize = rec->stringsSize;
+
+    if (fwrite (&header, sizeof (header), 1, f) != 1 ||
+        (rec->numEntries &&
+         fwrite (rec->entries, sizeof (rec->entries[0]),
+                 rec->numEntries, f) != rec->numEntries) ||
+        fwrite (rec->strings, 1, rec->stringsSize, f) != rec->stringsSize) {
+        fclose (f);
+        unlink (tmpname);
+        return;
+    }
+
+    if (fclose (f) != 0 || rename (tmpname, cachename) != 0)
+        unlink (tmpname);
+}
+
 /** \brief Elements in configuration files. */
 enum OptConfElem {
     OC_APPLICATION = 0, OC_DEVICE, OC_DRICONF, OC_OPTION, OC_COUNT
@@ -808,6 +1105,8 @@ optConfStartElem(void *userData, const XML_Char *name,
         if (data->inDevice)
             XML_WARNING1 ("nested <device> elements.");
         data->inDevice++;
+        if (data->rec)
+            recDeviceAttr (data->rec, attr);
         if (!data->ignoringDevice && !data->ignoringApp)
             parseDeviceAttr (data, attr);
         break;
@@ -817,6 +1116,8 @@ optConfStartElem(void *userData, const XML_Char *name,
         if (data->inApp)
             XML_WARNING1 ("nested <application> elements.");
         data->inApp++;
+        if (data->rec)
+            recAppAttr (data->rec, attr);
         if (!data->ignoringDevice && !data->ignoringApp)
             parseAppAttr (data, attr);
         break;
@@ -826,6 +1127,8 @@ optConfStartElem(void *userData, const XML_Char *name,
         if (data->inOption)
             XML_WARNING1 ("nested <option> elements.");
         data->inOption++;
+        if (data->rec)
+            recOptionAttr (data->rec, attr);
         if (!data->ignoringDevice && !data->ignoringApp)
             parseOptConfAttr (data, attr);
         break;
@@ -847,10 +1150,16 @@ optConfEndElem(void *userData, const XML_Char *name)
       case OC_DEVICE:
         if (data->inDevice-- == data->ignoringDevice)
             data->ignoringDevice = 0;
+        if (data->rec) {
+            data->rec->curDriver = data->rec->curKernel = 0;
+            data->rec->curScreen = -1;
+        }
         break;
       case OC_APPLICATION:
         if (data->inApp-- == data->ignoringApp)
             data->ignoringApp = 0;
+        if (data->rec)
+            data->rec->curExec = 0;
         break;
       case OC_OPTION:
         data->inOption--;
@@ -880,18 +1189,19 @@ initOptionCache(driOptionCache *cache, const driOptionCache *info)
     }
 }
 
-static void
+static bool
 _parseOneConfigFile(XML_Parser p)
 {
 #define BUF_SIZE 0x1000
     struct OptConfData *data = (struct OptConfData *)XML_GetUserData (p);
+    bool complete = false;
     int status;
     int fd;
 
     if ((fd = open (data->name, O_RDONLY)) == -1) {
         __driUtilMessage ("Can't open configuration file %s: %s.",
                           data->name, strerror (errno));
-        return;
+        return false;
     }
 
     while (1) {
@@ -912,11 +1222,14 @@ _parseOneConfigFile(XML_Parser p)
             XML_ERROR ("%s.", XML_ErrorString(XML_GetErrorCode(p)));
             break;
         }
-        if (bytesRead == 0)
+        if (bytesRead == 0) {
+            complete = true;
             break;
+        }
     }
 
     close (fd);
+    return complete;
 #undef BUF_SIZE
 }
 
@@ -925,6 +1238,24 @@ static void
 parseOneConfigFile(struct OptConfData *data, const char *filename)
 {
     XML_Parser p;
+    struct driConfRecorder rec;
+    char cachename[PATH_MAX];
+    struct stat st;
+    bool cacheable = stat (filename, &st) == 0 &&
+                     getConfigCacheName (filename, cachename);
+
+    if (cacheable && loadConfigCache (data, cachename, &st))
+        return;
+
+    memset (&rec, 0, sizeof (rec));
+    rec.curScreen = -1;
+    if (cacheable) {
+        /* Reserve string offset 0; it means "no matcher" in entries. */
+        recAddString (&rec, "");
+        data->rec = &rec;
+    } else {
+        data->rec = NULL;
+    }
 
     p = XML_ParserCreate (NULL); /* use encoding specified by file */
     XML_SetElementHandler (p, optConfStartElem, optConfEndElem);
@@ -938,8 +1269,13 @@ parseOneConfigFile(struct OptConfData *data, const char *filename)
     data->inApp = 0;
     data->inOption = 0;
 
-    _parseOneConfigFile (p);
+    if (_parseOneConfigFile (p) && data->rec && !rec.failed)
+        writeConfigCache (&rec, cachename, &st);
     XML_ParserFree (p);
+
+    data->rec = NULL;
+    free (rec.entries);
+    free (rec.strings);
 }
 
 static int
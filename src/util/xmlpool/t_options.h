@@ -215,6 +215,21 @@ DRI_CONF_OPT_BEGIN_B(adaptive_sync,def) \
         DRI_CONF_DESC(en,gettext("Adapt the monitor sync to the application performance (when possible)")) \
 DRI_CONF_OPT_END
 
+#define DRI_CONF_BLOCK_ON_DEPLETED_BUFFERS(def) \
+DRI_CONF_OPT_BEGIN_B(block_on_depleted_buffers,def) \
+        DRI_CONF_DESC(en,gettext("Limit the swapchain to two buffers when vsynced, so rendering blocks until the previous swap completes instead of queueing frames; trades throughput for a stable, minimal present latency")) \
+DRI_CONF_OPT_END
+
+#define DRI_CONF_MAX_FRAMES_IN_FLIGHT(def) \
+DRI_CONF_OPT_BEGIN_V(max_frames_in_flight, int, def, "0:4") \
+        DRI_CONF_DESC(en,gettext("Maximum number of frames the CPU may queue ahead of the GPU before the swap path throttles (0 = use the driver default)")) \
+DRI_CONF_OPT_END
+
+#define DRI_CONF_THROTTLE_AT_FIRST_DRAW(def) \
+DRI_CONF_OPT_BEGIN_B(throttle_at_first_draw, def) \
+        DRI_CONF_DESC(en,gettext("Wait for the frame-throttle fence at the first use of the new back buffer instead of at SwapBuffers, overlapping the wait with CPU-side frame setup")) \
+DRI_CONF_OPT_END
+
 #define DRI_CONF_MESA_GLTHREAD(def) \
 DRI_CONF_OPT_BEGIN_B(mesa_glthread, def) \
         DRI_CONF_DESC(en,gettext("Enable offloading GL driver work to a separate thread")) \
@@ -0,0 +1,129 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef XXH32_H
+#define XXH32_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * XXH32, the 32-bit variant of xxHash (https://github.com/Cyan4973/xxHash,
+ * algorithm placed in the public domain by Yann Collet).  A one-shot
+ * implementation is all the hash table users need, so we keep this header
+ * self-contained instead of vendoring the full library.
+ *
+ * This is a fast non-cryptographic hash for in-memory keying only: it is
+ * several times faster than FNV-1a on keys bigger than a few bytes and has
+ * far better avalanche behavior.  Anything that names on-disk artifacts
+ * must keep using mesa-sha1.
+ */
+
+#define XXH32_PRIME_1 2654435761u
+#define XXH32_PRIME_2 2246822519u
+#define XXH32_PRIME_3 3266489917u
+#define XXH32_PRIME_4  668265263u
+#define XXH32_PRIME_5  374761393u
+
+static inline uint32_t
+xxh32_rotl(uint32_t x, unsigned r)
+{
+   return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t
+xxh32_read32(const uint8_t *p)
+{
+   uint32_t v;
+   memcpy(&v, p, sizeof(v));
+   return v;
+}
+
+static inline uint32_t
+xxh32_round(uint32_t acc, uint32_t input)
+{
+   acc += input * XXH32_PRIME_2;
+   acc = xxh32_rotl(acc, 13);
+   acc *= XXH32_PRIME_1;
+   return acc;
+}
+
+static inline uint32_t
+xxh32(const void *data, size_t size, uint32_t seed)
+{
+   const uint8_t *p = (const uint8_t *)data;
+   const uint8_t *const end = p + size;
+   uint32_t h;
+
+   if (size >= 16) {
+      uint32_t v1 = seed + XXH32_PRIME_1 + XXH32_PRIME_2;
+      uint32_t v2 = seed + XXH32_PRIME_2;
+      uint32_t v3 = seed;
+      uint32_t v4 = seed - XXH32_PRIME_1;
+
+      do {
+         v1 = xxh32_round(v1, xxh32_read32(p + 0));
+         v2 = xxh32_round(v2, xxh32_read32(p + 4));
+         v3 = xxh32_round(v3, xxh32_read32(p + 8));
+         v4 = xxh32_round(v4, xxh32_read32(p + 12));
+         p += 16;
+      } while (p <= end - 16);
+
+      h = xxh32_rotl(v1, 1) + xxh32_rotl(v2, 7) +
+          xxh32_rotl(v3, 12) + xxh32_rotl(v4, 18);
+   } else {
+      h = seed + XXH32_PRIME_5;
+   }
+
+   h += (uint32_t)size;
+
+   while (p + 4 <= end) {
+      h += xxh32_read32(p) * XXH32_PRIME_3;
+      h = xxh32_rotl(h, 17) * XXH32_PRIME_4;
+      p += 4;
+   }
+
+   while (p < end) {
+      h += *p * XXH32_PRIME_5;
+      h = xxh32_rotl(h, 11) * XXH32_PRIME_1;
+      p++;
+   }
+
+   h ^= h >> 15;
+   h *= XXH32_PRIME_2;
+   h ^= h >> 13;
+   h *= XXH32_PRIME_3;
+   h ^= h >> 16;
+
+   return h;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XXH32_H */
@@ -24,6 +24,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include <vulkan/vulkan.h>
 #include <vulkan/vk_layer.h>
@@ -31,6 +34,7 @@
 #include "imgui.h"
 
 #include "overlay_params.h"
+#include "overlay_stats_shm.h"
 
 #include "util/debug.h"
 #include "util/hash_table.h"
@@ -51,6 +55,10 @@ struct instance_data {
    bool pipeline_statistics_enabled;
 
    bool first_line_printed;
+
+   /* Per-frame stats ring shared with external readers (stats_shm param) */
+   struct overlay_stats_shm *stats_shm;
+   int stats_shm_fd;
 };
 
 struct frame_stat {
@@ -320,10 +328,54 @@ static struct instance_data *new_instance_data(VkInstance instance)
    return data;
 }
 
+static void instance_stats_shm_setup(struct instance_data *data)
+{
+   int fd = open(data->params.stats_shm, O_CREAT | O_RDWR, 0644);
+   if (fd < 0) {
+      fprintf(stderr, "mesa-overlay: unable to open '%s'\n",
+              data->params.stats_shm);
+      return;
+   }
+
+   if (ftruncate(fd, sizeof(struct overlay_stats_shm)) < 0) {
+      close(fd);
+      return;
+   }
+
+   void *map = mmap(NULL, sizeof(struct overlay_stats_shm),
+                    PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (map == MAP_FAILED) {
+      close(fd);
+      return;
+   }
+
+   data->stats_shm = (struct overlay_stats_shm *) map;
+   data->stats_shm_fd = fd;
+
+   /* Reset head before publishing the magic, so a reader attached to a
+    * stale file from a previous run doesn't replay old frames. */
+   data->stats_shm->head = 0;
+   data->stats_shm->stats_count = OVERLAY_PARAM_ENABLED_MAX;
+   data->stats_shm->pid = getpid();
+   data->stats_shm->version = OVERLAY_STATS_SHM_VERSION;
+   __atomic_store_n(&data->stats_shm->magic, (uint32_t)OVERLAY_STATS_SHM_MAGIC,
+                    __ATOMIC_RELEASE);
+}
+
+static void instance_stats_shm_teardown(struct instance_data *data)
+{
+   if (!data->stats_shm)
+      return;
+   munmap(data->stats_shm, sizeof(struct overlay_stats_shm));
+   close(data->stats_shm_fd);
+}
+
 static void destroy_instance_data(struct instance_data *data)
 {
    if (data->params.output_file)
       fclose(data->params.output_file);
+   instance_stats_shm_teardown(data);
+   free((char *)data->params.stats_shm);
    unmap_object(HKEY(data->instance));
    ralloc_free(data);
 }
@@ -571,6 +623,21 @@ static void snapshot_swapchain_frame(struct swapchain_data *data)
       data->accumulated_stats.stats[s] += device_data->frame_stats.stats[s] + data->frame_stats.stats[s];
    }
 
+   if (instance_data->stats_shm) {
+      struct overlay_stats_shm *shm = instance_data->stats_shm;
+      struct overlay_stats_shm_frame *frame =
+         &shm->frames[shm->head % OVERLAY_STATS_SHM_FRAMES];
+
+      frame->n_frame = data->n_frames;
+      frame->present_time_us = now;
+      memcpy(frame->stats, data->frames_stats[f_idx].stats,
+             sizeof(frame->stats));
+
+      /* Publish the slot. Readers load head with acquire semantics and
+       * detect overwrites by re-reading it after copying. */
+      __atomic_store_n(&shm->head, shm->head + 1, __ATOMIC_RELEASE);
+   }
+
    if (data->last_fps_update) {
       double elapsed = (double)(now - data->last_fps_update); /* us */
       if (elapsed >= instance_data->params.fps_sampling_period) {
@@ -2180,6 +2247,9 @@ static VkResult overlay_CreateInstance(
 
    parse_overlay_env(&instance_data->params, getenv("VK_LAYER_MESA_OVERLAY_CONFIG"));
 
+   if (instance_data->params.stats_shm)
+      instance_stats_shm_setup(instance_data);
+
    for (int i = OVERLAY_PARAM_ENABLED_vertices;
         i <= OVERLAY_PARAM_ENABLED_compute_invocations; i++) {
       if (instance_data->params.enabled[i]) {
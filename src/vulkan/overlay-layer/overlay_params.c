@@ -59,6 +59,12 @@ parse_no_display(const char *str)
    return strtol(str, NULL, 0) != 0;
 }
 
+static const char *
+parse_stats_shm(const char *str)
+{
+   return strdup(str);
+}
+
 static unsigned
 parse_unsigned(const char *str)
 {
@@ -82,6 +88,7 @@ parse_help(const char *str)
    fprintf(stderr, "\tfps_sampling_period=number-of-milliseconds\n");
    fprintf(stderr, "\tno_display=0|1\n");
    fprintf(stderr, "\toutput_file=/path/to/output.txt\n");
+   fprintf(stderr, "\tstats_shm=/path/to/shared/ring (see overlay_stats_shm.h)\n");
    fprintf(stderr, "\twidth=width-in-pixels\n");
    fprintf(stderr, "\theight=height-in-pixels\n");
 
@@ -68,6 +68,7 @@ extern "C" {
    OVERLAY_PARAM_CUSTOM(width)                       \
    OVERLAY_PARAM_CUSTOM(height)                      \
    OVERLAY_PARAM_CUSTOM(no_display)                  \
+   OVERLAY_PARAM_CUSTOM(stats_shm)                   \
    OVERLAY_PARAM_CUSTOM(help)
 
 enum overlay_param_position {
@@ -93,6 +94,7 @@ struct overlay_params {
    uint32_t fps_sampling_period; /* us */
    bool help;
    bool no_display;
+   const char *stats_shm;
    unsigned width;
    unsigned height;
 };
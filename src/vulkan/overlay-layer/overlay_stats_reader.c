@@ -0,0 +1,135 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* Companion tool for the overlay layer's stats_shm option: attaches to the
+ * shared ring exported by the layer and streams one CSV line per presented
+ * frame to stdout, without the monitored application ever blocking on us.
+ *
+ *    VK_LAYER_MESA_OVERLAY_CONFIG=no_display,stats_shm=/dev/shm/game ... &
+ *    mesa-overlay-stats /dev/shm/game
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "overlay_stats_shm.h"
+
+static void
+print_frame(const struct overlay_stats_shm_frame *frame)
+{
+   int s;
+
+   printf("%" PRIu64 ", %" PRIu64, frame->n_frame, frame->present_time_us);
+   for (s = 0; s < OVERLAY_PARAM_ENABLED_MAX; s++)
+      printf(", %" PRIu64, frame->stats[s]);
+   printf("\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+   const struct overlay_stats_shm *shm;
+   struct overlay_stats_shm_frame frame;
+   uint64_t tail = 0, head;
+   void *map;
+   int fd, s;
+
+   if (argc != 2) {
+      fprintf(stderr, "usage: %s /path/to/stats_shm/file\n", argv[0]);
+      return 1;
+   }
+
+   fd = open(argv[1], O_RDONLY);
+   if (fd < 0) {
+      fprintf(stderr, "%s: %s: %s\n", argv[0], argv[1], strerror(errno));
+      return 1;
+   }
+
+   map = mmap(NULL, sizeof(*shm), PROT_READ, MAP_SHARED, fd, 0);
+   if (map == MAP_FAILED) {
+      fprintf(stderr, "%s: mmap: %s\n", argv[0], strerror(errno));
+      return 1;
+   }
+   shm = map;
+
+   /* The layer writes the magic last, so wait for it rather than racing
+    * with a layer that is still initializing the file. */
+   while (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) !=
+          OVERLAY_STATS_SHM_MAGIC)
+      usleep(100000);
+
+   if (shm->version != OVERLAY_STATS_SHM_VERSION ||
+       shm->stats_count != OVERLAY_PARAM_ENABLED_MAX) {
+      fprintf(stderr, "%s: layer exports version %u with %u stats, "
+              "this tool was built for version %u with %u\n", argv[0],
+              shm->version, shm->stats_count,
+              OVERLAY_STATS_SHM_VERSION, OVERLAY_PARAM_ENABLED_MAX);
+      return 1;
+   }
+
+   printf("frame, present_time(us)");
+   for (s = 0; s < OVERLAY_PARAM_ENABLED_MAX; s++)
+      printf(", %s", overlay_param_names[s]);
+   printf("\n");
+
+   while (1) {
+      head = __atomic_load_n(&shm->head, __ATOMIC_ACQUIRE);
+
+      if (head == tail) {
+         usleep(1000);
+         continue;
+      }
+
+      /* If we fell a full ring behind, the oldest frames are gone; resume
+       * from the oldest one still guaranteed intact.  At a lag of exactly
+       * OVERLAY_STATS_SHM_FRAMES the writer may already be overwriting
+       * slot tail, so that one is lost too. */
+      if (head - tail >= OVERLAY_STATS_SHM_FRAMES)
+         tail = head - OVERLAY_STATS_SHM_FRAMES + 1;
+
+      for (; tail < head; tail++) {
+         memcpy(&frame, &shm->frames[tail % OVERLAY_STATS_SHM_FRAMES],
+                sizeof(frame));
+
+         /* The writer may have lapped us while we copied; it fills a slot
+          * before publishing it in head, so a lag of a full ring already
+          * means slot tail may have been mid-overwrite.  Drop the torn
+          * slot and let the outer loop resynchronize. */
+         if (__atomic_load_n(&shm->head, __ATOMIC_ACQUIRE) - tail >=
+             OVERLAY_STATS_SHM_FRAMES)
+            break;
+
+         print_frame(&frame);
+      }
+      fflush(stdout);
+   }
+
+   return 0;
+}
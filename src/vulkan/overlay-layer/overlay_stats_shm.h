@@ -0,0 +1,72 @@
+/*
+ * Copyright © 2019 Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef OVERLAY_STATS_SHM_H
+#define OVERLAY_STATS_SHM_H
+
+#include <stdint.h>
+
+#include "overlay_params.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Layout of the file exported with stats_shm=/path (put it on a tmpfs like
+ * /dev/shm to make it an actual shared-memory ring).  The layer is the
+ * single writer; any number of readers may map the file read-only.
+ *
+ * Writes use a monotonic head counter: the writer fills
+ * frames[head % OVERLAY_STATS_SHM_FRAMES] and then bumps head with release
+ * semantics.  A reader snapshots head, copies the frames it wants, and
+ * reads head again; if it advanced by OVERLAY_STATS_SHM_FRAMES or more in
+ * the meantime the copy may be torn and should be retried.  Neither side
+ * ever takes a lock.
+ */
+
+#define OVERLAY_STATS_SHM_MAGIC   0x4c52564f /* 'OVRL' */
+#define OVERLAY_STATS_SHM_VERSION 1
+#define OVERLAY_STATS_SHM_FRAMES  256
+
+struct overlay_stats_shm_frame {
+   uint64_t n_frame;
+   uint64_t present_time_us;
+   uint64_t stats[OVERLAY_PARAM_ENABLED_MAX];
+};
+
+struct overlay_stats_shm {
+   uint32_t magic;
+   uint32_t version;
+   /* OVERLAY_PARAM_ENABLED_MAX of the writer, so a reader built against a
+    * different layer version can refuse to parse rather than misparse */
+   uint32_t stats_count;
+   uint32_t pid;
+   uint64_t head;
+   struct overlay_stats_shm_frame frames[OVERLAY_STATS_SHM_FRAMES];
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OVERLAY_STATS_SHM_H */
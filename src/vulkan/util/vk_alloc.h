@@ -122,4 +122,98 @@ vk_free2(const VkAllocationCallbacks *parent_alloc,
       vk_free(parent_alloc, data);
 }
 
+/* A trivial bump allocator for transient allocations whose lifetimes all
+ * end at the same point, e.g. at vkResetCommandBuffer time. Individual
+ * allocations cannot be freed; vk_arena_reset() reclaims everything at
+ * once while keeping the most recent (largest) block for reuse, so a
+ * command buffer recorded repeatedly stops hitting the parent allocator
+ * entirely.
+ */
+struct vk_arena_block {
+   struct vk_arena_block *next;
+   size_t size;
+   size_t used;
+   /* data follows */
+};
+
+struct vk_arena {
+   const VkAllocationCallbacks *parent;
+   struct vk_arena_block *blocks;
+   size_t block_size;
+};
+
+static inline void
+vk_arena_init(struct vk_arena *arena,
+              const VkAllocationCallbacks *parent,
+              size_t block_size)
+{
+   arena->parent = parent;
+   arena->blocks = NULL;
+   arena->block_size = block_size;
+}
+
+static inline void *
+vk_arena_alloc(struct vk_arena *arena, size_t size, size_t align)
+{
+   struct vk_arena_block *block = arena->blocks;
+   uintptr_t base, offset;
+
+   if (block) {
+      base = (uintptr_t)(block + 1);
+      offset = ((base + block->used + align - 1) & ~(uintptr_t)(align - 1)) - base;
+      if (offset + size <= block->size) {
+         block->used = offset + size;
+         return (char *)base + offset;
+      }
+   }
+
+   size_t block_size = arena->block_size;
+   if (block_size < size + align)
+      block_size = size + align;
+
+   block = (struct vk_arena_block *)
+      vk_alloc(arena->parent, sizeof(*block) + block_size, 8,
+               VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+   if (block == NULL)
+      return NULL;
+
+   block->next = arena->blocks;
+   block->size = block_size;
+   arena->blocks = block;
+
+   base = (uintptr_t)(block + 1);
+   offset = ((base + align - 1) & ~(uintptr_t)(align - 1)) - base;
+   block->used = offset + size;
+   return (char *)base + offset;
+}
+
+static inline void
+vk_arena_reset(struct vk_arena *arena)
+{
+   struct vk_arena_block *block = arena->blocks;
+
+   if (block == NULL)
+      return;
+
+   /* Keep the head block so that in steady state, when one block is
+    * enough, re-recording never returns to the parent allocator. */
+   for (struct vk_arena_block *b = block->next, *next; b; b = next) {
+      next = b->next;
+      vk_free(arena->parent, b);
+   }
+
+   block->next = NULL;
+   block->used = 0;
+}
+
+static inline void
+vk_arena_finish(struct vk_arena *arena)
+{
+   for (struct vk_arena_block *b = arena->blocks, *next; b; b = next) {
+      next = b->next;
+      vk_free(arena->parent, b);
+   }
+   arena->blocks = NULL;
+}
+
 #endif
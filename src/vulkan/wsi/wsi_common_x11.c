@@ -883,14 +883,41 @@ x11_acquire_next_image_poll_x11(struct x11_swapchain *chain,
    struct pollfd pfds;
    uint64_t atimeout;
    while (1) {
+      /* Drain any present events we have already received, so the scan
+       * below sees the freshest idle state rather than freeing images one
+       * event at a time.
+       */
+      while ((event = xcb_poll_for_special_event(chain->conn,
+                                                 chain->special_event))) {
+         VkResult result = x11_handle_dri3_present_event(chain, (void *)event);
+         free(event);
+         if (result < 0)
+            return x11_swapchain_result(chain, result);
+      }
+
+      uint32_t candidate = UINT32_MAX;
       for (uint32_t i = 0; i < chain->base.image_count; i++) {
-         if (!chain->images[i].busy) {
-            /* We found a non-busy image */
-            xshmfence_await(chain->images[i].shm_fence);
-            *image_index = i;
-            chain->images[i].busy = true;
-            return x11_swapchain_result(chain, VK_SUCCESS);
+         if (chain->images[i].busy)
+            continue;
+
+         /* Prefer an image whose serverside fence has already fired, so we
+          * don't sit in xshmfence_await below while a ready image exists.
+          */
+         if (xshmfence_query(chain->images[i].shm_fence)) {
+            candidate = i;
+            break;
          }
+
+         if (candidate == UINT32_MAX)
+            candidate = i;
+      }
+
+      if (candidate != UINT32_MAX) {
+         /* We found a non-busy image */
+         xshmfence_await(chain->images[candidate].shm_fence);
+         *image_index = candidate;
+         chain->images[candidate].busy = true;
+         return x11_swapchain_result(chain, VK_SUCCESS);
       }
 
       xcb_flush(chain->conn);